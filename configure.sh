@@ -18,6 +18,7 @@ lingeling=unknown
 minisat=unknown
 picosat=unknown
 cadical=unknown
+ipasir=unknown
 
 lingeling_dir=
 minisat_dir=
@@ -72,6 +73,7 @@ can not be found.
   --no-lingeling         do not use Lingeling
   --no-minisat           do not use MiniSAT
   --no-picosat           do not use PicoSAT
+  --no-ipasir            do not support loading IPASIR solvers at runtime
 
   --only-cadical         only use CaDiCaL
   --only-lingeling       only use Lingeling
@@ -142,6 +144,7 @@ do
     --no-lingeling) lingeling=no;;
     --no-minisat)   minisat=no;;
     --no-picosat)   picosat=no;;
+    --no-ipasir)    ipasir=no;;
 
     --only-cadical)   lingeling=no;minisat=no;picosat=no;cadical=yes;;
     --only-lingeling) lingeling=yes;minisat=no;picosat=no;cadical=no;;
@@ -197,6 +200,7 @@ cmake_opts="$CMAKE_OPTS"
 [ $lingeling = no ] && cmake_opts="$cmake_opts -DUSE_LINGELING=OFF"
 [ $minisat = no ] && cmake_opts="$cmake_opts -DUSE_MINISAT=OFF"
 [ $picosat = no ] && cmake_opts="$cmake_opts -DUSE_PICOSAT=OFF"
+[ $ipasir = no ] && cmake_opts="$cmake_opts -DUSE_IPASIR=OFF"
 
 [ $gcov = yes ] && cmake_opts="$cmake_opts -DGCOV=ON"
 [ $gprof = yes ] && cmake_opts="$cmake_opts -DGPROF=ON"
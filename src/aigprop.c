@@ -7,6 +7,7 @@
  */
 
 #include "aigprop.h"
+#include "btoraigsim.h"
 #include "btorclone.h"
 #include "btorcore.h"
 #include "utils/btorhashint.h"
@@ -339,76 +340,6 @@ compute_scores (AIGProp *aprop)
 
 /*------------------------------------------------------------------------*/
 
-static void
-recursively_compute_assignment (AIGProp *aprop, BtorAIG *aig)
-{
-  assert (aprop);
-  assert (aprop->model);
-  assert (aig);
-
-  int32_t aleft, aright;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorAIGPtrStack stack;
-  BtorIntHashTable *cache;
-  BtorMemMgr *mm;
-
-  if (btor_aig_is_const (aig)) return;
-
-  mm = aprop->amgr->btor->mm;
-
-  cache = btor_hashint_table_new (mm);
-  BTOR_INIT_STACK (mm, stack);
-  BTOR_PUSH_STACK (stack, aig);
-
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-    assert (!btor_aig_is_const (real_cur));
-    if (btor_hashint_map_contains (aprop->model, real_cur->id)) continue;
-
-    if (btor_aig_is_var (real_cur))
-    {
-      /* initialize with false */
-      btor_hashint_map_add (aprop->model, real_cur->id)->as_int = -1;
-    }
-    else
-    {
-      assert (btor_aig_is_and (real_cur));
-      left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-      right = btor_aig_get_right_child (aprop->amgr, real_cur);
-
-      if (!btor_hashint_table_contains (cache, real_cur->id))
-      {
-        btor_hashint_table_add (cache, real_cur->id);
-        BTOR_PUSH_STACK (stack, cur);
-        if (!btor_aig_is_const (left)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (left)->id))
-          BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (right)->id))
-          BTOR_PUSH_STACK (stack, right);
-      }
-      else
-      {
-        aleft = aigprop_get_assignment_aig (aprop, left);
-        assert (aleft);
-        aright = aigprop_get_assignment_aig (aprop, right);
-        assert (aright);
-        if (aleft < 0 || aright < 0)
-          btor_hashint_map_add (aprop->model, real_cur->id)->as_int = -1;
-        else
-          btor_hashint_map_add (aprop->model, real_cur->id)->as_int = 1;
-      }
-    }
-  }
-
-  btor_hashint_table_delete (cache);
-  BTOR_RELEASE_STACK (stack);
-}
-
 void
 aigprop_delete_model (AIGProp *aprop)
 {
@@ -428,20 +359,102 @@ aigprop_init_model (AIGProp *aprop)
   aprop->model = btor_hashint_map_new (aprop->amgr->btor->mm);
 }
 
+static BtorAIGSim *
+new_sim (AIGProp *aprop)
+{
+  BtorAIGPtrStack roots;
+  BtorIntHashTableIterator it;
+  BtorAIGSim *res;
+
+  BTOR_INIT_STACK (aprop->amgr->btor->mm, roots);
+  btor_iter_hashint_init (&it, aprop->roots);
+  while (btor_iter_hashint_has_next (&it))
+    BTOR_PUSH_STACK (
+        roots,
+        btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
+  res = btor_aig_sim_new (
+      aprop->amgr, roots.start, BTOR_COUNT_STACK (roots), 1, false);
+  BTOR_RELEASE_STACK (roots);
+  return res;
+}
+
+/* Set the assignment of all nodes of 'sim' to input pattern 'pattern'. */
+static void
+set_model_from_sim (AIGProp *aprop, BtorAIGSim *sim, uint32_t pattern)
+{
+  uint32_t i;
+  uint64_t word;
+  BtorAIG *aig;
+  BtorHashTableData *d;
+
+  for (i = 0; i < btor_aig_sim_num_nodes (sim); i++)
+  {
+    aig  = BTOR_PEEK_STACK (sim->nodes, i);
+    word = btor_aig_sim_get_words (sim, i)[0];
+    d    = btor_hashint_map_get (aprop->model, aig->id);
+    if (!d) d = btor_hashint_map_add (aprop->model, aig->id);
+    d->as_int = (word >> pattern) & 1 ? 1 : -1;
+  }
+}
+
 void
 aigprop_generate_model (AIGProp *aprop, bool reset)
 {
   assert (aprop);
   assert (aprop->roots);
 
-  BtorIntHashTableIterator it;
+  uint32_t i;
+  BtorAIG *aig;
+  BtorAIGSim *sim;
+  BtorHashTableData *d;
 
   if (reset) aigprop_init_model (aprop);
 
+  /* inputs without assignment are initialized with false */
+  sim = new_sim (aprop);
+  for (i = 0; i < btor_aig_sim_num_nodes (sim); i++)
+  {
+    if (!btor_aig_sim_is_input (sim, i)) continue;
+    aig = BTOR_PEEK_STACK (sim->nodes, i);
+    d   = btor_hashint_map_get (aprop->model, aig->id);
+    btor_aig_sim_get_words (sim, i)[0] = d && d->as_int > 0 ? 1 : 0;
+  }
+  btor_aig_sim_run (sim, 0, 1);
+  set_model_from_sim (aprop, sim, 0);
+  btor_aig_sim_delete (sim);
+}
+
+/* Generate a new model from the best of 64 input patterns w.r.t. the number
+ * of satisfied roots. Pattern 0 initializes all inputs with false, all
+ * other patterns are random. */
+static void
+generate_initial_model (AIGProp *aprop, BtorAIGSim *sim)
+{
+  uint32_t i, best, num_unsat[64];
+  uint64_t word;
+  BtorIntHashTableIterator it;
+
+  btor_aig_sim_randomize (sim, &aprop->rng, 0, 1);
+  for (i = 0; i < btor_aig_sim_num_nodes (sim); i++)
+  {
+    if (!btor_aig_sim_is_input (sim, i)) continue;
+    btor_aig_sim_get_words (sim, i)[0] &= ~UINT64_C (1);
+  }
+  btor_aig_sim_run (sim, 0, 1);
+
+  memset (num_unsat, 0, sizeof (num_unsat));
   btor_iter_hashint_init (&it, aprop->roots);
   while (btor_iter_hashint_has_next (&it))
-    recursively_compute_assignment (
-        aprop, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
+  {
+    word = btor_aig_sim_get_word (
+        sim, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)), 0);
+    for (i = 0; i < 64; i++) num_unsat[i] += !((word >> i) & 1);
+  }
+  for (i = 1, best = 0; i < 64; i++)
+    if (num_unsat[i] < num_unsat[best]) best = i;
+
+  aigprop_init_model (aprop);
+  set_model_from_sim (aprop, sim, best);
 }
 
 /*------------------------------------------------------------------------*/
@@ -920,6 +933,7 @@ aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
   BtorAIGPtrStack stack;
   BtorIntStack *childparents;
   BtorAIG *root, *cur, *child;
+  BtorAIGSim *sim;
 
   start      = btor_util_time_stamp ();
   sat_result = AIGPROP_UNKNOWN;
@@ -986,8 +1000,9 @@ aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
   btor_hashint_map_delete (cache);
   BTOR_RELEASE_STACK (stack);
 
-  /* generate initial model, all inputs are initialized with false */
-  aigprop_generate_model (aprop, true);
+  /* generate initial model by random simulation */
+  sim = new_sim (aprop);
+  generate_initial_model (aprop, sim);
 
   for (;;)
   {
@@ -1023,7 +1038,7 @@ aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
     }
 
     /* restart */
-    aigprop_generate_model (aprop, true);
+    generate_initial_model (aprop, sim);
     btor_hashint_map_delete (aprop->score);
     aprop->score = 0;
     btor_hashint_map_delete (aprop->unsatroots);
@@ -1046,6 +1061,7 @@ DONE:
   }
   btor_hashint_map_delete (aprop->parents);
   aprop->parents = 0;
+  btor_aig_sim_delete (sim);
   if (aprop->unsatroots) btor_hashint_map_delete (aprop->unsatroots);
   aprop->unsatroots = 0;
   aprop->roots      = 0;
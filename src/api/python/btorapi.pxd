@@ -112,6 +112,9 @@ cdef extern from "boolector.h":
     void boolector_set_sat_solver (Btor * btor, const char * solver) \
       except +raise_py_error
 
+    void boolector_set_result_cache (Btor * btor, const char * path) \
+      except +raise_py_error
+
     void boolector_set_opt (Btor * btor, BtorOption opt, uint32_t val) \
       except +raise_py_error
 
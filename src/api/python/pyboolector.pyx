@@ -1050,6 +1050,21 @@ cdef class Boolector:
         solver = solver.strip().lower()
         btorapi.boolector_set_sat_solver(self._c_btor, _ChPtr(solver)._c_str)
 
+    def Set_result_cache(self, str path):
+        """ Set_result_cache(path)
+
+            Use the persistent result cache stored in file ``path``.
+
+            The file is created if it does not exist. Calls to
+            :func:`~pyboolector.Boolector.Sat` without assumptions return
+            the cached result of the simplified formula without solving
+            on a hit.
+
+            :param path: Cache file name.
+            :type path:  str
+        """
+        btorapi.boolector_set_result_cache(self._c_btor, _ChPtr(path)._c_str)
+
     def Print_model(self, str format = "btor", outfile = None):
         """ Print_model(format = "btor", outfile = None)
 
@@ -501,11 +501,7 @@ boolector_push (Btor *btor, uint32_t level)
   if (level == 0) return;
 
   uint32_t i;
-  for (i = 0; i < level; i++)
-  {
-    BTOR_PUSH_STACK (btor->assertions_trail,
-                     BTOR_COUNT_STACK (btor->assertions));
-  }
+  for (i = 0; i < level; i++) btor_push_context (btor);
   btor->num_push_pop++;
 }
 
@@ -523,18 +519,8 @@ boolector_pop (Btor *btor, uint32_t level)
 
   if (level == 0) return;
 
-  uint32_t i, pos;
-  BtorNode *cur;
-
-  for (i = 0, pos = 0; i < level; i++)
-    pos = BTOR_POP_STACK (btor->assertions_trail);
-
-  while (BTOR_COUNT_STACK (btor->assertions) > pos)
-  {
-    cur = BTOR_POP_STACK (btor->assertions);
-    btor_hashint_table_remove (btor->assertions_cache, btor_node_get_id (cur));
-    btor_node_release (btor, cur);
-  }
+  uint32_t i;
+  for (i = 0; i < level; i++) btor_pop_context (btor);
   btor->num_push_pop++;
 }
 
@@ -567,6 +553,7 @@ boolector_assert (Btor *btor, BoolectorNode *node)
     if (!btor_hashint_table_contains (btor->assertions_cache, id))
     {
       BTOR_PUSH_STACK (btor->assertions, btor_node_copy (btor, exp));
+      BTOR_PUSH_STACK (btor->assertions_lit, 0);
       btor_hashint_table_add (btor->assertions_cache, id);
     }
   }
@@ -784,11 +771,17 @@ boolector_set_sat_solver (Btor *btor, const char *solver)
     sat_engine = BTOR_SAT_ENGINE_MINISAT;
   else if (!strcasecmp (solver, "cadical"))
     sat_engine = BTOR_SAT_ENGINE_CADICAL;
+  else if (!strncasecmp (solver, "ipasir:", 7))
+  {
+    BTOR_ABORT (!solver[7], "missing library path for IPASIR sat engine");
+    sat_engine = BTOR_SAT_ENGINE_IPASIR;
+  }
   else
     BTOR_ABORT (1, "invalid sat engine '%s' selected", solver);
 
-#if !defined(BTOR_USE_LINGELING) || !defined(BTOR_USE_CADICAL) \
-    || !defined(BTOR_USE_MINISAT) || !defined(BTOR_USE_PICOSAT)
+#if !defined(BTOR_USE_LINGELING) || !defined(BTOR_USE_CADICAL)  \
+    || !defined(BTOR_USE_MINISAT) || !defined(BTOR_USE_PICOSAT) \
+    || !defined(BTOR_USE_IPASIR)
   uint32_t oldval = btor_opt_get (btor, BTOR_OPT_SAT_ENGINE);
 #endif
 #ifndef BTOR_USE_LINGELING
@@ -839,13 +832,43 @@ boolector_set_sat_solver (Btor *btor, const char *solver)
     sat_engine = oldval;
   }
 #endif
+#ifndef BTOR_USE_IPASIR
+  if (sat_engine == BTOR_SAT_ENGINE_IPASIR)
+  {
+    BTOR_WARN (true,
+               "IPASIR support not compiled in, using %s",
+               oldval == BTOR_SAT_ENGINE_CADICAL
+                   ? "CaDiCaL"
+                   : (oldval == BTOR_SAT_ENGINE_LINGELING
+                          ? "Lingeling"
+                          : (oldval == BTOR_SAT_ENGINE_MINISAT ? "MiniSat"
+                                                               : "PicoSAT")));
+    sat_engine = oldval;
+  }
+#endif
 
+  if (sat_engine == BTOR_SAT_ENGINE_IPASIR)
+    btor_opt_set_str (btor, BTOR_OPT_SAT_ENGINE, solver + 7);
   btor_opt_set (btor, BTOR_OPT_SAT_ENGINE, sat_engine);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (set_sat_solver, solver);
 #endif
 }
 
+void
+boolector_set_result_cache (Btor *btor, const char *path)
+{
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("%s", path);
+  BTOR_ABORT_ARG_NULL (path);
+  BTOR_ABORT (btor->result_cache, "result cache already set");
+  btor->result_cache = btor_result_cache_new (btor, path);
+  BTOR_ABORT (!btor->result_cache, "failed to open result cache '%s'", path);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (set_result_cache, path);
+#endif
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -860,6 +883,16 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
       val,
       btor_opt_get_lng (btor, opt));
 
+  BTOR_ABORT (opt == BTOR_OPT_AIG_PG && btor->btor_sat_btor_called > 0
+                  && val != btor_opt_get (btor, opt),
+              "enabling/disabling polarity-aware CNF encoding must be done "
+              "before calling 'boolector_sat'");
+  BTOR_ABORT (opt == BTOR_OPT_SAT_ENGINE_PORTFOLIO
+                  && btor->btor_sat_btor_called > 0
+                  && val != btor_opt_get (btor, opt),
+              "setting the size of the SAT solver portfolio must be done "
+              "before calling 'boolector_sat'");
+
   if (val)
   {
     if (opt == BTOR_OPT_INCREMENTAL)
@@ -904,8 +937,9 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
     }
   }
 
-#if !defined(BTOR_USE_LINGELING) || !defined(BTOR_USE_CADICAL) \
-    || !defined(BTOR_USE_MINISAT) || !defined(BTOR_USE_PICOSAT)
+#if !defined(BTOR_USE_LINGELING) || !defined(BTOR_USE_CADICAL)  \
+    || !defined(BTOR_USE_MINISAT) || !defined(BTOR_USE_PICOSAT) \
+    || !defined(BTOR_USE_IPASIR)
   uint32_t oldval = btor_opt_get (btor, opt);
 #endif
 
@@ -958,6 +992,21 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
                                                             : "MiniSat"));
       val = oldval;
     }
+#endif
+#ifndef BTOR_USE_IPASIR
+    if (val == BTOR_SAT_ENGINE_IPASIR)
+    {
+      BTOR_WARN (
+          true,
+          "IPASIR support not compiled in, using %s",
+          oldval == BTOR_SAT_ENGINE_CADICAL
+              ? "CaDiCaL"
+              : (oldval == BTOR_SAT_ENGINE_LINGELING
+                     ? "Lingeling"
+                     : (oldval == BTOR_SAT_ENGINE_MINISAT ? "MiniSat"
+                                                          : "PicoSAT")));
+      val = oldval;
+    }
 #endif
   }
 
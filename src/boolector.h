@@ -392,6 +392,8 @@ int32_t boolector_simplify (Btor *btor);
   Currently, we support ``Lingeling``, ``PicoSAT``, and ``MiniSAT`` as string
   value of ``solver`` (case insensitive).  This is however
   only possible if the corresponding solvers were enabled at compile time.
+  Any SAT solver implementing the IPASIR interface can be loaded at runtime
+  from a shared library with ``ipasir:<path>`` as value of ``solver``.
   Call this function after boolector_new.
 
   :param btor: Boolector instance
@@ -399,6 +401,21 @@ int32_t boolector_simplify (Btor *btor);
 */
 void boolector_set_sat_solver (Btor *btor, const char *solver);
 
+/*!
+  Use the persistent result cache stored in file ``path``.
+
+  The file is created if it does not exist. On each call to boolector_sat
+  without assumptions, the simplified formula is looked up in the cache and
+  its result is returned without solving on a hit. Results of satisfiable
+  bit-vector formulas are cached together with their model if the formula has
+  at most 4096 input bits. Other satisfiable results are only returned from
+  the cache if model generation is disabled.
+
+  :param btor: Boolector instance.
+  :param path: Cache file name.
+*/
+void boolector_set_result_cache (Btor *btor, const char *path);
+
 /*------------------------------------------------------------------------*/
 
 /*!
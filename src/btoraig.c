@@ -64,19 +64,46 @@
 
 /*------------------------------------------------------------------------*/
 
-static void
-setup_aig_and_add_to_id_table (BtorAIGMgr *amgr, BtorAIG *aig)
+/* Get the node with 'id' in the node storage (which may be unused). */
+static BtorAIG *
+get_aig_slot (BtorAIGMgr *amgr, int32_t id)
+{
+  assert (id >= 2);
+  assert (id < amgr->num_ids);
+  return amgr->chunks.start[id >> BTOR_AIG_CHUNK_BITS]
+         + (id & (BTOR_AIG_CHUNK_SIZE - 1));
+}
+
+/* Allocate a new node, reuse the id of a released node if possible. */
+static BtorAIG *
+new_aig (BtorAIGMgr *amgr)
 {
+  BtorAIG *aig, *chunk;
   int32_t id;
 
-  id = BTOR_COUNT_STACK (amgr->id2aig);
-  BTOR_ABORT (id == INT32_MAX, "AIG id overflow");
+  if (amgr->free_ids)
+  {
+    id             = amgr->free_ids;
+    aig            = get_aig_slot (amgr, id);
+    amgr->free_ids = aig->next;
+  }
+  else
+  {
+    id = amgr->num_ids;
+    BTOR_ABORT (id == INT32_MAX, "AIG id overflow");
+    if ((id & (BTOR_AIG_CHUNK_SIZE - 1)) == 0)
+    {
+      BTOR_NEWN (amgr->btor->mm, chunk, BTOR_AIG_CHUNK_SIZE);
+      BTOR_PUSH_STACK (amgr->chunks, chunk);
+    }
+    amgr->num_ids += 1;
+    aig = get_aig_slot (amgr, id);
+  }
+  memset (aig, 0, sizeof (BtorAIG));
   aig->refs = 1;
   aig->id   = id;
-  BTOR_PUSH_STACK (amgr->id2aig, aig);
-  assert (aig->id >= 0);
-  assert (BTOR_COUNT_STACK (amgr->id2aig) == (size_t) aig->id + 1);
-  assert (BTOR_PEEK_STACK (amgr->id2aig, aig->id) == aig);
+  assert (btor_aig_get_by_id (amgr, id) == aig);
+  return aig;
 }
 
 static BtorAIG *
@@ -87,12 +114,8 @@ new_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   assert (!btor_aig_is_const (right));
 
   BtorAIG *aig;
-  size_t size;
 
-  size = sizeof (BtorAIG) + 2 * sizeof (int32_t);
-  aig  = btor_mem_malloc (amgr->btor->mm, size);
-  memset (aig, 0, size);
-  setup_aig_and_add_to_id_table (amgr, aig);
+  aig              = new_aig (amgr);
   aig->children[0] = btor_aig_get_id (left);
   aig->children[1] = btor_aig_get_id (right);
   amgr->cur_num_aigs++;
@@ -111,6 +134,7 @@ release_cnf_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *aig)
   amgr->cnfid2aig.start[aig->cnf_id] = 0;
   btor_sat_mgr_release_cnf_id (amgr->smgr, aig->cnf_id);
   aig->cnf_id = 0;
+  aig->pol    = 0;
 }
 
 static void
@@ -120,17 +144,24 @@ delete_aig_node (BtorAIGMgr *amgr, BtorAIG *aig)
   assert (amgr);
   if (btor_aig_is_const (aig)) return;
   if (aig->cnf_id) release_cnf_id_aig_mgr (amgr, aig);
-  amgr->id2aig.start[aig->id] = 0;
+  /* ids are reused, drop the value of the deleted node */
+  if (amgr->eval_cache && btor_hashint_map_contains (amgr->eval_cache, aig->id))
+    btor_hashint_map_remove (amgr->eval_cache, aig->id, 0);
   if (aig->is_var)
-  {
     amgr->cur_num_aig_vars--;
-    BTOR_DELETE (amgr->btor->mm, aig);
+  else
+    amgr->cur_num_aigs--;
+  aig->refs = 0;
+  if (amgr->hold_ids)
+  {
+    if (!amgr->held_ids) amgr->held_ids_last = aig->id;
+    aig->next      = amgr->held_ids;
+    amgr->held_ids = aig->id;
   }
   else
   {
-    amgr->cur_num_aigs--;
-    btor_mem_free (
-        amgr->btor->mm, aig, sizeof (BtorAIG) + 2 * sizeof (int32_t));
+    aig->next      = amgr->free_ids;
+    amgr->free_ids = aig->id;
   }
 }
 
@@ -354,8 +385,7 @@ btor_aig_var (BtorAIGMgr *amgr)
 {
   BtorAIG *aig;
   assert (amgr);
-  BTOR_CNEW (amgr->btor->mm, aig);
-  setup_aig_and_add_to_id_table (amgr, aig);
+  aig         = new_aig (amgr);
   aig->is_var = 1;
   amgr->cur_num_aig_vars++;
   if (amgr->max_num_aig_vars < amgr->cur_num_aig_vars)
@@ -411,6 +441,9 @@ simp_aig_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
    * (returns 0) FIXME why? */
   if (btor_aig_is_const (aig)) return aig;
 
+  /* the SAT value of an AND not encoded in both polarities does not
+   * necessarily correspond to its value */
+  if (!btor_aig_is_encoded (aig)) return aig;
   lit = btor_aig_get_cnf_id (aig);
   if (!lit) return aig;
   val = btor_sat_fixed (amgr->smgr, lit);
@@ -420,7 +453,7 @@ simp_aig_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   assert (repr >= 0);
   assert ((size_t) repr < BTOR_SIZE_STACK (amgr->cnfid2aig));
   res = btor_aig_get_by_id (amgr, amgr->cnfid2aig.start[repr]);
-  if (!res) return aig;
+  if (!res || !btor_aig_is_encoded (res)) return aig;
   if (sign) res = BTOR_INVERT_AIG (res);
   return res;
 }
@@ -787,40 +820,23 @@ btor_aig_mgr_new (Btor *btor)
   assert (btor);
 
   BtorAIGMgr *amgr;
+  BtorAIG *chunk;
 
   BTOR_CNEW (btor->mm, amgr);
   amgr->btor = btor;
   BTOR_INIT_AIG_UNIQUE_TABLE (btor->mm, amgr->table);
   amgr->smgr = btor_sat_mgr_new (btor);
-  BTOR_INIT_STACK (btor->mm, amgr->id2aig);
-  BTOR_PUSH_STACK (amgr->id2aig, BTOR_AIG_FALSE);
-  BTOR_PUSH_STACK (amgr->id2aig, BTOR_AIG_TRUE);
+  BTOR_INIT_STACK (btor->mm, amgr->chunks);
+  /* ids 0 and 1 are reserved for the constants */
+  amgr->num_ids = 2;
+  BTOR_NEWN (btor->mm, chunk, BTOR_AIG_CHUNK_SIZE);
+  BTOR_PUSH_STACK (amgr->chunks, chunk);
   assert ((size_t) BTOR_AIG_FALSE == 0);
   assert ((size_t) BTOR_AIG_TRUE == 1);
   BTOR_INIT_STACK (btor->mm, amgr->cnfid2aig);
   return amgr;
 }
 
-static BtorAIG *
-clone_aig (BtorMemMgr *mm, BtorAIG *aig)
-{
-  assert (mm);
-
-  size_t size;
-  BtorAIG *res, *real_aig;
-
-  if (btor_aig_is_const (aig)) return aig;
-
-  real_aig = BTOR_REAL_ADDR_AIG (aig);
-  size     = sizeof (BtorAIG);
-  if (!real_aig->is_var) size += 2 * sizeof (int32_t);
-  res = btor_mem_malloc (mm, size);
-  memcpy (res, real_aig, size);
-
-  res = BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
-  return res;
-}
-
 static void
 clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
 {
@@ -830,24 +846,25 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
   uint32_t i;
   size_t size;
   BtorMemMgr *mm;
-  BtorAIG *aig;
+  BtorAIG *chunk;
 
   mm = clone->btor->mm;
 
-  /* clone id2aig table */
-  BTOR_INIT_STACK (mm, clone->id2aig);
-  size = BTOR_SIZE_STACK (amgr->id2aig);
-  if (size)
+  /* clone node storage, AIGs refer to each other by id only */
+  BTOR_INIT_STACK (mm, clone->chunks);
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->chunks); i++)
   {
-    BTOR_CNEWN (mm, clone->id2aig.start, size);
-    clone->id2aig.end = clone->id2aig.start + size;
-    clone->id2aig.top = clone->id2aig.start + BTOR_COUNT_STACK (amgr->id2aig);
-  }
-  for (i = 0; i < BTOR_COUNT_STACK (amgr->id2aig); i++)
-  {
-    aig = clone_aig (mm, BTOR_PEEK_STACK (amgr->id2aig, i));
-    BTOR_POKE_STACK (clone->id2aig, i, aig);
+    BTOR_NEWN (mm, chunk, BTOR_AIG_CHUNK_SIZE);
+    memcpy (chunk,
+            BTOR_PEEK_STACK (amgr->chunks, i),
+            BTOR_AIG_CHUNK_SIZE * sizeof (BtorAIG));
+    BTOR_PUSH_STACK (clone->chunks, chunk);
   }
+  clone->num_ids       = amgr->num_ids;
+  clone->free_ids      = amgr->free_ids;
+  clone->hold_ids      = amgr->hold_ids;
+  clone->held_ids      = amgr->held_ids;
+  clone->held_ids_last = amgr->held_ids_last;
 
   /* clone unique table */
   BTOR_CNEWN (mm, clone->table.chains, amgr->table.size);
@@ -895,6 +912,10 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->num_cnf_vars     = amgr->num_cnf_vars;
   res->num_cnf_clauses  = amgr->num_cnf_clauses;
   res->num_cnf_literals = amgr->num_cnf_literals;
+  res->num_opt_rewrites    = amgr->num_opt_rewrites;
+  res->num_opt_saved       = amgr->num_opt_saved;
+  res->num_fraig_merges    = amgr->num_fraig_merges;
+  res->num_fraig_sat_calls = amgr->num_fraig_sat_calls;
   clone_aigs (amgr, res);
   return res;
 }
@@ -909,11 +930,36 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   mm = amgr->btor->mm;
   BTOR_RELEASE_AIG_UNIQUE_TABLE (mm, amgr->table);
   btor_sat_mgr_delete (amgr->smgr);
-  BTOR_RELEASE_STACK (amgr->id2aig);
+  while (!BTOR_EMPTY_STACK (amgr->chunks))
+    BTOR_DELETEN (mm, BTOR_POP_STACK (amgr->chunks), BTOR_AIG_CHUNK_SIZE);
+  BTOR_RELEASE_STACK (amgr->chunks);
   BTOR_RELEASE_STACK (amgr->cnfid2aig);
+  if (amgr->eval_cache) btor_hashint_map_delete (amgr->eval_cache);
   BTOR_DELETE (mm, amgr);
 }
 
+void
+btor_aig_mgr_hold_ids (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+  amgr->hold_ids += 1;
+}
+
+void
+btor_aig_mgr_release_ids (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+  assert (amgr->hold_ids > 0);
+
+  amgr->hold_ids -= 1;
+  if (amgr->hold_ids || !amgr->held_ids) return;
+  /* prepend the ids released in the meantime to the free list */
+  get_aig_slot (amgr, amgr->held_ids_last)->next = amgr->free_ids;
+  amgr->free_ids                                 = amgr->held_ids;
+  amgr->held_ids                                 = 0;
+  amgr->held_ids_last                            = 0;
+}
+
 static bool
 is_xor_aig (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIGPtrStack *leafs)
 {
@@ -1109,14 +1155,320 @@ is_or_aig (BtorAIGMgr *amgr, BtorAIG *root, BtorAIGPtrStack *leafs)
 }
 #endif
 
+/* Collect the leafs of the gate encoded for AND 'root', i.e., of an XOR, an
+ * ITE or a (n-ary) AND. */
+static void
+get_gate_leafs_aig (BtorAIGMgr *amgr,
+                    BtorAIG *root,
+                    BtorAIGPtrStack *leafs,
+                    bool *isxor,
+                    bool *isite)
+{
+  assert (amgr);
+  assert (root);
+  assert (!BTOR_IS_INVERTED_AIG (root));
+  assert (btor_aig_is_and (root));
+  assert (leafs);
+  assert (BTOR_EMPTY_STACK (*leafs));
+  assert (isxor);
+  assert (isite);
+
+  if ((*isxor = is_xor_aig (amgr, root, leafs)))
+    *isite = false;
+  else
+    *isite = is_ite_aig (amgr, root, leafs);
+
+  if (*isxor || *isite) return;
+
+#ifdef BTOR_AIG_TO_CNF_NARY_AND
+  BtorAIGPtrStack tree;
+  BtorAIG *cur;
+
+  BTOR_INIT_STACK (amgr->btor->mm, tree);
+  BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, root));
+  BTOR_PUSH_STACK (tree, btor_aig_get_left_child (amgr, root));
+
+  while (!BTOR_EMPTY_STACK (tree))
+  {
+    cur = BTOR_POP_STACK (tree);
+
+    if (BTOR_IS_INVERTED_AIG (cur) || btor_aig_is_var (cur)
+        || cur->refs > 1u || cur->cnf_id)
+    {
+      BTOR_PUSH_STACK (*leafs, cur);
+    }
+    else
+    {
+      BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (tree, btor_aig_get_left_child (amgr, cur));
+    }
+  }
+  BTOR_RELEASE_STACK (tree);
+#else
+  BTOR_PUSH_STACK (*leafs, btor_aig_get_left_child (amgr, root));
+  BTOR_PUSH_STACK (*leafs, btor_aig_get_right_child (amgr, root));
+#endif
+}
+
+/* Add the clauses of gate x = f (leafs) for the directions in 'pol'. */
+static void
+add_gate_clauses_aig (BtorAIGMgr *amgr,
+                      int32_t x,
+                      BtorAIGPtrStack *leafs,
+                      bool isxor,
+                      bool isite,
+                      uint8_t pol)
+{
+  assert (amgr);
+  assert (x > 0);
+  assert (leafs);
+  assert (pol);
+
+  int32_t y, a, b, c;
+  BtorSATMgr *smgr;
+  BtorAIG **p;
+
+  smgr = amgr->smgr;
+
+  if (isxor)
+  {
+    assert (BTOR_COUNT_STACK (*leafs) == 2);
+    a = btor_aig_get_cnf_id (leafs->start[0]);
+    b = btor_aig_get_cnf_id (leafs->start[1]);
+
+    if (pol & BTOR_AIG_POL_POS)
+    {
+      btor_sat_add (smgr, -x);
+      btor_sat_add (smgr, a);
+      btor_sat_add (smgr, -b);
+      btor_sat_add (smgr, 0);
+
+      btor_sat_add (smgr, -x);
+      btor_sat_add (smgr, -a);
+      btor_sat_add (smgr, b);
+      btor_sat_add (smgr, 0);
+      amgr->num_cnf_clauses += 2;
+      amgr->num_cnf_literals += 6;
+    }
+
+    if (pol & BTOR_AIG_POL_NEG)
+    {
+      btor_sat_add (smgr, x);
+      btor_sat_add (smgr, -a);
+      btor_sat_add (smgr, -b);
+      btor_sat_add (smgr, 0);
+
+      btor_sat_add (smgr, x);
+      btor_sat_add (smgr, a);
+      btor_sat_add (smgr, b);
+      btor_sat_add (smgr, 0);
+      amgr->num_cnf_clauses += 2;
+      amgr->num_cnf_literals += 6;
+    }
+  }
+  else if (isite)
+  {
+    assert (BTOR_COUNT_STACK (*leafs) == 3);
+    a = btor_aig_get_cnf_id (leafs->start[0]);  // else
+    b = btor_aig_get_cnf_id (leafs->start[1]);  // then
+    c = btor_aig_get_cnf_id (leafs->start[2]);  // cond
+
+    if (pol & BTOR_AIG_POL_POS)
+    {
+      btor_sat_add (smgr, -x);
+      btor_sat_add (smgr, -c);
+      btor_sat_add (smgr, b);
+      btor_sat_add (smgr, 0);
+
+      btor_sat_add (smgr, -x);
+      btor_sat_add (smgr, c);
+      btor_sat_add (smgr, a);
+      btor_sat_add (smgr, 0);
+      amgr->num_cnf_clauses += 2;
+      amgr->num_cnf_literals += 6;
+    }
+
+    if (pol & BTOR_AIG_POL_NEG)
+    {
+      btor_sat_add (smgr, x);
+      btor_sat_add (smgr, -c);
+      btor_sat_add (smgr, -b);
+      btor_sat_add (smgr, 0);
+
+      btor_sat_add (smgr, x);
+      btor_sat_add (smgr, c);
+      btor_sat_add (smgr, -a);
+      btor_sat_add (smgr, 0);
+      amgr->num_cnf_clauses += 2;
+      amgr->num_cnf_literals += 6;
+    }
+  }
+  else
+  {
+    if (pol & BTOR_AIG_POL_NEG)
+    {
+      for (p = leafs->start; p < leafs->top; p++)
+      {
+        y = btor_aig_get_cnf_id (*p);
+        assert (y);
+        btor_sat_add (smgr, -y);
+        amgr->num_cnf_literals++;
+      }
+      btor_sat_add (smgr, x);
+      btor_sat_add (smgr, 0);
+      amgr->num_cnf_clauses++;
+      amgr->num_cnf_literals++;
+    }
+
+    if (pol & BTOR_AIG_POL_POS)
+    {
+      for (p = leafs->start; p < leafs->top; p++)
+      {
+        y = btor_aig_get_cnf_id (*p);
+        assert (y);
+        btor_sat_add (smgr, -x);
+        btor_sat_add (smgr, y);
+        btor_sat_add (smgr, 0);
+        amgr->num_cnf_clauses++;
+        amgr->num_cnf_literals += 2;
+      }
+    }
+  }
+}
+
+/* Polarities of the regular AIG required for polarities 'pol' of 'aig'. */
+static inline uint8_t
+real_pol_aig (const BtorAIG *aig, uint8_t pol)
+{
+  if (!BTOR_IS_INVERTED_AIG (aig)) return pol;
+  return ((pol & BTOR_AIG_POL_POS) << 1) | ((pol & BTOR_AIG_POL_NEG) >> 1);
+}
+
+/* Polarity-aware (Plaisted-Greenbaum) transformation of AIG 'start' such
+ * that its polarities 'pol' are defined. Required polarities are propagated
+ * top-down to the leafs of each gate and only clause directions that have
+ * not been generated yet are added bottom-up. The CNF ids of ANDs that are
+ * not encoded in both polarities are never released, since a later call
+ * may add the missing direction.
+ */
+static void
+aig_to_sat_pg (BtorAIGMgr *amgr, BtorAIG *start, uint8_t pol)
+{
+  assert (amgr);
+  assert (pol);
+
+  BtorAIGPtrStack stack, leafs, order;
+  BtorAIG *cur, *leaf, **p;
+  bool isxor, isite;
+  uint8_t need, lpol;
+  BtorMemMgr *mm;
+  size_t i;
+
+  if (btor_aig_is_const (start)) return;
+
+  pol   = real_pol_aig (start, pol);
+  start = BTOR_REAL_ADDR_AIG (start);
+
+  if (btor_aig_is_var (start))
+  {
+    if (!start->cnf_id) set_next_id_aig_mgr (amgr, start);
+    return;
+  }
+
+  if ((start->pol & pol) == pol) return;
+
+  mm = amgr->btor->mm;
+  BTOR_INIT_STACK (mm, stack);
+  BTOR_INIT_STACK (mm, leafs);
+  BTOR_INIT_STACK (mm, order);
+
+  /* collect ANDs that are not encoded in both polarities in post-order */
+  BTOR_PUSH_STACK (stack, start);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (stack));
+
+    if (cur->mark == 2 || btor_aig_is_var (cur)
+        || cur->pol == BTOR_AIG_POL_BOTH)
+      continue;
+
+    if (cur->mark == 0)
+    {
+      cur->mark = 1;
+      BTOR_PUSH_STACK (stack, cur);
+      get_gate_leafs_aig (amgr, cur, &leafs, &isxor, &isite);
+      for (p = leafs.start; p < leafs.top; p++) BTOR_PUSH_STACK (stack, *p);
+      BTOR_RESET_STACK (leafs);
+    }
+    else
+    {
+      assert (cur->mark == 1);
+      cur->mark = 2;
+      BTOR_PUSH_STACK (order, cur);
+    }
+  }
+
+  /* propagate required polarities top-down */
+  assert (!start->local);
+  start->local = pol;
+  for (i = BTOR_COUNT_STACK (order); i > 0; i--)
+  {
+    cur  = BTOR_PEEK_STACK (order, i - 1);
+    need = cur->local & ~cur->pol;
+    if (!need) continue;
+
+    get_gate_leafs_aig (amgr, cur, &leafs, &isxor, &isite);
+    for (p = leafs.start; p < leafs.top; p++)
+    {
+      leaf = *p;
+      /* inputs of XORs and conditions of ITEs occur in both phases in the
+       * clauses of either direction */
+      if (isxor || (isite && p == leafs.start + 2))
+        lpol = BTOR_AIG_POL_BOTH;
+      else
+        lpol = real_pol_aig (leaf, need);
+      leaf = BTOR_REAL_ADDR_AIG (leaf);
+
+      if (btor_aig_is_var (leaf))
+      {
+        if (!leaf->cnf_id) set_next_id_aig_mgr (amgr, leaf);
+      }
+      else if ((leaf->pol & lpol) != lpol)
+      {
+        assert (leaf->mark == 2);
+        leaf->local |= lpol;
+      }
+    }
+    BTOR_RESET_STACK (leafs);
+  }
+
+  /* encode missing directions bottom-up */
+  for (i = 0; i < BTOR_COUNT_STACK (order); i++)
+  {
+    cur        = BTOR_PEEK_STACK (order, i);
+    need       = cur->local & ~cur->pol;
+    cur->mark  = 0;
+    cur->local = 0;
+    if (!need) continue;
+
+    if (!cur->cnf_id) set_next_id_aig_mgr (amgr, cur);
+    get_gate_leafs_aig (amgr, cur, &leafs, &isxor, &isite);
+    add_gate_clauses_aig (amgr, cur->cnf_id, &leafs, isxor, isite, need);
+    cur->pol |= need;
+    BTOR_RESET_STACK (leafs);
+  }
+
+  BTOR_RELEASE_STACK (order);
+  BTOR_RELEASE_STACK (leafs);
+  BTOR_RELEASE_STACK (stack);
+}
+
 void
 btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 {
-  BtorAIGPtrStack stack, tree, leafs, marked;
-  int32_t x, y, a, b, c;
+  BtorAIGPtrStack stack, leafs, marked;
   bool isxor, isite;
   BtorAIG *root, *cur;
-  BtorSATMgr *smgr;
   BtorMemMgr *mm;
   uint32_t local;
   BtorAIG **p;
@@ -1125,11 +1477,15 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 
   assert (amgr);
 
-  smgr = amgr->smgr;
-  mm   = amgr->btor->mm;
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_PG))
+  {
+    aig_to_sat_pg (amgr, start, BTOR_AIG_POL_BOTH);
+    return;
+  }
+
+  mm = amgr->btor->mm;
 
   BTOR_INIT_STACK (mm, stack);
-  BTOR_INIT_STACK (mm, tree);
   BTOR_INIT_STACK (mm, leafs);
   BTOR_INIT_STACK (mm, marked);
 
@@ -1158,40 +1514,9 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 
     assert (root->mark < 2);
     assert (btor_aig_is_and (root));
-    assert (BTOR_EMPTY_STACK (tree));
     assert (BTOR_EMPTY_STACK (leafs));
 
-    if ((isxor = is_xor_aig (amgr, root, &leafs)))
-      isite = 0;
-    else
-      isite = is_ite_aig (amgr, root, &leafs);
-
-    if (!isxor && !isite)
-    {
-#ifdef BTOR_AIG_TO_CNF_NARY_AND
-      BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, root));
-      BTOR_PUSH_STACK (tree, btor_aig_get_left_child (amgr, root));
-
-      while (!BTOR_EMPTY_STACK (tree))
-      {
-        cur = BTOR_POP_STACK (tree);
-
-        if (BTOR_IS_INVERTED_AIG (cur) || btor_aig_is_var (cur)
-            || cur->refs > 1u || cur->cnf_id)
-        {
-          BTOR_PUSH_STACK (leafs, cur);
-        }
-        else
-        {
-          BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, cur));
-          BTOR_PUSH_STACK (tree, btor_aig_get_left_child (amgr, cur));
-        }
-      }
-#else
-      BTOR_PUSH_STACK (leafs, btor_aig_get_left_child (amgr, root));
-      BTOR_PUSH_STACK (leafs, btor_aig_get_right_child (amgr, root));
-#endif
-    }
+    get_gate_leafs_aig (amgr, root, &leafs, &isxor, &isite);
 
     if (root->mark == 0)
     {
@@ -1209,98 +1534,15 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
       root->mark = 2;
 
       set_next_id_aig_mgr (amgr, root);
-      x = root->cnf_id;
-      assert (x);
-
-      if (isxor)
-      {
-        assert (BTOR_COUNT_STACK (leafs) == 2);
-        a = btor_aig_get_cnf_id (leafs.start[0]);
-        b = btor_aig_get_cnf_id (leafs.start[1]);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
-      }
-      else if (isite)
-      {
-        assert (BTOR_COUNT_STACK (leafs) == 3);
-        a = btor_aig_get_cnf_id (leafs.start[0]);  // else
-        b = btor_aig_get_cnf_id (leafs.start[1]);  // then
-        c = btor_aig_get_cnf_id (leafs.start[2]);  // cond
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
-      }
-      else
-      {
-        for (p = leafs.start; p < leafs.top; p++)
-        {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          assert (y);
-          btor_sat_add (smgr, -y);
-          amgr->num_cnf_literals++;
-        }
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses++;
-        amgr->num_cnf_literals++;
-
-        for (p = leafs.start; p < leafs.top; p++)
-        {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          btor_sat_add (smgr, -x);
-          btor_sat_add (smgr, y);
-          btor_sat_add (smgr, 0);
-          amgr->num_cnf_clauses++;
-          amgr->num_cnf_literals += 2;
-        }
-      }
+      assert (root->cnf_id);
+      add_gate_clauses_aig (
+          amgr, root->cnf_id, &leafs, isxor, isite, BTOR_AIG_POL_BOTH);
+      root->pol = BTOR_AIG_POL_BOTH;
     }
     BTOR_RESET_STACK (leafs);
   }
   BTOR_RELEASE_STACK (stack);
   BTOR_RELEASE_STACK (leafs);
-  BTOR_RELEASE_STACK (tree);
 
   while (!BTOR_EMPTY_STACK (marked))
   {
@@ -1340,6 +1582,18 @@ btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   if (!btor_aig_is_const (aig)) aig_to_sat_tseitin (amgr, aig);
 }
 
+void
+btor_aig_lit_to_sat (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+  if (!btor_sat_is_initialized (amgr->smgr)) return;
+  if (btor_aig_is_const (aig)) return;
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_PG))
+    aig_to_sat_pg (amgr, aig, BTOR_AIG_POL_POS);
+  else
+    aig_to_sat_tseitin (amgr, aig);
+}
+
 void
 btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
 {
@@ -1399,7 +1653,7 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
           left = *p;
           if (btor_aig_is_const (left))  // TODO reachable?
             continue;
-          btor_aig_to_sat (amgr, left);
+          btor_aig_lit_to_sat (amgr, BTOR_INVERT_AIG (left));
         }
         for (p = leafs.start; p < leafs.top; p++)
         {
@@ -1413,7 +1667,7 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
       }
       else
       {
-        btor_aig_to_sat (amgr, aig);
+        btor_aig_lit_to_sat (amgr, aig);
         btor_sat_add (smgr, btor_aig_get_cnf_id (aig));
         btor_sat_add (smgr, 0);
         amgr->num_cnf_literals++;
@@ -1426,8 +1680,8 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
       {
         left  = BTOR_INVERT_AIG (btor_aig_get_left_child (amgr, real_aig));
         right = BTOR_INVERT_AIG (btor_aig_get_right_child (amgr, real_aig));
-        btor_aig_to_sat (amgr, left);
-        btor_aig_to_sat (amgr, right);
+        btor_aig_lit_to_sat (amgr, left);
+        btor_aig_lit_to_sat (amgr, right);
         btor_sat_add (smgr, btor_aig_get_cnf_id (left));
         btor_sat_add (smgr, btor_aig_get_cnf_id (right));
         btor_sat_add (smgr, 0);
@@ -1436,7 +1690,7 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
       }
       else
       {
-        btor_aig_to_sat (amgr, aig);
+        btor_aig_lit_to_sat (amgr, aig);
         btor_sat_add (smgr, btor_aig_get_cnf_id (aig));
         btor_sat_add (smgr, 0);
         amgr->num_cnf_clauses++;
@@ -1454,7 +1708,7 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
     btor_sat_add (amgr->smgr, 0);
     return;
   }
-  btor_aig_to_sat (amgr, root);
+  btor_aig_lit_to_sat (amgr, root);
   btor_sat_add (amgr->smgr, btor_aig_get_cnf_id (root));
   btor_sat_add (amgr->smgr, 0);
 #endif
@@ -1466,24 +1720,179 @@ btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
   return amgr ? amgr->smgr : 0;
 }
 
-int32_t
-btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+static int32_t
+deref_aig (BtorAIGMgr *amgr, BtorAIG *aig, const int8_t *snapshot)
 {
   assert (amgr);
-  if (aig == BTOR_AIG_TRUE) return 1;
-  if (aig == BTOR_AIG_FALSE) return -1;
+  assert (!BTOR_IS_INVERTED_AIG (aig));
 
   /* Note: If an AIG is not yet encoded to SAT or if the SAT solver returns
    * undefined for a variable, we implicitly initialize it with false (-1). */
   int32_t val = -1;
-  if (BTOR_REAL_ADDR_AIG (aig)->cnf_id > 0)
+  if (aig->cnf_id > 0)
   {
-    val = btor_sat_deref (amgr->smgr, BTOR_REAL_ADDR_AIG (aig)->cnf_id);
+    if (snapshot)
+      val = snapshot[aig->cnf_id];
+    else
+      val = btor_sat_deref (amgr->smgr, aig->cnf_id);
     if (val == 0)
     {
       val = -1;
     }
   }
+  return val;
+}
+
+static inline bool
+is_eval_aig (BtorAIG *aig)
+{
+  return btor_aig_is_and (aig) && !btor_aig_is_encoded (aig);
+}
+
+/* Evaluate AND 'aig' that is not encoded in both polarities. With
+ * polarity-aware encoding the SAT solver may assign its CNF id a value
+ * different from its value under the current assignment of the variables.
+ * Values are cached in 'cache', CNF ids are looked up in 'snapshot' if
+ * given and in the SAT solver otherwise.
+ */
+static int32_t
+eval_aig (BtorAIGMgr *amgr,
+          BtorAIG *aig,
+          BtorIntHashTable *cache,
+          const int8_t *snapshot)
+{
+  assert (amgr);
+  assert (!BTOR_IS_INVERTED_AIG (aig));
+  assert (is_eval_aig (aig));
+  assert (cache);
+
+  int32_t i, val, cval;
+  BtorAIG *cur, *child, *real_child;
+  BtorAIGPtrStack stack;
+  BtorHashTableData *d;
+  bool pending;
+
+  if ((d = btor_hashint_map_get (cache, aig->id))) return d->as_int;
+
+  BTOR_INIT_STACK (cache->mm, stack);
+  BTOR_PUSH_STACK (stack, aig);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    if (btor_hashint_map_contains (cache, cur->id))
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+
+    pending = false;
+    for (i = 0; i < 2; i++)
+    {
+      real_child = BTOR_REAL_ADDR_AIG (
+          btor_aig_get_by_id (amgr, cur->children[i]));
+      if (is_eval_aig (real_child)
+          && !btor_hashint_map_contains (cache, real_child->id))
+      {
+        BTOR_PUSH_STACK (stack, real_child);
+        pending = true;
+      }
+    }
+    if (pending) continue;
+    (void) BTOR_POP_STACK (stack);
+
+    val = 1;
+    for (i = 0; i < 2 && val > 0; i++)
+    {
+      child      = btor_aig_get_by_id (amgr, cur->children[i]);
+      real_child = BTOR_REAL_ADDR_AIG (child);
+      if (is_eval_aig (real_child))
+        cval = btor_hashint_map_get (cache, real_child->id)->as_int;
+      else
+        cval = deref_aig (amgr, real_child, snapshot);
+      val = BTOR_IS_INVERTED_AIG (child) ? -cval : cval;
+    }
+    btor_hashint_map_add (cache, cur->id)->as_int = val;
+  }
+  BTOR_RELEASE_STACK (stack);
+
+  return btor_hashint_map_get (cache, aig->id)->as_int;
+}
+
+int32_t
+btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+
+  BtorAIG *real_aig;
+  int32_t val;
+
+  if (aig == BTOR_AIG_TRUE) return 1;
+  if (aig == BTOR_AIG_FALSE) return -1;
+
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_PG) && is_eval_aig (real_aig))
+  {
+    /* values are cached until the next SAT call */
+    if (!amgr->eval_cache
+        || amgr->eval_cache_satcalls != amgr->smgr->satcalls)
+    {
+      if (amgr->eval_cache) btor_hashint_map_delete (amgr->eval_cache);
+      amgr->eval_cache          = btor_hashint_map_new (amgr->btor->mm);
+      amgr->eval_cache_satcalls = amgr->smgr->satcalls;
+    }
+    val = eval_aig (amgr, real_aig, amgr->eval_cache, 0);
+  }
+  else
+    val = deref_aig (amgr, real_aig, 0);
+  return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
+}
+
+int8_t *
+btor_aig_snapshot_assignment (BtorAIGMgr *amgr, BtorMemMgr *mm)
+{
+  assert (amgr);
+  assert (mm);
+
+  int8_t *res;
+  int32_t i;
+
+  BTOR_NEWN (mm, res, amgr->smgr->maxvar + 1);
+  res[0] = 0;
+  for (i = 1; i <= amgr->smgr->maxvar; i++)
+    res[i] = btor_sat_deref (amgr->smgr, i);
+  return res;
+}
+
+void
+btor_aig_delete_snapshot (BtorAIGMgr *amgr, BtorMemMgr *mm, int8_t *snapshot)
+{
+  assert (amgr);
+  assert (mm);
+  assert (snapshot);
+  BTOR_DELETEN (mm, snapshot, amgr->smgr->maxvar + 1);
+}
+
+int32_t
+btor_aig_get_snapshot_assignment (BtorAIGMgr *amgr,
+                                  BtorAIG *aig,
+                                  const int8_t *snapshot,
+                                  BtorIntHashTable *cache)
+{
+  assert (amgr);
+  assert (snapshot);
+  assert (cache);
+
+  BtorAIG *real_aig;
+  int32_t val;
+
+  if (aig == BTOR_AIG_TRUE) return 1;
+  if (aig == BTOR_AIG_FALSE) return -1;
+
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_PG) && is_eval_aig (real_aig))
+    val = eval_aig (amgr, real_aig, cache, snapshot);
+  else
+    val = deref_aig (amgr, real_aig, snapshot);
   return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
 }
 
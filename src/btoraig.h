@@ -15,6 +15,7 @@
 #include "btoropt.h"
 #include "btorsat.h"
 #include "btortypes.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -26,20 +27,37 @@ struct BtorAIGMap;
 
 /*------------------------------------------------------------------------*/
 
+/* AIG nodes are stored in fixed size chunks of BTOR_AIG_CHUNK_SIZE nodes
+ * and are addressed by their id. Ids of released nodes are reused, unless
+ * ids are held (see btor_aig_mgr_hold_ids). */
+#define BTOR_AIG_CHUNK_BITS 12
+#define BTOR_AIG_CHUNK_SIZE (1u << BTOR_AIG_CHUNK_BITS)
+
 struct BtorAIG
 {
   int32_t id;
   int32_t cnf_id;
-  uint32_t refs;
-  int32_t next; /* next AIG id for unique table */
+  uint32_t refs; /* 0 if unused */
+  int32_t next;  /* next AIG id for unique table or free list */
   uint8_t mark : 2;
   uint8_t is_var : 1; /* is it an AIG variable or an AND? */
+  uint8_t pol : 2;    /* polarities encoded to SAT (BTOR_AIG_POL_*) */
   uint32_t local;
-  int32_t children[]; /* only allocated for AIG AND */
+  int32_t children[2]; /* only used for AIG AND */
 };
 
 typedef struct BtorAIG BtorAIG;
 
+/* Clause directions of an AND x = f (leafs) encoded to SAT. With
+ * polarity-aware (Plaisted-Greenbaum) encoding only the directions required
+ * by the occurrences of x are generated:
+ *   BTOR_AIG_POL_POS: x -> f (leafs)
+ *   BTOR_AIG_POL_NEG: f (leafs) -> x
+ */
+#define BTOR_AIG_POL_POS 1
+#define BTOR_AIG_POL_NEG 2
+#define BTOR_AIG_POL_BOTH 3
+
 BTOR_DECLARE_STACK (BtorAIGPtr, BtorAIG *);
 
 struct BtorAIGUniqueTable
@@ -56,9 +74,18 @@ struct BtorAIGMgr
   Btor *btor;
   BtorAIGUniqueTable table;
   BtorSATMgr *smgr;
-  BtorAIGPtrStack id2aig; /* id to AIG node */
+  BtorAIGPtrStack chunks; /* AIG node storage, indexed by id */
+  int32_t num_ids;        /* number of allocated ids */
+  int32_t free_ids;       /* first unused id, 0 if there is none */
+  uint32_t hold_ids;      /* ids are not reused while > 0 */
+  int32_t held_ids;       /* ids released while holding, 0 if none */
+  int32_t held_ids_last;  /* last id of the 'held_ids' list */
   BtorIntStack cnfid2aig; /* cnf id to AIG id */
 
+  /* values of ANDs not encoded in both polarities in the current model */
+  BtorIntHashTable *eval_cache;
+  int32_t eval_cache_satcalls;
+
   uint_least64_t cur_num_aigs;     /* current number of ANDs */
   uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
 
@@ -68,6 +95,10 @@ struct BtorAIGMgr
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_opt_rewrites;    /* cuts replaced by AIG optimization */
+  uint_least64_t num_opt_saved;       /* ANDs removed by AIG optimization */
+  uint_least64_t num_fraig_merges;    /* nodes merged by SAT sweeping */
+  uint_least64_t num_fraig_sat_calls; /* SAT calls of SAT sweeping */
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -133,8 +164,17 @@ btor_aig_get_by_id (BtorAIGMgr *amgr, int32_t id)
 {
   assert (amgr);
 
-  return id < 0 ? BTOR_INVERT_AIG (BTOR_PEEK_STACK (amgr->id2aig, -id))
-                : BTOR_PEEK_STACK (amgr->id2aig, id);
+  BtorAIG *res;
+  uint32_t real_id;
+
+  real_id = id < 0 ? -id : id;
+  /* ids 0 and 1 are reserved for the constants */
+  if (real_id < 2) return (BtorAIG *) (uintptr_t) real_id;
+  assert (real_id < (uint32_t) amgr->num_ids);
+  res = amgr->chunks.start[real_id >> BTOR_AIG_CHUNK_BITS]
+        + (real_id & (BTOR_AIG_CHUNK_SIZE - 1));
+  assert (res->refs > 0);
+  return id < 0 ? BTOR_INVERT_AIG (res) : res;
 }
 
 static inline int32_t
@@ -146,6 +186,18 @@ btor_aig_get_cnf_id (const BtorAIG *aig)
                                     : aig->cnf_id;
 }
 
+/* Returns true if the value of 'aig' is determined by the SAT encoding, i.e.,
+ * if it is a variable with a CNF id or an AND encoded in both polarities. */
+static inline bool
+btor_aig_is_encoded (const BtorAIG *aig)
+{
+  const BtorAIG *real_aig;
+  if (btor_aig_is_const (aig)) return true;
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  return real_aig->cnf_id
+         && (real_aig->is_var || real_aig->pol == BTOR_AIG_POL_BOTH);
+}
+
 static inline BtorAIG *
 btor_aig_get_left_child (BtorAIGMgr *amgr, const BtorAIG *aig)
 {
@@ -169,6 +221,13 @@ BtorAIGMgr *btor_aig_mgr_new (Btor *btor);
 BtorAIGMgr *btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr);
 void btor_aig_mgr_delete (BtorAIGMgr *amgr);
 
+/* Do not reuse the ids of released AIGs until the matching call to
+ * btor_aig_mgr_release_ids. Tables keyed by AIG id thus never map a released
+ * AIG to a new one, which may only be used after checking its refs. Calls may
+ * be nested. */
+void btor_aig_mgr_hold_ids (BtorAIGMgr *amgr);
+void btor_aig_mgr_release_ids (BtorAIGMgr *amgr);
+
 BtorSATMgr *btor_aig_get_sat_mgr (const BtorAIGMgr *amgr);
 
 /* Variable representing 1 bit. */
@@ -210,6 +269,12 @@ void btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
  */
 void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 
+/* Translates AIG into SAT instance such that its CNF id may be asserted or
+ * assumed. With polarity-aware encoding (BTOR_OPT_AIG_PG) only the clauses
+ * required for 'aig' to be true are generated.
+ */
+void btor_aig_lit_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
+
 /* Translates AIG into SAT instance in both phases.
  * The function guarantees that after finishing every reachable AIG
  * has a CNF id.
@@ -220,6 +285,26 @@ void btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *aig);
  */
 int32_t btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig);
 
+/* Copies the current assignment of all CNF ids into a new array (indexed by
+ * CNF id) allocated from 'mm'.  No CNF ids may be added until the snapshot
+ * is deleted.
+ */
+int8_t *btor_aig_snapshot_assignment (BtorAIGMgr *amgr, BtorMemMgr *mm);
+
+void btor_aig_delete_snapshot (BtorAIGMgr *amgr,
+                               BtorMemMgr *mm,
+                               int8_t *snapshot);
+
+/* Gets the assignment of AIG aig as btor_aig_get_assignment, but reads the
+ * values of CNF ids from 'snapshot' and caches evaluated ANDs in 'cache'
+ * (an int map).  Neither the AIG manager nor the SAT solver are modified,
+ * hence it may be called from several threads with separate caches.
+ */
+int32_t btor_aig_get_snapshot_assignment (BtorAIGMgr *amgr,
+                                          BtorAIG *aig,
+                                          const int8_t *snapshot,
+                                          BtorIntHashTable *cache);
+
 /* Orders AIGs (actually assume left child of an AND node is smaller
  * than right child
  */
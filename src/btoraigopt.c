@@ -0,0 +1,1457 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigopt.h"
+#include "btoraigsim.h"
+#include "btorcore.h"
+#include "btorsat.h"
+#include "utils/btorrng.h"
+#include "utils/btorhashint.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of leaves of a cut. */
+#define BTOR_AIG_OPT_CUT_SIZE 4
+/* Maximum number of (non-trivial) cuts stored per node. */
+#define BTOR_AIG_OPT_MAX_CUTS 8
+/* Maximum number of AND nodes between a cut and its root. */
+#define BTOR_AIG_OPT_MAX_CONE 32
+/* Number of ints per stored cut (size + leaves). */
+#define BTOR_AIG_OPT_CUT_INTS (BTOR_AIG_OPT_CUT_SIZE + 1)
+
+#define BTOR_AIG_OPT_LIVE 1    /* node is restructured */
+#define BTOR_AIG_OPT_INV_REF 2 /* node is referenced via an inverted edge */
+#define BTOR_AIG_OPT_HELD 4    /* node holds a reference to its new AIG */
+
+/* Truth tables of the cut leaves. */
+static const uint16_t leaf_tt[BTOR_AIG_OPT_CUT_SIZE] = {
+    0xAAAA, 0xCCCC, 0xF0F0, 0xFF00};
+
+/*------------------------------------------------------------------------*/
+
+/* The window of an optimization pass, i.e., the AND nodes reachable from the
+ * roots that are not encoded yet.
+ * Live nodes are only referenced from live nodes and the roots and are
+ * restructured, all other nodes are kept as they are. */
+struct BtorAIGOptWindow
+{
+  BtorAIGMgr *amgr;
+  BtorIntHashTable *idx;   /* AIG id -> position in 'nodes' */
+  BtorAIGPtrStack nodes;   /* AND nodes of the window in post-order */
+  BtorIntStack fo;         /* number of live references (incl. roots) */
+  BtorIntStack rootocc;    /* number of occurrences as root */
+  BtorIntStack rem;        /* number of live parents not processed yet */
+  BtorIntStack kept;       /* number of live parents that were kept */
+  BtorIntStack flags;      /* BTOR_AIG_OPT_* */
+  BtorAIGPtrStack map;     /* new AIG of a live node */
+  BtorIntHashTable *cuts;  /* AIG id -> (position in 'leaves' << 4) | #cuts */
+  BtorIntStack leaves;     /* stored cuts (size + leaves) */
+  BtorIntHashTable *held;  /* ids of cut leaves the window holds a ref to */
+  BtorIntHashTable *level; /* AIG id -> level (balancing only) */
+};
+
+typedef struct BtorAIGOptWindow BtorAIGOptWindow;
+
+typedef void (*BtorAIGOptPass) (BtorAIGOptWindow *);
+
+static bool
+is_internal (const BtorAIG *aig)
+{
+  return btor_aig_is_and (aig) && !aig->cnf_id;
+}
+
+static int32_t
+get_pos (BtorAIGOptWindow *w, const BtorAIG *real_aig)
+{
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (w->idx, real_aig->id);
+  return d ? d->as_int : -1;
+}
+
+static bool
+is_live (BtorAIGOptWindow *w, const BtorAIG *real_aig)
+{
+  int32_t pos;
+  if (!is_internal (real_aig)) return false;
+  pos = get_pos (w, real_aig);
+  return pos >= 0 && (BTOR_PEEK_STACK (w->flags, pos) & BTOR_AIG_OPT_LIVE);
+}
+
+/* Returns the new AIG of 'aig' (not a new reference). */
+static BtorAIG *
+get_new (BtorAIGOptWindow *w, BtorAIG *aig)
+{
+  BtorAIG *real_aig, *res;
+  int32_t pos;
+
+  if (btor_aig_is_const (aig)) return aig;
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (!is_live (w, real_aig)) return aig;
+  pos = get_pos (w, real_aig);
+  assert (BTOR_PEEK_STACK (w->flags, pos) & BTOR_AIG_OPT_HELD);
+  res = BTOR_PEEK_STACK (w->map, pos);
+  return BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
+}
+
+static void
+set_new (BtorAIGOptWindow *w, int32_t pos, BtorAIG *aig)
+{
+  assert (!(BTOR_PEEK_STACK (w->flags, pos) & BTOR_AIG_OPT_HELD));
+  BTOR_POKE_STACK (w->map, pos, aig);
+  BTOR_POKE_STACK (
+      w->flags, pos, BTOR_PEEK_STACK (w->flags, pos) | BTOR_AIG_OPT_HELD);
+}
+
+/* Release the new AIG of the node at position 'pos'. */
+static void
+release_new (BtorAIGOptWindow *w, int32_t pos)
+{
+  int32_t flags;
+
+  flags = BTOR_PEEK_STACK (w->flags, pos);
+  if (!(flags & BTOR_AIG_OPT_HELD)) return;
+  btor_aig_release (w->amgr, BTOR_PEEK_STACK (w->map, pos));
+  BTOR_POKE_STACK (w->flags, pos, flags & ~BTOR_AIG_OPT_HELD);
+}
+
+/* Called after the parent of 'child' has been processed. */
+static void
+dec_rem (BtorAIGOptWindow *w, BtorAIG *child)
+{
+  BtorAIG *real_child;
+  int32_t pos, rem;
+
+  real_child = BTOR_REAL_ADDR_AIG (child);
+  if (!is_live (w, real_child)) return;
+  pos = get_pos (w, real_child);
+  rem = BTOR_PEEK_STACK (w->rem, pos) - 1;
+  assert (rem >= 0);
+  BTOR_POKE_STACK (w->rem, pos, rem);
+  if (!rem && !BTOR_PEEK_STACK (w->rootocc, pos)) release_new (w, pos);
+}
+
+static void
+init_window (BtorAIGOptWindow *w, BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n)
+{
+  BtorMemMgr *mm;
+  BtorAIGPtrStack visit;
+  BtorAIG *cur, *child;
+  BtorHashTableData *d;
+  int32_t pos, cpos, fo, flags;
+  uint32_t i, j;
+
+  mm = amgr->btor->mm;
+  BTOR_CLR (w);
+  w->amgr = amgr;
+  /* the window refers to AIGs by id, which must not be reused for new AIGs
+   * while nodes are released during a pass */
+  btor_aig_mgr_hold_ids (amgr);
+  w->idx = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, w->nodes);
+  BTOR_INIT_STACK (mm, w->fo);
+  BTOR_INIT_STACK (mm, w->rootocc);
+  BTOR_INIT_STACK (mm, w->rem);
+  BTOR_INIT_STACK (mm, w->kept);
+  BTOR_INIT_STACK (mm, w->flags);
+  BTOR_INIT_STACK (mm, w->map);
+  BTOR_INIT_STACK (mm, w->leaves);
+  w->cuts = btor_hashint_map_new (mm);
+  w->held = btor_hashint_table_new (mm);
+
+  /* collect internal AND nodes in post-order */
+  BTOR_INIT_STACK (mm, visit);
+  for (i = 0; i < n; i++)
+  {
+    if (btor_aig_is_const (aigs[i])) continue;
+    cur = BTOR_REAL_ADDR_AIG (aigs[i]);
+    if (is_internal (cur)) BTOR_PUSH_STACK (visit, cur);
+  }
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    d   = btor_hashint_map_get (w->idx, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (w->idx, cur->id)->as_int = -1;
+      BTOR_PUSH_STACK (visit, cur);
+      for (j = 0; j < 2; j++)
+      {
+        child = btor_aig_get_by_id (amgr, cur->children[j]);
+        child = BTOR_REAL_ADDR_AIG (child);
+        if (is_internal (child)
+            && !btor_hashint_map_contains (w->idx, child->id))
+          BTOR_PUSH_STACK (visit, child);
+      }
+    }
+    else if (d->as_int == -1)
+    {
+      d->as_int = BTOR_COUNT_STACK (w->nodes);
+      BTOR_PUSH_STACK (w->nodes, cur);
+      BTOR_PUSH_STACK (w->fo, 0);
+      BTOR_PUSH_STACK (w->rootocc, 0);
+      BTOR_PUSH_STACK (w->rem, 0);
+      BTOR_PUSH_STACK (w->kept, 0);
+      BTOR_PUSH_STACK (w->flags, 0);
+      BTOR_PUSH_STACK (w->map, 0);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  for (i = 0; i < n; i++)
+  {
+    if (btor_aig_is_const (aigs[i])) continue;
+    cur = BTOR_REAL_ADDR_AIG (aigs[i]);
+    if (!is_internal (cur)) continue;
+    pos = get_pos (w, cur);
+    w->rootocc.start[pos] += 1;
+    w->fo.start[pos] += 1;
+  }
+
+  /* Determine live nodes in reverse post-order (parents first). A node is
+   * live if all of its references are live references. */
+  for (pos = BTOR_COUNT_STACK (w->nodes) - 1; pos >= 0; pos--)
+  {
+    cur = BTOR_PEEK_STACK (w->nodes, pos);
+    fo  = BTOR_PEEK_STACK (w->fo, pos);
+    if (!fo || cur->refs > (uint32_t) fo) continue;
+    BTOR_POKE_STACK (
+        w->flags, pos, BTOR_PEEK_STACK (w->flags, pos) | BTOR_AIG_OPT_LIVE);
+    for (j = 0; j < 2; j++)
+    {
+      child = btor_aig_get_by_id (amgr, cur->children[j]);
+      if (!is_internal (BTOR_REAL_ADDR_AIG (child))) continue;
+      cpos = get_pos (w, BTOR_REAL_ADDR_AIG (child));
+      w->fo.start[cpos] += 1;
+      w->rem.start[cpos] += 1;
+      if (BTOR_IS_INVERTED_AIG (child))
+      {
+        flags = BTOR_PEEK_STACK (w->flags, cpos) | BTOR_AIG_OPT_INV_REF;
+        BTOR_POKE_STACK (w->flags, cpos, flags);
+      }
+    }
+  }
+}
+
+static void
+release_window (BtorAIGOptWindow *w)
+{
+  BtorIntHashTableIterator it;
+  uint32_t i;
+  int32_t id;
+
+  for (i = 0; i < BTOR_COUNT_STACK (w->nodes); i++) release_new (w, i);
+  btor_iter_hashint_init (&it, w->held);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id = btor_iter_hashint_next (&it);
+    btor_aig_release (w->amgr, btor_aig_get_by_id (w->amgr, id));
+  }
+  btor_hashint_table_delete (w->held);
+  btor_hashint_map_delete (w->idx);
+  btor_hashint_map_delete (w->cuts);
+  if (w->level) btor_hashint_map_delete (w->level);
+  BTOR_RELEASE_STACK (w->nodes);
+  BTOR_RELEASE_STACK (w->fo);
+  BTOR_RELEASE_STACK (w->rootocc);
+  BTOR_RELEASE_STACK (w->rem);
+  BTOR_RELEASE_STACK (w->kept);
+  BTOR_RELEASE_STACK (w->flags);
+  BTOR_RELEASE_STACK (w->map);
+  BTOR_RELEASE_STACK (w->leaves);
+  btor_aig_mgr_release_ids (w->amgr);
+}
+
+/* Count the AND nodes reachable from 'aigs' that are not encoded yet. */
+static uint32_t
+count_ands (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n)
+{
+  BtorMemMgr *mm;
+  BtorIntHashTable *cache;
+  BtorAIGPtrStack visit;
+  BtorAIG *cur;
+  uint32_t i, res;
+
+  mm    = amgr->btor->mm;
+  cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  for (i = 0; i < n; i++) BTOR_PUSH_STACK (visit, aigs[i]);
+  res = 0;
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    if (btor_aig_is_const (cur)) continue;
+    cur = BTOR_REAL_ADDR_AIG (cur);
+    if (!is_internal (cur) || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+    res += 1;
+    BTOR_PUSH_STACK (visit, btor_aig_get_left_child (amgr, cur));
+    BTOR_PUSH_STACK (visit, btor_aig_get_right_child (amgr, cur));
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* Truth table operations on 4 variables.                                  */
+/*------------------------------------------------------------------------*/
+
+static uint16_t
+tt_cof0 (uint16_t tt, uint32_t var)
+{
+  uint16_t t = tt & ~leaf_tt[var];
+  return t | (uint16_t) (t << (1u << var));
+}
+
+static uint16_t
+tt_cof1 (uint16_t tt, uint32_t var)
+{
+  uint16_t t = tt & leaf_tt[var];
+  return t | (uint16_t) (t >> (1u << var));
+}
+
+static uint16_t
+tt_not (uint16_t tt)
+{
+  return ~tt;
+}
+
+static bool
+tt_depends (uint16_t tt, uint32_t var)
+{
+  return tt_cof0 (tt, var) != tt_cof1 (tt, var);
+}
+
+/* Cube of a sum-of-products, bit i corresponds to leaf i. */
+struct BtorAIGOptCube
+{
+  uint8_t pos;
+  uint8_t neg;
+};
+
+typedef struct BtorAIGOptCube BtorAIGOptCube;
+
+struct BtorAIGOptCover
+{
+  BtorAIGOptCube cubes[16];
+  uint32_t size;
+};
+
+typedef struct BtorAIGOptCover BtorAIGOptCover;
+
+/* Minato-Morreale irredundant sum-of-products of an incompletely specified
+ * function with on-set 'lo' and on-set + don't care set 'up'. Returns the
+ * truth table of the computed cover. */
+static uint16_t
+isop (uint16_t lo, uint16_t up, int32_t var, BtorAIGOptCover *cover)
+{
+  assert ((lo & ~up) == 0);
+
+  uint16_t lo0, lo1, up0, up1, f0, f1, fs;
+  uint32_t i, beg;
+
+  if (!lo) return 0;
+  if (up == 0xFFFF)
+  {
+    assert (cover->size < 16);
+    cover->cubes[cover->size].pos = 0;
+    cover->cubes[cover->size].neg = 0;
+    cover->size += 1;
+    return 0xFFFF;
+  }
+
+  do
+    var -= 1;
+  while (!tt_depends (lo, var) && !tt_depends (up, var));
+  assert (var >= 0);
+
+  lo0 = tt_cof0 (lo, var);
+  lo1 = tt_cof1 (lo, var);
+  up0 = tt_cof0 (up, var);
+  up1 = tt_cof1 (up, var);
+
+  beg = cover->size;
+  f0  = isop (lo0 & ~up1, up0, var, cover);
+  for (i = beg; i < cover->size; i++) cover->cubes[i].neg |= 1u << var;
+  beg = cover->size;
+  f1  = isop (lo1 & ~up0, up1, var, cover);
+  for (i = beg; i < cover->size; i++) cover->cubes[i].pos |= 1u << var;
+  fs = isop ((lo0 & ~f0) | (lo1 & ~f1), up0 & up1, var, cover);
+
+  return fs | (f0 & ~leaf_tt[var]) | (f1 & leaf_tt[var]);
+}
+
+/*------------------------------------------------------------------------*/
+/* Resynthesis of the function of a cut.                                   */
+/*------------------------------------------------------------------------*/
+
+static BtorAIG *
+synth_sop (BtorAIGMgr *amgr, uint16_t tt, BtorAIG **leaves, uint32_t k)
+{
+  BtorAIGOptCover cover;
+  BtorAIG *res, *cube, *tmp;
+  uint32_t i, j;
+
+  cover.size = 0;
+  isop (tt, tt, BTOR_AIG_OPT_CUT_SIZE, &cover);
+
+  res = BTOR_AIG_FALSE;
+  for (i = 0; i < cover.size; i++)
+  {
+    cube = BTOR_AIG_TRUE;
+    for (j = 0; j < k; j++)
+    {
+      if (cover.cubes[i].pos & (1u << j))
+        tmp = btor_aig_and (amgr, cube, leaves[j]);
+      else if (cover.cubes[i].neg & (1u << j))
+        tmp = btor_aig_and (amgr, cube, BTOR_INVERT_AIG (leaves[j]));
+      else
+        continue;
+      btor_aig_release (amgr, cube);
+      cube = tmp;
+    }
+    tmp = btor_aig_or (amgr, res, cube);
+    btor_aig_release (amgr, cube);
+    btor_aig_release (amgr, res);
+    res = tmp;
+  }
+  return res;
+}
+
+/* Recursive cofactor decomposition (AND, OR, XOR and ITE). */
+static BtorAIG *
+synth_dec (BtorAIGMgr *amgr, uint16_t tt, BtorAIG **leaves, uint32_t k)
+{
+  BtorAIG *x, *g0, *g1, *res;
+  uint16_t f0, f1;
+  int32_t v;
+  uint32_t i;
+
+  if (tt == 0) return BTOR_AIG_FALSE;
+  if (tt == 0xFFFF) return BTOR_AIG_TRUE;
+  for (i = 0; i < k; i++)
+  {
+    if (tt == leaf_tt[i]) return btor_aig_copy (amgr, leaves[i]);
+    if (tt == tt_not (leaf_tt[i]))
+      return BTOR_INVERT_AIG (btor_aig_copy (amgr, leaves[i]));
+  }
+
+  /* prefer variables with a constant or complementary cofactor */
+  for (i = 0, v = -1; i < k; i++)
+  {
+    if (!tt_depends (tt, i)) continue;
+    f0 = tt_cof0 (tt, i);
+    f1 = tt_cof1 (tt, i);
+    if (v < 0) v = i;
+    if (f0 == 0 || f1 == 0 || f0 == 0xFFFF || f1 == 0xFFFF
+        || f0 == tt_not (f1))
+    {
+      v = i;
+      break;
+    }
+  }
+  assert (v >= 0);
+
+  x  = leaves[v];
+  f0 = tt_cof0 (tt, v);
+  f1 = tt_cof1 (tt, v);
+  if (f0 == 0)
+  {
+    g1  = synth_dec (amgr, f1, leaves, k);
+    res = btor_aig_and (amgr, x, g1);
+    btor_aig_release (amgr, g1);
+  }
+  else if (f1 == 0)
+  {
+    g0  = synth_dec (amgr, f0, leaves, k);
+    res = btor_aig_and (amgr, BTOR_INVERT_AIG (x), g0);
+    btor_aig_release (amgr, g0);
+  }
+  else if (f0 == 0xFFFF)
+  {
+    g1  = synth_dec (amgr, f1, leaves, k);
+    res = btor_aig_or (amgr, BTOR_INVERT_AIG (x), g1);
+    btor_aig_release (amgr, g1);
+  }
+  else if (f1 == 0xFFFF)
+  {
+    g0  = synth_dec (amgr, f0, leaves, k);
+    res = btor_aig_or (amgr, x, g0);
+    btor_aig_release (amgr, g0);
+  }
+  else if (f0 == tt_not (f1))
+  {
+    g0  = synth_dec (amgr, f0, leaves, k);
+    res = BTOR_INVERT_AIG (btor_aig_eq (amgr, x, g0));
+    btor_aig_release (amgr, g0);
+  }
+  else
+  {
+    g0  = synth_dec (amgr, f0, leaves, k);
+    g1  = synth_dec (amgr, f1, leaves, k);
+    res = btor_aig_cond (amgr, x, g1, g0);
+    btor_aig_release (amgr, g0);
+    btor_aig_release (amgr, g1);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* Cuts                                                                    */
+/*------------------------------------------------------------------------*/
+
+/* Returns the stored cuts of 'real_aig' and sets 'num' accordingly. */
+static int32_t *
+get_cuts (BtorAIGOptWindow *w, const BtorAIG *real_aig, uint32_t *num)
+{
+  BtorHashTableData *d;
+
+  d = btor_hashint_map_get (w->cuts, real_aig->id);
+  if (!d)
+  {
+    *num = 0;
+    return 0;
+  }
+  *num = d->as_int & 15;
+  return w->leaves.start + (d->as_int >> 4);
+}
+
+/* Take a reference to the leaves of 'cut' (unless already held), which keeps
+ * them alive as long as the cut is stored. */
+static void
+hold_leaves (BtorAIGOptWindow *w, const int32_t *cut)
+{
+  BtorAIG *leaf;
+  uint32_t i;
+
+  for (i = 0; i < (uint32_t) cut[0]; i++)
+  {
+    if (btor_hashint_table_contains (w->held, cut[i + 1])) continue;
+    leaf = btor_aig_get_by_id (w->amgr, cut[i + 1]);
+    btor_aig_copy (w->amgr, leaf);
+    btor_hashint_table_add (w->held, cut[i + 1]);
+  }
+}
+
+/* Returns true if cut 'a' is a subset of cut 'b'. */
+static bool
+is_subset (const int32_t *a, const int32_t *b)
+{
+  uint32_t i, j;
+
+  for (i = 0, j = 0; i < (uint32_t) a[0]; i++)
+  {
+    while (j < (uint32_t) b[0] && b[j + 1] < a[i + 1]) j++;
+    if (j == (uint32_t) b[0] || b[j + 1] != a[i + 1]) return false;
+  }
+  return true;
+}
+
+/* Merge the sorted cuts 'a' and 'b' into 'res'. */
+static bool
+merge_cuts (const int32_t *a, const int32_t *b, int32_t *res)
+{
+  uint32_t i, j, k;
+
+  for (i = 0, j = 0, k = 0; i < (uint32_t) a[0] || j < (uint32_t) b[0];)
+  {
+    if (k == BTOR_AIG_OPT_CUT_SIZE) return false;
+    if (j == (uint32_t) b[0] || (i < (uint32_t) a[0] && a[i + 1] < b[j + 1]))
+      res[++k] = a[++i];
+    else if (i == (uint32_t) a[0] || b[j + 1] < a[i + 1])
+      res[++k] = b[++j];
+    else
+    {
+      res[++k] = a[++i];
+      j++;
+    }
+  }
+  res[0] = k;
+  return true;
+}
+
+/* Compute and store the cuts of AND node 'real_aig' from the cuts of its
+ * children. Children without stored cuts only provide the trivial cut. */
+static void
+compute_cuts (BtorAIGOptWindow *w, const BtorAIG *real_aig)
+{
+  BtorAIGMgr *amgr;
+  BtorAIG *child;
+  int32_t cuts[2][BTOR_AIG_OPT_MAX_CUTS + 1][BTOR_AIG_OPT_CUT_INTS];
+  int32_t res[BTOR_AIG_OPT_MAX_CUTS][BTOR_AIG_OPT_CUT_INTS];
+  int32_t tmp[BTOR_AIG_OPT_CUT_INTS], *stored;
+  uint32_t num[2], num_res, i, j, l, c;
+  size_t pos;
+
+  if (btor_hashint_map_contains (w->cuts, real_aig->id)) return;
+
+  amgr = w->amgr;
+  for (c = 0; c < 2; c++)
+  {
+    child = btor_aig_get_by_id (amgr, real_aig->children[c]);
+    child = BTOR_REAL_ADDR_AIG (child);
+    cuts[c][0][0] = 1;
+    cuts[c][0][1] = child->id;
+    stored        = get_cuts (w, child, &num[c]);
+    for (i = 0; i < num[c]; i++)
+      memcpy (cuts[c][i + 1],
+              stored + i * BTOR_AIG_OPT_CUT_INTS,
+              sizeof (int32_t) * BTOR_AIG_OPT_CUT_INTS);
+    num[c] += 1;
+  }
+
+  num_res = 0;
+  for (i = 0; i < num[0] && num_res < BTOR_AIG_OPT_MAX_CUTS; i++)
+    for (j = 0; j < num[1] && num_res < BTOR_AIG_OPT_MAX_CUTS; j++)
+    {
+      if (!merge_cuts (cuts[0][i], cuts[1][j], tmp)) continue;
+      for (l = 0; l < num_res; l++)
+        if (is_subset (res[l], tmp)) break;
+      if (l < num_res) continue;
+      memcpy (res[num_res++], tmp, sizeof (tmp));
+    }
+
+  pos = BTOR_COUNT_STACK (w->leaves);
+  for (i = 0; i < num_res; i++)
+  {
+    hold_leaves (w, res[i]);
+    for (j = 0; j < BTOR_AIG_OPT_CUT_INTS; j++)
+      BTOR_PUSH_STACK (w->leaves, res[i][j]);
+  }
+  btor_hashint_map_add (w->cuts, real_aig->id)->as_int = (pos << 4) | num_res;
+}
+
+/* Store 'cut' as the only cut of 'real_aig'. */
+static void
+set_cut (BtorAIGOptWindow *w, const BtorAIG *real_aig, const int32_t *cut)
+{
+  int32_t tmp[BTOR_AIG_OPT_CUT_INTS];
+  size_t pos;
+  uint32_t i;
+
+  if (btor_hashint_map_contains (w->cuts, real_aig->id)) return;
+  /* 'cut' may point into 'leaves' */
+  memcpy (tmp, cut, sizeof (tmp));
+  hold_leaves (w, tmp);
+  pos = BTOR_COUNT_STACK (w->leaves);
+  for (i = 0; i < BTOR_AIG_OPT_CUT_INTS; i++)
+    BTOR_PUSH_STACK (w->leaves, tmp[i]);
+  btor_hashint_map_add (w->cuts, real_aig->id)->as_int = (pos << 4) | 1;
+}
+
+/* Memoized AND nodes of a cone between a cut and its root. */
+struct BtorAIGOptCone
+{
+  int32_t ids[BTOR_AIG_OPT_MAX_CONE];
+  uint16_t tt[BTOR_AIG_OPT_MAX_CONE];
+  uint32_t size;
+};
+
+typedef struct BtorAIGOptCone BtorAIGOptCone;
+
+/* Compute the truth table of 'aig' w.r.t. 'cut'. Returns false if the cone
+ * exceeds BTOR_AIG_OPT_MAX_CONE nodes. */
+static bool
+cone_tt (BtorAIGMgr *amgr,
+         BtorAIGOptCone *cone,
+         const int32_t *cut,
+         BtorAIG *aig,
+         uint16_t *res)
+{
+  BtorAIG *real_aig;
+  uint16_t t, t0, t1;
+  uint32_t i, pos;
+
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  for (i = 0; i < (uint32_t) cut[0]; i++)
+    if (cut[i + 1] == real_aig->id)
+    {
+      t = leaf_tt[i];
+      goto DONE;
+    }
+  for (i = 0; i < cone->size; i++)
+    if (cone->ids[i] == real_aig->id)
+    {
+      t = cone->tt[i];
+      goto DONE;
+    }
+  if (!btor_aig_is_and (real_aig) || cone->size == BTOR_AIG_OPT_MAX_CONE)
+    return false;
+  pos            = cone->size++;
+  cone->ids[pos] = real_aig->id;
+  if (!cone_tt (amgr,
+                cone,
+                cut,
+                btor_aig_get_left_child (amgr, real_aig),
+                &t0)
+      || !cone_tt (amgr,
+                   cone,
+                   cut,
+                   btor_aig_get_right_child (amgr, real_aig),
+                   &t1))
+    return false;
+  t             = t0 & t1;
+  cone->tt[pos] = t;
+DONE:
+  *res = BTOR_IS_INVERTED_AIG (aig) ? ~t : t;
+  return true;
+}
+
+/* Returns the number of references to 'real_aig' that are kept if the pass
+ * succeeds. The live references to a live node are released together with
+ * the old AIGs unless the referencing parent is kept. References held for
+ * cut leaves are released with the window and are not counted. */
+static uint32_t
+get_new_refs (BtorAIGOptWindow *w, const BtorAIG *real_aig)
+{
+  int32_t pos;
+  uint32_t refs;
+
+  refs = real_aig->refs;
+  if (btor_hashint_table_contains (w->held, real_aig->id)) refs -= 1;
+  if (!is_live (w, real_aig)) return refs;
+  pos = get_pos (w, real_aig);
+  return refs - BTOR_PEEK_STACK (w->fo, pos) + BTOR_PEEK_STACK (w->kept, pos);
+}
+
+/* Update the number of kept live references of the children of 'n'. */
+static void
+update_kept (BtorAIGOptWindow *w, BtorAIG *n, int32_t delta)
+{
+  BtorAIG *child;
+  uint32_t i;
+
+  for (i = 0; i < 2; i++)
+  {
+    child = BTOR_REAL_ADDR_AIG (btor_aig_get_by_id (w->amgr, n->children[i]));
+    if (!is_live (w, child)) continue;
+    w->kept.start[get_pos (w, child)] += delta;
+  }
+}
+
+/* Compute the size of the maximum fanout-free cone of 'real_aig' bounded by
+ * 'cut', i.e., the number of AND nodes that are deleted if the reference to
+ * 'real_aig' is released (reference counting simulation, no AIG is
+ * modified). */
+static uint32_t
+mffc_size (BtorAIGOptWindow *w, BtorAIG *real_aig, const int32_t *cut)
+{
+  BtorAIGMgr *amgr;
+  int32_t ids[2 * BTOR_AIG_OPT_MAX_CONE];
+  uint32_t decs[2 * BTOR_AIG_OPT_MAX_CONE];
+  BtorAIG *stack[4 * BTOR_AIG_OPT_MAX_CONE], *cur;
+  uint32_t i, num, sp, res;
+
+  amgr = w->amgr;
+  res = num = sp = 0;
+  stack[sp++] = real_aig;
+  while (sp)
+  {
+    cur = BTOR_REAL_ADDR_AIG (stack[--sp]);
+    if (!is_internal (cur)) continue;
+    for (i = 0; i < (uint32_t) cut[0]; i++)
+      if (cut[i + 1] == cur->id) break;
+    if (i < (uint32_t) cut[0]) continue;
+    for (i = 0; i < num; i++)
+      if (ids[i] == cur->id) break;
+    if (i == num)
+    {
+      if (num == 2 * BTOR_AIG_OPT_MAX_CONE) continue;
+      ids[num]    = cur->id;
+      decs[num++] = 0;
+    }
+    decs[i] += 1;
+    if (decs[i] < get_new_refs (w, cur)) continue;
+    res += 1;
+    if (sp + 2 > 4 * BTOR_AIG_OPT_MAX_CONE) break;
+    stack[sp++] = btor_aig_get_left_child (amgr, cur);
+    stack[sp++] = btor_aig_get_right_child (amgr, cur);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+/* Passes                                                                  */
+/*------------------------------------------------------------------------*/
+
+/* Try to replace the cone of 'c0' by a smaller structure. Returns the new
+ * AIG (the reference to 'c0' is taken over). */
+static BtorAIG *
+rewrite_node (BtorAIGOptWindow *w, BtorAIG *c0)
+{
+  BtorAIGMgr *amgr;
+  BtorAIG *real_c0, *leaves[BTOR_AIG_OPT_CUT_SIZE], *cand, *best;
+  BtorAIGOptCone cone;
+  int32_t *cuts, *cut, *best_cut, l, r, gain, best_gain;
+  uint32_t num_cuts, i, j, mffc;
+  uint_least64_t num_aigs;
+  uint16_t tt;
+
+  amgr    = w->amgr;
+  real_c0 = BTOR_REAL_ADDR_AIG (c0);
+  if (btor_aig_is_const (c0) || !is_internal (real_c0)) return c0;
+
+  compute_cuts (w, real_c0);
+  cuts = get_cuts (w, real_c0, &num_cuts);
+  l    = BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (amgr, real_c0))->id;
+  r    = BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (amgr, real_c0))->id;
+
+  best      = 0;
+  best_cut  = 0;
+  best_gain = 0;
+  for (i = 0; i < num_cuts; i++)
+  {
+    cut = cuts + i * BTOR_AIG_OPT_CUT_INTS;
+    if (cut[0] == 2
+        && ((cut[1] == l && cut[2] == r) || (cut[1] == r && cut[2] == l)))
+      continue;
+    cone.size = 0;
+    if (!cone_tt (amgr, &cone, cut, real_c0, &tt)) continue;
+    if (mffc_size (w, real_c0, cut) < 2) continue;
+
+    for (j = 0; j < (uint32_t) cut[0]; j++)
+    {
+      assert (btor_hashint_table_contains (w->held, cut[j + 1]));
+      leaves[j] = btor_aig_get_by_id (amgr, cut[j + 1]);
+    }
+
+    for (j = 0; j < 3; j++)
+    {
+      num_aigs = amgr->cur_num_aigs;
+      if (j == 0)
+        cand = synth_sop (amgr, tt, leaves, cut[0]);
+      else if (j == 1)
+        cand = BTOR_INVERT_AIG (synth_sop (amgr, tt_not (tt), leaves, cut[0]));
+      else
+        cand = synth_dec (amgr, tt, leaves, cut[0]);
+      /* nodes shared with the candidate are not freed anymore */
+      mffc = mffc_size (w, real_c0, cut);
+      gain = (int32_t) mffc - (int32_t) (amgr->cur_num_aigs - num_aigs);
+      if (gain > best_gain)
+      {
+        if (best) btor_aig_release (amgr, best);
+        best      = cand;
+        best_cut  = cut;
+        best_gain = gain;
+      }
+      else
+        btor_aig_release (amgr, cand);
+    }
+  }
+
+  if (!best) return c0;
+
+  amgr->num_opt_rewrites += 1;
+  if (!btor_aig_is_const (best) && is_internal (BTOR_REAL_ADDR_AIG (best)))
+    set_cut (w, BTOR_REAL_ADDR_AIG (best), best_cut);
+  if (BTOR_IS_INVERTED_AIG (c0)) best = BTOR_INVERT_AIG (best);
+  btor_aig_release (amgr, c0);
+  return best;
+}
+
+/* DAG-aware rewriting of all live nodes in topological order. */
+static void
+rewrite_pass (BtorAIGOptWindow *w)
+{
+  BtorAIGMgr *amgr;
+  BtorAIG *n, *l, *r, *c0;
+  uint32_t pos;
+
+  amgr = w->amgr;
+  for (pos = 0; pos < BTOR_COUNT_STACK (w->nodes); pos++)
+  {
+    if (!(BTOR_PEEK_STACK (w->flags, pos) & BTOR_AIG_OPT_LIVE)) continue;
+    n  = BTOR_PEEK_STACK (w->nodes, pos);
+    l  = btor_aig_get_left_child (amgr, n);
+    r  = btor_aig_get_right_child (amgr, n);
+    c0 = btor_aig_and (amgr, get_new (w, l), get_new (w, r));
+    /* the new AIGs of the children are referenced by 'c0' from now on */
+    dec_rem (w, l);
+    dec_rem (w, r);
+    /* 'n' is kept unless its cone is rewritten */
+    if (BTOR_REAL_ADDR_AIG (c0) == n)
+    {
+      update_kept (w, n, 1);
+      c0 = rewrite_node (w, c0);
+      if (BTOR_REAL_ADDR_AIG (c0) != n) update_kept (w, n, -1);
+    }
+    else
+      c0 = rewrite_node (w, c0);
+    set_new (w, pos, c0);
+  }
+}
+
+struct BtorAIGOptInput
+{
+  BtorAIG *aig;
+  int32_t level;
+  bool owned; /* holds a reference to 'aig' */
+};
+
+typedef struct BtorAIGOptInput BtorAIGOptInput;
+
+BTOR_DECLARE_STACK (BtorAIGOptInput, BtorAIGOptInput);
+
+static int32_t
+cmp_input_by_id (const void *p, const void *q)
+{
+  const BtorAIGOptInput *a = p, *b = q;
+  int32_t ia, ib;
+
+  ia = btor_aig_is_const (a->aig) ? 0 : btor_aig_get_id (a->aig);
+  ib = btor_aig_is_const (b->aig) ? 0 : btor_aig_get_id (b->aig);
+  if (abs (ia) != abs (ib)) return abs (ia) - abs (ib);
+  return ia - ib;
+}
+
+static int32_t
+get_level (BtorAIGOptWindow *w, BtorAIG *aig)
+{
+  BtorHashTableData *d;
+
+  if (btor_aig_is_const (aig)) return 0;
+  d = btor_hashint_map_get (w->level, BTOR_REAL_ADDR_AIG (aig)->id);
+  return d ? d->as_int : 0;
+}
+
+static void
+set_level (BtorAIGOptWindow *w, BtorAIG *aig, int32_t level)
+{
+  if (btor_aig_is_const (aig)) return;
+  if (btor_hashint_map_contains (w->level, BTOR_REAL_ADDR_AIG (aig)->id))
+    return;
+  btor_hashint_map_add (w->level, BTOR_REAL_ADDR_AIG (aig)->id)->as_int = level;
+}
+
+/* Rebuild the supergate (multi-input AND) rooted at 'n' such that the two
+ * inputs with the lowest levels are combined first. */
+static BtorAIG *
+balance_supergate (BtorAIGOptWindow *w,
+                   BtorAIG *n,
+                   BtorAIGOptInputStack *inputs)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack visit;
+  BtorAIG *cur, *real_cur, *res;
+  BtorAIGOptInput in, a, b;
+  uint32_t i, j;
+  int32_t pos;
+
+  amgr = w->amgr;
+  BTOR_RESET_STACK (*inputs);
+  BTOR_INIT_STACK (amgr->btor->mm, visit);
+  BTOR_PUSH_STACK (visit, btor_aig_get_left_child (amgr, n));
+  BTOR_PUSH_STACK (visit, btor_aig_get_right_child (amgr, n));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur      = BTOR_POP_STACK (visit);
+    real_cur = BTOR_REAL_ADDR_AIG (cur);
+    pos      = btor_aig_is_const (cur) ? -1 : get_pos (w, real_cur);
+    /* non-inverted edge to a live node that is not a supergate root */
+    if (!BTOR_IS_INVERTED_AIG (cur) && pos >= 0 && is_live (w, real_cur)
+        && BTOR_PEEK_STACK (w->fo, pos) == 1
+        && !BTOR_PEEK_STACK (w->rootocc, pos))
+    {
+      BTOR_PUSH_STACK (visit, btor_aig_get_left_child (amgr, real_cur));
+      BTOR_PUSH_STACK (visit, btor_aig_get_right_child (amgr, real_cur));
+      continue;
+    }
+    in.aig   = get_new (w, cur);
+    in.level = get_level (w, in.aig);
+    in.owned = false;
+    BTOR_PUSH_STACK (*inputs, in);
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  /* remove duplicates and constants */
+  qsort (inputs->start,
+         BTOR_COUNT_STACK (*inputs),
+         sizeof (BtorAIGOptInput),
+         cmp_input_by_id);
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (*inputs); i++)
+  {
+    in = BTOR_PEEK_STACK (*inputs, i);
+    if (btor_aig_is_false (in.aig)) return BTOR_AIG_FALSE;
+    if (btor_aig_is_true (in.aig)) continue;
+    if (j > 0 && inputs->start[j - 1].aig == in.aig) continue;
+    if (j > 0 && inputs->start[j - 1].aig == BTOR_INVERT_AIG (in.aig))
+      return BTOR_AIG_FALSE;
+    inputs->start[j++] = in;
+  }
+  inputs->top = inputs->start + j;
+  if (j == 0) return BTOR_AIG_TRUE;
+
+  /* sort by decreasing level and combine the last two inputs */
+  for (i = 1; i < j; i++)
+  {
+    in = inputs->start[i];
+    for (pos = i; pos > 0 && inputs->start[pos - 1].level < in.level; pos--)
+      inputs->start[pos] = inputs->start[pos - 1];
+    inputs->start[pos] = in;
+  }
+  while (BTOR_COUNT_STACK (*inputs) > 1)
+  {
+    b      = BTOR_POP_STACK (*inputs);
+    a      = BTOR_POP_STACK (*inputs);
+    in.aig = btor_aig_and (amgr, a.aig, b.aig);
+    in.level = (a.level > b.level ? a.level : b.level) + 1;
+    in.owned = true;
+    set_level (w, in.aig, in.level);
+    if (a.owned) btor_aig_release (amgr, a.aig);
+    if (b.owned) btor_aig_release (amgr, b.aig);
+    BTOR_PUSH_STACK (*inputs, in);
+    for (pos = BTOR_COUNT_STACK (*inputs) - 1;
+         pos > 0 && inputs->start[pos - 1].level < in.level;
+         pos--)
+      inputs->start[pos] = inputs->start[pos - 1];
+    inputs->start[pos] = in;
+  }
+  in  = BTOR_POP_STACK (*inputs);
+  res = in.owned ? in.aig : btor_aig_copy (amgr, in.aig);
+  return res;
+}
+
+/* Balance all supergates of the window. A live node is the root of a
+ * supergate if it is a root, has more than one live parent or is referenced
+ * via an inverted edge. */
+static void
+balance_pass (BtorAIGOptWindow *w)
+{
+  BtorAIGOptInputStack inputs;
+  BtorAIG *n, *res;
+  uint32_t pos;
+  int32_t flags;
+
+  w->level = btor_hashint_map_new (w->amgr->btor->mm);
+  BTOR_INIT_STACK (w->amgr->btor->mm, inputs);
+  for (pos = 0; pos < BTOR_COUNT_STACK (w->nodes); pos++)
+  {
+    flags = BTOR_PEEK_STACK (w->flags, pos);
+    if (!(flags & BTOR_AIG_OPT_LIVE)) continue;
+    if (!BTOR_PEEK_STACK (w->rootocc, pos) && BTOR_PEEK_STACK (w->fo, pos) == 1
+        && !(flags & BTOR_AIG_OPT_INV_REF))
+      continue;
+    n   = BTOR_PEEK_STACK (w->nodes, pos);
+    res = balance_supergate (w, n, &inputs);
+    set_new (w, pos, res);
+  }
+  BTOR_RELEASE_STACK (inputs);
+}
+
+/*------------------------------------------------------------------------*/
+/* FRAIG sweeping                                                          */
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of 64-bit simulation words per node. */
+#define BTOR_AIG_FRAIG_MAX_WORDS 16
+/* Limit of a single equivalence check. */
+#define BTOR_AIG_FRAIG_LIMIT 1000
+
+#define BTOR_AIG_FRAIG_NONE -1
+#define BTOR_AIG_FRAIG_FALSE -2
+#define BTOR_AIG_FRAIG_TRUE -3
+
+/* Functionally reduced AIG construction. The leaves of the window (AIG
+ * variables and encoded AND nodes) are treated as free inputs. Nodes are
+ * identified by their position in the simulator. */
+struct BtorAIGFraig
+{
+  BtorAIGOptWindow *w;
+  BtorSATMgr *smgr; /* SAT solver for equivalence checks */
+  BtorRNG rng;
+  BtorAIGSim *sim;
+  uint32_t num;       /* number of nodes incl. inputs */
+  uint32_t num_words; /* number of simulated words */
+  uint64_t *cex;      /* collected counter examples (per input) */
+  uint32_t num_cex;
+  int32_t *lits;   /* CNF ids of nodes in 'smgr', 0 if not encoded */
+  int32_t *repr;   /* representative of the class of a node */
+  int32_t *merged; /* (node << 1) | phase or BTOR_AIG_FRAIG_* */
+};
+
+typedef struct BtorAIGFraig BtorAIGFraig;
+
+struct BtorAIGFraigKey
+{
+  uint64_t sig;
+  uint32_t node;
+};
+
+typedef struct BtorAIGFraigKey BtorAIGFraigKey;
+
+/* The phase of a node is the value of its first simulation pattern. */
+static bool
+fraig_phase (BtorAIGFraig *fr, uint32_t node)
+{
+  return btor_aig_sim_get_words (fr->sim, node)[0] & 1;
+}
+
+static int32_t
+fraig_cmp_key (const void *p, const void *q)
+{
+  const BtorAIGFraigKey *a = p, *b = q;
+  if (a->sig != b->sig) return a->sig < b->sig ? -1 : 1;
+  return (int32_t) a->node - (int32_t) b->node;
+}
+
+/* Partition the nodes into candidate equivalence classes w.r.t. the
+ * simulation signatures normalized to phase 0. The representative of a
+ * class is its smallest node. */
+static void
+fraig_compute_classes (BtorAIGFraig *fr)
+{
+  BtorMemMgr *mm;
+  BtorAIGFraigKey *keys;
+  uint64_t sig, s, *words;
+  uint32_t i, j, repr;
+  bool zero;
+
+  mm = fr->w->amgr->btor->mm;
+  BTOR_NEWN (mm, keys, fr->num);
+  for (i = 0; i < fr->num; i++)
+  {
+    sig   = 0;
+    zero  = true;
+    words = btor_aig_sim_get_words (fr->sim, i);
+    for (j = 0; j < fr->num_words; j++)
+    {
+      s = fraig_phase (fr, i) ? ~words[j] : words[j];
+      if (s) zero = false;
+      sig = (sig ^ s) * 0x9E3779B97F4A7C15ull;
+    }
+    keys[i].sig  = sig;
+    keys[i].node = i;
+    fr->repr[i]  = zero ? BTOR_AIG_FRAIG_FALSE : BTOR_AIG_FRAIG_NONE;
+  }
+  qsort (keys, fr->num, sizeof (BtorAIGFraigKey), fraig_cmp_key);
+  for (i = 0, repr = 0; i < fr->num; i++)
+  {
+    if (i == 0 || keys[i].sig != keys[i - 1].sig) repr = keys[i].node;
+    if (fr->repr[keys[i].node] == BTOR_AIG_FRAIG_FALSE) continue;
+    fr->repr[keys[i].node] = repr;
+  }
+  BTOR_DELETEN (mm, keys, fr->num);
+}
+
+/* Encode the cone of 'node' into the SAT solver of 'fr'. */
+static int32_t
+fraig_encode (BtorAIGFraig *fr, uint32_t node)
+{
+  BtorUIntStack visit;
+  uint32_t cur, i;
+  int32_t lit, l[2], *children;
+
+  if (fr->lits[node]) return fr->lits[node];
+  BTOR_INIT_STACK (fr->w->amgr->btor->mm, visit);
+  BTOR_PUSH_STACK (visit, node);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_TOP_STACK (visit);
+    if (fr->lits[cur])
+    {
+      (void) BTOR_POP_STACK (visit);
+      continue;
+    }
+    if (btor_aig_sim_is_input (fr->sim, cur))
+    {
+      (void) BTOR_POP_STACK (visit);
+      fr->lits[cur] = btor_sat_mgr_next_cnf_id (fr->smgr);
+      continue;
+    }
+    children = fr->sim->children + 2 * cur;
+    for (i = 0; i < 2; i++)
+    {
+      if (fr->lits[children[i] >> 1]) continue;
+      BTOR_PUSH_STACK (visit, children[i] >> 1);
+    }
+    if (BTOR_TOP_STACK (visit) != cur) continue;
+    (void) BTOR_POP_STACK (visit);
+    for (i = 0; i < 2; i++)
+    {
+      l[i] = fr->lits[children[i] >> 1];
+      if (children[i] & 1) l[i] = -l[i];
+    }
+    lit           = btor_sat_mgr_next_cnf_id (fr->smgr);
+    fr->lits[cur] = lit;
+    btor_sat_add (fr->smgr, -lit);
+    btor_sat_add (fr->smgr, l[0]);
+    btor_sat_add (fr->smgr, 0);
+    btor_sat_add (fr->smgr, -lit);
+    btor_sat_add (fr->smgr, l[1]);
+    btor_sat_add (fr->smgr, 0);
+    btor_sat_add (fr->smgr, lit);
+    btor_sat_add (fr->smgr, -l[0]);
+    btor_sat_add (fr->smgr, -l[1]);
+    btor_sat_add (fr->smgr, 0);
+  }
+  BTOR_RELEASE_STACK (visit);
+  return fr->lits[node];
+}
+
+/* Store the model of the last satisfiable check as counter example and
+ * refine the classes if enough counter examples have been collected.
+ * Inputs that are not encoded keep their random value. */
+static void
+fraig_add_cex (BtorAIGFraig *fr)
+{
+  uint32_t i;
+  uint64_t bit;
+
+  bit = (uint64_t) 1 << fr->num_cex;
+  for (i = 0; i < fr->num; i++)
+  {
+    if (!fr->lits[i] || !btor_aig_sim_is_input (fr->sim, i)) continue;
+    if (btor_sat_deref (fr->smgr, fr->lits[i]) > 0)
+      fr->cex[i] |= bit;
+    else
+      fr->cex[i] &= ~bit;
+  }
+  fr->num_cex += 1;
+  if (fr->num_cex < 64 || fr->num_words == BTOR_AIG_FRAIG_MAX_WORDS) return;
+  for (i = 0; i < fr->num; i++)
+  {
+    if (!btor_aig_sim_is_input (fr->sim, i)) continue;
+    btor_aig_sim_get_words (fr->sim, i)[fr->num_words] = fr->cex[i];
+  }
+  btor_aig_sim_run (fr->sim, fr->num_words, fr->num_words + 1);
+  fr->num_words += 1;
+  fraig_compute_classes (fr);
+  /* next counter examples start from random values */
+  if (fr->num_words < BTOR_AIG_FRAIG_MAX_WORDS)
+  {
+    btor_aig_sim_randomize (
+        fr->sim, &fr->rng, fr->num_words, fr->num_words + 1);
+    for (i = 0; i < fr->num; i++)
+    {
+      if (!btor_aig_sim_is_input (fr->sim, i)) continue;
+      fr->cex[i] = btor_aig_sim_get_words (fr->sim, i)[fr->num_words];
+    }
+  }
+  fr->num_cex = 0;
+}
+
+/* Check if 'a' is always false ('b' = 0) or 'a' and 'b' are equivalent. */
+static BtorSolverResult
+fraig_check (BtorAIGFraig *fr, int32_t a, int32_t b)
+{
+  BtorSolverResult res;
+
+  fr->w->amgr->num_fraig_sat_calls += 1;
+  btor_sat_assume (fr->smgr, a);
+  if (b) btor_sat_assume (fr->smgr, -b);
+  res = btor_sat_check_sat (fr->smgr, BTOR_AIG_FRAIG_LIMIT);
+  if (res != BTOR_RESULT_UNSAT || !b) return res;
+  fr->w->amgr->num_fraig_sat_calls += 1;
+  btor_sat_assume (fr->smgr, -a);
+  btor_sat_assume (fr->smgr, b);
+  return btor_sat_check_sat (fr->smgr, BTOR_AIG_FRAIG_LIMIT);
+}
+
+/* Prove or refute the candidate equivalence of every live node and its
+ * class representative in topological order. */
+static void
+fraig_sweep (BtorAIGFraig *fr)
+{
+  BtorSolverResult res;
+  uint32_t node;
+  int32_t repr, a, b;
+  bool phase;
+
+  for (node = 0; node < fr->num; node++)
+  {
+    if (btor_aig_sim_is_input (fr->sim, node)) continue;
+    if (!is_live (fr->w, BTOR_PEEK_STACK (fr->sim->nodes, node))) continue;
+    repr = fr->repr[node];
+    if (repr == (int32_t) node) continue;
+    phase = fraig_phase (fr, node);
+    a     = fraig_encode (fr, node);
+    if (phase) a = -a;
+    b = 0;
+    if (repr >= 0)
+    {
+      b = fraig_encode (fr, repr);
+      if (fraig_phase (fr, repr)) b = -b;
+    }
+    res = fraig_check (fr, a, b);
+    if (res == BTOR_RESULT_SAT)
+    {
+      fraig_add_cex (fr);
+      continue;
+    }
+    if (res != BTOR_RESULT_UNSAT) continue;
+
+    /* add proven equivalence to the SAT solver */
+    btor_sat_add (fr->smgr, -a);
+    if (b) btor_sat_add (fr->smgr, b);
+    btor_sat_add (fr->smgr, 0);
+    if (b)
+    {
+      btor_sat_add (fr->smgr, a);
+      btor_sat_add (fr->smgr, -b);
+      btor_sat_add (fr->smgr, 0);
+      phase ^= fraig_phase (fr, repr);
+      fr->merged[node] = (repr << 1) | phase;
+    }
+    else
+      fr->merged[node] = phase ? BTOR_AIG_FRAIG_TRUE : BTOR_AIG_FRAIG_FALSE;
+    fr->w->amgr->num_fraig_merges += 1;
+  }
+}
+
+static void
+fraig_init (BtorAIGFraig *fr, BtorAIGOptWindow *w)
+{
+  BtorMemMgr *mm;
+  uint32_t i;
+
+  mm = w->amgr->btor->mm;
+  BTOR_CLR (fr);
+  fr->w = w;
+  btor_rng_init (&fr->rng, btor_opt_get (w->amgr->btor, BTOR_OPT_SEED));
+  fr->sim = btor_aig_sim_new (w->amgr,
+                              w->nodes.start,
+                              BTOR_COUNT_STACK (w->nodes),
+                              BTOR_AIG_FRAIG_MAX_WORDS,
+                              true);
+  fr->num = btor_aig_sim_num_nodes (fr->sim);
+
+  BTOR_CNEWN (mm, fr->lits, fr->num);
+  BTOR_NEWN (mm, fr->repr, fr->num);
+  BTOR_NEWN (mm, fr->merged, fr->num);
+  BTOR_NEWN (mm, fr->cex, fr->num);
+  for (i = 0; i < fr->num; i++) fr->merged[i] = BTOR_AIG_FRAIG_NONE;
+
+  /* initial random simulation, the second word is the starting point of
+   * the counter examples */
+  btor_aig_sim_randomize (fr->sim, &fr->rng, 0, 2);
+  btor_aig_sim_run (fr->sim, 0, 1);
+  fr->num_words = 1;
+  for (i = 0; i < fr->num; i++)
+    fr->cex[i] = btor_aig_sim_get_words (fr->sim, i)[1];
+  fraig_compute_classes (fr);
+
+  fr->smgr = btor_sat_mgr_new (w->amgr->btor);
+  /* only bounded calls, running a portfolio does not pay off */
+  btor_sat_enable_engine (fr->smgr);
+  btor_sat_init (fr->smgr);
+}
+
+static void
+fraig_delete (BtorAIGFraig *fr)
+{
+  BtorMemMgr *mm;
+
+  mm = fr->w->amgr->btor->mm;
+  btor_sat_mgr_delete (fr->smgr);
+  BTOR_DELETEN (mm, fr->cex, fr->num);
+  BTOR_DELETEN (mm, fr->lits, fr->num);
+  BTOR_DELETEN (mm, fr->repr, fr->num);
+  BTOR_DELETEN (mm, fr->merged, fr->num);
+  btor_aig_sim_delete (fr->sim);
+}
+
+/* Merge live nodes that are proven to be equivalent to a smaller node or a
+ * constant. */
+static void
+fraig_pass (BtorAIGOptWindow *w)
+{
+  BtorAIGFraig fr;
+  BtorAIG *n, *res;
+  uint32_t pos;
+  int32_t merged;
+
+  fraig_init (&fr, w);
+  if (!btor_sat_mgr_has_incremental_support (fr.smgr))
+  {
+    fraig_delete (&fr);
+    return;
+  }
+  fraig_sweep (&fr);
+
+  /* The new AIGs of all live nodes are kept until the window is released
+   * since they may be used as representative. */
+  for (pos = 0; pos < BTOR_COUNT_STACK (w->nodes); pos++)
+  {
+    if (!(BTOR_PEEK_STACK (w->flags, pos) & BTOR_AIG_OPT_LIVE)) continue;
+    n      = BTOR_PEEK_STACK (w->nodes, pos);
+    merged = fr.merged[btor_aig_sim_get_pos (fr.sim, n)];
+    if (merged == BTOR_AIG_FRAIG_FALSE)
+      res = BTOR_AIG_FALSE;
+    else if (merged == BTOR_AIG_FRAIG_TRUE)
+      res = BTOR_AIG_TRUE;
+    else if (merged >= 0)
+    {
+      res = get_new (w, BTOR_PEEK_STACK (fr.sim->nodes, merged >> 1));
+      if (merged & 1) res = BTOR_INVERT_AIG (res);
+      res = btor_aig_copy (w->amgr, res);
+    }
+    else
+      res = btor_aig_and (w->amgr,
+                          get_new (w, btor_aig_get_left_child (w->amgr, n)),
+                          get_new (w, btor_aig_get_right_child (w->amgr, n)));
+    set_new (w, pos, res);
+  }
+  fraig_delete (&fr);
+}
+
+/* Run 'pass' on 'aigs' and keep the result if it has no more AND nodes. */
+static void
+run_pass (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n, BtorAIGOptPass pass)
+{
+  BtorAIGOptWindow w;
+  BtorAIGPtrStack new_aigs;
+  uint32_t i, old_size, new_size;
+
+  init_window (&w, amgr, aigs, n);
+  if (BTOR_EMPTY_STACK (w.nodes))
+  {
+    release_window (&w);
+    return;
+  }
+  pass (&w);
+
+  BTOR_INIT_STACK (amgr->btor->mm, new_aigs);
+  for (i = 0; i < n; i++)
+    BTOR_PUSH_STACK (new_aigs, btor_aig_copy (amgr, get_new (&w, aigs[i])));
+  release_window (&w);
+
+  old_size = count_ands (amgr, aigs, n);
+  new_size = count_ands (amgr, new_aigs.start, n);
+  if (new_size <= old_size)
+  {
+    amgr->num_opt_saved += old_size - new_size;
+    for (i = 0; i < n; i++)
+    {
+      btor_aig_release (amgr, aigs[i]);
+      aigs[i] = BTOR_PEEK_STACK (new_aigs, i);
+    }
+  }
+  else
+  {
+    for (i = 0; i < n; i++)
+      btor_aig_release (amgr, BTOR_PEEK_STACK (new_aigs, i));
+  }
+  BTOR_RELEASE_STACK (new_aigs);
+}
+
+void
+btor_aig_optimize (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n)
+{
+  assert (amgr);
+  assert (aigs);
+
+  uint32_t level;
+
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_FRAIG))
+    run_pass (amgr, aigs, n, fraig_pass);
+  level = btor_opt_get (amgr->btor, BTOR_OPT_AIG_REWRITE);
+  if (level > 1) run_pass (amgr, aigs, n, balance_pass);
+  if (level > 0) run_pass (amgr, aigs, n, rewrite_pass);
+}
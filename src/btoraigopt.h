@@ -0,0 +1,33 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGOPT_H_INCLUDED
+#define BTORAIGOPT_H_INCLUDED
+
+#include "btoraig.h"
+
+/* Optimize the not yet encoded part of the AIGs 'aigs' prior to CNF encoding
+ * (options BTOR_OPT_AIG_FRAIG and BTOR_OPT_AIG_REWRITE).
+ *
+ * SAT sweeping (FRAIG) partitions the AND nodes into candidate equivalence
+ * classes by 64-way bit-parallel random simulation and merges nodes that are
+ * proven equivalent (modulo negation) to a smaller node or a constant by an
+ * incremental SAT solver. Counter examples refine the classes.
+ *
+ * Level 1 applies DAG-aware rewriting: for every AND node the 4-feasible cuts
+ * are enumerated and the cone of a cut is replaced by a resynthesized
+ * structure (irredundant sum-of-products or cofactor decomposition of the
+ * truth table of the cut) if this reduces the number of ANDs, taking node
+ * sharing into account. Level 2 additionally balances multi-input AND trees
+ * (supergates) w.r.t. the level of their inputs before rewriting.
+ *
+ * Only AIGs that are exclusively referenced by 'aigs' are restructured,
+ * shared and already encoded AIGs are kept. The AIGs in 'aigs' are replaced
+ * in place (the old ones are released), the result is discarded if it has
+ * more AND nodes than the original. */
+void btor_aig_optimize (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n);
+
+#endif
@@ -0,0 +1,211 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigsim.h"
+#include "btorcore.h"
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_input (const BtorAIG *real_aig, bool encoded_inputs)
+{
+  return btor_aig_is_var (real_aig) || (encoded_inputs && real_aig->cnf_id);
+}
+
+static int32_t
+get_pos (const BtorAIGSim *sim, const BtorAIG *real_aig)
+{
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (sim->idx, real_aig->id);
+  return d ? d->as_int : -1;
+}
+
+BtorAIGSim *
+btor_aig_sim_new (BtorAIGMgr *amgr,
+                  BtorAIG **roots,
+                  uint32_t n,
+                  uint32_t num_words,
+                  bool encoded_inputs)
+{
+  assert (amgr);
+  assert (roots || !n);
+  assert (num_words > 0);
+
+  uint32_t i, j, num_nodes;
+  int32_t pos;
+  BtorMemMgr *mm;
+  BtorAIGSim *sim;
+  BtorAIGPtrStack visit;
+  BtorAIG *cur, *real_cur, *child;
+  BtorIntHashTable *cache;
+
+  mm = amgr->btor->mm;
+  BTOR_CNEW (mm, sim);
+  sim->amgr      = amgr;
+  sim->num_words = num_words;
+  sim->idx       = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, sim->nodes);
+
+  /* collect nodes in post-order */
+  cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  for (i = 0; i < n; i++)
+  {
+    if (btor_aig_is_const (roots[i])) continue;
+    BTOR_PUSH_STACK (visit, BTOR_REAL_ADDR_AIG (roots[i]));
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur      = BTOR_POP_STACK (visit);
+      real_cur = BTOR_REAL_ADDR_AIG (cur);
+      if (btor_hashint_map_contains (sim->idx, real_cur->id)) continue;
+      if (real_cur != cur || is_input (real_cur, encoded_inputs))
+      {
+        btor_hashint_map_add (sim->idx, real_cur->id)->as_int =
+            BTOR_COUNT_STACK (sim->nodes);
+        BTOR_PUSH_STACK (sim->nodes, real_cur);
+        continue;
+      }
+      if (btor_hashint_table_contains (cache, real_cur->id)) continue;
+      btor_hashint_table_add (cache, real_cur->id);
+      /* the inverted entry marks a node whose children are done */
+      BTOR_PUSH_STACK (visit, BTOR_INVERT_AIG (real_cur));
+      for (j = 0; j < 2; j++)
+      {
+        child = BTOR_REAL_ADDR_AIG (
+            btor_aig_get_by_id (amgr, real_cur->children[j]));
+        if (!btor_hashint_map_contains (sim->idx, child->id))
+          BTOR_PUSH_STACK (visit, child);
+      }
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+
+  num_nodes = BTOR_COUNT_STACK (sim->nodes);
+  if (num_nodes)
+  {
+    BTOR_NEWN (mm, sim->children, 2 * num_nodes);
+    BTOR_CNEWN (mm, sim->values, (size_t) num_nodes * num_words);
+  }
+  for (i = 0; i < num_nodes; i++)
+  {
+    cur = BTOR_PEEK_STACK (sim->nodes, i);
+    if (is_input (cur, encoded_inputs))
+    {
+      sim->children[2 * i]     = -1;
+      sim->children[2 * i + 1] = -1;
+      continue;
+    }
+    for (j = 0; j < 2; j++)
+    {
+      child = btor_aig_get_by_id (amgr, cur->children[j]);
+      pos   = get_pos (sim, BTOR_REAL_ADDR_AIG (child));
+      assert (pos >= 0 && (uint32_t) pos < i);
+      sim->children[2 * i + j] = (pos << 1) | BTOR_IS_INVERTED_AIG (child);
+    }
+  }
+  return sim;
+}
+
+void
+btor_aig_sim_delete (BtorAIGSim *sim)
+{
+  assert (sim);
+
+  BtorMemMgr *mm;
+  uint32_t num_nodes;
+
+  mm        = sim->amgr->btor->mm;
+  num_nodes = BTOR_COUNT_STACK (sim->nodes);
+  BTOR_DELETEN (mm, sim->children, 2 * num_nodes);
+  BTOR_DELETEN (mm, sim->values, (size_t) num_nodes * sim->num_words);
+  btor_hashint_map_delete (sim->idx);
+  BTOR_RELEASE_STACK (sim->nodes);
+  BTOR_DELETE (mm, sim);
+}
+
+uint32_t
+btor_aig_sim_num_nodes (const BtorAIGSim *sim)
+{
+  assert (sim);
+  return BTOR_COUNT_STACK (sim->nodes);
+}
+
+int32_t
+btor_aig_sim_get_pos (const BtorAIGSim *sim, const BtorAIG *aig)
+{
+  assert (sim);
+  if (btor_aig_is_const (aig)) return -1;
+  return get_pos (sim, BTOR_REAL_ADDR_AIG (aig));
+}
+
+uint64_t
+btor_aig_sim_get_word (BtorAIGSim *sim, BtorAIG *aig, uint32_t word)
+{
+  assert (sim);
+  assert (word < sim->num_words);
+
+  int32_t pos;
+  uint64_t res;
+
+  if (btor_aig_is_true (aig)) return ~UINT64_C (0);
+  if (btor_aig_is_false (aig)) return 0;
+  pos = get_pos (sim, BTOR_REAL_ADDR_AIG (aig));
+  assert (pos >= 0);
+  res = btor_aig_sim_get_words (sim, pos)[word];
+  return BTOR_IS_INVERTED_AIG (aig) ? ~res : res;
+}
+
+void
+btor_aig_sim_randomize (BtorAIGSim *sim,
+                        BtorRNG *rng,
+                        uint32_t from,
+                        uint32_t to)
+{
+  assert (sim);
+  assert (rng);
+  assert (from <= to);
+  assert (to <= sim->num_words);
+
+  uint32_t i, j, num_nodes;
+  uint64_t *words;
+
+  num_nodes = BTOR_COUNT_STACK (sim->nodes);
+  for (i = 0; i < num_nodes; i++)
+  {
+    if (!btor_aig_sim_is_input (sim, i)) continue;
+    words = btor_aig_sim_get_words (sim, i);
+    for (j = from; j < to; j++)
+      words[j] = ((uint64_t) btor_rng_rand (rng) << 32) | btor_rng_rand (rng);
+  }
+}
+
+void
+btor_aig_sim_run (BtorAIGSim *sim, uint32_t from, uint32_t to)
+{
+  assert (sim);
+  assert (from <= to);
+  assert (to <= sim->num_words);
+
+  uint32_t i, j, num_nodes;
+  int32_t c0, c1;
+  uint64_t m0, m1, *res;
+  const uint64_t *v0, *v1;
+
+  num_nodes = BTOR_COUNT_STACK (sim->nodes);
+  for (i = 0; i < num_nodes; i++)
+  {
+    c0 = sim->children[2 * i];
+    if (c0 < 0) continue;
+    c1  = sim->children[2 * i + 1];
+    v0  = btor_aig_sim_get_words (sim, c0 >> 1);
+    v1  = btor_aig_sim_get_words (sim, c1 >> 1);
+    m0  = (c0 & 1) ? ~UINT64_C (0) : 0;
+    m1  = (c1 & 1) ? ~UINT64_C (0) : 0;
+    res = btor_aig_sim_get_words (sim, i);
+    for (j = from; j < to; j++) res[j] = (v0[j] ^ m0) & (v1[j] ^ m1);
+  }
+}
@@ -0,0 +1,80 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGSIM_H_INCLUDED
+#define BTORAIGSIM_H_INCLUDED
+
+#include "btoraig.h"
+#include "utils/btorhashint.h"
+#include "utils/btorrng.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Bit-parallel simulator for the cone of a set of AIGs. Every node holds
+ * 'num_words' 64-bit words, i.e., 64 * 'num_words' input patterns are
+ * evaluated in one pass over the nodes in topological order. The inner loop
+ * over the words is branch-free and is vectorized by the compiler.
+ *
+ * Inputs are AIG variables and, if enabled, AND nodes that are already
+ * encoded to CNF (their cone is not simulated). */
+struct BtorAIGSim
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack nodes; /* inputs and AND nodes in topological order */
+  BtorIntHashTable *idx; /* AIG id -> position in 'nodes' */
+  int32_t *children;     /* (position << 1) | inverted, -1 for inputs */
+  uint32_t num_words;    /* number of words per node */
+  uint64_t *values;      /* 'num_words' words per node */
+};
+
+typedef struct BtorAIGSim BtorAIGSim;
+
+/* Create a simulator for the cones of 'roots'. All words are initialized
+ * with 0. */
+BtorAIGSim *btor_aig_sim_new (BtorAIGMgr *amgr,
+                              BtorAIG **roots,
+                              uint32_t n,
+                              uint32_t num_words,
+                              bool encoded_inputs);
+
+void btor_aig_sim_delete (BtorAIGSim *sim);
+
+/* Returns the number of nodes of the simulator. */
+uint32_t btor_aig_sim_num_nodes (const BtorAIGSim *sim);
+
+/* Returns the position of 'aig' in the topological order, -1 if 'aig' is not
+ * a node of the simulator. */
+int32_t btor_aig_sim_get_pos (const BtorAIGSim *sim, const BtorAIG *aig);
+
+static inline bool
+btor_aig_sim_is_input (const BtorAIGSim *sim, uint32_t pos)
+{
+  return sim->children[2 * pos] < 0;
+}
+
+/* Returns the words of the node at position 'pos' (writable for inputs). */
+static inline uint64_t *
+btor_aig_sim_get_words (BtorAIGSim *sim, uint32_t pos)
+{
+  return sim->values + (size_t) pos * sim->num_words;
+}
+
+/* Returns word 'word' of 'aig' (may be inverted or constant). */
+uint64_t btor_aig_sim_get_word (BtorAIGSim *sim, BtorAIG *aig, uint32_t word);
+
+/* Assign random values to words [from, to) of all inputs. */
+void btor_aig_sim_randomize (BtorAIGSim *sim,
+                             BtorRNG *rng,
+                             uint32_t from,
+                             uint32_t to);
+
+/* Simulate words [from, to) of all AND nodes. */
+void btor_aig_sim_run (BtorAIGSim *sim, uint32_t from, uint32_t to);
+
+#endif
@@ -10,6 +10,7 @@
  */
 
 #include "btoraigvec.h"
+#include "btoraigopt.h"
 #include "btorcore.h"
 #include "btoropt.h"
 #include "utils/btoraigmap.h"
@@ -137,6 +138,133 @@ btor_aigvec_and (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
   return result;
 }
 
+static BtorAIG *
+xor_aig (BtorAIGMgr *amgr, BtorAIG *x, BtorAIG *y)
+{
+  return BTOR_INVERT_AIG (btor_aig_eq (amgr, x, y));
+}
+
+/*------------------------------------------------------------------------*/
+/* Parallel-prefix networks.                                              */
+/*------------------------------------------------------------------------*/
+
+static bool
+use_prefix (BtorAIGVecMgr *avmgr, uint32_t width)
+{
+  uint32_t min_width = btor_opt_get (avmgr->btor, BTOR_OPT_PREFIX_WIDTH);
+  return min_width && width >= min_width;
+}
+
+/* Replace the generate/propagate pair (g, p) by
+ * (g, p) o (g_low, p_low) = (g | p & g_low, p & p_low). */
+static void
+prefix_op (BtorAIGMgr *amgr,
+           BtorAIG **g,
+           BtorAIG **p,
+           BtorAIG *g_low,
+           BtorAIG *p_low)
+{
+  BtorAIG *tmp, *res;
+
+  tmp = btor_aig_and (amgr, *p, g_low);
+  res = btor_aig_or (amgr, *g, tmp);
+  btor_aig_release (amgr, tmp);
+  btor_aig_release (amgr, *g);
+  *g  = res;
+  res = btor_aig_and (amgr, *p, p_low);
+  btor_aig_release (amgr, *p);
+  *p = res;
+}
+
+/* Compute all prefixes (g[i], p[i]) o ... o (g[0], p[0]) in place, where
+ * index 0 is the LSB, with a Brent-Kung or Kogge-Stone network. */
+static void
+prefix_aigs (BtorAIGVecMgr *avmgr, BtorAIG **g, BtorAIG **p, uint32_t n)
+{
+  BtorAIGMgr *amgr;
+  uint32_t i, d;
+
+  amgr = avmgr->amgr;
+  if (btor_opt_get (avmgr->btor, BTOR_OPT_PREFIX_ENC) == BTOR_PREFIX_ENC_KS)
+  {
+    /* in descending order, such that i - d still holds the previous level */
+    for (d = 1; d < n; d *= 2)
+      for (i = n - 1; i >= d; i--)
+        prefix_op (amgr, &g[i], &p[i], g[i - d], p[i - d]);
+  }
+  else
+  {
+    /* up-sweep computes the prefixes at positions 2^k - 1 */
+    for (d = 1; 2 * d <= n; d *= 2)
+      for (i = 2 * d - 1; i < n; i += 2 * d)
+        prefix_op (amgr, &g[i], &p[i], g[i - d], p[i - d]);
+    /* down-sweep fills in the remaining positions */
+    for (; d >= 1; d /= 2)
+      for (i = 3 * d - 1; i < n; i += 2 * d)
+        prefix_op (amgr, &g[i], &p[i], g[i - d], p[i - d]);
+  }
+}
+
+/* Compute the group (g[n-1], p[n-1]) o ... o (g[0], p[0]) with a balanced
+ * tree into (g[0], p[0]). */
+static void
+group_aigs (BtorAIGMgr *amgr, BtorAIG **g, BtorAIG **p, uint32_t n)
+{
+  uint32_t i, m;
+
+  for (m = n; m > 1; m = (m + 1) / 2)
+  {
+    for (i = 0; 2 * i < m; i++)
+    {
+      if (2 * i + 1 < m)
+      {
+        prefix_op (amgr, &g[2 * i + 1], &p[2 * i + 1], g[2 * i], p[2 * i]);
+        btor_aig_release (amgr, g[2 * i]);
+        btor_aig_release (amgr, p[2 * i]);
+        g[i] = g[2 * i + 1];
+        p[i] = p[2 * i + 1];
+      }
+      else
+      {
+        g[i] = g[2 * i];
+        p[i] = p[2 * i];
+      }
+    }
+  }
+}
+
+/* Unsigned a < b iff a - b borrows, i.e., iff the group of the pairs
+ * (a_i & ~b_i, a_i = b_i) neither generates nor propagates. */
+static BtorAIG *
+lt_prefix_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
+{
+  BtorAIGMgr *amgr;
+  BtorMemMgr *mm;
+  BtorAIG **g, **p, *x, *y, *res;
+  uint32_t i, n;
+
+  amgr = avmgr->amgr;
+  mm   = avmgr->btor->mm;
+  n    = av1->width;
+
+  BTOR_NEWN (mm, g, n);
+  BTOR_NEWN (mm, p, n);
+  for (i = 0; i < n; i++)
+  {
+    x    = av1->aigs[n - 1 - i];
+    y    = av2->aigs[n - 1 - i];
+    g[i] = btor_aig_and (amgr, x, BTOR_INVERT_AIG (y));
+    p[i] = btor_aig_eq (amgr, x, y);
+  }
+  group_aigs (amgr, g, p, n);
+  res = btor_aig_or (amgr, g[0], p[0]);
+  btor_aig_release (amgr, g[0]);
+  btor_aig_release (amgr, p[0]);
+  BTOR_DELETEN (mm, g, n);
+  BTOR_DELETEN (mm, p, n);
+  return BTOR_INVERT_AIG (res);
+}
+
 static BtorAIG *
 lt_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
 {
@@ -176,7 +304,9 @@ btor_aigvec_ult (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
   assert (av1->width == av2->width);
   assert (av1->width > 0);
   result          = new_aigvec (avmgr, 1);
-  result->aigs[0] = lt_aigvec (avmgr, av1, av2);
+  result->aigs[0] = use_prefix (avmgr, av1->width)
+                        ? lt_prefix_aigvec (avmgr, av1, av2)
+                        : lt_aigvec (avmgr, av1, av2);
   return result;
 }
 
@@ -237,6 +367,53 @@ full_adder (
   return res;
 }
 
+/* Parallel-prefix adder: the carry into bit i is the group generate of the
+ * pairs (a_j & b_j, a_j ^ b_j) for j < i. */
+static BtorAIGVec *
+add_prefix_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
+{
+  BtorAIGMgr *amgr;
+  BtorMemMgr *mm;
+  BtorAIGVec *result;
+  BtorAIG **g, **p, **s, *x, *y;
+  uint32_t i, n;
+
+  amgr = avmgr->amgr;
+  mm   = avmgr->btor->mm;
+  n    = av1->width;
+
+  BTOR_NEWN (mm, g, n);
+  BTOR_NEWN (mm, p, n);
+  BTOR_NEWN (mm, s, n);
+  for (i = 0; i < n; i++)
+  {
+    x    = av1->aigs[n - 1 - i];
+    y    = av2->aigs[n - 1 - i];
+    g[i] = btor_aig_and (amgr, x, y);
+    p[i] = xor_aig (amgr, x, y);
+    s[i] = btor_aig_copy (amgr, p[i]);
+  }
+  /* the carry out of the MSB is not needed */
+  prefix_aigs (avmgr, g, p, n - 1);
+
+  result              = new_aigvec (avmgr, n);
+  result->aigs[n - 1] = s[0];
+  for (i = 1; i < n; i++)
+  {
+    result->aigs[n - 1 - i] = xor_aig (amgr, s[i], g[i - 1]);
+    btor_aig_release (amgr, s[i]);
+  }
+  for (i = 0; i < n; i++)
+  {
+    btor_aig_release (amgr, g[i]);
+    btor_aig_release (amgr, p[i]);
+  }
+  BTOR_DELETEN (mm, g, n);
+  BTOR_DELETEN (mm, p, n);
+  BTOR_DELETEN (mm, s, n);
+  return result;
+}
+
 static int32_t
 compare_aigvec_lsb_first (BtorAIGVec *a, BtorAIGVec *b)
 {
@@ -272,6 +449,9 @@ btor_aigvec_add (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
     BTOR_SWAP (BtorAIGVec *, av1, av2);
   }
 
+  if (use_prefix (avmgr, av1->width))
+    return add_prefix_aigvec (avmgr, av1, av2);
+
   amgr   = avmgr->amgr;
   result = new_aigvec (avmgr, av1->width);
   cout = cin = BTOR_AIG_FALSE; /* for 'cout' to avoid warning */
@@ -441,9 +621,286 @@ mul_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+/* Column compression multipliers.                                        */
+/*------------------------------------------------------------------------*/
+
+/* Partial product bits are collected in 'width' columns (index 0 is the
+ * LSB column). Bits beyond the width of the result and constant zeroes are
+ * dropped. Takes ownership of 'aig'. */
+static void
+push_column_bit (BtorAIGMgr *amgr,
+                 BtorAIGPtrStack *cols,
+                 uint32_t width,
+                 uint32_t col,
+                 BtorAIG *aig)
+{
+  if (col >= width || btor_aig_is_false (aig))
+    btor_aig_release (amgr, aig);
+  else
+    BTOR_PUSH_STACK (cols[col], aig);
+}
+
+/* Sum up the columns 'cols' with a Dadda tree of full and half adders until
+ * every column holds at most two bits, and add the remaining two rows with a
+ * ripple-carry adder. Releases the bits and deletes 'cols'. */
+static BtorAIGVec *
+sum_columns (BtorAIGVecMgr *avmgr, BtorAIGPtrStack *cols, uint32_t width)
+{
+  BtorMemMgr *mm;
+  BtorAIGMgr *amgr;
+  BtorAIGVec *res;
+  BtorAIGPtrStack *next;
+  BtorAIG *x, *y, *z, *sum, *cin, *cout;
+  uint32_t c, k, n, h, max_h, d, d_next;
+
+  mm   = avmgr->btor->mm;
+  amgr = avmgr->amgr;
+
+  max_h = 0;
+  for (c = 0; c < width; c++)
+    if (BTOR_COUNT_STACK (cols[c]) > max_h) max_h = BTOR_COUNT_STACK (cols[c]);
+
+  BTOR_CNEWN (mm, next, width);
+  for (c = 0; c < width; c++) BTOR_INIT_STACK (mm, next[c]);
+
+  while (max_h > 2)
+  {
+    /* largest stage height d_j < max_h, d_1 = 2, d_j+1 = floor (1.5 d_j) */
+    for (d = 2, d_next = 3; d_next < max_h; d = d_next, d_next = 3 * d / 2)
+      ;
+    max_h = 0;
+    for (c = 0; c < width; c++)
+    {
+      /* 'next[c]' already holds the carries of column c - 1 */
+      n = BTOR_COUNT_STACK (cols[c]);
+      h = n + BTOR_COUNT_STACK (next[c]);
+      for (k = 0; h > d && n - k >= 2;)
+      {
+        x = cols[c].start[k++];
+        y = cols[c].start[k++];
+        if (h == d + 1 || n - k == 0)
+        {
+          sum = half_adder (amgr, x, y, &cout);
+          h -= 1;
+        }
+        else
+        {
+          z   = cols[c].start[k++];
+          sum = full_adder (amgr, x, y, z, &cout);
+          btor_aig_release (amgr, z);
+          h -= 2;
+        }
+        btor_aig_release (amgr, x);
+        btor_aig_release (amgr, y);
+        BTOR_PUSH_STACK (next[c], sum);
+        push_column_bit (amgr, next, width, c + 1, cout);
+      }
+      for (; k < n; k++) BTOR_PUSH_STACK (next[c], cols[c].start[k]);
+      BTOR_RESET_STACK (cols[c]);
+      if (BTOR_COUNT_STACK (next[c]) > max_h)
+        max_h = BTOR_COUNT_STACK (next[c]);
+    }
+    BTOR_SWAP (BtorAIGPtrStack *, cols, next);
+  }
+
+  res = new_aigvec (avmgr, width);
+  cin = BTOR_AIG_FALSE;
+  for (c = 0; c < width; c++)
+  {
+    n = BTOR_COUNT_STACK (cols[c]);
+    assert (n <= 2);
+    x = n > 0 ? cols[c].start[0] : BTOR_AIG_FALSE;
+    y = n > 1 ? cols[c].start[1] : BTOR_AIG_FALSE;
+    res->aigs[width - 1 - c] = full_adder (amgr, x, y, cin, &cout);
+    btor_aig_release (amgr, x);
+    btor_aig_release (amgr, y);
+    btor_aig_release (amgr, cin);
+    cin = cout;
+  }
+  btor_aig_release (amgr, cin);
+
+  for (c = 0; c < width; c++)
+  {
+    BTOR_RELEASE_STACK (cols[c]);
+    BTOR_RELEASE_STACK (next[c]);
+  }
+  BTOR_DELETEN (mm, cols, width);
+  BTOR_DELETEN (mm, next, width);
+  return res;
+}
+
+static BtorAIGPtrStack *
+new_columns (BtorMemMgr *mm, uint32_t width)
+{
+  BtorAIGPtrStack *cols;
+  uint32_t c;
+
+  BTOR_CNEWN (mm, cols, width);
+  for (c = 0; c < width; c++) BTOR_INIT_STACK (mm, cols[c]);
+  return cols;
+}
+
+/* Multiplier with radix-4 Booth encoded partial products of 'a' w.r.t. the
+ * digits of 'b', summed up by a Dadda tree. Operand 'b' is interpreted as
+ * signed, which yields the same product modulo 2^width. */
+static BtorAIGVec *
+mul_tree_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack *cols;
+  BtorAIG *b0, *b1, *bm1, *one, *two, *neg, *t0, *t1, *sel;
+  uint32_t i, j, width;
+
+  width = a->width;
+  amgr  = avmgr->amgr;
+
+  assert (width > 0);
+  assert (width == b->width);
+
+/* bit 'i' of 'av' with LSB index 0 */
+#define BIT(av, i) ((av)->aigs[width - 1 - (i)])
+
+  cols = new_columns (avmgr->btor->mm, width);
+  for (i = 0; 2 * i < width; i++)
+  {
+    bm1 = i > 0 ? BIT (b, 2 * i - 1) : BTOR_AIG_FALSE;
+    b0  = BIT (b, 2 * i);
+    b1  = 2 * i + 1 < width ? BIT (b, 2 * i + 1) : BIT (b, width - 1);
+
+    /* digit = -2 * b1 + b0 + bm1 */
+    one = xor_aig (amgr, b0, bm1);
+    t0  = xor_aig (amgr, b1, b0);
+    two = btor_aig_and (amgr, t0, BTOR_INVERT_AIG (one));
+    btor_aig_release (amgr, t0);
+    t0  = btor_aig_and (amgr, b0, bm1);
+    neg = btor_aig_and (amgr, b1, BTOR_INVERT_AIG (t0));
+    btor_aig_release (amgr, t0);
+
+    /* (digit * a) << 2i = ((|digit| * a) ^ neg) + neg */
+    for (j = 0; 2 * i + j < width; j++)
+    {
+      t0 = btor_aig_and (amgr, BIT (a, j), one);
+      t1 = j > 0 ? btor_aig_and (amgr, BIT (a, j - 1), two) : BTOR_AIG_FALSE;
+      sel = btor_aig_or (amgr, t0, t1);
+      push_column_bit (amgr, cols, width, 2 * i + j, xor_aig (amgr, sel, neg));
+      btor_aig_release (amgr, t0);
+      btor_aig_release (amgr, t1);
+      btor_aig_release (amgr, sel);
+    }
+    push_column_bit (amgr, cols, width, 2 * i, neg);
+    btor_aig_release (amgr, one);
+    btor_aig_release (amgr, two);
+  }
+#undef BIT
+
+  return sum_columns (avmgr, cols, width);
+}
+
+static bool
+is_const_aigvec (BtorAIGVec *av)
+{
+  uint32_t i;
+  for (i = 0; i < av->width; i++)
+    if (!btor_aig_is_const (av->aigs[i])) return false;
+  return true;
+}
+
+/* Multiplier for constant 'b' that adds the shifted terms +/- (a << i) of the
+ * canonical signed digit (non-adjacent form) representation of 'b'. The
+ * negated terms ~(a << i) + (1 << i) share one constant correction term. */
+static BtorAIGVec *
+mul_csd_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack *cols;
+  BtorBitVector *corr;
+  BtorMemMgr *mm;
+  BtorAIG *aig;
+  bool bit, next, carry;
+  uint32_t i, j, width;
+  int32_t digit;
+
+  width = a->width;
+  amgr  = avmgr->amgr;
+  mm    = avmgr->btor->mm;
+
+  assert (width > 0);
+  assert (width == b->width);
+  assert (is_const_aigvec (b));
+
+  cols  = new_columns (mm, width);
+  corr  = btor_bv_new (mm, width);
+  carry = false;
+  for (i = 0; i < width; i++)
+  {
+    bit  = btor_aig_is_true (b->aigs[width - 1 - i]);
+    next = i + 1 < width && btor_aig_is_true (b->aigs[width - 2 - i]);
+    if (bit == carry)
+      digit = 0; /* carry is kept if both are set */
+    else if (next)
+    {
+      digit = -1;
+      carry = true;
+    }
+    else
+    {
+      digit = 1;
+      carry = false;
+    }
+    if (!digit) continue;
+    for (j = 0; i + j < width; j++)
+    {
+      aig = btor_aig_copy (amgr, a->aigs[width - 1 - j]);
+      push_column_bit (
+          amgr, cols, width, i + j, digit < 0 ? BTOR_INVERT_AIG (aig) : aig);
+    }
+    if (digit < 0)
+    {
+      /* corr += 1 << i */
+      for (j = i; j < width; j++)
+      {
+        bit = btor_bv_get_bit (corr, j);
+        btor_bv_set_bit (corr, j, !bit);
+        if (!bit) break;
+      }
+    }
+  }
+  for (i = 0; i < width; i++)
+    if (btor_bv_get_bit (corr, i))
+      push_column_bit (amgr, cols, width, i, BTOR_AIG_TRUE);
+  btor_bv_free (mm, corr);
+
+  return sum_columns (avmgr, cols, width);
+}
+
+/*------------------------------------------------------------------------*/
+
 BtorAIGVec *
 btor_aigvec_mul (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
 {
+  assert (avmgr);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+
+  if (btor_opt_get (avmgr->btor, BTOR_OPT_MUL_CSD))
+  {
+    if (is_const_aigvec (a)) BTOR_SWAP (BtorAIGVec *, a, b);
+    if (is_const_aigvec (b)) return mul_csd_aigvec (avmgr, a, b);
+  }
+  if (btor_opt_get (avmgr->btor, BTOR_OPT_MUL_ENC) == BTOR_MUL_ENC_TREE)
+  {
+    /* Booth recoding of a constant operand simplifies to its digits */
+    if (is_const_aigvec (a))
+      BTOR_SWAP (BtorAIGVec *, a, b);
+    else if (btor_opt_get (avmgr->btor, BTOR_OPT_SORT_AIGVEC) > 0
+             && !is_const_aigvec (b) && compare_aigvec_lsb_first (a, b) > 0)
+    {
+      BTOR_SWAP (BtorAIGVec *, a, b);
+    }
+    return mul_tree_aigvec (avmgr, a, b);
+  }
   return mul_aigvec (avmgr, a, b);
 }
 
@@ -568,6 +1025,207 @@ udiv_urem_aigvec (BtorAIGVecMgr *avmgr,
   *Rptr = R;
 }
 
+static BtorAIGVec *
+const_aigvec (BtorAIGVecMgr *avmgr, uint32_t width, bool ones)
+{
+  BtorAIGVec *res;
+  uint32_t i;
+
+  res = new_aigvec (avmgr, width);
+  for (i = 0; i < width; i++)
+    res->aigs[i] = ones ? BTOR_AIG_TRUE : BTOR_AIG_FALSE;
+  return res;
+}
+
+/* Encode a / b by fresh variables for quotient q and remainder r, and add
+ *   b = 0 ? q = ~0 & r = a : a = q * b + r & r < b
+ * to the SAT solver, where q * b + r is computed without overflow in
+ * 2 * width bits. */
+static void
+udiv_urem_constraint_aigvec (BtorAIGVecMgr *avmgr,
+                             BtorAIGVec *a,
+                             BtorAIGVec *b,
+                             BtorAIGVec **Qptr,
+                             BtorAIGVec **Rptr)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGVec *Q, *R, *zero, *ones, *b_zero, *q_ones, *r_a, *r_ult_b;
+  BtorAIGVec *ext_a, *ext_b, *ext_q, *ext_r, *mul, *add, *eq;
+  BtorAIG *def_zero, *def, *cons;
+  uint32_t width;
+
+  amgr  = avmgr->amgr;
+  width = a->width;
+
+  Q    = btor_aigvec_var (avmgr, width);
+  R    = btor_aigvec_var (avmgr, width);
+  zero = const_aigvec (avmgr, width, false);
+  ones = const_aigvec (avmgr, width, true);
+
+  b_zero   = btor_aigvec_eq (avmgr, b, zero);
+  q_ones   = btor_aigvec_eq (avmgr, Q, ones);
+  r_a      = btor_aigvec_eq (avmgr, R, a);
+  def_zero = btor_aig_and (amgr, q_ones->aigs[0], r_a->aigs[0]);
+
+  ext_a   = btor_aigvec_concat (avmgr, zero, a);
+  ext_b   = btor_aigvec_concat (avmgr, zero, b);
+  ext_q   = btor_aigvec_concat (avmgr, zero, Q);
+  ext_r   = btor_aigvec_concat (avmgr, zero, R);
+  mul     = btor_aigvec_mul (avmgr, ext_q, ext_b);
+  add     = btor_aigvec_add (avmgr, mul, ext_r);
+  eq      = btor_aigvec_eq (avmgr, add, ext_a);
+  r_ult_b = btor_aigvec_ult (avmgr, R, b);
+  def     = btor_aig_and (amgr, eq->aigs[0], r_ult_b->aigs[0]);
+
+  cons = btor_aig_cond (amgr, b_zero->aigs[0], def_zero, def);
+  btor_aig_add_toplevel_to_sat (amgr, cons);
+  btor_aig_release (amgr, cons);
+  btor_aig_release (amgr, def);
+  btor_aig_release (amgr, def_zero);
+
+  btor_aigvec_release_delete (avmgr, r_ult_b);
+  btor_aigvec_release_delete (avmgr, eq);
+  btor_aigvec_release_delete (avmgr, add);
+  btor_aigvec_release_delete (avmgr, mul);
+  btor_aigvec_release_delete (avmgr, ext_r);
+  btor_aigvec_release_delete (avmgr, ext_q);
+  btor_aigvec_release_delete (avmgr, ext_b);
+  btor_aigvec_release_delete (avmgr, ext_a);
+  btor_aigvec_release_delete (avmgr, r_a);
+  btor_aigvec_release_delete (avmgr, q_ones);
+  btor_aigvec_release_delete (avmgr, b_zero);
+  btor_aigvec_release_delete (avmgr, ones);
+  btor_aigvec_release_delete (avmgr, zero);
+
+  *Qptr = Q;
+  *Rptr = R;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of cached dividers. If exceeded, the least recently used
+ * divider is evicted. */
+#define BTOR_AIGVEC_DIV_CACHE_SIZE 1024
+
+static uint32_t
+hash_aigvec (const BtorAIGVec *av)
+{
+  uint32_t i, res;
+  BtorAIG *aig;
+
+  res = av->width;
+  for (i = 0; i < av->width; i++)
+  {
+    aig = av->aigs[i];
+    res = res * 31
+          + (btor_aig_is_const (aig) ? (uint32_t) (uintptr_t) aig
+                                     : (uint32_t) btor_aig_get_id (aig));
+  }
+  return res;
+}
+
+static int32_t
+compare_aigvec (const BtorAIGVec *a, const BtorAIGVec *b)
+{
+  uint32_t i;
+
+  if (a->width != b->width) return 1;
+  for (i = 0; i < a->width; i++)
+    if (a->aigs[i] != b->aigs[i]) return 1;
+  return 0;
+}
+
+static void
+flush_div_cache (BtorAIGVecMgr *avmgr)
+{
+  BtorPtrHashTableIterator it;
+  BtorAIGVec *key, *data;
+
+  if (!avmgr->div_cache) return;
+  btor_iter_hashptr_init (&it, avmgr->div_cache);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    key  = it.cur;
+    data = btor_iter_hashptr_next_data (&it)->as_ptr;
+    btor_aigvec_release_delete (avmgr, key);
+    btor_aigvec_release_delete (avmgr, data);
+  }
+  btor_hashptr_table_delete (avmgr->div_cache);
+  avmgr->div_cache = 0;
+}
+
+/* Remove the least recently used divider, i.e., the chronologically first
+ * entry of the cache (hits are moved to the end). */
+static void
+evict_div_cache (BtorAIGVecMgr *avmgr)
+{
+  BtorAIGVec *key;
+  BtorHashTableData data;
+
+  assert (avmgr->div_cache);
+  assert (avmgr->div_cache->first);
+  key = avmgr->div_cache->first->key;
+  btor_hashptr_table_remove (avmgr->div_cache, key, 0, &data);
+  btor_aigvec_release_delete (avmgr, key);
+  btor_aigvec_release_delete (avmgr, data.as_ptr);
+}
+
+/* Compute quotient and remainder of a / b. Since udiv and urem on the same
+ * operands usually both occur, the divider is cached and shared between all
+ * divisions on the same operands. The cache holds references to the operands
+ * and results of up to BTOR_AIGVEC_DIV_CACHE_SIZE dividers, which are evicted
+ * in least recently used order. */
+static void
+udiv_urem_shared_aigvec (BtorAIGVecMgr *avmgr,
+                         BtorAIGVec *a,
+                         BtorAIGVec *b,
+                         BtorAIGVec **Qptr,
+                         BtorAIGVec **Rptr)
+{
+  assert (avmgr);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (a->width > 0);
+
+  BtorMemMgr *mm;
+  BtorAIGVec *key, *ckey, *qr;
+  BtorHashTableData data;
+  uint32_t width;
+
+  mm    = avmgr->btor->mm;
+  width = a->width;
+  key   = btor_aigvec_concat (avmgr, a, b);
+
+  if (avmgr->div_cache && btor_hashptr_table_get (avmgr->div_cache, key))
+  {
+    /* move to the end of the chronological order */
+    btor_hashptr_table_remove (avmgr->div_cache, key, (void **) &ckey, &data);
+    btor_hashptr_table_add (avmgr->div_cache, ckey)->data = data;
+    qr    = data.as_ptr;
+    *Qptr = btor_aigvec_slice (avmgr, qr, 2 * width - 1, width);
+    *Rptr = btor_aigvec_slice (avmgr, qr, width - 1, 0);
+    btor_aigvec_release_delete (avmgr, key);
+    return;
+  }
+
+  /* the circuit simplifies for constant divisors */
+  if (btor_opt_get (avmgr->btor, BTOR_OPT_DIV_ENC) == BTOR_DIV_ENC_CONSTRAINT
+      && !is_const_aigvec (b) && btor_sat_is_initialized (avmgr->amgr->smgr))
+    udiv_urem_constraint_aigvec (avmgr, a, b, Qptr, Rptr);
+  else
+    udiv_urem_aigvec (avmgr, a, b, Qptr, Rptr);
+
+  if (avmgr->div_cache
+      && avmgr->div_cache->count >= BTOR_AIGVEC_DIV_CACHE_SIZE)
+    evict_div_cache (avmgr);
+  if (!avmgr->div_cache)
+    avmgr->div_cache = btor_hashptr_table_new (
+        mm, (BtorHashPtr) hash_aigvec, (BtorCmpPtr) compare_aigvec);
+  btor_hashptr_table_add (avmgr->div_cache, key)->data.as_ptr =
+      btor_aigvec_concat (avmgr, *Qptr, *Rptr);
+}
+
 BtorAIGVec *
 btor_aigvec_udiv (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
 {
@@ -578,7 +1236,7 @@ btor_aigvec_udiv (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
   assert (av2);
   assert (av1->width == av2->width);
   assert (av1->width > 0);
-  udiv_urem_aigvec (avmgr, av1, av2, &quotient, &remainder);
+  udiv_urem_shared_aigvec (avmgr, av1, av2, &quotient, &remainder);
   btor_aigvec_release_delete (avmgr, remainder);
   return quotient;
 }
@@ -592,7 +1250,7 @@ btor_aigvec_urem (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
   assert (av2);
   assert (av1->width == av2->width);
   assert (av1->width > 0);
-  udiv_urem_aigvec (avmgr, av1, av2, &quotient, &remainder);
+  udiv_urem_shared_aigvec (avmgr, av1, av2, &quotient, &remainder);
   btor_aigvec_release_delete (avmgr, quotient);
   return remainder;
 }
@@ -683,15 +1341,11 @@ btor_aigvec_clone (BtorAIGVec *av, BtorAIGVecMgr *avmgr)
     {
       aig = av->aigs[i];
       assert (BTOR_REAL_ADDR_AIG (aig)->id >= 0);
-      assert ((size_t) BTOR_REAL_ADDR_AIG (aig)->id
-              < BTOR_COUNT_STACK (amgr->id2aig));
-      caig = BTOR_PEEK_STACK (amgr->id2aig, BTOR_REAL_ADDR_AIG (aig)->id);
+      assert (BTOR_REAL_ADDR_AIG (aig)->id < amgr->num_ids);
+      caig = btor_aig_get_by_id (amgr, btor_aig_get_id (aig));
       assert (caig);
       assert (!btor_aig_is_const (caig));
-      if (BTOR_IS_INVERTED_AIG (aig))
-        res->aigs[i] = BTOR_INVERT_AIG (caig);
-      else
-        res->aigs[i] = caig;
+      res->aigs[i] = caig;
       assert (res->aigs[i]);
     }
   }
@@ -711,6 +1365,28 @@ btor_aigvec_to_sat_tseitin (BtorAIGVecMgr *avmgr, BtorAIGVec *av)
   for (i = 0; i < width; i++) btor_aig_to_sat_tseitin (amgr, av->aigs[i]);
 }
 
+void
+btor_aigvec_optimize (BtorAIGVecMgr *avmgr, BtorAIGVec **avs, uint32_t n)
+{
+  assert (avmgr);
+  assert (avs);
+
+  BtorAIGPtrStack aigs;
+  uint32_t i, j, k;
+
+  if (!btor_sat_is_initialized (avmgr->amgr->smgr)) return;
+
+  /* optimize all vectors at once to preserve sharing between them */
+  BTOR_INIT_STACK (avmgr->btor->mm, aigs);
+  for (i = 0; i < n; i++)
+    for (j = 0; j < avs[i]->width; j++) BTOR_PUSH_STACK (aigs, avs[i]->aigs[j]);
+  btor_aig_optimize (avmgr->amgr, aigs.start, BTOR_COUNT_STACK (aigs));
+  for (i = 0, k = 0; i < n; i++)
+    for (j = 0; j < avs[i]->width; j++)
+      avs[i]->aigs[j] = aigs.start[k++];
+  BTOR_RELEASE_STACK (aigs);
+}
+
 void
 btor_aigvec_release_delete (BtorAIGVecMgr *avmgr, BtorAIGVec *av)
 {
@@ -740,6 +1416,24 @@ btor_aigvec_mgr_new (Btor *btor)
   return avmgr;
 }
 
+static void *
+clone_key_as_aigvec (BtorMemMgr *mm, const void *map, const void *key)
+{
+  (void) mm;
+  return btor_aigvec_clone ((BtorAIGVec *) key, (BtorAIGVecMgr *) map);
+}
+
+static void
+clone_data_as_aigvec (BtorMemMgr *mm,
+                      const void *map,
+                      BtorHashTableData *data,
+                      BtorHashTableData *cloned_data)
+{
+  (void) mm;
+  cloned_data->as_ptr =
+      btor_aigvec_clone ((BtorAIGVec *) data->as_ptr, (BtorAIGVecMgr *) map);
+}
+
 BtorAIGVecMgr *
 btor_aigvec_mgr_clone (Btor *btor, BtorAIGVecMgr *avmgr)
 {
@@ -753,6 +1447,14 @@ btor_aigvec_mgr_clone (Btor *btor, BtorAIGVecMgr *avmgr)
   res->amgr            = btor_aig_mgr_clone (btor, avmgr->amgr);
   res->max_num_aigvecs = avmgr->max_num_aigvecs;
   res->cur_num_aigvecs = avmgr->cur_num_aigvecs;
+  res->div_cache       = 0;
+  if (avmgr->div_cache)
+    res->div_cache = btor_hashptr_table_clone (btor->mm,
+                                               avmgr->div_cache,
+                                               clone_key_as_aigvec,
+                                               clone_data_as_aigvec,
+                                               res,
+                                               res);
   return res;
 }
 
@@ -760,6 +1462,7 @@ void
 btor_aigvec_mgr_delete (BtorAIGVecMgr *avmgr)
 {
   assert (avmgr);
+  flush_div_cache (avmgr);
   btor_aig_mgr_delete (avmgr->amgr);
   BTOR_DELETE (avmgr->btor->mm, avmgr);
 }
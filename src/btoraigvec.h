@@ -16,6 +16,7 @@
 #include "btorbv.h"
 #include "btoropt.h"
 #include "btortypes.h"
+#include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 
 struct BtorAIGMap;
@@ -30,6 +31,8 @@ struct BtorAIGVec
 
 typedef struct BtorAIGVec BtorAIGVec;
 
+BTOR_DECLARE_STACK (BtorAIGVecPtr, BtorAIGVec *);
+
 typedef struct BtorAIGVecMgr BtorAIGVecMgr;
 
 struct BtorAIGVecMgr
@@ -38,6 +41,10 @@ struct BtorAIGVecMgr
   BtorAIGMgr *amgr;
   uint_least64_t max_num_aigvecs;
   uint_least64_t cur_num_aigvecs;
+  /* shared divider circuits, maps concatenated operands a::b to the
+   * concatenated quotient and remainder q::r, created on demand, in least
+   * recently used order */
+  BtorPtrHashTable *div_cache;
 };
 
 /*------------------------------------------------------------------------*/
@@ -182,6 +189,12 @@ BtorAIGVec *btor_aigvec_clone (BtorAIGVec *av, BtorAIGVecMgr *avmgr);
 /* Translates every AIG of the AIG vector into SAT in both phases  */
 void btor_aigvec_to_sat_tseitin (BtorAIGVecMgr *avmgr, BtorAIGVec *av);
 
+/* Optimize the not yet encoded AIGs of the AIG vectors 'avs' prior to
+ * encoding them into SAT (see btor_aig_optimize). */
+void btor_aigvec_optimize (BtorAIGVecMgr *avmgr,
+                           BtorAIGVec **avs,
+                           uint32_t n);
+
 /* Release all AIGs of the AIG vector and delete AIG vector from memory. */
 void btor_aigvec_release_delete (BtorAIGVecMgr *avmgr, BtorAIGVec *av);
 #endif
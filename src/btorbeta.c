@@ -23,7 +23,7 @@
 
 static void
 cache_beta_result (Btor *btor,
-                   BtorPtrHashTable *cache,
+                   BtorPtrHashMap *cache,
                    BtorNode *lambda,
                    BtorNode *exp,
                    BtorNode *result)
@@ -40,17 +40,17 @@ cache_beta_result (Btor *btor,
   assert (btor_node_is_lambda (lambda));
 
   BtorNodePair *pair;
-  BtorPtrHashBucket *bucket;
+  BtorPtrHashMapEntry *entry;
 
-  pair   = btor_node_pair_new (btor, lambda, exp);
-  bucket = btor_hashptr_table_get (cache, pair);
-  if (bucket)
+  pair  = btor_node_pair_new (btor, lambda, exp);
+  entry = btor_hashptrmap_get (cache, pair);
+  if (entry)
   {
     btor_node_pair_delete (btor, pair);
-    assert ((BtorNode *) bucket->data.as_ptr == result);
+    assert ((BtorNode *) entry->data.as_ptr == result);
   }
   else
-    btor_hashptr_table_add (cache, pair)->data.as_ptr =
+    btor_hashptrmap_add (cache, pair)->data.as_ptr =
         btor_node_copy (btor, result);
   BTORLOG (3,
            "%s: (%s, %s) -> %s",
@@ -62,7 +62,7 @@ cache_beta_result (Btor *btor,
 
 static BtorNode *
 cached_beta_result (Btor *btor,
-                    BtorPtrHashTable *cache,
+                    BtorPtrHashMap *cache,
                     BtorNode *lambda,
                     BtorNode *exp)
 {
@@ -73,21 +73,21 @@ cached_beta_result (Btor *btor,
   assert (btor_node_is_lambda (lambda));
 
   BtorNodePair *pair;
-  BtorPtrHashBucket *bucket;
+  BtorPtrHashMapEntry *entry;
 
-  pair   = btor_node_pair_new (btor, lambda, exp);
-  bucket = btor_hashptr_table_get (cache, pair);
+  pair  = btor_node_pair_new (btor, lambda, exp);
+  entry = btor_hashptrmap_get (cache, pair);
   btor_node_pair_delete (btor, pair);
 
-  if (bucket)
+  if (entry)
   {
     BTORLOG (3,
              "%s: (%s, %s) -> %s",
              __FUNCTION__,
              btor_util_node2string (lambda),
              btor_util_node2string (exp),
-             btor_util_node2string (bucket->data.as_ptr));
-    return (BtorNode *) bucket->data.as_ptr;
+             btor_util_node2string (entry->data.as_ptr));
+    return (BtorNode *) entry->data.as_ptr;
   }
 
   return 0;
@@ -172,7 +172,7 @@ beta_reduce (Btor *btor,
              int32_t mode,
              int32_t bound,
              BtorPtrHashTable *merge_lambdas,
-             BtorPtrHashTable *cache)
+             BtorPtrHashMap *cache)
 {
   assert (btor);
   assert (exp);
@@ -894,7 +894,7 @@ beta_reduce_partial_aux (Btor *btor,
 }
 
 BtorNode *
-btor_beta_reduce_full (Btor *btor, BtorNode *exp, BtorPtrHashTable *cache)
+btor_beta_reduce_full (Btor *btor, BtorNode *exp, BtorPtrHashMap *cache)
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
   return beta_reduce (btor, exp, BETA_RED_FULL, 0, 0, cache);
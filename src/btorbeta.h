@@ -13,10 +13,11 @@
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
+#include "utils/btorhashptrmap.h"
 
 BtorNode* btor_beta_reduce_full (Btor* btor,
                                  BtorNode* exp,
-                                 BtorPtrHashTable* cache);
+                                 BtorPtrHashMap* cache);
 
 BtorNode* btor_beta_reduce_merge (Btor* btor,
                                   BtorNode* exp,
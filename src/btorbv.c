@@ -43,7 +43,7 @@ check_bits_sll_dbg (const BtorBitVector *bv,
 
   if (shift >= bv->width)
   {
-    for (i = 0; i < bv->width; i++) assert (btor_bv_get_bit (bv, i) == 0);
+    for (i = 0; i < bv->width; i++) assert (btor_bv_get_bit (res, i) == 0);
   }
   else
   {
@@ -62,6 +62,451 @@ set_rem_bits_to_zero (BtorBitVector *bv)
     bv->bits[0] &= BTOR_MASK_REM_BITS (bv);
 }
 
+/*------------------------------------------------------------------------*/
+/* Kernels for bitwise operations, comparison and hashing on arrays of 'n'
+ * chunks. Bit vectors with less than BTOR_BV_SIMD_MIN_LEN chunks do not go
+ * through the kernel table, the call overhead does not pay off there. */
+
+typedef struct BtorBVKernels BtorBVKernels;
+
+struct BtorBVKernels
+{
+  const char *name;
+  void (*bv_and) (BTOR_BV_TYPE *, const BTOR_BV_TYPE *, const BTOR_BV_TYPE *,
+                  uint32_t);
+  void (*bv_or) (BTOR_BV_TYPE *, const BTOR_BV_TYPE *, const BTOR_BV_TYPE *,
+                 uint32_t);
+  void (*bv_xor) (BTOR_BV_TYPE *, const BTOR_BV_TYPE *, const BTOR_BV_TYPE *,
+                  uint32_t);
+  void (*bv_not) (BTOR_BV_TYPE *, const BTOR_BV_TYPE *, uint32_t);
+  /* Index of the first chunk on which both arrays differ, 'n' if equal. */
+  uint32_t (*mismatch) (const BTOR_BV_TYPE *, const BTOR_BV_TYPE *, uint32_t);
+  /* True if all chunks are equal to 'v'. */
+  bool (*all_eq) (const BTOR_BV_TYPE *, uint32_t, BTOR_BV_TYPE v);
+  /* Hash 'n' / BTOR_BV_HASH_BLOCK blocks of chunks into independent 32-bit
+   * lanes. */
+  void (*hash) (const BTOR_BV_TYPE *, uint32_t, uint32_t *);
+};
+
+/* Lane j of a hash block is the lower (j even) resp. upper (j odd) 32 bits
+ * of chunk j / 2 of the block. */
+#define BTOR_BV_HASH_BLOCK 8
+#define BTOR_BV_HASH_LANES (2 * BTOR_BV_HASH_BLOCK)
+
+static const uint32_t hash_lane_primes[BTOR_BV_HASH_LANES] = {
+    2654435761u, 2246822519u, 3266489917u, 668265263u,
+    374761393u,  3141592661u, 1610612741u, 805306457u,
+    402653189u,  201326611u,  100663319u,  50331653u,
+    25165843u,   12582917u,   6291469u,    3145739u};
+
+static void
+and_scalar (BTOR_BV_TYPE *d,
+            const BTOR_BV_TYPE *a,
+            const BTOR_BV_TYPE *b,
+            uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) d[i] = a[i] & b[i];
+}
+
+static void
+or_scalar (BTOR_BV_TYPE *d,
+           const BTOR_BV_TYPE *a,
+           const BTOR_BV_TYPE *b,
+           uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) d[i] = a[i] | b[i];
+}
+
+static void
+xor_scalar (BTOR_BV_TYPE *d,
+            const BTOR_BV_TYPE *a,
+            const BTOR_BV_TYPE *b,
+            uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) d[i] = a[i] ^ b[i];
+}
+
+static void
+not_scalar (BTOR_BV_TYPE *d, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) d[i] = ~a[i];
+}
+
+static uint32_t
+mismatch_scalar (const BTOR_BV_TYPE *a, const BTOR_BV_TYPE *b, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n && a[i] == b[i]; i++)
+    ;
+  return i;
+}
+
+static bool
+all_eq_scalar (const BTOR_BV_TYPE *a, uint32_t n, BTOR_BV_TYPE v)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++)
+    if (a[i] != v) return false;
+  return true;
+}
+
+static void
+hash_scalar (const BTOR_BV_TYPE *a, uint32_t n, uint32_t *h)
+{
+  uint32_t i, j, x;
+  for (i = 0; i + BTOR_BV_HASH_BLOCK <= n; i += BTOR_BV_HASH_BLOCK)
+    for (j = 0; j < BTOR_BV_HASH_LANES; j++)
+    {
+      x    = (uint32_t) (a[i + j / 2] >> (j & 1 ? 32 : 0));
+      x    = (h[j] ^ x) * hash_lane_primes[j];
+      h[j] = x ^ (x >> 15);
+    }
+}
+
+static const BtorBVKernels kernels_scalar = {"scalar",
+                                             and_scalar,
+                                             or_scalar,
+                                             xor_scalar,
+                                             not_scalar,
+                                             mismatch_scalar,
+                                             all_eq_scalar,
+                                             hash_scalar};
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BTOR_BV_SIMD_X86
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#define BTOR_BV_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef BTOR_BV_SIMD_X86
+
+/* SSE2 is part of the x86-64 baseline, AVX2 is checked for at runtime. There
+ * is no 32-bit multiplication in SSE2, hashing falls back to scalar code. */
+
+#define BTOR_BV_SSE2_BINOP(name, op)                                      \
+  static void name##_sse2 (BTOR_BV_TYPE *d,                               \
+                           const BTOR_BV_TYPE *a,                         \
+                           const BTOR_BV_TYPE *b,                         \
+                           uint32_t n)                                    \
+  {                                                                       \
+    uint32_t i;                                                           \
+    for (i = 0; i + 2 <= n; i += 2)                                       \
+      _mm_storeu_si128 ((__m128i *) (d + i),                              \
+                        op (_mm_loadu_si128 ((const __m128i *) (a + i)),  \
+                            _mm_loadu_si128 ((const __m128i *) (b + i)))); \
+    name##_scalar (d + i, a + i, b + i, n - i);                           \
+  }
+
+BTOR_BV_SSE2_BINOP (and, _mm_and_si128)
+BTOR_BV_SSE2_BINOP (or, _mm_or_si128)
+BTOR_BV_SSE2_BINOP (xor, _mm_xor_si128)
+
+static void
+not_sse2 (BTOR_BV_TYPE *d, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m128i ones = _mm_set1_epi32 (-1);
+  for (i = 0; i + 2 <= n; i += 2)
+    _mm_storeu_si128 (
+        (__m128i *) (d + i),
+        _mm_xor_si128 (_mm_loadu_si128 ((const __m128i *) (a + i)), ones));
+  not_scalar (d + i, a + i, n - i);
+}
+
+static uint32_t
+mismatch_sse2 (const BTOR_BV_TYPE *a, const BTOR_BV_TYPE *b, uint32_t n)
+{
+  uint32_t i, m;
+  for (i = 0; i + 2 <= n; i += 2)
+  {
+    m = _mm_movemask_epi8 (
+        _mm_cmpeq_epi32 (_mm_loadu_si128 ((const __m128i *) (a + i)),
+                         _mm_loadu_si128 ((const __m128i *) (b + i))));
+    if (m != 0xffff) return (m & 0xff) != 0xff ? i : i + 1;
+  }
+  return i + mismatch_scalar (a + i, b + i, n - i);
+}
+
+static bool
+all_eq_sse2 (const BTOR_BV_TYPE *a, uint32_t n, BTOR_BV_TYPE v)
+{
+  uint32_t i;
+  __m128i vv = _mm_set1_epi64x ((long long) v);
+  for (i = 0; i + 2 <= n; i += 2)
+    if (_mm_movemask_epi8 (_mm_cmpeq_epi32 (
+            _mm_loadu_si128 ((const __m128i *) (a + i)), vv))
+        != 0xffff)
+      return false;
+  return all_eq_scalar (a + i, n - i, v);
+}
+
+static const BtorBVKernels kernels_sse2 = {"sse2",
+                                           and_sse2,
+                                           or_sse2,
+                                           xor_sse2,
+                                           not_sse2,
+                                           mismatch_sse2,
+                                           all_eq_sse2,
+                                           hash_scalar};
+
+#define BTOR_BV_AVX2 __attribute__ ((target ("avx2")))
+
+#define BTOR_BV_AVX2_BINOP(name, op)                                      \
+  BTOR_BV_AVX2 static void name##_avx2 (BTOR_BV_TYPE *d,                  \
+                                        const BTOR_BV_TYPE *a,            \
+                                        const BTOR_BV_TYPE *b,            \
+                                        uint32_t n)                       \
+  {                                                                       \
+    uint32_t i;                                                           \
+    for (i = 0; i + 4 <= n; i += 4)                                       \
+      _mm256_storeu_si256 (                                               \
+          (__m256i *) (d + i),                                            \
+          op (_mm256_loadu_si256 ((const __m256i *) (a + i)),             \
+              _mm256_loadu_si256 ((const __m256i *) (b + i))));           \
+    name##_scalar (d + i, a + i, b + i, n - i);                           \
+  }
+
+BTOR_BV_AVX2_BINOP (and, _mm256_and_si256)
+BTOR_BV_AVX2_BINOP (or, _mm256_or_si256)
+BTOR_BV_AVX2_BINOP (xor, _mm256_xor_si256)
+
+BTOR_BV_AVX2 static void
+not_avx2 (BTOR_BV_TYPE *d, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m256i ones = _mm256_set1_epi32 (-1);
+  for (i = 0; i + 4 <= n; i += 4)
+    _mm256_storeu_si256 (
+        (__m256i *) (d + i),
+        _mm256_xor_si256 (_mm256_loadu_si256 ((const __m256i *) (a + i)),
+                          ones));
+  not_scalar (d + i, a + i, n - i);
+}
+
+BTOR_BV_AVX2 static uint32_t
+mismatch_avx2 (const BTOR_BV_TYPE *a, const BTOR_BV_TYPE *b, uint32_t n)
+{
+  uint32_t i, m;
+  for (i = 0; i + 4 <= n; i += 4)
+  {
+    m = (uint32_t) _mm256_movemask_epi8 (
+        _mm256_cmpeq_epi64 (_mm256_loadu_si256 ((const __m256i *) (a + i)),
+                            _mm256_loadu_si256 ((const __m256i *) (b + i))));
+    if (m != 0xffffffffu) return i + __builtin_ctz (~m) / 8;
+  }
+  return i + mismatch_scalar (a + i, b + i, n - i);
+}
+
+BTOR_BV_AVX2 static bool
+all_eq_avx2 (const BTOR_BV_TYPE *a, uint32_t n, BTOR_BV_TYPE v)
+{
+  uint32_t i;
+  __m256i vv = _mm256_set1_epi64x ((long long) v), x;
+  for (i = 0; i + 4 <= n; i += 4)
+  {
+    x = _mm256_xor_si256 (_mm256_loadu_si256 ((const __m256i *) (a + i)), vv);
+    if (!_mm256_testz_si256 (x, x)) return false;
+  }
+  return all_eq_scalar (a + i, n - i, v);
+}
+
+BTOR_BV_AVX2 static void
+hash_avx2 (const BTOR_BV_TYPE *a, uint32_t n, uint32_t *h)
+{
+  uint32_t i;
+  __m256i x0, x1, h0, h1, p0, p1;
+  h0 = _mm256_loadu_si256 ((const __m256i *) h);
+  h1 = _mm256_loadu_si256 ((const __m256i *) (h + 8));
+  p0 = _mm256_loadu_si256 ((const __m256i *) hash_lane_primes);
+  p1 = _mm256_loadu_si256 ((const __m256i *) (hash_lane_primes + 8));
+  for (i = 0; i + BTOR_BV_HASH_BLOCK <= n; i += BTOR_BV_HASH_BLOCK)
+  {
+    x0 = _mm256_loadu_si256 ((const __m256i *) (a + i));
+    x1 = _mm256_loadu_si256 ((const __m256i *) (a + i + 4));
+    x0 = _mm256_mullo_epi32 (_mm256_xor_si256 (h0, x0), p0);
+    x1 = _mm256_mullo_epi32 (_mm256_xor_si256 (h1, x1), p1);
+    h0 = _mm256_xor_si256 (x0, _mm256_srli_epi32 (x0, 15));
+    h1 = _mm256_xor_si256 (x1, _mm256_srli_epi32 (x1, 15));
+  }
+  _mm256_storeu_si256 ((__m256i *) h, h0);
+  _mm256_storeu_si256 ((__m256i *) (h + 8), h1);
+}
+
+static const BtorBVKernels kernels_avx2 = {"avx2",
+                                           and_avx2,
+                                           or_avx2,
+                                           xor_avx2,
+                                           not_avx2,
+                                           mismatch_avx2,
+                                           all_eq_avx2,
+                                           hash_avx2};
+#endif
+
+#ifdef BTOR_BV_SIMD_NEON
+
+#define BTOR_BV_NEON_BINOP(name, op)                                        \
+  static void name##_neon (BTOR_BV_TYPE *d,                                 \
+                           const BTOR_BV_TYPE *a,                           \
+                           const BTOR_BV_TYPE *b,                           \
+                           uint32_t n)                                      \
+  {                                                                         \
+    uint32_t i;                                                             \
+    for (i = 0; i + 2 <= n; i += 2)                                         \
+      vst1q_u64 (d + i, op (vld1q_u64 (a + i), vld1q_u64 (b + i)));         \
+    name##_scalar (d + i, a + i, b + i, n - i);                             \
+  }
+
+BTOR_BV_NEON_BINOP (and, vandq_u64)
+BTOR_BV_NEON_BINOP (or, vorrq_u64)
+BTOR_BV_NEON_BINOP (xor, veorq_u64)
+
+static void
+not_neon (BTOR_BV_TYPE *d, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 2 <= n; i += 2)
+    vst1q_u64 (d + i,
+               vreinterpretq_u64_u32 (
+                   vmvnq_u32 (vreinterpretq_u32_u64 (vld1q_u64 (a + i)))));
+  not_scalar (d + i, a + i, n - i);
+}
+
+static uint32_t
+mismatch_neon (const BTOR_BV_TYPE *a, const BTOR_BV_TYPE *b, uint32_t n)
+{
+  uint32_t i;
+  uint64x2_t x;
+  for (i = 0; i + 2 <= n; i += 2)
+  {
+    x = veorq_u64 (vld1q_u64 (a + i), vld1q_u64 (b + i));
+    if (vgetq_lane_u64 (x, 0)) return i;
+    if (vgetq_lane_u64 (x, 1)) return i + 1;
+  }
+  return i + mismatch_scalar (a + i, b + i, n - i);
+}
+
+static bool
+all_eq_neon (const BTOR_BV_TYPE *a, uint32_t n, BTOR_BV_TYPE v)
+{
+  uint32_t i;
+  uint64x2_t vv = vdupq_n_u64 (v), x;
+  for (i = 0; i + 2 <= n; i += 2)
+  {
+    x = veorq_u64 (vld1q_u64 (a + i), vv);
+    if (vgetq_lane_u64 (x, 0) | vgetq_lane_u64 (x, 1)) return false;
+  }
+  return all_eq_scalar (a + i, n - i, v);
+}
+
+static void
+hash_neon (const BTOR_BV_TYPE *a, uint32_t n, uint32_t *h)
+{
+  uint32_t i, j;
+  uint32x4_t x[4], hv[4], pv[4];
+  for (j = 0; j < 4; j++)
+  {
+    hv[j] = vld1q_u32 (h + 4 * j);
+    pv[j] = vld1q_u32 (hash_lane_primes + 4 * j);
+  }
+  for (i = 0; i + BTOR_BV_HASH_BLOCK <= n; i += BTOR_BV_HASH_BLOCK)
+    for (j = 0; j < 4; j++)
+    {
+      x[j]  = vreinterpretq_u32_u64 (vld1q_u64 (a + i + 2 * j));
+      x[j]  = vmulq_u32 (veorq_u32 (hv[j], x[j]), pv[j]);
+      hv[j] = veorq_u32 (x[j], vshrq_n_u32 (x[j], 15));
+    }
+  for (j = 0; j < 4; j++) vst1q_u32 (h + 4 * j, hv[j]);
+}
+
+static const BtorBVKernels kernels_neon = {"neon",
+                                           and_neon,
+                                           or_neon,
+                                           xor_neon,
+                                           not_neon,
+                                           mismatch_neon,
+                                           all_eq_neon,
+                                           hash_neon};
+#endif
+
+static const BtorBVKernels *kernels_best;
+static const BtorBVKernels *kernels;
+
+static const BtorBVKernels *
+select_kernels (void)
+{
+#if defined(BTOR_BV_SIMD_X86)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2")) return &kernels_avx2;
+  return &kernels_sse2;
+#elif defined(BTOR_BV_SIMD_NEON)
+  return &kernels_neon;
+#else
+  return &kernels_scalar;
+#endif
+}
+
+/* Selected lazily on first use. Concurrent initialization is harmless since
+ * all threads select the same kernels. */
+static inline const BtorBVKernels *
+get_kernels (void)
+{
+  if (!kernels)
+  {
+    if (!kernels_best) kernels_best = select_kernels ();
+    kernels = kernels_best;
+  }
+  return kernels;
+}
+
+const char *
+btor_bv_simd_kernels (void)
+{
+  return get_kernels ()->name;
+}
+
+void
+btor_bv_simd_enable (bool enable)
+{
+  if (!kernels_best) kernels_best = select_kernels ();
+  kernels = enable ? kernels_best : &kernels_scalar;
+}
+
+/* Fill all chunks of 'bv' with random bits, spare bits are zeroed out. */
+static void
+set_random_bits (BtorRNG *rng, BtorBitVector *bv)
+{
+  uint32_t i;
+
+  for (i = 0; i < bv->len; i++)
+    bv->bits[i] = ((BTOR_BV_TYPE) btor_rng_rand (rng) << 32)
+                  | (BTOR_BV_TYPE) btor_rng_rand (rng);
+  set_rem_bits_to_zero (bv);
+}
+
+/* Get the BTOR_BV_TYPE_BW bits of 'bv' starting at bit index 'pos' (index 0
+ * is LSB), bits beyond the MSB of 'bv' are zero. */
+static BTOR_BV_TYPE
+get_chunk (const BtorBitVector *bv, uint32_t pos)
+{
+  assert (pos < bv->width);
+
+  uint32_t i, j;
+  BTOR_BV_TYPE res;
+
+  i   = pos / BTOR_BV_TYPE_BW;
+  j   = pos % BTOR_BV_TYPE_BW;
+  res = bv->bits[bv->len - 1 - i] >> j;
+  if (j && i + 1 < bv->len)
+    res |= bv->bits[bv->len - 2 - i] << (BTOR_BV_TYPE_BW - j);
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 BtorBitVector *
@@ -102,6 +547,20 @@ btor_bv_new_random_range (BtorMemMgr *mm,
   assert (btor_bv_compare (from, to) <= 0);
 
   BtorBitVector *res, *resext, *fromext, *toext, *tmp1, *tmp2;
+  uint64_t r, f, t;
+
+  if (bw < BTOR_BV_TYPE_BW)
+  {
+    /* to + 1 - from can not overflow */
+    res = btor_bv_new (mm, bw);
+    set_random_bits (rng, res);
+    r = btor_bv_to_uint64 (res);
+    f = btor_bv_to_uint64 (from);
+    t = btor_bv_to_uint64 (to);
+    res->bits[0] = f + r % (t + 1 - f);
+    assert (rem_bits_zero_dbg (res));
+    return res;
+  }
 
   /* we allow to = 1...1 */
   fromext = btor_bv_uext (mm, from, 1);
@@ -145,16 +604,12 @@ btor_bv_new_random_bit_range (
   BtorBitVector *res;
 
   res = btor_bv_new (mm, bw);
-  for (i = 1; i < res->len; i++)
-    res->bits[i] = (BTOR_BV_TYPE) btor_rng_rand (rng);
-  res->bits[0] = (BTOR_BV_TYPE) btor_rng_pick_rand (
-      rng, 0, ((~0) >> (BTOR_BV_TYPE_BW - bw % BTOR_BV_TYPE_BW)) - 1);
+  set_random_bits (rng, res);
 
   for (i = 0; i < lo; i++) btor_bv_set_bit (res, i, 0);
   for (i = up + 1; i < res->width; i++) btor_bv_set_bit (res, i, 0);
 
-  set_rem_bits_to_zero (res);
-
+  assert (rem_bits_zero_dbg (res));
   return res;
 }
 
@@ -187,8 +642,6 @@ btor_bv_uint64_to_bv (BtorMemMgr *mm, uint64_t value, uint32_t bw)
   res = btor_bv_new (mm, bw);
   assert (res->len > 0);
   res->bits[res->len - 1] = (BTOR_BV_TYPE) value;
-  if (res->width > 32)
-    res->bits[res->len - 2] = (BTOR_BV_TYPE) (value >> BTOR_BV_TYPE_BW);
 
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
@@ -201,7 +654,8 @@ btor_bv_int64_to_bv (BtorMemMgr *mm, int64_t value, uint32_t bw)
   assert (mm);
   assert (bw > 0);
 
-  BtorBitVector *res, *tmp;
+  uint32_t i;
+  BtorBitVector *res;
 
   res = btor_bv_new (mm, bw);
   assert (res->len > 0);
@@ -209,14 +663,10 @@ btor_bv_int64_to_bv (BtorMemMgr *mm, int64_t value, uint32_t bw)
   /* ensure that all bits > 64 are set to 1 in case of negative values */
   if (value < 0 && bw > 64)
   {
-    tmp = btor_bv_not (mm, res);
-    btor_bv_free (mm, res);
-    res = tmp;
+    for (i = 0; i < res->len - 1; i++) res->bits[i] = ~(BTOR_BV_TYPE) 0;
   }
 
   res->bits[res->len - 1] = (BTOR_BV_TYPE) value;
-  if (res->width > 32)
-    res->bits[res->len - 2] = (BTOR_BV_TYPE) (value >> BTOR_BV_TYPE_BW);
 
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
@@ -365,6 +815,24 @@ btor_bv_copy (BtorMemMgr *mm, const BtorBitVector *bv)
   return res;
 }
 
+BtorBitVector *
+btor_bv_init_inline (BtorBitVectorInline *ibv, uint64_t value, uint32_t bw)
+{
+  assert (ibv);
+  assert (bw > 0);
+  assert (bw <= BTOR_BV_TYPE_BW);
+
+  BtorBitVector *res;
+
+  res          = &ibv->bv;
+  res->width   = bw;
+  res->len     = 1;
+  res->bits[0] = (BTOR_BV_TYPE) value;
+  set_rem_bits_to_zero (res);
+  assert (rem_bits_zero_dbg (res));
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 size_t
@@ -394,8 +862,11 @@ btor_bv_compare (const BtorBitVector *a, const BtorBitVector *b)
   if (a->width != b->width) return -1;
 
   /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
+  if (a->len >= BTOR_BV_SIMD_MIN_LEN)
+    i = get_kernels ()->mismatch (a->bits, b->bits, a->len);
+  else
+    for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
+      ;
 
   if (i == a->len) return 0;
 
@@ -414,19 +885,39 @@ btor_bv_hash (const BtorBitVector *bv)
 {
   assert (bv);
 
-  uint32_t res = 0, i, j = 0, x, p0, p1;
+  uint32_t res = 0, i, j = 0, k, x, p0, p1, n, h[BTOR_BV_HASH_LANES];
 
   res = bv->width * hash_primes[j++];
-  for (i = 0, j = 0; i < bv->len; i++)
+  i   = 0;
+  /* hash blocks of chunks in independent lanes, fold the lanes into 'res'
+   * and hash the remaining chunks sequentially */
+  if (bv->len >= BTOR_BV_HASH_BLOCK)
   {
-    p0 = hash_primes[j++];
-    if (j == NPRIMES) j = 0;
-    p1 = hash_primes[j++];
-    if (j == NPRIMES) j = 0;
-    x   = bv->bits[i] ^ res;
-    x   = ((x >> 16) ^ x) * p0;
-    x   = ((x >> 16) ^ x) * p1;
-    res = ((x >> 16) ^ x);
+    n = bv->len - bv->len % BTOR_BV_HASH_BLOCK;
+    for (k = 0; k < BTOR_BV_HASH_LANES; k++) h[k] = res + k;
+    get_kernels ()->hash (bv->bits, n, h);
+    for (k = 0; k < BTOR_BV_HASH_LANES; k++)
+    {
+      x   = h[k] ^ res;
+      x   = ((x >> 16) ^ x) * hash_primes[k % NPRIMES];
+      res = ((x >> 16) ^ x);
+    }
+    i = n;
+  }
+  for (j = 0; i < bv->len; i++)
+  {
+    /* hash upper and lower 32 bits of each chunk separately */
+    for (k = 0; k < 2; k++)
+    {
+      p0 = hash_primes[j++];
+      if (j == NPRIMES) j = 0;
+      p1 = hash_primes[j++];
+      if (j == NPRIMES) j = 0;
+      x   = (uint32_t) (k ? bv->bits[i] : bv->bits[i] >> 32) ^ res;
+      x   = ((x >> 16) ^ x) * p0;
+      x   = ((x >> 16) ^ x) * p1;
+      res = ((x >> 16) ^ x);
+    }
   }
   return res;
 }
@@ -597,16 +1088,9 @@ btor_bv_to_uint64 (const BtorBitVector *bv)
 {
   assert (bv);
   assert (bv->width <= sizeof (uint64_t) * 8);
-  assert (bv->len <= 2);
-
-  uint32_t i;
-  uint64_t res;
-
-  res = 0;
-  for (i = 0; i < bv->len; i++)
-    res |= ((uint64_t) bv->bits[i]) << (BTOR_BV_TYPE_BW * (bv->len - 1 - i));
+  assert (bv->len == 1);
 
-  return res;
+  return (uint64_t) bv->bits[0];
 }
 
 /*------------------------------------------------------------------------*/
@@ -640,9 +1124,9 @@ btor_bv_set_bit (BtorBitVector *bv, uint32_t pos, uint32_t bit)
   assert (i < bv->len);
 
   if (bit)
-    bv->bits[bv->len - 1 - i] |= (1u << j);
+    bv->bits[bv->len - 1 - i] |= ((BTOR_BV_TYPE) 1 << j);
   else
-    bv->bits[bv->len - 1 - i] &= ~(1u << j);
+    bv->bits[bv->len - 1 - i] &= ~((BTOR_BV_TYPE) 1 << j);
 }
 
 void
@@ -681,6 +1165,8 @@ btor_bv_is_zero (const BtorBitVector *bv)
   assert (bv);
 
   uint32_t i;
+  if (bv->len >= BTOR_BV_SIMD_MIN_LEN)
+    return get_kernels ()->all_eq (bv->bits, bv->len, 0);
   for (i = 0; i < bv->len; i++)
     if (bv->bits[i] != 0) return false;
   return true;
@@ -692,17 +1178,19 @@ btor_bv_is_ones (const BtorBitVector *bv)
   assert (bv);
 
   uint32_t i, n;
-  for (i = bv->len - 1; i >= 1; i--)
-    if (bv->bits[i] != UINT32_MAX) return false;
-  if (bv->width == BTOR_BV_TYPE_BW)
-    return bv->bits[0] == UINT32_MAX;
+  if (bv->len >= BTOR_BV_SIMD_MIN_LEN)
+  {
+    if (!get_kernels ()->all_eq (bv->bits + 1, bv->len - 1, ~(BTOR_BV_TYPE) 0))
+      return false;
+  }
   else
   {
-    n = BTOR_BV_TYPE_BW - bv->width % BTOR_BV_TYPE_BW;
-    assert (n > 0);
-    if (bv->bits[0] != UINT32_MAX >> n) return false;
+    for (i = bv->len - 1; i >= 1; i--)
+      if (bv->bits[i] != ~(BTOR_BV_TYPE) 0) return false;
   }
-  return true;
+  n = bv->width % BTOR_BV_TYPE_BW;
+  if (n == 0) return bv->bits[0] == ~(BTOR_BV_TYPE) 0;
+  return bv->bits[0] == ~(BTOR_BV_TYPE) 0 >> (BTOR_BV_TYPE_BW - n);
 }
 
 bool
@@ -725,7 +1213,8 @@ btor_bv_is_min_signed (const BtorBitVector *bv)
 
   uint32_t i;
 
-  if (bv->bits[0] != (1u << ((bv->width % BTOR_BV_TYPE_BW) - 1))) return false;
+  if (bv->bits[0] != ((BTOR_BV_TYPE) 1 << ((bv->width - 1) % BTOR_BV_TYPE_BW)))
+    return false;
   for (i = 1; i < bv->len; i++)
     if (bv->bits[i] != 0) return false;
   return true;
@@ -736,19 +1225,13 @@ btor_bv_is_max_signed (const BtorBitVector *bv)
 {
   assert (bv);
 
-  uint32_t i, msc;
+  uint32_t i, msb;
 
-  msc = (BTOR_BV_TYPE_BW - (bv->width % BTOR_BV_TYPE_BW) + 1);
-  if (msc == BTOR_BV_TYPE_BW)
-  {
-    if (bv->bits[0] != 0) return false;
-  }
-  else if (bv->bits[0] != (~0u >> msc))
-  {
-    return false;
-  }
+  /* index of the sign bit in bits[0] */
+  msb = (bv->width - 1) % BTOR_BV_TYPE_BW;
+  if (bv->bits[0] != ((BTOR_BV_TYPE) 1 << msb) - 1) return false;
   for (i = 1; i < bv->len; i++)
-    if (bv->bits[i] != ~0u) return false;
+    if (bv->bits[i] != ~(BTOR_BV_TYPE) 0) return false;
   return true;
 }
 
@@ -782,8 +1265,8 @@ btor_bv_small_positive_int (const BtorBitVector *bv)
 
   for (i = 0; i < bv->len - 1; i++)
     if (bv->bits[i] != 0) return -1;
-  if (((int32_t) bv->bits[bv->len - 1]) < 0) return -1;
-  return bv->bits[bv->len - 1];
+  if (bv->bits[bv->len - 1] > INT32_MAX) return -1;
+  return (int32_t) bv->bits[bv->len - 1];
 }
 
 uint32_t
@@ -853,12 +1336,14 @@ btor_bv_ones (BtorMemMgr *mm, uint32_t bw)
   assert (mm);
   assert (bw);
 
-  BtorBitVector *res, *tmp;
+  uint32_t i;
+  BtorBitVector *res;
 
-  tmp = btor_bv_new (mm, bw);
-  res = btor_bv_not (mm, tmp);
-  btor_bv_free (mm, tmp);
+  res = btor_bv_new (mm, bw);
+  for (i = 0; i < res->len; i++) res->bits[i] = ~(BTOR_BV_TYPE) 0;
 
+  set_rem_bits_to_zero (res);
+  assert (rem_bits_zero_dbg (res));
   return res;
 }
 
@@ -894,15 +1379,11 @@ btor_bv_neg (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (mm);
   assert (bv);
 
-  BtorBitVector *not_bv, *one, *neg_b;
-
-  not_bv = btor_bv_not (mm, bv);
-  one    = btor_bv_uint64_to_bv (mm, 1, bv->width);
-  neg_b  = btor_bv_add (mm, not_bv, one);
-  btor_bv_free (mm, not_bv);
-  btor_bv_free (mm, one);
+  BtorBitVector *res;
 
-  return neg_b;
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_neg_into (res, bv);
+  return res;
 }
 
 BtorBitVector *
@@ -911,14 +1392,10 @@ btor_bv_not (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (mm);
   assert (bv);
 
-  uint32_t i;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, bv->width);
-  for (i = 0; i < bv->len; i++) res->bits[i] = ~bv->bits[i];
-
-  set_rem_bits_to_zero (res);
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_not_into (res, bv);
   return res;
 }
 
@@ -928,11 +1405,10 @@ btor_bv_inc (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (mm);
   assert (bv);
 
-  BtorBitVector *res, *one;
+  BtorBitVector *res;
 
-  one = btor_bv_uint64_to_bv (mm, 1, bv->width);
-  res = btor_bv_add (mm, bv, one);
-  btor_bv_free (mm, one);
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_inc_into (res, bv);
   return res;
 }
 
@@ -942,13 +1418,10 @@ btor_bv_dec (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (mm);
   assert (bv);
 
-  BtorBitVector *res, *one, *negone;
+  BtorBitVector *res;
 
-  one    = btor_bv_uint64_to_bv (mm, 1, bv->width);
-  negone = btor_bv_neg (mm, one);
-  res    = btor_bv_add (mm, bv, negone);
-  btor_bv_free (mm, one);
-  btor_bv_free (mm, negone);
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_dec_into (res, bv);
   return res;
 }
 
@@ -960,7 +1433,7 @@ btor_bv_redand (BtorMemMgr *mm, const BtorBitVector *bv)
 
   uint32_t i;
   uint32_t bit;
-  uint32_t mask0;
+  BTOR_BV_TYPE mask0;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, 1);
@@ -1015,31 +1488,10 @@ btor_bv_add (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  int64_t i;
-  uint64_t x, y, sum;
   BtorBitVector *res;
-  BTOR_BV_TYPE carry;
-
-  if (a->width <= 64)
-  {
-    x   = btor_bv_to_uint64 (a);
-    y   = btor_bv_to_uint64 (b);
-    res = btor_bv_uint64_to_bv (mm, x + y, a->width);
-  }
-  else
-  {
-    res   = btor_bv_new (mm, a->width);
-    carry = 0;
-    for (i = a->len - 1; i >= 0; i--)
-    {
-      sum          = (uint64_t) a->bits[i] + b->bits[i] + carry;
-      res->bits[i] = (BTOR_BV_TYPE) sum;
-      carry        = (BTOR_BV_TYPE) (sum >> 32);
-    }
-  }
 
-  set_rem_bits_to_zero (res);
-  assert (rem_bits_zero_dbg (res));
+  res = btor_bv_new (mm, a->width);
+  btor_bv_add_into (res, a, b);
   return res;
 }
 
@@ -1052,11 +1504,10 @@ btor_bv_sub (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  BtorBitVector *negb, *res;
+  BtorBitVector *res;
 
-  negb = btor_bv_neg (mm, b);
-  res  = btor_bv_add (mm, a, negb);
-  btor_bv_free (mm, negb);
+  res = btor_bv_new (mm, a->width);
+  btor_bv_sub_into (res, a, b);
   return res;
 }
 
@@ -1069,13 +1520,10 @@ btor_bv_and (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  uint32_t i;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, a->width);
-  for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] & b->bits[i];
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_and_into (res, a, b);
   return res;
 }
 
@@ -1108,13 +1556,10 @@ btor_bv_or (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  uint32_t i;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, a->width);
-  for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] | b->bits[i];
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_or_into (res, a, b);
   return res;
 }
 
@@ -1187,13 +1632,10 @@ btor_bv_xor (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  uint32_t i;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, a->width);
-  for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] ^ b->bits[i];
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_xor_into (res, a, b);
   return res;
 }
 
@@ -1206,22 +1648,10 @@ btor_bv_eq (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  uint32_t i, bit;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, 1);
-  bit = 1;
-  for (i = 0; i < a->len; i++)
-  {
-    if (a->bits[i] != b->bits[i])
-    {
-      bit = 0;
-      break;
-    }
-  }
-  btor_bv_set_bit (res, 0, bit);
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_eq_into (res, a, b);
   return res;
 }
 
@@ -1262,22 +1692,10 @@ btor_bv_ult (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  uint32_t i, bit;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, 1);
-  bit = 1;
-
-  /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
-
-  /* a == b */
-  if (i == a->len || a->bits[i] >= b->bits[i]) bit = 0;
-
-  btor_bv_set_bit (res, 0, bit);
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_ult_into (res, a, b);
   return res;
 }
 
@@ -1309,80 +1727,37 @@ btor_bv_ulte (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   return res;
 }
 
-static BtorBitVector *
-sll_bv (BtorMemMgr *mm, const BtorBitVector *a, uint32_t shift)
+BtorBitVector *
+btor_bv_sll (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
 {
   assert (mm);
   assert (a);
+  assert (b);
+  assert (a->width == b->width
+          || (btor_util_is_power_of_2 (a->width)
+              && btor_util_log_2 (a->width) == b->width));
 
-  uint32_t skip, i, j, k;
   BtorBitVector *res;
-  BTOR_BV_TYPE v;
 
   res = btor_bv_new (mm, a->width);
-  if (shift >= a->width) return res;
-
-  k    = shift % BTOR_BV_TYPE_BW;
-  skip = shift / BTOR_BV_TYPE_BW;
-
-  v = 0;
-  for (i = a->len - 1, j = res->len - 1 - skip;; i--, j--)
-  {
-    v            = (k == 0) ? a->bits[i] : v | (a->bits[i] << k);
-    res->bits[j] = v;
-    v            = (k == 0) ? a->bits[i] : a->bits[i] >> (BTOR_BV_TYPE_BW - k);
-    if (i == 0 || j == 0) break;
-  }
-  set_rem_bits_to_zero (res);
-  assert (rem_bits_zero_dbg (res));
-  assert (check_bits_sll_dbg (a, res, shift));
+  btor_bv_sll_into (res, a, b);
   return res;
 }
 
-BtorBitVector *
-btor_bv_sll (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
-{
-  assert (mm);
-  assert (a);
-  assert (b);
-  assert (btor_util_is_power_of_2 (a->width) || a->len == b->len);
-  assert (btor_util_log_2 (a->width) == b->width || a->width == b->width);
-
-  uint64_t shift;
-  shift = btor_bv_to_uint64 (b);
-  return sll_bv (mm, a, shift);
-}
-
 BtorBitVector *
 btor_bv_srl (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
 {
   assert (mm);
   assert (a);
   assert (b);
-  assert (btor_util_is_power_of_2 (a->width) || a->len == b->len);
-  assert (btor_util_log_2 (a->width) == b->width || a->width == b->width);
+  assert (a->width == b->width
+          || (btor_util_is_power_of_2 (a->width)
+              && btor_util_log_2 (a->width) == b->width));
 
-  uint32_t skip, i, j, k;
-  uint64_t shift;
   BtorBitVector *res;
-  BTOR_BV_TYPE v;
-
-  res   = btor_bv_new (mm, a->width);
-  shift = btor_bv_to_uint64 (b);
-  if (shift >= a->width) return res;
 
-  k    = shift % BTOR_BV_TYPE_BW;
-  skip = shift / BTOR_BV_TYPE_BW;
-
-  v = 0;
-  for (i = 0, j = skip; i < a->len && j < a->len; i++, j++)
-  {
-    v            = (k == 0) ? a->bits[i] : v | (a->bits[i] >> k);
-    res->bits[j] = v;
-    v            = (k == 0) ? a->bits[i] : a->bits[i] << (BTOR_BV_TYPE_BW - k);
-  }
-
-  assert (rem_bits_zero_dbg (res));
+  res = btor_bv_new (mm, a->width);
+  btor_bv_srl_into (res, a, b);
   return res;
 }
 
@@ -1395,119 +1770,13 @@ btor_bv_mul (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  uint32_t i;
-  uint64_t x, y;
-  BtorBitVector *res, *and, *shift, *add;
+  BtorBitVector *res;
 
-  if (a->width <= 64)
-  {
-    x   = btor_bv_to_uint64 (a);
-    y   = btor_bv_to_uint64 (b);
-    res = btor_bv_uint64_to_bv (mm, x * y, a->width);
-  }
-  else
-  {
-    res = btor_bv_new (mm, a->width);
-    for (i = 0; i < a->width; i++)
-    {
-      if (btor_bv_get_bit (b, i))
-        and = btor_bv_copy (mm, a);
-      else
-        and = btor_bv_new (mm, a->width);
-      shift = sll_bv (mm, and, i);
-      add   = btor_bv_add (mm, res, shift);
-      btor_bv_free (mm, and);
-      btor_bv_free (mm, shift);
-      btor_bv_free (mm, res);
-      res = add;
-    }
-  }
+  res = btor_bv_new (mm, a->width);
+  btor_bv_mul_into (mm, res, a, b);
   return res;
 }
 
-static void
-udiv_urem_bv (BtorMemMgr *mm,
-              const BtorBitVector *a,
-              const BtorBitVector *b,
-              BtorBitVector **q,
-              BtorBitVector **r)
-{
-  assert (mm);
-  assert (a);
-  assert (b);
-  assert (a->len == b->len);
-  assert (a->width == b->width);
-
-  int64_t i;
-  bool is_true;
-  uint64_t x, y, z;
-
-  BtorBitVector *neg_b, *quot, *rem, *ult, *eq, *tmp;
-
-  if (a->width <= 64)
-  {
-    x = btor_bv_to_uint64 (a);
-    y = btor_bv_to_uint64 (b);
-    if (y == 0)
-    {
-      y = x;
-      x = UINT64_MAX;
-    }
-    else
-    {
-      z = x / y;
-      y = x % y;
-      x = z;
-    }
-    quot = btor_bv_uint64_to_bv (mm, x, a->width);
-    rem  = btor_bv_uint64_to_bv (mm, y, a->width);
-  }
-  else
-  {
-    neg_b = btor_bv_neg (mm, b);
-    quot  = btor_bv_new (mm, a->width);
-    rem   = btor_bv_new (mm, a->width);
-
-    for (i = a->width - 1; i >= 0; i--)
-    {
-      tmp = sll_bv (mm, rem, 1);
-      btor_bv_free (mm, rem);
-      rem = tmp;
-      btor_bv_set_bit (rem, 0, btor_bv_get_bit (a, i));
-
-      ult     = btor_bv_ult (mm, b, rem);
-      is_true = btor_bv_is_true (ult);
-      btor_bv_free (mm, ult);
-
-      if (is_true) goto UDIV_UREM_SUBTRACT;
-
-      eq      = btor_bv_eq (mm, b, rem);
-      is_true = btor_bv_is_true (eq);
-      btor_bv_free (mm, eq);
-
-      if (is_true)
-      {
-      UDIV_UREM_SUBTRACT:
-        tmp = btor_bv_add (mm, rem, neg_b);
-        btor_bv_free (mm, rem);
-        rem = tmp;
-        btor_bv_set_bit (quot, i, 1);
-      }
-    }
-    btor_bv_free (mm, neg_b);
-  }
-
-  if (q)
-    *q = quot;
-  else
-    btor_bv_free (mm, quot);
-
-  if (r)
-    *r = rem;
-  else
-    btor_bv_free (mm, rem);
-}
-
 BtorBitVector *
 btor_bv_udiv (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
 {
@@ -1517,9 +1786,10 @@ btor_bv_udiv (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  BtorBitVector *res = 0;
-  udiv_urem_bv (mm, a, b, &res, 0);
-  assert (res);
+  BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_udiv_into (mm, res, a, b);
   return res;
 }
 
@@ -1532,9 +1802,10 @@ btor_bv_urem (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->len == b->len);
   assert (a->width == b->width);
 
-  BtorBitVector *res = 0;
-  udiv_urem_bv (mm, a, b, 0, &res);
-  assert (res);
+  BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_urem_into (mm, res, a, b);
   return res;
 }
 
@@ -1545,42 +1816,10 @@ btor_bv_concat (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a);
   assert (b);
 
-  int64_t i, j, k;
-  BTOR_BV_TYPE v;
   BtorBitVector *res;
 
   res = btor_bv_new (mm, a->width + b->width);
-
-  j = res->len - 1;
-
-  /* copy bits from bit vector b */
-  for (i = b->len - 1; i >= 0; i--) res->bits[j--] = b->bits[i];
-
-  k = b->width % BTOR_BV_TYPE_BW;
-
-  /* copy bits from bit vector a */
-  if (k == 0)
-  {
-    assert (j >= 0);
-    for (i = a->len - 1; i >= 0; i--) res->bits[j--] = a->bits[i];
-  }
-  else
-  {
-    j += 1;
-    assert (res->bits[j] >> k == 0);
-    v = res->bits[j];
-    for (i = a->len - 1; i >= 0; i--)
-    {
-      v = v | (a->bits[i] << k);
-      assert (j >= 0);
-      res->bits[j--] = v;
-      v              = a->bits[i] >> (BTOR_BV_TYPE_BW - k);
-    }
-    assert (j <= 0);
-    if (j == 0) res->bits[j] = v;
-  }
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_concat_into (res, a, b);
   return res;
 }
 
@@ -1593,14 +1832,13 @@ btor_bv_slice (BtorMemMgr *mm,
   assert (mm);
   assert (bv);
 
-  uint32_t i, j;
+  assert (lower <= upper);
+  assert (upper < bv->width);
+
   BtorBitVector *res;
 
   res = btor_bv_new (mm, upper - lower + 1);
-  for (i = lower, j = 0; i <= upper; i++)
-    btor_bv_set_bit (res, j++, btor_bv_get_bit (bv, i));
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_slice_into (res, bv, upper, lower);
   return res;
 }
 
@@ -1652,17 +1890,9 @@ btor_bv_ite (BtorMemMgr *mm,
   assert (t->width == e->width);
 
   BtorBitVector *res;
-  BTOR_BV_TYPE cc, nn;
-  uint32_t i;
-
-  cc = btor_bv_get_bit (c, 0) ? (~(BTOR_BV_TYPE) 0) : 0;
-  nn = ~cc;
 
   res = btor_bv_new (mm, t->width);
-  for (i = 0; i < t->len; i++)
-    res->bits[i] = (cc & t->bits[i]) | (nn & e->bits[i]);
-
-  assert (rem_bits_zero_dbg (res));
+  btor_bv_ite_into (res, c, t, e);
   return res;
 }
 
@@ -1706,6 +1936,1011 @@ btor_bv_flipped_bit_range (BtorMemMgr *mm,
 
 /*------------------------------------------------------------------------*/
 
+/* Compute the full 128-bit product of 'x' and 'y'. */
+static void
+mul_chunk (BTOR_BV_TYPE x, BTOR_BV_TYPE y, BTOR_BV_TYPE *hi, BTOR_BV_TYPE *lo)
+{
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 p;
+
+  p   = (unsigned __int128) x * y;
+  *lo = (BTOR_BV_TYPE) p;
+  *hi = (BTOR_BV_TYPE) (p >> 64);
+#else
+  uint64_t x0, x1, y0, y1, p00, p01, p10, p11, mid;
+
+  x0  = x & UINT32_MAX;
+  x1  = x >> 32;
+  y0  = y & UINT32_MAX;
+  y1  = y >> 32;
+  p00 = x0 * y0;
+  p01 = x0 * y1;
+  p10 = x1 * y0;
+  p11 = x1 * y1;
+  mid = (p00 >> 32) + (p01 & UINT32_MAX) + (p10 & UINT32_MAX);
+  *lo = (mid << 32) | (p00 & UINT32_MAX);
+  *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+
+/* Get the shift amount given by 'b', saturated to the width of 'a'. */
+static uint32_t
+get_shift (const BtorBitVector *a, const BtorBitVector *b)
+{
+  uint32_t i;
+  BTOR_BV_TYPE shift;
+
+  for (i = 0; i + 1 < b->len; i++)
+    if (b->bits[i]) return a->width;
+  shift = b->bits[b->len - 1];
+  return shift >= a->width ? a->width : (uint32_t) shift;
+}
+
+void
+btor_bv_copy_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+  if (dst == bv) return;
+  memcpy (dst->bits, bv->bits, sizeof (*(bv->bits)) * bv->len);
+}
+
+void
+btor_bv_neg_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+  int64_t i;
+  BTOR_BV_TYPE carry;
+
+  /* ~bv + 1 */
+  carry = 1;
+  for (i = bv->len - 1; i >= 0; i--)
+  {
+    dst->bits[i] = ~bv->bits[i] + carry;
+    carry        = carry && dst->bits[i] == 0;
+  }
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_not_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+  uint32_t i;
+
+  if (bv->len >= BTOR_BV_SIMD_MIN_LEN)
+    get_kernels ()->bv_not (dst->bits, bv->bits, bv->len);
+  else
+    for (i = 0; i < bv->len; i++) dst->bits[i] = ~bv->bits[i];
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_inc_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+  int64_t i;
+  BTOR_BV_TYPE carry;
+
+  carry = 1;
+  for (i = bv->len - 1; i >= 0; i--)
+  {
+    dst->bits[i] = bv->bits[i] + carry;
+    carry        = carry && dst->bits[i] == 0;
+  }
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_dec_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+  int64_t i;
+  BTOR_BV_TYPE x, borrow;
+
+  borrow = 1;
+  for (i = bv->len - 1; i >= 0; i--)
+  {
+    x            = bv->bits[i];
+    dst->bits[i] = x - borrow;
+    borrow       = borrow && x == 0;
+  }
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_add_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  int64_t i;
+  BTOR_BV_TYPE x, carry;
+
+  if (a->len == 1)
+  {
+    dst->bits[0] = a->bits[0] + b->bits[0];
+  }
+  else
+  {
+    carry = 0;
+    for (i = a->len - 1; i >= 0; i--)
+    {
+      x            = a->bits[i] + carry;
+      carry        = x < carry;
+      dst->bits[i] = x + b->bits[i];
+      carry |= dst->bits[i] < x;
+    }
+  }
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_sub_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  int64_t i;
+  BTOR_BV_TYPE x, y, borrow;
+
+  borrow = 0;
+  for (i = a->len - 1; i >= 0; i--)
+  {
+    x            = a->bits[i];
+    y            = b->bits[i];
+    dst->bits[i] = x - y - borrow;
+    borrow       = x < y || (x == y && borrow);
+  }
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_and_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  uint32_t i;
+
+  if (a->len >= BTOR_BV_SIMD_MIN_LEN)
+    get_kernels ()->bv_and (dst->bits, a->bits, b->bits, a->len);
+  else
+    for (i = 0; i < a->len; i++) dst->bits[i] = a->bits[i] & b->bits[i];
+
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_or_into (BtorBitVector *dst,
+                 const BtorBitVector *a,
+                 const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  uint32_t i;
+
+  if (a->len >= BTOR_BV_SIMD_MIN_LEN)
+    get_kernels ()->bv_or (dst->bits, a->bits, b->bits, a->len);
+  else
+    for (i = 0; i < a->len; i++) dst->bits[i] = a->bits[i] | b->bits[i];
+
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_xor_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  uint32_t i;
+
+  if (a->len >= BTOR_BV_SIMD_MIN_LEN)
+    get_kernels ()->bv_xor (dst->bits, a->bits, b->bits, a->len);
+  else
+    for (i = 0; i < a->len; i++) dst->bits[i] = a->bits[i] ^ b->bits[i];
+
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_eq_into (BtorBitVector *dst,
+                 const BtorBitVector *a,
+                 const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == 1);
+
+  uint32_t i;
+
+  if (a->len >= BTOR_BV_SIMD_MIN_LEN)
+    i = get_kernels ()->mismatch (a->bits, b->bits, a->len);
+  else
+    for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
+      ;
+
+  dst->bits[0] = i == a->len;
+}
+
+void
+btor_bv_ult_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == 1);
+
+  uint32_t i;
+
+  /* find index on which a and b differ */
+  if (a->len >= BTOR_BV_SIMD_MIN_LEN)
+    i = get_kernels ()->mismatch (a->bits, b->bits, a->len);
+  else
+    for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
+      ;
+
+  dst->bits[0] = i < a->len && a->bits[i] < b->bits[i];
+}
+
+void
+btor_bv_sll_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (dst->width == a->width);
+  assert (a->width == b->width
+          || (btor_util_is_power_of_2 (a->width)
+              && btor_util_log_2 (a->width) == b->width));
+
+  uint32_t shift, skip, i, j, k;
+  BTOR_BV_TYPE v;
+
+  shift = get_shift (a, b);
+  k     = shift % BTOR_BV_TYPE_BW;
+  skip  = shift / BTOR_BV_TYPE_BW;
+
+  /* dst->bits[j] only depends on a->bits[i] with i >= j, hence 'dst' may be
+   * the same as 'a' if we go from MSB to LSB */
+  for (j = 0; j < a->len; j++)
+  {
+    i = j + skip;
+    v = i < a->len ? a->bits[i] << k : 0;
+    if (k && i + 1 < a->len) v |= a->bits[i + 1] >> (BTOR_BV_TYPE_BW - k);
+    dst->bits[j] = v;
+  }
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+  assert (dst == a || check_bits_sll_dbg (a, dst, shift));
+}
+
+void
+btor_bv_srl_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (dst->width == a->width);
+  assert (a->width == b->width
+          || (btor_util_is_power_of_2 (a->width)
+              && btor_util_log_2 (a->width) == b->width));
+
+  int64_t i, j;
+  uint32_t shift, skip, k;
+  BTOR_BV_TYPE v;
+
+  shift = get_shift (a, b);
+  k     = shift % BTOR_BV_TYPE_BW;
+  skip  = shift / BTOR_BV_TYPE_BW;
+
+  /* dst->bits[j] only depends on a->bits[i] with i <= j, hence 'dst' may be
+   * the same as 'a' if we go from LSB to MSB */
+  for (j = a->len - 1; j >= 0; j--)
+  {
+    i = j - skip;
+    v = i >= 0 ? a->bits[i] >> k : 0;
+    if (k && i >= 1) v |= a->bits[i - 1] << (BTOR_BV_TYPE_BW - k);
+    dst->bits[j] = v;
+  }
+
+  assert (rem_bits_zero_dbg (dst));
+}
+
+/* Multiplication and division of bit vectors wider than BTOR_BV_TYPE_BW
+ * work on arrays of chunks resp. 32-bit digits stored LSB first. */
+
+uint32_t btor_bv_karatsuba_threshold = BTOR_BV_KARATSUBA_THRESHOLD;
+
+/* r[0..n) += a[0..m) for m <= n, returns the carry out of r[n - 1]. */
+static BTOR_BV_TYPE
+chunks_add (BTOR_BV_TYPE *r, uint32_t n, const BTOR_BV_TYPE *a, uint32_t m)
+{
+  assert (m <= n);
+
+  uint32_t i;
+  BTOR_BV_TYPE x, carry;
+
+  carry = 0;
+  for (i = 0; i < m; i++)
+  {
+    x     = a[i] + carry;
+    carry = x < carry;
+    r[i] += x;
+    carry += r[i] < x;
+  }
+  for (; carry && i < n; i++) carry = ++r[i] == 0;
+  return carry;
+}
+
+/* r[0..n) -= a[0..m) for m <= n, returns the borrow out of r[n - 1]. */
+static BTOR_BV_TYPE
+chunks_sub (BTOR_BV_TYPE *r, uint32_t n, const BTOR_BV_TYPE *a, uint32_t m)
+{
+  assert (m <= n);
+
+  uint32_t i;
+  BTOR_BV_TYPE x, borrow;
+
+  borrow = 0;
+  for (i = 0; i < m; i++)
+  {
+    x      = r[i];
+    r[i]   = x - a[i] - borrow;
+    borrow = x < a[i] || (x == a[i] && borrow);
+  }
+  for (; borrow && i < n; i++) borrow = r[i]-- == 0;
+  return borrow;
+}
+
+/* r[0..2n) = a[0..n) * b[0..n) */
+static void
+chunks_mul_basecase (BTOR_BV_TYPE *r,
+                     const BTOR_BV_TYPE *a,
+                     const BTOR_BV_TYPE *b,
+                     uint32_t n)
+{
+  uint32_t i, j;
+  BTOR_BV_TYPE hi, lo, carry;
+
+  memset (r, 0, sizeof (*r) * 2 * n);
+  for (i = 0; i < n; i++)
+  {
+    if (!a[i]) continue;
+    carry = 0;
+    for (j = 0; j < n; j++)
+    {
+      mul_chunk (a[i], b[j], &hi, &lo);
+      lo += carry;
+      hi += lo < carry;
+      lo += r[i + j];
+      hi += lo < r[i + j];
+      r[i + j] = lo;
+      carry    = hi;
+    }
+    r[i + n] = carry;
+  }
+}
+
+/* r[0..n) = lower n chunks of a[0..n) * b[0..n) */
+static void
+chunks_mullo_basecase (BTOR_BV_TYPE *r,
+                       const BTOR_BV_TYPE *a,
+                       const BTOR_BV_TYPE *b,
+                       uint32_t n)
+{
+  uint32_t i, j;
+  BTOR_BV_TYPE hi, lo, carry;
+
+  memset (r, 0, sizeof (*r) * n);
+  for (i = 0; i < n; i++)
+  {
+    if (!a[i]) continue;
+    carry = 0;
+    for (j = 0; i + j < n; j++)
+    {
+      mul_chunk (a[i], b[j], &hi, &lo);
+      lo += carry;
+      hi += lo < carry;
+      lo += r[i + j];
+      hi += lo < r[i + j];
+      r[i + j] = lo;
+      carry    = hi;
+    }
+  }
+}
+
+static bool
+use_karatsuba (uint32_t n)
+{
+  return n >= 2 && n >= btor_bv_karatsuba_threshold;
+}
+
+/* Number of chunks of scratch memory required by 'chunks_mul_karatsuba'. */
+static uint32_t
+karatsuba_scratch_size (uint32_t n)
+{
+  uint32_t res, l;
+
+  for (res = 0; use_karatsuba (n); n = l)
+  {
+    l = n - n / 2;
+    res += 4 * l + 1;
+  }
+  return res;
+}
+
+/* r[0..2n) = a[0..n) * b[0..n), 'tmp' provides scratch memory of
+ * 'karatsuba_scratch_size (n)' chunks.
+ *
+ * With a = a1 * B^l + a0 and b = b1 * B^l + b0:
+ *   a * b = z2 * B^2l + z1 * B^l + z0
+ * where z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) * (b0 + b1) - z0 - z2.
+ */
+static void
+chunks_mul_karatsuba (BTOR_BV_TYPE *r,
+                      const BTOR_BV_TYPE *a,
+                      const BTOR_BV_TYPE *b,
+                      uint32_t n,
+                      BTOR_BV_TYPE *tmp)
+{
+  uint32_t l, h, m;
+  BTOR_BV_TYPE ca, cb, *sa, *sb, *p;
+
+  if (!use_karatsuba (n))
+  {
+    chunks_mul_basecase (r, a, b, n);
+    return;
+  }
+
+  h  = n / 2;
+  l  = n - h;
+  sa = tmp;
+  sb = sa + l;
+  p  = sb + l;
+  tmp += 4 * l + 1;
+
+  /* z0 and z2 */
+  chunks_mul_karatsuba (r, a, b, l, tmp);
+  chunks_mul_karatsuba (r + 2 * l, a + l, b + l, h, tmp);
+
+  /* (a0 + a1) * (b0 + b1) with (l + 1)-chunk sums */
+  memcpy (sa, a, sizeof (*sa) * l);
+  memcpy (sb, b, sizeof (*sb) * l);
+  ca = chunks_add (sa, l, a + l, h);
+  cb = chunks_add (sb, l, b + l, h);
+  chunks_mul_karatsuba (p, sa, sb, l, tmp);
+  p[2 * l] = ca && cb;
+  if (ca) chunks_add (p + l, l + 1, sb, l);
+  if (cb) chunks_add (p + l, l + 1, sa, l);
+
+  /* z1 */
+  chunks_sub (p, 2 * l + 1, r, 2 * l);
+  chunks_sub (p, 2 * l + 1, r + 2 * l, 2 * h);
+
+  /* z1 < B^(n + 1), hence only the lower 2n - l chunks of p may be
+   * non-zero */
+  m = 2 * n - l < 2 * l + 1 ? 2 * n - l : 2 * l + 1;
+  assert (m == 2 * l + 1 || p[m] == 0);
+  chunks_add (r + l, 2 * n - l, p, m);
+}
+
+/* Number of chunks of scratch memory required by 'chunks_mullo'. */
+static uint32_t
+mullo_scratch_size (uint32_t n)
+{
+  uint32_t l, h, k, m;
+
+  h = n / 2;
+  l = n - h;
+  if (!use_karatsuba (l)) return 0;
+  k = karatsuba_scratch_size (l);
+  m = h + mullo_scratch_size (h);
+  return 2 * l + (k > m ? k : m);
+}
+
+/* r[0..n) = lower n chunks of a[0..n) * b[0..n), 'tmp' provides scratch
+ * memory of 'mullo_scratch_size (n)' chunks.
+ *
+ * With a = a1 * B^l + a0 and b = b1 * B^l + b0:
+ *   a * b mod B^n = (a0 * b0 + (a1 * b0 + a0 * b1) * B^l) mod B^n
+ * where a0 * b0 is a full product (Karatsuba) and only the lower n - l
+ * chunks of a1 * b0 and a0 * b1 are needed. */
+static void
+chunks_mullo (BTOR_BV_TYPE *r,
+              const BTOR_BV_TYPE *a,
+              const BTOR_BV_TYPE *b,
+              uint32_t n,
+              BTOR_BV_TYPE *tmp)
+{
+  uint32_t l, h;
+  BTOR_BV_TYPE *z;
+
+  h = n / 2;
+  l = n - h;
+  if (!use_karatsuba (l))
+  {
+    chunks_mullo_basecase (r, a, b, n);
+    return;
+  }
+
+  z = tmp;
+  tmp += 2 * l;
+  chunks_mul_karatsuba (z, a, b, l, tmp);
+  memcpy (r, z, sizeof (*r) * n);
+
+  chunks_mullo (z, a + l, b, h, z + h);
+  chunks_add (r + l, h, z, h);
+  chunks_mullo (z, a, b + l, h, z + h);
+  chunks_add (r + l, h, z, h);
+}
+
+void
+btor_bv_mul_into (BtorMemMgr *mm,
+                  BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (mm);
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  uint32_t i, j, len, size;
+  BTOR_BV_TYPE x, hi, lo, carry, *r, *buf, *ca, *cb;
+  BtorBitVector *res;
+
+  if (a->len == 1)
+  {
+    dst->bits[0] = a->bits[0] * b->bits[0];
+    set_rem_bits_to_zero (dst);
+    return;
+  }
+
+  len = a->len;
+
+  if (use_karatsuba (len - len / 2))
+  {
+    size = 3 * len + mullo_scratch_size (len);
+    BTOR_NEWN (mm, buf, size);
+    ca = buf;
+    cb = ca + len;
+    r  = cb + len;
+    for (i = 0; i < len; i++)
+    {
+      ca[i] = a->bits[len - 1 - i];
+      cb[i] = b->bits[len - 1 - i];
+    }
+    chunks_mullo (r, ca, cb, len, r + len);
+    for (i = 0; i < len; i++) dst->bits[len - 1 - i] = r[i];
+    BTOR_DELETEN (mm, buf, size);
+    set_rem_bits_to_zero (dst);
+    assert (rem_bits_zero_dbg (dst));
+    return;
+  }
+
+  /* schoolbook multiplication on chunks, only the lower 'len' chunks of
+   * the product are computed */
+  res = dst == a || dst == b ? btor_bv_new (mm, a->width) : dst;
+  r   = res->bits;
+  memset (r, 0, sizeof (*r) * len);
+  for (i = 0; i < len; i++)
+  {
+    x = a->bits[len - 1 - i];
+    if (!x) continue;
+    carry = 0;
+    for (j = 0; i + j < len; j++)
+    {
+      mul_chunk (x, b->bits[len - 1 - j], &hi, &lo);
+      lo += carry;
+      hi += lo < carry;
+      r[len - 1 - i - j] += lo;
+      hi += r[len - 1 - i - j] < lo;
+      carry = hi;
+    }
+  }
+  set_rem_bits_to_zero (res);
+
+  if (res != dst)
+  {
+    btor_bv_copy_into (dst, res);
+    btor_bv_free (mm, res);
+  }
+  assert (rem_bits_zero_dbg (dst));
+}
+
+/* Knuth's algorithm D (TAOCP Vol. 2, 4.3.1) on 32-bit digits, see also
+ * 'divmnu' in Hacker's Delight. Computes q[0..m-n] = u / v and
+ * r[0..n) = u % v for m >= n >= 2 and v[n - 1] != 0. 'un' (m + 1 digits)
+ * and 'vn' (n digits) are scratch memory. */
+static void
+digits_divmod (uint32_t *q,
+               uint32_t *r,
+               const uint32_t *u,
+               const uint32_t *v,
+               uint32_t m,
+               uint32_t n,
+               uint32_t *un,
+               uint32_t *vn)
+{
+  assert (m >= n);
+  assert (n >= 2);
+  assert (v[n - 1]);
+
+  uint32_t i, s;
+  int64_t j, k, t;
+  uint64_t b, qhat, rhat, p;
+
+  b = (uint64_t) 1 << 32;
+
+  /* normalize such that the MSB of the divisor is set */
+  for (s = 0; !(v[n - 1] & (UINT32_C (1) << (31 - s))); s++)
+    ;
+  for (i = n - 1; i > 0; i--)
+    vn[i] = (v[i] << s) | (uint32_t) ((uint64_t) v[i - 1] >> (32 - s));
+  vn[0] = v[0] << s;
+  un[m] = (uint32_t) ((uint64_t) u[m - 1] >> (32 - s));
+  for (i = m - 1; i > 0; i--)
+    un[i] = (u[i] << s) | (uint32_t) ((uint64_t) u[i - 1] >> (32 - s));
+  un[0] = u[0] << s;
+
+  for (j = m - n; j >= 0; j--)
+  {
+    /* estimate quotient digit, it is too large by at most 2 */
+    p    = ((uint64_t) un[j + n] << 32) | un[j + n - 1];
+    qhat = p / vn[n - 1];
+    rhat = p % vn[n - 1];
+    while (qhat >= b || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+    {
+      qhat -= 1;
+      rhat += vn[n - 1];
+      if (rhat >= b) break;
+    }
+
+    /* multiply and subtract */
+    k = 0;
+    for (i = 0; i < n; i++)
+    {
+      p         = qhat * vn[i];
+      t         = un[i + j] - k - (int64_t) (p & UINT32_MAX);
+      un[i + j] = (uint32_t) t;
+      k         = (int64_t) (p >> 32) - (t >> 32);
+    }
+    t         = un[j + n] - k;
+    un[j + n] = (uint32_t) t;
+
+    /* add back if we subtracted too much */
+    q[j] = (uint32_t) qhat;
+    if (t < 0)
+    {
+      q[j] -= 1;
+      p = 0;
+      for (i = 0; i < n; i++)
+      {
+        p         = (uint64_t) un[i + j] + vn[i] + (p >> 32);
+        un[i + j] = (uint32_t) p;
+      }
+      un[j + n] += (uint32_t) (p >> 32);
+    }
+  }
+
+  /* denormalize remainder */
+  for (i = 0; i < n; i++)
+    r[i] = (uint32_t) ((((uint64_t) un[i + 1] << 32) | un[i]) >> s);
+}
+
+static void
+bv_to_digits (const BtorBitVector *bv, uint32_t *d)
+{
+  uint32_t i;
+  BTOR_BV_TYPE x;
+
+  for (i = 0; i < bv->len; i++)
+  {
+    x            = bv->bits[bv->len - 1 - i];
+    d[2 * i]     = (uint32_t) x;
+    d[2 * i + 1] = (uint32_t) (x >> 32);
+  }
+}
+
+static void
+digits_to_bv (const uint32_t *d, BtorBitVector *bv)
+{
+  uint32_t i;
+
+  for (i = 0; i < bv->len; i++)
+    bv->bits[bv->len - 1 - i] =
+        ((BTOR_BV_TYPE) d[2 * i + 1] << 32) | (BTOR_BV_TYPE) d[2 * i];
+  set_rem_bits_to_zero (bv);
+}
+
+static void
+udiv_urem_into (BtorMemMgr *mm,
+                BtorBitVector *q,
+                BtorBitVector *r,
+                const BtorBitVector *a,
+                const BtorBitVector *b)
+{
+  assert (mm);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (!q || q->width == a->width);
+  assert (!r || r->width == a->width);
+
+  uint32_t i, m, n, len, size;
+  uint32_t *buf, *u, *v, *qd, *rd, *un, *vn;
+  uint64_t x, y, z;
+
+  if (a->len == 1)
+  {
+    x = a->bits[0];
+    y = b->bits[0];
+    if (y == 0)
+    {
+      y = x;
+      x = UINT64_MAX;
+    }
+    else
+    {
+      z = x / y;
+      y = x % y;
+      x = z;
+    }
+    if (q)
+    {
+      q->bits[0] = x;
+      set_rem_bits_to_zero (q);
+    }
+    if (r) r->bits[0] = y;
+    return;
+  }
+
+  /* 'a' and 'b' are copied first, hence they may be the same as 'q' or
+   * 'r' */
+  len  = 2 * a->len;
+  size = 6 * len + 1;
+  BTOR_CNEWN (mm, buf, size);
+  u  = buf;
+  v  = u + len;
+  qd = v + len;
+  rd = qd + len;
+  vn = rd + len;
+  un = vn + len;
+  bv_to_digits (a, u);
+  bv_to_digits (b, v);
+
+  for (m = len; m > 0 && !u[m - 1]; m--)
+    ;
+  for (n = len; n > 0 && !v[n - 1]; n--)
+    ;
+
+  if (n == 0)
+  {
+    /* division by zero: q = ~0, r = a */
+    memset (qd, 0xff, sizeof (*qd) * len);
+    memcpy (rd, u, sizeof (*rd) * len);
+  }
+  else if (m < n)
+  {
+    memcpy (rd, u, sizeof (*rd) * len);
+  }
+  else if (n == 1)
+  {
+    /* short division */
+    for (x = 0, i = m; i > 0; i--)
+    {
+      y         = (x << 32) | u[i - 1];
+      qd[i - 1] = (uint32_t) (y / v[0]);
+      x         = y % v[0];
+    }
+    rd[0] = (uint32_t) x;
+  }
+  else
+  {
+    digits_divmod (qd, rd, u, v, m, n, un, vn);
+  }
+
+  if (q) digits_to_bv (qd, q);
+  if (r) digits_to_bv (rd, r);
+  BTOR_DELETEN (mm, buf, size);
+}
+
+void
+btor_bv_udiv_into (BtorMemMgr *mm,
+                   BtorBitVector *dst,
+                   const BtorBitVector *a,
+                   const BtorBitVector *b)
+{
+  assert (mm);
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  udiv_urem_into (mm, dst, 0, a, b);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_urem_into (BtorMemMgr *mm,
+                   BtorBitVector *dst,
+                   const BtorBitVector *a,
+                   const BtorBitVector *b)
+{
+  assert (mm);
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
+  udiv_urem_into (mm, 0, dst, a, b);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_concat_into (BtorBitVector *dst,
+                     const BtorBitVector *a,
+                     const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (dst != a);
+  assert (dst != b);
+  assert (dst->width == a->width + b->width);
+
+  int64_t i, j, k;
+  BTOR_BV_TYPE v;
+
+  j = dst->len - 1;
+
+  /* copy bits from bit vector b */
+  for (i = b->len - 1; i >= 0; i--) dst->bits[j--] = b->bits[i];
+
+  k = b->width % BTOR_BV_TYPE_BW;
+
+  /* copy bits from bit vector a */
+  if (k == 0)
+  {
+    assert (j >= 0);
+    for (i = a->len - 1; i >= 0; i--) dst->bits[j--] = a->bits[i];
+  }
+  else
+  {
+    j += 1;
+    assert (dst->bits[j] >> k == 0);
+    v = dst->bits[j];
+    for (i = a->len - 1; i >= 0; i--)
+    {
+      v = v | (a->bits[i] << k);
+      assert (j >= 0);
+      dst->bits[j--] = v;
+      v              = a->bits[i] >> (BTOR_BV_TYPE_BW - k);
+    }
+    assert (j <= 0);
+    if (j == 0) dst->bits[j] = v;
+  }
+
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_slice_into (BtorBitVector *dst,
+                    const BtorBitVector *bv,
+                    uint32_t upper,
+                    uint32_t lower)
+{
+  assert (dst);
+  assert (bv);
+  assert (lower <= upper);
+  assert (upper < bv->width);
+  assert (dst->width == upper - lower + 1);
+
+  uint32_t i;
+
+  /* chunk i of 'dst' (from LSB) only depends on chunks >= i of 'bv' (from
+   * LSB), hence 'dst' may be the same as 'bv' */
+  for (i = 0; i < dst->len; i++)
+    dst->bits[dst->len - 1 - i] = get_chunk (bv, lower + i * BTOR_BV_TYPE_BW);
+
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
+}
+
+void
+btor_bv_ite_into (BtorBitVector *dst,
+                  const BtorBitVector *c,
+                  const BtorBitVector *t,
+                  const BtorBitVector *e)
+{
+  assert (dst);
+  assert (c);
+  assert (c->len == 1);
+  assert (t);
+  assert (e);
+  assert (t->width == e->width);
+  assert (dst->width == t->width);
+
+  uint32_t i;
+  BTOR_BV_TYPE cc, nn;
+
+  cc = btor_bv_get_bit (c, 0) ? (~(BTOR_BV_TYPE) 0) : 0;
+  nn = ~cc;
+
+  for (i = 0; i < t->len; i++)
+    dst->bits[i] = (cc & t->bits[i]) | (nn & e->bits[i]);
+
+  assert (rem_bits_zero_dbg (dst));
+}
+
+/*------------------------------------------------------------------------*/
+
 bool
 btor_bv_is_umulo (BtorMemMgr *mm,
                   const BtorBitVector *a,
@@ -1853,7 +3088,9 @@ btor_bv_mod_inverse (BtorMemMgr *mm, const BtorBitVector *bv)
 
   while (!btor_bv_is_zero (b))
   {
-    udiv_urem_bv (mm, a, b, &q, &r);
+    q = btor_bv_new (mm, a->width);
+    r = btor_bv_new (mm, a->width);
+    udiv_urem_into (mm, q, r, a, b);
     btor_bv_free (mm, a);
 
     a = b;
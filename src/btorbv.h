@@ -18,7 +18,7 @@
 #include "utils/btorrng.h"
 #include "utils/btorstack.h"
 
-#define BTOR_BV_TYPE uint32_t
+#define BTOR_BV_TYPE uint64_t
 #define BTOR_BV_TYPE_BW (sizeof (BTOR_BV_TYPE) * 8)
 
 struct BtorBitVector
@@ -26,10 +26,10 @@ struct BtorBitVector
   uint32_t width; /* length of bit vector */
   uint32_t len;   /* length of 'bits' array */
 
-  /* 'bits' represents the bit vector in 32-bit chunks, first bit of 32-bit bv
+  /* 'bits' represents the bit vector in 64-bit chunks, first bit of 64-bit bv
    * in bits[0] is MSB, bit vector is 'filled' from LSB, hence spare bits (if
    * any) come in front of the MSB and are zeroed out.
-   * E.g., for a bit vector of width 31, representing value 1:
+   * E.g., for a bit vector of width 63, representing value 1:
    *
    *    bits[0] = 0 0000....1
    *              ^ ^--- MSB
@@ -40,6 +40,20 @@ struct BtorBitVector
 
 typedef struct BtorBitVector BtorBitVector;
 
+/* Storage for a bit vector of width <= BTOR_BV_TYPE_BW that does not live on
+ * the heap (e.g., temporaries on the stack). Initialize with
+ * 'btor_bv_init_inline' and pass member 'bv' to any function that expects a
+ * bit vector. Inline bit vectors must not be freed via 'btor_bv_free'.
+ * Only temporaries in btorslvpropsls.c use this form, all bit vectors created
+ * via btor_bv_new and friends are heap-allocated regardless of their width. */
+union BtorBitVectorInline
+{
+  BtorBitVector bv;
+  uint8_t mem[sizeof (BtorBitVector) + sizeof (BTOR_BV_TYPE)];
+};
+
+typedef union BtorBitVectorInline BtorBitVectorInline;
+
 BTOR_DECLARE_STACK (BtorBitVectorPtr, BtorBitVector *);
 
 BtorBitVector *btor_bv_new (BtorMemMgr *mm, uint32_t bw);
@@ -77,6 +91,12 @@ BtorBitVector *btor_bv_get_assignment (BtorMemMgr *mm, BtorNode *exp);
 
 BtorBitVector *btor_bv_copy (BtorMemMgr *mm, const BtorBitVector *bv);
 
+/* Initialize inline bit vector 'ibv' of width 'bw' <= BTOR_BV_TYPE_BW with
+ * 'value' (truncated to 'bw' bits) and return it. */
+BtorBitVector *btor_bv_init_inline (BtorBitVectorInline *ibv,
+                                    uint64_t value,
+                                    uint32_t bw);
+
 /*------------------------------------------------------------------------*/
 
 size_t btor_bv_size (const BtorBitVector *bv);
@@ -247,6 +267,111 @@ BtorBitVector *btor_bv_flipped_bit_range (BtorMemMgr *mm,
 
 /*------------------------------------------------------------------------*/
 
+/* Multiplication of bit vectors with at least 'btor_bv_karatsuba_threshold'
+ * chunks uses Karatsuba's algorithm, smaller ones use schoolbook
+ * multiplication. Division of bit vectors wider than BTOR_BV_TYPE_BW uses
+ * Knuth's algorithm D. The threshold is a variable for benchmarking purposes
+ * only (see 'perf_mul_bitvec' in testbv.c). */
+#define BTOR_BV_KARATSUBA_THRESHOLD 24
+
+extern uint32_t btor_bv_karatsuba_threshold;
+
+/* Bitwise operations, eq, ult, compare, is_zero, is_ones and hash on bit
+ * vectors with at least BTOR_BV_SIMD_MIN_LEN chunks use vectorized kernels
+ * (AVX2 or SSE2 on x86, NEON on ARM) selected at runtime, with a portable
+ * scalar fallback. The results do not depend on the selected kernels. */
+#define BTOR_BV_SIMD_MIN_LEN 4
+
+/* Get the name of the kernels currently in use. */
+const char *btor_bv_simd_kernels (void);
+
+/* Enable (default) or disable (use scalar kernels) vectorized kernels.
+ * For testing and benchmarking purposes only. */
+void btor_bv_simd_enable (bool enable);
+
+/*------------------------------------------------------------------------*/
+
+/* Destination passing variants of the operations above: the result is
+ * written into 'dst', which must already have the width of the result.
+ * Unless noted otherwise, 'dst' may be the same bit vector as an operand.
+ * 'mm' is only used for temporaries of bit vectors wider than
+ * BTOR_BV_TYPE_BW. */
+
+void btor_bv_copy_into (BtorBitVector *dst, const BtorBitVector *bv);
+
+void btor_bv_neg_into (BtorBitVector *dst, const BtorBitVector *bv);
+void btor_bv_not_into (BtorBitVector *dst, const BtorBitVector *bv);
+void btor_bv_inc_into (BtorBitVector *dst, const BtorBitVector *bv);
+void btor_bv_dec_into (BtorBitVector *dst, const BtorBitVector *bv);
+
+void btor_bv_add_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_sub_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_and_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_or_into (BtorBitVector *dst,
+                      const BtorBitVector *a,
+                      const BtorBitVector *b);
+
+void btor_bv_xor_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_eq_into (BtorBitVector *dst,
+                      const BtorBitVector *a,
+                      const BtorBitVector *b);
+
+void btor_bv_ult_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_sll_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_srl_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_mul_into (BtorMemMgr *mm,
+                       BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_udiv_into (BtorMemMgr *mm,
+                        BtorBitVector *dst,
+                        const BtorBitVector *a,
+                        const BtorBitVector *b);
+
+void btor_bv_urem_into (BtorMemMgr *mm,
+                        BtorBitVector *dst,
+                        const BtorBitVector *a,
+                        const BtorBitVector *b);
+
+/* 'dst' must not be the same as 'a' or 'b' */
+void btor_bv_concat_into (BtorBitVector *dst,
+                          const BtorBitVector *a,
+                          const BtorBitVector *b);
+
+void btor_bv_slice_into (BtorBitVector *dst,
+                         const BtorBitVector *bv,
+                         uint32_t upper,
+                         uint32_t lower);
+
+void btor_bv_ite_into (BtorBitVector *dst,
+                       const BtorBitVector *c,
+                       const BtorBitVector *t,
+                       const BtorBitVector *e);
+
+/*------------------------------------------------------------------------*/
+
 bool btor_bv_is_umulo (BtorMemMgr *mm,
                        const BtorBitVector *bv0,
                        const BtorBitVector *bv1);
@@ -163,6 +163,38 @@ chkclone_node_ptr_hash_table (BtorPtrHashTable *table,
   assert (!btor_iter_hashptr_has_next (&cit));
 }
 
+static void
+chkclone_node_ptr_hash_map (BtorPtrHashMap *map,
+                            BtorPtrHashMap *cmap,
+                            int32_t (*cmp_data) (const BtorHashTableData *,
+                                                 const BtorHashTableData *))
+{
+  BtorPtrHashMapIterator it, cit;
+  BtorPtrHashMapEntry *e, *ce;
+
+  if (!map)
+  {
+    assert (!cmap);
+    return;
+  }
+
+  assert (map->size == cmap->size);
+  assert (map->count == cmap->count);
+  assert (map->hash == cmap->hash);
+  assert (map->cmp == cmap->cmp);
+  btor_iter_hashptrmap_init (&it, map);
+  btor_iter_hashptrmap_init (&cit, cmap);
+  while (btor_iter_hashptrmap_has_next (&it))
+  {
+    assert (btor_iter_hashptrmap_has_next (&cit));
+    e  = btor_iter_hashptrmap_next_entry (&it);
+    ce = btor_iter_hashptrmap_next_entry (&cit);
+    if (cmp_data) assert (!cmp_data (&e->data, &ce->data));
+    BTOR_CHKCLONE_EXPID ((BtorNode *) e->key, (BtorNode *) ce->key);
+  }
+  assert (!btor_iter_hashptrmap_has_next (&cit));
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -383,6 +415,7 @@ chkclone_aig (BtorAIG *aig, BtorAIG *clone)
     BTOR_CHKCLONE_AIG (cnf_id);
     BTOR_CHKCLONE_AIG (mark);
     BTOR_CHKCLONE_AIG (is_var);
+    BTOR_CHKCLONE_AIG (pol);
     BTOR_CHKCLONE_AIG (local);
     if (!real_aig->is_var)
       for (i = 0; i < 2; i++) BTOR_CHKCLONE_AIG (children[i]);
@@ -409,15 +442,26 @@ chkclone_aig_unique_table (Btor *btor, Btor *clone)
 static inline void
 chkclone_aig_id_table (Btor *btor, Btor *clone)
 {
-  uint32_t i;
-  BtorAIGPtrStack *btable, *ctable;
-
-  btable = &btor_get_aig_mgr (btor)->id2aig;
-  ctable = &btor_get_aig_mgr (clone)->id2aig;
-  assert (btable != ctable);
-
-  for (i = 0; i < BTOR_COUNT_STACK (*btable); i++)
-    chkclone_aig (btable->start[i], ctable->start[i]);
+  int32_t i;
+  uint32_t chunk, idx;
+  BtorAIGMgr *bamgr, *camgr;
+
+  bamgr = btor_get_aig_mgr (btor);
+  camgr = btor_get_aig_mgr (clone);
+  assert (bamgr != camgr);
+  assert (bamgr->num_ids == camgr->num_ids);
+  assert (bamgr->free_ids == camgr->free_ids);
+  assert (bamgr->hold_ids == camgr->hold_ids);
+  assert (bamgr->held_ids == camgr->held_ids);
+
+  /* compare all nodes incl. the unused ones (free list) */
+  for (i = 2; i < bamgr->num_ids; i++)
+  {
+    chunk = i >> BTOR_AIG_CHUNK_BITS;
+    idx   = i & (BTOR_AIG_CHUNK_SIZE - 1);
+    chkclone_aig (bamgr->chunks.start[chunk] + idx,
+                  camgr->chunks.start[chunk] + idx);
+  }
 }
 
 static inline void
@@ -487,7 +531,7 @@ btor_chkclone_exp (Btor *btor,
 
   uint32_t i;
   BtorNode *real_exp, *real_cexp, *e, *ce;
-  BtorPtrHashTableIterator it, cit;
+  BtorPtrHashMapIterator it, cit;
 
   real_exp  = btor_node_real_addr (exp);
   real_cexp = btor_node_real_addr (cexp);
@@ -547,15 +591,13 @@ btor_chkclone_exp (Btor *btor,
       assert (real_exp->av == real_cexp->av);
   }
   else if (real_exp->rho)
-    chkclone_node_ptr_hash_table (real_exp->rho, real_cexp->rho, 0);
+    chkclone_node_ptr_hash_map (real_exp->rho, real_cexp->rho, 0);
 
-  BTOR_CHKCLONE_EXPPTRID (next);
+  BTOR_CHKCLONE_EXP (next);
   BTOR_CHKCLONE_EXPPTRID (simplified);
-  BTOR_CHKCLONE_EXPPTRID (first_parent);
-  BTOR_CHKCLONE_EXPPTRID (last_parent);
+  BTOR_CHKCLONE_EXP (first_parent);
+  BTOR_CHKCLONE_EXP (last_parent);
   BTOR_CHKCLONE_EXPPTRINV (simplified);
-  BTOR_CHKCLONE_EXPPTRTAG (first_parent);
-  BTOR_CHKCLONE_EXPPTRTAG (last_parent);
 
   if (btor_node_is_proxy (real_exp)) return;
 
@@ -580,10 +622,8 @@ btor_chkclone_exp (Btor *btor,
 
     for (i = 0; i < real_exp->arity; i++)
     {
-      BTOR_CHKCLONE_EXPPTRID (prev_parent[i]);
-      BTOR_CHKCLONE_EXPPTRID (next_parent[i]);
-      BTOR_CHKCLONE_EXPPTRTAG (prev_parent[i]);
-      BTOR_CHKCLONE_EXPPTRTAG (next_parent[i]);
+      BTOR_CHKCLONE_EXP (prev_parent[i]);
+      BTOR_CHKCLONE_EXP (next_parent[i]);
     }
   }
 
@@ -636,14 +676,15 @@ btor_chkclone_exp (Btor *btor,
   {
     if (btor_node_lambda_get_static_rho (real_exp))
     {
-      btor_iter_hashptr_init (&it, btor_node_lambda_get_static_rho (real_exp));
-      btor_iter_hashptr_init (&cit,
-                              btor_node_lambda_get_static_rho (real_cexp));
-      while (btor_iter_hashptr_has_next (&it))
+      btor_iter_hashptrmap_init (&it,
+                                 btor_node_lambda_get_static_rho (real_exp));
+      btor_iter_hashptrmap_init (&cit,
+                                 btor_node_lambda_get_static_rho (real_cexp));
+      while (btor_iter_hashptrmap_has_next (&it))
       {
-        assert (btor_iter_hashptr_has_next (&cit));
-        e  = btor_iter_hashptr_next (&it);
-        ce = btor_iter_hashptr_next (&cit);
+        assert (btor_iter_hashptrmap_has_next (&cit));
+        e  = btor_iter_hashptrmap_next (&it);
+        ce = btor_iter_hashptrmap_next (&cit);
         if (e)
         {
           assert (ce);
@@ -653,7 +694,7 @@ btor_chkclone_exp (Btor *btor,
         else
           assert (!ce);
       }
-      assert (!btor_iter_hashptr_has_next (&cit));
+      assert (!btor_iter_hashptrmap_has_next (&cit));
     }
 
 #if 0
@@ -747,14 +788,7 @@ chkclone_node_unique_table (Btor *btor, Btor *clone)
   assert (btable->num_elements == ctable->num_elements);
 
   for (i = 0; i < btable->size; i++)
-  {
-    if (!btable->chains[i])
-    {
-      assert (!ctable->chains[i]);
-      continue;
-    }
-    BTOR_CHKCLONE_EXPID (btable->chains[i], ctable->chains[i]);
-  }
+    assert (btable->chains[i] == ctable->chains[i]);
 }
 
 /*------------------------------------------------------------------------*/
@@ -855,7 +889,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (!btor_iter_hashptr_has_next (&cpit));
   }
 
-  chkclone_node_ptr_hash_table (btor->bv_vars, clone->bv_vars, 0);
+  chkclone_node_ptr_hash_map (btor->bv_vars, clone->bv_vars, 0);
   chkclone_node_ptr_hash_table (btor->lambdas, clone->lambdas, 0);
   chkclone_node_ptr_hash_table (btor->feqs, clone->feqs, 0);
   chkclone_node_ptr_hash_table (btor->substitutions, clone->substitutions, 0);
@@ -1038,7 +1072,13 @@ chkclone_slv (Btor *btor, Btor *clone)
     BtorPtrHashTableIterator it;
     BtorPtrHashTableIterator cit;
 
-    chkclone_node_ptr_hash_table (slv->lemmas, cslv->lemmas, 0);
+    chkclone_node_ptr_hash_table (slv->lemmas, cslv->lemmas, cmp_data_as_int);
+    chkclone_node_ptr_stack (&slv->init_apps, &cslv->init_apps);
+    chkclone_node_ptr_hash_table (
+        slv->init_apps_roots, cslv->init_apps_roots, 0);
+    chkclone_node_ptr_stack (&slv->rho_funs, &cslv->rho_funs);
+    chkclone_node_ptr_hash_table (
+        slv->rho_values, cslv->rho_values, cmp_data_as_bv_ptr);
 
     if (slv->score)
     {
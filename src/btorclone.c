@@ -85,21 +85,6 @@ btor_clone_key_as_bv_tuple (BtorMemMgr *mm, const void *map, const void *t)
   return btor_bv_copy_tuple (mm, (BtorBitVectorTuple *) t);
 }
 
-void *
-btor_clone_key_as_rw_cache_tuple (BtorMemMgr *mm,
-                                  const void *map,
-                                  const void *t)
-{
-  assert (mm);
-  assert (t);
-  (void) map;
-
-  BtorRwCacheTuple *res;
-  BTOR_CNEW (mm, res);
-  memcpy (res, t, sizeof (BtorRwCacheTuple));
-  return res;
-}
-
 void
 btor_clone_data_as_node_ptr (BtorMemMgr *mm,
                              const void *map,
@@ -488,7 +473,6 @@ clone_sorts_unique_table (BtorMemMgr * mm,
 static BtorNode *
 clone_exp (Btor *clone,
            BtorNode *exp,
-           BtorNodePtrPtrStack *parents,
            BtorNodePtrPtrStack *nodes,
            BtorNodePtrStack *rhos,
            BtorNodePtrStack *static_rhos,
@@ -498,7 +482,6 @@ clone_exp (Btor *clone,
   assert (clone);
   assert (exp);
   assert (btor_node_is_regular (exp));
-  assert (parents);
   assert (nodes);
   assert (exp_map);
 
@@ -536,19 +519,13 @@ clone_exp (Btor *clone,
   else if (exp->av)
     res->av = exp_layer_only ? 0 : btor_aigvec_clone (exp->av, clone->avmgr);
 
-  assert (!exp->next || !btor_node_is_invalid (exp->next));
-  BTOR_PUSH_STACK_IF (exp->next, *nodes, &res->next);
-
   assert (!exp->simplified || !btor_node_is_invalid (exp->simplified));
   BTOR_PUSH_STACK_IF (exp->simplified, *nodes, &res->simplified);
 
   res->btor = clone;
 
-  assert (!exp->first_parent || !btor_node_is_invalid (exp->first_parent));
-  assert (!exp->last_parent || !btor_node_is_invalid (exp->last_parent));
-
-  BTOR_PUSH_STACK_IF (exp->first_parent, *parents, &res->first_parent);
-  BTOR_PUSH_STACK_IF (exp->last_parent, *parents, &res->last_parent);
+  /* Note: unique table chains and parent lists are given as node ids, which
+   *       are the same in the clone. */
   /* <---------------------------------------------------------------------- */
 
   /* ------------ BTOR_BV_ADDITIONAL_VAR_NODE_STRUCT (all nodes) ----------> */
@@ -556,27 +533,11 @@ clone_exp (Btor *clone,
   {
     if (!btor_node_is_bv_var (exp) && !btor_node_is_param (exp))
     {
-      if (exp->arity)
-      {
-        for (i = 0; i < exp->arity; i++)
-        {
-          res->e[i] = btor_nodemap_mapped (exp_map, exp->e[i]);
-          assert (exp->e[i] != res->e[i]);
-          assert (res->e[i]);
-        }
-      }
-
       for (i = 0; i < exp->arity; i++)
       {
-        assert (!exp->prev_parent[i]
-                || !btor_node_is_invalid (exp->prev_parent[i]));
-        assert (!exp->next_parent[i]
-                || !btor_node_is_invalid (exp->next_parent[i]));
-
-        BTOR_PUSH_STACK_IF (
-            exp->prev_parent[i], *parents, &res->prev_parent[i]);
-        BTOR_PUSH_STACK_IF (
-            exp->next_parent[i], *parents, &res->next_parent[i]);
+        res->e[i] = btor_nodemap_mapped (exp_map, exp->e[i]);
+        assert (exp->e[i] != res->e[i]);
+        assert (res->e[i]);
       }
     }
   }
@@ -671,18 +632,16 @@ clone_nodes_id_table (Btor *btor,
   assert (exp_map);
 
   size_t i;
-  int32_t tag;
   BtorNode **tmp, *exp, *cloned_exp;
   BtorMemMgr *mm;
   BtorNodePtrStack *id_table;
-  BtorNodePtrPtrStack parents, nodes;
-  BtorPtrHashTable *t;
+  BtorNodePtrPtrStack nodes;
+  BtorPtrHashMap *t;
   BtorNodePtrStack static_rhos;
 
   mm       = clone->mm;
   id_table = &btor->nodes_id_table;
 
-  BTOR_INIT_STACK (mm, parents);
   BTOR_INIT_STACK (mm, nodes);
   BTOR_INIT_STACK (mm, static_rhos);
 
@@ -702,7 +661,6 @@ clone_nodes_id_table (Btor *btor,
       exp           = id_table->start[i];
       res->start[i] = exp ? clone_exp (clone,
                                        exp,
-                                       &parents,
                                        &nodes,
                                        rhos,
                                        &static_rhos,
@@ -716,7 +674,7 @@ clone_nodes_id_table (Btor *btor,
   assert (BTOR_COUNT_STACK (*res) == BTOR_COUNT_STACK (*id_table));
   assert (BTOR_SIZE_STACK (*res) == BTOR_SIZE_STACK (*id_table));
 
-  /* update children, parent, lambda and next pointers of expressions */
+  /* update simplified, lambda and param pointers of expressions */
   while (!BTOR_EMPTY_STACK (nodes))
   {
     tmp = BTOR_POP_STACK (nodes);
@@ -725,16 +683,6 @@ clone_nodes_id_table (Btor *btor,
     assert (*tmp);
   }
 
-  while (!BTOR_EMPTY_STACK (parents))
-  {
-    tmp = BTOR_POP_STACK (parents);
-    assert (*tmp);
-    tag  = btor_node_get_tag (*tmp);
-    *tmp = btor_nodemap_mapped (exp_map, btor_node_real_addr (*tmp));
-    assert (*tmp);
-    *tmp = btor_node_set_tag (*tmp, tag);
-  }
-
   /* clone static_rho tables */
   while (!BTOR_EMPTY_STACK (static_rhos))
   {
@@ -746,27 +694,24 @@ clone_nodes_id_table (Btor *btor,
     assert (t);
     btor_node_lambda_set_static_rho (
         cloned_exp,
-        btor_hashptr_table_clone (mm,
-                                  t,
-                                  btor_clone_key_as_node,
-                                  btor_clone_data_as_node_ptr,
-                                  exp_map,
-                                  exp_map));
+        btor_hashptrmap_clone (mm,
+                               t,
+                               btor_clone_key_as_node,
+                               btor_clone_data_as_node_ptr,
+                               exp_map,
+                               exp_map));
   }
 
-  BTOR_RELEASE_STACK (parents);
   BTOR_RELEASE_STACK (nodes);
   BTOR_RELEASE_STACK (static_rhos);
 }
 
 static void
-clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
+clone_nodes_unique_table (Btor *btor, Btor *clone)
 {
   assert (btor);
   assert (clone);
-  assert (exp_map);
 
-  uint32_t i;
   BtorNodeUniqueTable *table, *res;
   BtorMemMgr *mm;
 
@@ -774,16 +719,11 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
   table = &btor->nodes_unique_table;
   res   = &clone->nodes_unique_table;
 
-  BTOR_CNEWN (mm, res->chains, table->size);
+  /* chains are given as node ids, which are the same in the clone */
+  BTOR_NEWN (mm, res->chains, table->size);
+  memcpy (res->chains, table->chains, table->size * sizeof (*table->chains));
   res->size         = table->size;
   res->num_elements = table->num_elements;
-
-  for (i = 0; i < table->size; i++)
-  {
-    if (!table->chains[i]) continue;
-    res->chains[i] = btor_nodemap_mapped (exp_map, table->chains[i]);
-    assert (res->chains[i]);
-  }
 }
 
 #define MEM_INT_HASH_TABLE(table)                                 \
@@ -801,6 +741,8 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
                  + (table)->count * sizeof (BtorPtrHashBucket)                \
            : 0)
 
+#define MEM_PTR_HASH_MAP(map) ((map) ? btor_hashptrmap_size (map) : 0)
+
 #define CHKCLONE_MEM_INT_HASH_TABLE(table, clone)                      \
   do                                                                   \
   {                                                                    \
@@ -819,6 +761,12 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
     assert (MEM_PTR_HASH_TABLE (table) == MEM_PTR_HASH_TABLE (clone)); \
   } while (0)
 
+#define CHKCLONE_MEM_PTR_HASH_MAP(map, clone)                    \
+  do                                                             \
+  {                                                              \
+    assert (MEM_PTR_HASH_MAP (map) == MEM_PTR_HASH_MAP (clone)); \
+  } while (0)
+
 #define CLONE_PTR_HASH_TABLE(table)                           \
   do                                                          \
   {                                                           \
@@ -827,6 +775,14 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
     CHKCLONE_MEM_PTR_HASH_TABLE (btor->table, clone->table);  \
   } while (0)
 
+#define CLONE_PTR_HASH_MAP(map)                             \
+  do                                                        \
+  {                                                         \
+    clone->map = btor_hashptrmap_clone (                    \
+        mm, btor->map, btor_clone_key_as_node, 0, emap, 0); \
+    CHKCLONE_MEM_PTR_HASH_MAP (btor->map, clone->map);      \
+  } while (0)
+
 #define CLONE_PTR_HASH_TABLE_DATA(table, data_func)                      \
   do                                                                     \
   {                                                                      \
@@ -883,6 +839,7 @@ clone_aux_btor (Btor *btor,
   BtorPtrHashTableIterator cpit, ncpit;
   BtorIntHashTableIterator iit, ciit;
   BtorSort *sort;
+  BtorAIGVec *cav;
   char **ind, **val;
   amgr = exp_layer_only ? 0 : btor_get_aig_mgr (btor);
   BtorHashTableData *data, *cdata;
@@ -893,7 +850,7 @@ clone_aux_btor (Btor *btor,
   start = btor_util_time_stamp ();
   btor->stats.clone_calls += 1;
 
-  mm = btor_mem_mgr_new ();
+  mm = btor_mem_mgr_new_pooled ();
   BTOR_CNEW (mm, clone);
 #ifndef NDEBUG
   allocated = sizeof (Btor);
@@ -901,6 +858,8 @@ clone_aux_btor (Btor *btor,
   memcpy (clone, btor, sizeof (Btor));
   clone->mm = mm;
   BTOR_CLR (&clone->cbs);
+  /* the result cache file is not shared with clones */
+  clone->result_cache = 0;
   btor_opt_clone_opts (btor, clone);
 #ifndef NDEBUG
   allocated += BTOR_OPT_NUM_OPTS * sizeof (BtorOpt);
@@ -1007,8 +966,9 @@ clone_aux_btor (Btor *btor,
       clone->avmgr = btor_aigvec_mgr_new (clone);
       assert ((allocated += sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr)
                             + sizeof (BtorSATMgr)
-                            /* true and false AIGs */
-                            + 2 * sizeof (BtorAIG *)
+                            /* first chunk of AIG nodes */
+                            + BTOR_AIG_CHUNK_SIZE * sizeof (BtorAIG)
+                            + sizeof (BtorAIG *)
                             + sizeof (int32_t)) /* unique table chains */
               == clone->mm->allocated);
     }
@@ -1017,6 +977,19 @@ clone_aux_btor (Btor *btor,
       BTORLOG_TIMESTAMP (delta);
       clone->avmgr = btor_aigvec_mgr_clone (clone, btor->avmgr);
       BTORLOG (1, "  clone AIG mgr: %.3f s", (btor_util_time_stamp () - delta));
+#ifndef NDEBUG
+      if (clone->avmgr->div_cache)
+      {
+        btor_iter_hashptr_init (&pit, clone->avmgr->div_cache);
+        while (btor_iter_hashptr_has_next (&pit))
+        {
+          cav = pit.bucket->data.as_ptr;
+          allocated += sizeof (BtorAIGVec) + cav->width * sizeof (BtorAIG *);
+          cav = btor_iter_hashptr_next (&pit);
+          allocated += sizeof (BtorAIGVec) + cav->width * sizeof (BtorAIG *);
+        }
+      }
+#endif
       assert (
           (allocated +=
            sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr) + sizeof (BtorSATMgr)
@@ -1024,13 +997,14 @@ clone_aux_btor (Btor *btor,
            + (amgr->smgr->solver ? sizeof (BtorLGL) : 0)
 #endif
            /* memory of AIG nodes */
-           + (amgr->cur_num_aigs + amgr->cur_num_aig_vars) * sizeof (BtorAIG)
-           /* children for AND AIGs */
-           + amgr->cur_num_aigs * sizeof (int32_t) * 2
+           + BTOR_COUNT_STACK (amgr->chunks) * BTOR_AIG_CHUNK_SIZE
+                 * sizeof (BtorAIG)
            /* unique table chain */
            + amgr->table.size * sizeof (int32_t)
-           + BTOR_SIZE_STACK (amgr->id2aig) * sizeof (BtorAIG *)
-           + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t))
+           + BTOR_SIZE_STACK (amgr->chunks) * sizeof (BtorAIG *)
+           + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t)
+           /* cached dividers */
+           + MEM_PTR_HASH_TABLE (clone->avmgr->div_cache))
           == clone->mm->allocated);
     }
   }
@@ -1080,7 +1054,7 @@ clone_aux_btor (Btor *btor,
         allocated += sizeof (*(cur->av)) + cur->av->width * sizeof (BtorAIG *);
     }
     if (btor_node_is_lambda (cur) && btor_node_lambda_get_static_rho (cur))
-      allocated += MEM_PTR_HASH_TABLE (btor_node_lambda_get_static_rho (cur));
+      allocated += MEM_PTR_HASH_MAP (btor_node_lambda_get_static_rho (cur));
   }
   /* Note: hash table is initialized with size 1 */
   allocated += (emap->table->size - 1) * sizeof (BtorPtrHashBucket *)
@@ -1093,11 +1067,11 @@ clone_aux_btor (Btor *btor,
   assert (clone->true_exp);
 
   BTORLOG_TIMESTAMP (delta);
-  clone_nodes_unique_table (btor, clone, emap);
+  clone_nodes_unique_table (btor, clone);
   BTORLOG (1,
            "  clone nodes unique table: %.3f s",
            (btor_util_time_stamp () - delta));
-  assert ((allocated += btor->nodes_unique_table.size * sizeof (BtorNode *))
+  assert ((allocated += btor->nodes_unique_table.size * sizeof (int32_t))
           == clone->mm->allocated);
 
   clone->symbols = btor_hashptr_table_clone (mm,
@@ -1129,8 +1103,8 @@ clone_aux_btor (Btor *btor,
   CLONE_PTR_HASH_TABLE_DATA (inputs, btor_clone_data_as_int);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->inputs))
           == clone->mm->allocated);
-  CLONE_PTR_HASH_TABLE (bv_vars);
-  assert ((allocated += MEM_PTR_HASH_TABLE (btor->bv_vars))
+  CLONE_PTR_HASH_MAP (bv_vars);
+  assert ((allocated += MEM_PTR_HASH_MAP (btor->bv_vars))
           == clone->mm->allocated);
   CLONE_PTR_HASH_TABLE (ufs);
   assert ((allocated += MEM_PTR_HASH_TABLE (btor->ufs))
@@ -1200,6 +1174,35 @@ clone_aux_btor (Btor *btor,
            BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
           == clone->mm->allocated);
 
+  /* activation and assertion literals refer to the SAT solver, which is not
+   * cloned if only the expression layer is cloned */
+  BTOR_INIT_STACK (clone->mm, clone->assertions_act);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_act); i++)
+    BTOR_PUSH_STACK (
+        clone->assertions_act,
+        exp_layer_only ? 0 : BTOR_PEEK_STACK (btor->assertions_act, i));
+  BTOR_ADJUST_STACK (btor->assertions_act, clone->assertions_act);
+  assert ((allocated +=
+           BTOR_SIZE_STACK (btor->assertions_act) * sizeof (int32_t))
+          == clone->mm->allocated);
+
+  BTOR_INIT_STACK (clone->mm, clone->assertions_lit);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_lit); i++)
+    BTOR_PUSH_STACK (
+        clone->assertions_lit,
+        exp_layer_only ? 0 : BTOR_PEEK_STACK (btor->assertions_lit, i));
+  BTOR_ADJUST_STACK (btor->assertions_lit, clone->assertions_lit);
+  assert ((allocated +=
+           BTOR_SIZE_STACK (btor->assertions_lit) * sizeof (int32_t))
+          == clone->mm->allocated);
+
+  clone->assertions_assumed =
+      exp_layer_only
+          ? btor_hashint_table_new (clone->mm)
+          : btor_hashint_table_clone (clone->mm, btor->assertions_assumed);
+  assert ((allocated += MEM_INT_HASH_TABLE (clone->assertions_assumed))
+          == clone->mm->allocated);
+
   if (btor->bv_model)
   {
     clone->bv_model = btor_model_clone_bv (clone, btor->bv_model, false);
@@ -1266,14 +1269,14 @@ clone_aux_btor (Btor *btor,
     assert (btor_node_is_fun (exp));
     assert (btor_node_is_fun (cloned_exp));
     assert (exp->rho);
-    cloned_exp->rho = btor_hashptr_table_clone (mm,
-                                                exp->rho,
-                                                btor_clone_key_as_node,
-                                                btor_clone_data_as_node_ptr,
-                                                emap,
-                                                emap);
+    cloned_exp->rho = btor_hashptrmap_clone (mm,
+                                             exp->rho,
+                                             btor_clone_key_as_node,
+                                             btor_clone_data_as_node_ptr,
+                                             emap,
+                                             emap);
 #ifndef NDEBUG
-    allocated += MEM_PTR_HASH_TABLE (cloned_exp->rho);
+    allocated += MEM_PTR_HASH_MAP (cloned_exp->rho);
 #endif
   }
   BTOR_RELEASE_STACK (rhos);
@@ -1339,14 +1342,20 @@ clone_aux_btor (Btor *btor,
   assert (allocated == clone->mm->allocated);
 #endif
   BTOR_NEW (mm, clone->rw_cache);
-  clone->rw_cache->btor  = clone;
-  clone->rw_cache->cache = btor_hashptr_table_clone (
-      mm, btor->rw_cache->cache, btor_clone_key_as_rw_cache_tuple, 0, 0, 0);
+  memcpy (clone->rw_cache, btor->rw_cache, sizeof (BtorRwCache));
+  clone->rw_cache->btor = clone;
+  if (btor->rw_cache->cache)
+  {
+    len = btor->rw_cache->num_sets * BTOR_RW_CACHE_WAYS;
+    BTOR_NEWN (mm, clone->rw_cache->cache, len);
+    memcpy (clone->rw_cache->cache,
+            btor->rw_cache->cache,
+            len * sizeof (BtorRwCacheTuple));
+  }
 #ifndef NDEBUG
-  CHKCLONE_MEM_PTR_HASH_TABLE (btor->rw_cache->cache, clone->rw_cache->cache);
-  allocated += sizeof (*btor->rw_cache);
-  allocated += btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple);
-  allocated += MEM_PTR_HASH_TABLE (btor->rw_cache->cache);
+  assert (btor_rw_cache_size (btor->rw_cache)
+          == btor_rw_cache_size (clone->rw_cache));
+  allocated += btor_rw_cache_size (btor->rw_cache);
 #endif
 
   /* move synthesized constraints to unsynthesized if we only clone the exp
@@ -1394,6 +1403,20 @@ clone_aux_btor (Btor *btor,
       allocated += MEM_PTR_HASH_TABLE (slv->lemmas);
       allocated += BTOR_SIZE_STACK (slv->cur_lemmas) * sizeof (BtorNode *);
 
+      CHKCLONE_MEM_INT_HASH_TABLE (slv->init_apps_cache, cslv->init_apps_cache);
+      CHKCLONE_MEM_PTR_HASH_TABLE (slv->init_apps_roots, cslv->init_apps_roots);
+      allocated += BTOR_SIZE_STACK (slv->init_apps) * sizeof (BtorNode *)
+                   + MEM_INT_HASH_TABLE (slv->init_apps_cache)
+                   + MEM_PTR_HASH_TABLE (slv->init_apps_roots);
+
+      CHKCLONE_MEM_PTR_HASH_TABLE (slv->rho_values, cslv->rho_values);
+      allocated += BTOR_SIZE_STACK (slv->rho_funs) * sizeof (BtorNode *)
+                   + MEM_PTR_HASH_TABLE (slv->rho_values);
+      btor_iter_hashptr_init (&pit, slv->rho_values);
+      while (btor_iter_hashptr_has_next (&pit))
+        allocated += btor_bv_size (
+            (BtorBitVector *) btor_iter_hashptr_next_data (&pit)->as_ptr);
+
       if (slv->score)
       {
         h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -522,14 +522,21 @@ btor_print_stats (Btor *btor)
   BTOR_MSG (btor->msg, 1, "  %lld cached (add) ", btor->rw_cache->num_add);
   BTOR_MSG (btor->msg, 1, "  %lld cached (get)", btor->rw_cache->num_get);
   BTOR_MSG (btor->msg, 1, "  %lld updated", btor->rw_cache->num_update);
-  BTOR_MSG (btor->msg, 1, "  %lld removed (gc)", btor->rw_cache->num_remove);
+  BTOR_MSG (btor->msg, 1, "  %lld evicted", btor->rw_cache->num_evict);
+  BTOR_MSG (btor->msg, 1, "  %lld stale", btor->rw_cache->num_stale);
   BTOR_MSG (btor->msg,
             1,
             "  %.2f MB cache",
-            (btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple)
-             + btor->rw_cache->cache->count * sizeof (BtorPtrHashBucket)
-             + btor->rw_cache->cache->size * sizeof (BtorPtrHashBucket *))
-                / (double) (1 << 20));
+            btor_rw_cache_size (btor->rw_cache) / (double) (1 << 20));
+
+  if (btor->result_cache)
+  {
+    BTOR_MSG (btor->msg, 1, "");
+    BTOR_MSG (btor->msg, 1, "result cache");
+    BTOR_MSG (btor->msg, 1, "  %lld hits", btor->result_cache->num_hits);
+    BTOR_MSG (btor->msg, 1, "  %lld misses", btor->result_cache->num_misses);
+    BTOR_MSG (btor->msg, 1, "  %lld stored", btor->result_cache->num_stores);
+  }
 
 #ifndef NDEBUG
   BtorPtrHashTableIterator it;
@@ -578,6 +585,16 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld CNF literals",
             btor->avmgr ? btor->avmgr->amgr->num_cnf_literals : 0);
+  BTOR_MSG (btor->msg,
+            1,
+            "  %7lld AIG rewrites (%lld ANDs removed)",
+            btor->avmgr ? btor->avmgr->amgr->num_opt_rewrites : 0,
+            btor->avmgr ? btor->avmgr->amgr->num_opt_saved : 0);
+  BTOR_MSG (btor->msg,
+            1,
+            "  %7lld AIG nodes merged by SAT sweeping (%lld SAT calls)",
+            btor->avmgr ? btor->avmgr->amgr->num_fraig_merges : 0,
+            btor->avmgr ? btor->avmgr->amgr->num_fraig_sat_calls : 0);
 
   if (btor->slv) btor->slv->api.print_stats (btor->slv);
 
@@ -679,7 +696,7 @@ btor_new (void)
   BtorMemMgr *mm;
   Btor *btor;
 
-  mm = btor_mem_mgr_new ();
+  mm = btor_mem_mgr_new_pooled ();
   BTOR_CNEW (mm, btor);
 
   btor->mm  = mm;
@@ -712,9 +729,9 @@ btor_new (void)
   btor->inputs  = btor_hashptr_table_new (mm,
                                          (BtorHashPtr) btor_node_hash_by_id,
                                          (BtorCmpPtr) btor_node_compare_by_id);
-  btor->bv_vars = btor_hashptr_table_new (mm,
-                                          (BtorHashPtr) btor_node_hash_by_id,
-                                          (BtorCmpPtr) btor_node_compare_by_id);
+  btor->bv_vars = btor_hashptrmap_new (mm,
+                                       (BtorHashPtr) btor_node_hash_by_id,
+                                       (BtorCmpPtr) btor_node_compare_by_id);
   btor->ufs     = btor_hashptr_table_new (mm,
                                       (BtorHashPtr) btor_node_hash_by_id,
                                       (BtorCmpPtr) btor_node_compare_by_id);
@@ -774,6 +791,9 @@ btor_new (void)
   BTOR_INIT_STACK (mm, btor->assertions);
   BTOR_INIT_STACK (mm, btor->assertions_trail);
   btor->assertions_cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, btor->assertions_act);
+  BTOR_INIT_STACK (mm, btor->assertions_lit);
+  btor->assertions_assumed = btor_hashint_table_new (mm);
 
 #ifndef NDEBUG
   btor->stats.rw_rules_applied = btor_hashptr_table_new (
@@ -951,6 +971,9 @@ btor_delete (Btor *btor)
   BTOR_RELEASE_STACK (btor->assertions);
   BTOR_RELEASE_STACK (btor->assertions_trail);
   btor_hashint_table_delete (btor->assertions_cache);
+  BTOR_RELEASE_STACK (btor->assertions_act);
+  BTOR_RELEASE_STACK (btor->assertions_lit);
+  btor_hashint_table_delete (btor->assertions_assumed);
 
   btor_model_delete (btor);
   btor_node_release (btor, btor->true_exp);
@@ -1037,7 +1060,7 @@ btor_delete (Btor *btor)
     btor_mem_freestr (btor->mm, (char *) btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (btor->symbols);
 
-  btor_hashptr_table_delete (btor->bv_vars);
+  btor_hashptrmap_delete (btor->bv_vars);
   btor_hashptr_table_delete (btor->ufs);
   btor_hashptr_table_delete (btor->lambdas);
   btor_hashptr_table_delete (btor->quantifiers);
@@ -1057,6 +1080,8 @@ btor_delete (Btor *btor)
   btor_rw_cache_delete (btor->rw_cache);
   BTOR_DELETE (mm, btor->rw_cache);
 
+  if (btor->result_cache) btor_result_cache_delete (btor->result_cache);
+
   assert (btor->rec_rw_calls == 0);
   btor_msg_delete (btor->msg);
   BTOR_DELETE (mm, btor);
@@ -1662,6 +1687,57 @@ btor_reset_assumptions (Btor *btor)
       btor_node_release (btor, BTOR_PEEK_STACK (btor->failed_assumptions, i));
   }
   BTOR_RESET_STACK (btor->failed_assumptions);
+
+  btor_hashint_table_delete (btor->assertions_assumed);
+  btor->assertions_assumed = btor_hashint_table_new (btor->mm);
+}
+
+void
+btor_push_context (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+
+  BTOR_PUSH_STACK (btor->assertions_trail,
+                   BTOR_COUNT_STACK (btor->assertions));
+  BTOR_PUSH_STACK (btor->assertions_act, 0);
+}
+
+void
+btor_pop_context (Btor *btor)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+  assert (!BTOR_EMPTY_STACK (btor->assertions_trail));
+  assert (BTOR_COUNT_STACK (btor->assertions_trail)
+          == BTOR_COUNT_STACK (btor->assertions_act));
+
+  uint32_t pos;
+  int32_t act;
+  BtorNode *cur;
+  BtorSATMgr *smgr;
+
+  pos = BTOR_POP_STACK (btor->assertions_trail);
+  act = BTOR_POP_STACK (btor->assertions_act);
+
+  while (BTOR_COUNT_STACK (btor->assertions) > pos)
+  {
+    cur = BTOR_POP_STACK (btor->assertions);
+    (void) BTOR_POP_STACK (btor->assertions_lit);
+    btor_hashint_table_remove (btor->assertions_cache, btor_node_get_id (cur));
+    btor_node_release (btor, cur);
+  }
+
+  /* permanently disable the context, the SAT solver may then garbage collect
+   * all clauses guarded by its activation literal */
+  if (act)
+  {
+    smgr = btor_get_sat_mgr (btor);
+    assert (btor_sat_is_initialized (smgr));
+    btor_sat_add (smgr, -act);
+    btor_sat_add (smgr, 0);
+    btor_sat_mgr_release_cnf_id (smgr, act);
+  }
 }
 
 static void
@@ -1680,7 +1756,7 @@ reset_functions_with_model (Btor *btor)
     {
       assert (btor_node_is_fun (cur));
       assert (cur->rho);
-      btor_hashptr_table_delete (cur->rho);
+      btor_hashptrmap_delete (cur->rho);
       cur->rho = 0;
     }
     btor_node_release (btor, cur);
@@ -1808,7 +1884,7 @@ exp_to_cnf_lit (Btor *btor, BtorNode *exp)
       sign *= -1;
     }
 
-    if (!aig->cnf_id) btor_aig_to_sat_tseitin (amgr, aig);
+    if (!btor_aig_is_encoded (aig)) btor_aig_to_sat_tseitin (amgr, aig);
 
     res = aig->cnf_id;
     btor_aig_release (amgr, aig);
@@ -1868,6 +1944,7 @@ btor_failed_exp (Btor *btor, BtorNode *exp)
 
   bool res;
   int32_t i, lit;
+  uint32_t j, k, n;
   double start;
   BtorAIG *aig;
   BtorNode *real_exp, *cur, *e;
@@ -1905,6 +1982,25 @@ btor_failed_exp (Btor *btor, BtorNode *exp)
   {
     res = true;
   }
+  else if (btor_hashint_table_contains (btor->assertions_assumed,
+                                        btor_node_get_id (exp)))
+  {
+    /* assertion of a context, assumed via the activation literal of the
+     * context it was asserted in (see assume_contexts) */
+    res = false;
+    n   = BTOR_COUNT_STACK (btor->assertions_trail);
+    for (j = 0, k = 0; !res && j < BTOR_COUNT_STACK (btor->assertions); j++)
+    {
+      while (k + 1 < n && BTOR_PEEK_STACK (btor->assertions_trail, k + 1) <= j)
+        k++;
+      if (btor_pointer_chase_simplified_exp (
+              btor, BTOR_PEEK_STACK (btor->assertions, j))
+          != exp)
+        continue;
+      lit = BTOR_PEEK_STACK (btor->assertions_act, k);
+      res = lit && btor_sat_failed (smgr, lit) > 0;
+    }
+  }
   else if (btor_node_is_inverted (exp) || !btor_node_is_bv_and (exp))
   {
     real_exp = btor_node_real_addr (exp);
@@ -2297,8 +2393,10 @@ static void
 update_node_hash_tables (Btor *btor)
 {
   BtorNode *cur, *data, *key, *simp_key, *simp_data;
-  BtorPtrHashTableIterator it, iit;
-  BtorPtrHashTable *static_rho, *new_static_rho;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator iit;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMap *static_rho, *new_static_rho;
 
   /* update static_rhos */
   btor_iter_hashptr_init (&it, btor->lambdas);
@@ -2310,28 +2408,29 @@ update_node_hash_tables (Btor *btor)
     if (!static_rho) continue;
 
     new_static_rho =
-        btor_hashptr_table_new (btor->mm,
-                                (BtorHashPtr) btor_node_hash_by_id,
-                                (BtorCmpPtr) btor_node_compare_by_id);
+        btor_hashptrmap_new (btor->mm,
+                             (BtorHashPtr) btor_node_hash_by_id,
+                             (BtorCmpPtr) btor_node_compare_by_id);
     /* update static rho to get rid of proxy nodes */
-    btor_iter_hashptr_init (&iit, static_rho);
-    while (btor_iter_hashptr_has_next (&iit))
+    btor_iter_hashptrmap_init (&iit, static_rho);
+    while (btor_iter_hashptrmap_has_next (&iit))
     {
-      data = iit.bucket->data.as_ptr;
-      key  = btor_iter_hashptr_next (&iit);
+      e    = btor_iter_hashptrmap_next_entry (&iit);
+      data = e->data.as_ptr;
+      key  = e->key;
       assert (btor_node_is_regular (key));
       simp_key  = btor_simplify_exp (btor, key);
       simp_data = btor_simplify_exp (btor, data);
 
-      if (!btor_hashptr_table_get (new_static_rho, simp_key))
+      if (!btor_hashptrmap_get (new_static_rho, simp_key))
       {
-        btor_hashptr_table_add (new_static_rho, btor_node_copy (btor, simp_key))
+        btor_hashptrmap_add (new_static_rho, btor_node_copy (btor, simp_key))
             ->data.as_ptr = btor_node_copy (btor, simp_data);
       }
       btor_node_release (btor, key);
       btor_node_release (btor, data);
     }
-    btor_hashptr_table_delete (static_rho);
+    btor_hashptrmap_delete (static_rho);
     btor_node_lambda_set_static_rho (cur, new_static_rho);
   }
 }
@@ -3389,8 +3488,9 @@ btor_synthesize_exp (Btor *btor,
   BtorMemMgr *mm;
   BtorAIGVecMgr *avmgr;
   BtorPtrHashBucket *b;
-  BtorPtrHashTable *static_rho;
-  BtorPtrHashTableIterator it;
+  BtorPtrHashMap *static_rho;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
   char *indexed_name;
   const char *name;
   uint32_t count, i, j, len;
@@ -3399,8 +3499,9 @@ btor_synthesize_exp (Btor *btor,
   bool invert_av1 = false;
   bool invert_av2 = false;
   double start;
-  bool restart, opt_lazy_synth;
+  bool restart, opt_lazy_synth, opt_aig_optimize, opt_encode;
   BtorIntHashTable *cache;
+  BtorAIGVecPtrStack encode;
 
   assert (btor);
   assert (exp);
@@ -3411,8 +3512,16 @@ btor_synthesize_exp (Btor *btor,
   count          = 0;
   cache          = btor_hashint_table_new (mm);
   opt_lazy_synth = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  /* with AIG optimization enabled, the synthesized AIG vectors are optimized
+   * and encoded at once when all expressions are synthesized */
+  opt_aig_optimize = btor_opt_get (btor, BTOR_OPT_AIG_REWRITE) > 0
+                     || btor_opt_get (btor, BTOR_OPT_AIG_FRAIG);
+  /* with polarity-aware encoding, only assertions, assumptions and lemmas
+   * are encoded on demand */
+  opt_encode = !btor_opt_get (btor, BTOR_OPT_AIG_PG);
 
   BTOR_INIT_STACK (mm, exp_stack);
+  BTOR_INIT_STACK (mm, encode);
   BTOR_PUSH_STACK (exp_stack, exp);
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
 
@@ -3464,7 +3573,7 @@ btor_synthesize_exp (Btor *btor,
           }
         }
         BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-        btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+        if (opt_encode) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
 
         /* continue synthesizing children for apply and feq nodes if
          * lazy_synthesize is disabled */
@@ -3492,11 +3601,12 @@ btor_synthesize_exp (Btor *btor,
           static_rho = btor_node_lambda_get_static_rho (cur);
           if (static_rho)
           {
-            btor_iter_hashptr_init (&it, static_rho);
-            while (btor_iter_hashptr_has_next (&it))
+            btor_iter_hashptrmap_init (&it, static_rho);
+            while (btor_iter_hashptrmap_has_next (&it))
             {
-              value = it.bucket->data.as_ptr;
-              args  = btor_iter_hashptr_next (&it);
+              e     = btor_iter_hashptrmap_next_entry (&it);
+              value = e->data.as_ptr;
+              args  = e->key;
               BTOR_PUSH_STACK (exp_stack, btor_simplify_exp (btor, value));
               BTOR_PUSH_STACK (exp_stack, btor_simplify_exp (btor, args));
             }
@@ -3609,7 +3719,8 @@ btor_synthesize_exp (Btor *btor,
           if (invert_av0) btor_aigvec_invert (avmgr, av0);
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
-        if (!opt_lazy_synth) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+        if (!opt_lazy_synth && !opt_aig_optimize && opt_encode)
+          btor_aigvec_to_sat_tseitin (avmgr, cur->av);
       }
       else
       {
@@ -3658,10 +3769,21 @@ btor_synthesize_exp (Btor *btor,
       }
       assert (cur->av);
       BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-      btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+      if (opt_aig_optimize)
+        BTOR_PUSH_STACK (encode, cur->av);
+      else if (opt_encode)
+        btor_aigvec_to_sat_tseitin (avmgr, cur->av);
     }
   }
   BTOR_RELEASE_STACK (exp_stack);
+
+  if (!BTOR_EMPTY_STACK (encode))
+  {
+    btor_aigvec_optimize (avmgr, encode.start, BTOR_COUNT_STACK (encode));
+    for (i = 0; opt_encode && i < BTOR_COUNT_STACK (encode); i++)
+      btor_aigvec_to_sat_tseitin (avmgr, BTOR_PEEK_STACK (encode, i));
+  }
+  BTOR_RELEASE_STACK (encode);
   btor_hashint_table_delete (cache);
 
   if (count > 0 && btor_opt_get (btor, BTOR_OPT_VERBOSITY) > 3)
@@ -3671,6 +3793,67 @@ btor_synthesize_exp (Btor *btor,
   btor->time.synth_exp += btor_util_time_stamp () - start;
 }
 
+/* Add the assertions on stack 'assertions' to the SAT solver, each guarded
+ * by the activation literal of its context, and assume the activation
+ * literals of all contexts.  An assertion is added again only if its
+ * encoding changed due to simplifications since it was last added. */
+static void
+assume_contexts (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, k, n;
+  int32_t act, lit;
+  BtorNode *exp;
+  BtorAIG *aig;
+  BtorSATMgr *smgr;
+  BtorAIGMgr *amgr;
+
+  amgr = btor_get_aig_mgr (btor);
+  smgr = btor_get_sat_mgr (btor);
+  assert (btor_sat_is_initialized (smgr));
+
+  n = BTOR_COUNT_STACK (btor->assertions_trail);
+  assert (n == BTOR_COUNT_STACK (btor->assertions_act));
+  assert (BTOR_COUNT_STACK (btor->assertions)
+          == BTOR_COUNT_STACK (btor->assertions_lit));
+
+  for (i = 0, k = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+  {
+    /* the context of an assertion is the last one pushed before it */
+    while (k + 1 < n && BTOR_PEEK_STACK (btor->assertions_trail, k + 1) <= i)
+      k++;
+    assert (BTOR_PEEK_STACK (btor->assertions_trail, k) <= i);
+
+    exp = btor_pointer_chase_simplified_exp (
+        btor, BTOR_PEEK_STACK (btor->assertions, i));
+    aig = exp_to_aig (btor, exp);
+    btor_aig_lit_to_sat (amgr, aig);
+    lit = btor_aig_get_cnf_id (aig);
+    btor_aig_release (amgr, aig);
+    assert (lit);
+    if (BTOR_PEEK_STACK (btor->assertions_lit, i) == lit) continue;
+    BTOR_POKE_STACK (btor->assertions_lit, i, lit);
+    if (aig == BTOR_AIG_TRUE) continue;
+
+    act = BTOR_PEEK_STACK (btor->assertions_act, k);
+    if (!act)
+    {
+      act = btor_sat_mgr_next_cnf_id (smgr);
+      BTOR_POKE_STACK (btor->assertions_act, k, act);
+    }
+    btor_sat_add (smgr, -act);
+    btor_sat_add (smgr, lit);
+    btor_sat_add (smgr, 0);
+  }
+
+  for (k = 0; k < n; k++)
+  {
+    act = BTOR_PEEK_STACK (btor->assertions_act, k);
+    if (act) btor_sat_assume (smgr, act);
+  }
+}
+
 /* forward assumptions to the SAT solver */
 void
 btor_add_again_assumptions (Btor *btor)
@@ -3704,6 +3887,11 @@ btor_add_again_assumptions (Btor *btor)
     exp = btor_iter_hashptr_next (&it);
     assert (!btor_node_is_proxy (exp));
 
+    /* passed to the SAT solver via activation literals below */
+    if (btor_hashint_table_contains (btor->assertions_assumed,
+                                     btor_node_get_id (exp)))
+      continue;
+
     if (btor_node_is_inverted (exp) || !btor_node_is_bv_and (exp))
     {
       if (!btor_hashptr_table_get (assumptions, exp))
@@ -3738,7 +3926,7 @@ btor_add_again_assumptions (Btor *btor)
     assert (btor_node_bv_get_width (btor, cur) == 1);
     assert (!btor_node_real_addr (cur)->simplified);
     aig = exp_to_aig (btor, cur);
-    btor_aig_to_sat (amgr, aig);
+    btor_aig_lit_to_sat (amgr, aig);
     if (aig == BTOR_AIG_TRUE) continue;
     if (btor_sat_is_initialized (smgr))
     {
@@ -3748,6 +3936,9 @@ btor_add_again_assumptions (Btor *btor)
     btor_aig_release (amgr, aig);
   }
 
+  if (btor->assertions_assumed->count > 0 && btor_sat_is_initialized (smgr))
+    assume_contexts (btor);
+
   BTOR_RELEASE_STACK (stack);
   btor_hashptr_table_delete (assumptions);
   btor_hashint_table_delete (mark);
@@ -3788,7 +3979,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   bool check = true;
 #endif
   double start, delta;
-  BtorSolverResult res;
+  BtorSolverResult res, cached;
   uint32_t engine;
 
   start = btor_util_time_stamp ();
@@ -3845,8 +4036,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
     inputs = map_inputs_check_model (btor, mclone);
 
-    // NOTE: cadical does not support incremental mode, which is required for
-    // checking the model. we need to switch to lingeling.
+    // NOTE: the incremental support of the cadical backend has not been
+    // validated against the incremental regression tests yet, checking the
+    // model uses lingeling for now.
 #ifdef BTOR_USE_CADICAL
     if (btor_opt_get (mclone, BTOR_OPT_SAT_ENGINE) == BTOR_SAT_ENGINE_CADICAL)
     {
@@ -3906,7 +4098,23 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   res = btor_simplify (btor);
 
-  if (res != BTOR_RESULT_UNSAT)
+  /* Formulas with assumptions are not cached since failed assumptions can not
+   * be determined without solving. */
+  cached = BTOR_RESULT_UNKNOWN;
+  if (res != BTOR_RESULT_UNSAT && btor->result_cache
+      && btor->assumptions->count == 0 && BTOR_EMPTY_STACK (btor->assertions))
+    cached = btor_result_cache_lookup (btor->result_cache);
+
+  if (cached != BTOR_RESULT_UNKNOWN)
+  {
+    BTOR_MSG (btor->msg, 1, "result cache hit");
+    res = cached;
+#ifndef NDEBUG
+    /* results restored from the result cache are not checked */
+    check = false;
+#endif
+  }
+  else if (res != BTOR_RESULT_UNSAT)
   {
     engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
 
@@ -3961,13 +4169,23 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     /* 'btor->assertions' contains all assertions that were asserted in context
      * levels > 0 (boolector_push). We assume all these assertions on every
      * btor_check_sat call since these assumptions are valid until the
-     * corresponding context is popped. */
+     * corresponding context is popped. The SAT solver only sees the
+     * activation literals of the contexts (see assume_contexts). */
     if (BTOR_COUNT_STACK (btor->assertions) > 0)
     {
       assert (BTOR_COUNT_STACK (btor->assertions_trail) > 0);
       uint32_t i;
+      BtorNode *ass;
+      if (btor->valid_assignments) btor_reset_incremental_usage (btor);
       for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
-        btor_assume_exp (btor, BTOR_PEEK_STACK (btor->assertions, i));
+      {
+        ass = BTOR_PEEK_STACK (btor->assertions, i);
+        if (!btor_is_assumption_exp (btor, ass))
+          btor_hashint_table_add (
+              btor->assertions_assumed,
+              btor_node_get_id (btor_pointer_chase_simplified_exp (btor, ass)));
+        btor_assume_exp (btor, ass);
+      }
     }
 
     assert (btor->slv);
@@ -3977,7 +4195,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   btor->btor_sat_btor_called++;
   btor->valid_assignments = 1;
 
-  if (btor_opt_get (btor, BTOR_OPT_MODEL_GEN) && res == BTOR_RESULT_SAT)
+  /* the model was already restored on a result cache hit */
+  if (btor_opt_get (btor, BTOR_OPT_MODEL_GEN) && res == BTOR_RESULT_SAT
+      && cached == BTOR_RESULT_UNKNOWN)
   {
     switch (btor_opt_get (btor, BTOR_OPT_ENGINE))
     {
@@ -3993,6 +4213,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     }
   }
 
+  if (btor->result_cache && cached == BTOR_RESULT_UNKNOWN)
+    btor_result_cache_store (btor->result_cache, res);
+
 #ifndef NDEBUG
   if (uclone)
   {
@@ -4008,7 +4231,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   if (mclone)
   {
     assert (inputs);
-    if (res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
+    if (check && res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
     {
       if (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
       {
@@ -4168,23 +4391,25 @@ map_inputs_check_model (Btor *btor, Btor *clone)
 
   BtorNode *cur;
   BtorPtrHashBucket *b;
+  BtorPtrHashMapEntry *e;
   BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator mit;
   BtorPtrHashTable *inputs;
 
   inputs = btor_hashptr_table_new (clone->mm,
                                    (BtorHashPtr) btor_node_hash_by_id,
                                    (BtorCmpPtr) btor_node_compare_by_id);
 
-  btor_iter_hashptr_init (&it, clone->bv_vars);
-  while (btor_iter_hashptr_has_next (&it))
+  btor_iter_hashptrmap_init (&mit, clone->bv_vars);
+  while (btor_iter_hashptrmap_has_next (&mit))
   {
-    cur = btor_iter_hashptr_next (&it);
-    b   = btor_hashptr_table_get (btor->bv_vars, cur);
-    assert (b);
+    cur = btor_iter_hashptrmap_next (&mit);
+    e   = btor_hashptrmap_get (btor->bv_vars, cur);
+    assert (e);
 
     assert (!btor_hashptr_table_get (inputs, cur));
     btor_hashptr_table_add (inputs, btor_node_copy (clone, cur))->data.as_ptr =
-        btor_node_copy (btor, (BtorNode *) b->key);
+        btor_node_copy (btor, (BtorNode *) e->key);
   }
 
   btor_iter_hashptr_init (&it, clone->ufs);
@@ -16,6 +16,7 @@
 #include "btormsg.h"
 #include "btornode.h"
 #include "btoropt.h"
+#include "btorresultcache.h"
 #include "btorrwcache.h"
 #include "btorsat.h"
 #include "btorslv.h"
@@ -56,7 +57,7 @@ struct BtorNodeUniqueTable
 {
   uint32_t size;
   uint32_t num_elements;
-  BtorNode **chains;
+  int32_t *chains; /* node ids, chained via BtorNode::next */
 };
 
 typedef struct BtorNodeUniqueTable BtorNodeUniqueTable;
@@ -106,7 +107,7 @@ struct Btor
   BtorPtrHashTable *node2symbol;
 
   BtorPtrHashTable *inputs;
-  BtorPtrHashTable *bv_vars;
+  BtorPtrHashMap *bv_vars;
   BtorPtrHashTable *ufs;
   BtorPtrHashTable *lambdas;
   BtorPtrHashTable *quantifiers;
@@ -127,6 +128,7 @@ struct Btor
   uint32_t rec_rw_calls; /* calls for recursive rewriting */
   uint32_t valid_assignments;
   BtorRwCache *rw_cache;
+  BtorResultCache *result_cache; /* persistent result cache (optional) */
 
   int32_t vis_idx; /* file index for visualizing expressions */
 
@@ -158,6 +160,16 @@ struct Btor
   BtorIntHashTable *assertions_cache;
   /* saves the number of assertions on each push */
   BtorUIntStack assertions_trail;
+  /* activation literal (CNF id) of each context on 'assertions_trail',
+   * 0 if not allocated yet */
+  BtorIntStack assertions_act;
+  /* CNF literal the assertion at the same position on stack 'assertions'
+   * was added to the SAT solver with (guarded by the activation literal of
+   * its context), 0 if not added yet */
+  BtorIntStack assertions_lit;
+  /* ids of the assumptions that solely stem from assuming the assertions on
+   * stack 'assertions' (passed to the SAT solver via activation literals) */
+  BtorIntHashTable *assertions_assumed;
   /* Number of push/pop calls (used for unique symbol prefixes) */
   uint32_t num_push_pop;
 
@@ -286,6 +298,13 @@ void btor_fixate_assumptions (Btor *btor);
 /* Resets assumptions */
 void btor_reset_assumptions (Btor *btor);
 
+/* Creates a new context level for assertions (boolector_push). */
+void btor_push_context (Btor *btor);
+
+/* Removes the assertions of the last context level and permanently disables
+ * them in the SAT solver (boolector_pop). */
+void btor_pop_context (Btor *btor);
+
 /* Solves instance, but with lemmas on demand limit 'lod_limit' and conflict
  * limit for the underlying SAT solver 'sat_limit'. */
 int32_t btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit);
@@ -27,8 +27,10 @@ bool
 btor_dbg_check_lambdas_static_rho_proxy_free (const Btor *btor)
 {
   BtorNode *cur, *data, *key;
-  BtorPtrHashTableIterator it, iit;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator iit;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMap *static_rho;
 
   btor_iter_hashptr_init (&it, btor->lambdas);
   while (btor_iter_hashptr_has_next (&it))
@@ -37,11 +39,12 @@ btor_dbg_check_lambdas_static_rho_proxy_free (const Btor *btor)
     static_rho = btor_node_lambda_get_static_rho (cur);
     if (!static_rho) continue;
 
-    btor_iter_hashptr_init (&iit, static_rho);
-    while (btor_iter_hashptr_has_next (&iit))
+    btor_iter_hashptrmap_init (&iit, static_rho);
+    while (btor_iter_hashptrmap_has_next (&iit))
     {
-      data = iit.bucket->data.as_ptr;
-      key  = btor_iter_hashptr_next (&iit);
+      e    = btor_iter_hashptrmap_next_entry (&iit);
+      data = e->data.as_ptr;
+      key  = e->key;
       assert (data);
       if (btor_node_is_proxy (data)) return false;
       if (btor_node_is_proxy (key)) return false;
@@ -57,7 +60,10 @@ btor_dbg_check_unique_table_children_proxy_free (const Btor *btor)
   BtorNode *cur;
 
   for (i = 0; i < btor->nodes_unique_table.size; i++)
-    for (cur = btor->nodes_unique_table.chains[i]; cur; cur = cur->next)
+    for (cur = BTOR_PEEK_STACK (btor->nodes_id_table,
+                                btor->nodes_unique_table.chains[i]);
+         cur;
+         cur = BTOR_PEEK_STACK (btor->nodes_id_table, cur->next))
       for (j = 0; j < cur->arity; j++)
         if (btor_node_is_proxy (cur->e[j])) return false;
   return true;
@@ -1725,7 +1725,6 @@ btor_exp_lambda_write (Btor *btor,
 {
   BtorNode *param, *e_cond, *e_if, *e_else, *bvcond, *args;
   BtorLambdaNode *lambda;
-  BtorPtrHashBucket *b;
 
   param  = btor_exp_param (btor, btor_node_get_sort_id (e_index), 0);
   e_cond = btor_exp_eq (btor, param, e_index);
@@ -1736,12 +1735,12 @@ btor_exp_lambda_write (Btor *btor,
   if (!lambda->static_rho)
   {
     lambda->static_rho =
-        btor_hashptr_table_new (btor->mm,
-                                (BtorHashPtr) btor_node_hash_by_id,
-                                (BtorCmpPtr) btor_node_compare_by_id);
-    args           = btor_exp_args (btor, &e_index, 1);
-    b              = btor_hashptr_table_add (lambda->static_rho, args);
-    b->data.as_ptr = btor_node_copy (btor, e_value);
+        btor_hashptrmap_new (btor->mm,
+                             (BtorHashPtr) btor_node_hash_by_id,
+                             (BtorCmpPtr) btor_node_compare_by_id);
+    args = btor_exp_args (btor, &e_index, 1);
+    btor_hashptrmap_add (lambda->static_rho, args)->data.as_ptr =
+        btor_node_copy (btor, e_value);
   }
   btor_node_release (btor, e_if);
   btor_node_release (btor, e_else);
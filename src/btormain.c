@@ -62,6 +62,7 @@ enum BtorMainOption
   BTORMAIN_OPT_VERSION,
   BTORMAIN_OPT_TIME,
   BTORMAIN_OPT_OUTPUT,
+  BTORMAIN_OPT_RESULT_CACHE,
   BTORMAIN_OPT_LGL_NOFORK,
   BTORMAIN_OPT_HEX,
   BTORMAIN_OPT_DEC,
@@ -219,6 +220,18 @@ btormain_init_opts (BtorMainApp *app)
                      false,
                      BTOR_ARG_EXPECT_STR,
                      "set output file for dumping");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_RESULT_CACHE,
+                     true,
+                     false,
+                     "result-cache",
+                     0,
+                     0,
+                     0,
+                     0,
+                     false,
+                     BTOR_ARG_EXPECT_STR,
+                     "use persistent result cache file");
 #ifdef BTOR_USE_LINGELING
   btormain_init_opt (app,
                      BTORMAIN_OPT_LGL_NOFORK,
@@ -1171,6 +1184,10 @@ boolector_main (int32_t argc, char **argv)
           g_app->outfile_name = po->valstr;
           break;
 
+        case BTORMAIN_OPT_RESULT_CACHE:
+          boolector_set_result_cache (btor, po->valstr);
+          break;
+
         case BTORMAIN_OPT_SMT2_MODEL:
           g_app->options[BTORMAIN_OPT_SMT2_MODEL].val += 1;
           break;
@@ -1271,7 +1288,12 @@ boolector_main (int32_t argc, char **argv)
         btormain_error (g_app, "missing argument for '%s'", po->orig.start);
         goto DONE;
       }
-      if (bo->options)
+      if (bopt == BTOR_OPT_SAT_ENGINE && po->valstr
+          && !strncmp (po->valstr, "ipasir:", 7))
+      {
+        boolector_set_sat_solver (btor, po->valstr);
+      }
+      else if (bo->options)
       {
         if (strcmp (po->valstr, "help") == 0)
         {
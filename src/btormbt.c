@@ -828,6 +828,9 @@ btormbt_new_btormbt (void)
     btoropt->desc = boolector_get_opt_desc (tmpbtor, opt);
     /* disabling incremental not supported */
     if (opt == BTOR_OPT_INCREMENTAL) btoropt->min = btoropt->max;
+    /* keep the number of threads small */
+    if (opt == BTOR_OPT_SAT_ENGINE_PORTFOLIO) btoropt->max = 4;
+    if (opt == BTOR_OPT_FUN_PROP_THREADS) btoropt->max = 4;
     /* check if opt is an engine opt */
     if (strchr (btoropt->name, ':'))
     {
@@ -2713,9 +2716,9 @@ btormbt_state_opt (BtorMBT *mbt)
 
   if (!btoropt->forced_by_cl)
   {
-    /* pick SAT engine randomly */
-    btoropt->val =
-        btor_rng_pick_rand (&mbt->round.rng, btoropt->min, btoropt->max);
+    /* pick SAT engine randomly (IPASIR requires a library path) */
+    btoropt->val = btor_rng_pick_rand (
+        &mbt->round.rng, btoropt->min, BTOR_SAT_ENGINE_IPASIR - 1);
   }
 
   if (btor_rng_pick_with_prob (&mbt->round.rng, 500))
@@ -2740,7 +2743,7 @@ btormbt_state_opt (BtorMBT *mbt)
   BTORMBT_LOG (
       1, "opt: set boolector option '%s' to '%d'", btoropt->name, btoropt->val);
 
-  // currently, CaDiCaL only support non-incremental calls
+  // the incremental support of the CaDiCaL backend is not validated yet
   if (boolector_get_opt (mbt->btor, BTOR_OPT_SAT_ENGINE)
       == BTOR_SAT_ENGINE_CADICAL)
   {
@@ -2860,8 +2863,8 @@ btormbt_state_opt (BtorMBT *mbt)
     }
 
     /* set some mbt specific options */
-    // NOTE: inc flag required since CaDiCaL does not yet support incremental
-    // mode
+    // NOTE: inc flag required since the incremental mode of CaDiCaL is not
+    // validated yet
     if (btoropt->kind == BTOR_OPT_INCREMENTAL && btoropt->val == 1 && inc)
     {
       mbt->round.inc = true;
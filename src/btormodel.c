@@ -232,20 +232,22 @@ mk_bv_tuple_from_args (Btor *btor,
 static void
 add_rho_to_model (Btor *btor,
                   BtorNode *fun,
-                  BtorPtrHashTable *rho,
+                  BtorPtrHashMap *rho,
                   BtorIntHashTable *bv_model,
                   BtorIntHashTable *fun_model)
 {
   BtorNode *value, *args;
   BtorBitVectorTuple *t;
   BtorBitVector *bv_value;
-  BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
 
-  btor_iter_hashptr_init (&it, rho);
-  while (btor_iter_hashptr_has_next (&it))
+  btor_iter_hashptrmap_init (&it, rho);
+  while (btor_iter_hashptrmap_has_next (&it))
   {
-    value = (BtorNode *) it.bucket->data.as_ptr;
-    args  = btor_iter_hashptr_next (&it);
+    e     = btor_iter_hashptrmap_next_entry (&it);
+    value = (BtorNode *) e->data.as_ptr;
+    args  = e->key;
     assert (!btor_node_real_addr (value)->parameterized);
     assert (btor_node_is_regular (args));
     assert (btor_node_is_args (args));
@@ -275,7 +277,7 @@ recursively_compute_function_model (Btor *btor,
 
   int32_t i;
   BtorNode *value, *cur_fun, *cur;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashMap *static_rho;
   BtorBitVectorTuple *t;
   BtorBitVector *bv_value;
   BtorMemMgr *mm;
@@ -735,7 +737,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
   BtorNode *cur, *real_cur, *next, *cur_parent;
   BtorHashTableData *d, dd;
   BtorIntHashTable *assigned, *reset_st, *param_model_cache;
-  BtorBitVector *result = 0, *inv_result, **e;
+  BtorBitVector *result = 0, **e;
   BtorBitVectorTuple *t;
   BtorIntHashTable *mark;
   BtorHashTableData *md;
@@ -903,6 +905,8 @@ btor_model_recursively_compute_assignment (Btor *btor,
 
       e = (BtorBitVector **) arg_stack.top; /* arguments in reverse order */
 
+      /* Note: results of the same width as the operands are computed in place
+       *       (into the storage of e[1]) to avoid allocating new bit vectors */
       switch (real_cur->kind)
       {
         case BTOR_BV_SLICE_NODE:
@@ -913,9 +917,9 @@ btor_model_recursively_compute_assignment (Btor *btor,
           btor_bv_free (mm, e[0]);
           break;
         case BTOR_BV_AND_NODE:
-          result = btor_bv_and (mm, e[1], e[0]);
+          btor_bv_and_into (e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_EQ_NODE:
           result = btor_bv_eq (mm, e[1], e[0]);
@@ -923,14 +927,14 @@ btor_model_recursively_compute_assignment (Btor *btor,
           btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_ADD_NODE:
-          result = btor_bv_add (mm, e[1], e[0]);
+          btor_bv_add_into (e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_MUL_NODE:
-          result = btor_bv_mul (mm, e[1], e[0]);
+          btor_bv_mul_into (mm, e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_ULT_NODE:
           result = btor_bv_ult (mm, e[1], e[0]);
@@ -938,24 +942,24 @@ btor_model_recursively_compute_assignment (Btor *btor,
           btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_SLL_NODE:
-          result = btor_bv_sll (mm, e[1], e[0]);
+          btor_bv_sll_into (e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_SRL_NODE:
-          result = btor_bv_srl (mm, e[1], e[0]);
+          btor_bv_srl_into (e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_UDIV_NODE:
-          result = btor_bv_udiv (mm, e[1], e[0]);
+          btor_bv_udiv_into (mm, e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_UREM_NODE:
-          result = btor_bv_urem (mm, e[1], e[0]);
+          btor_bv_urem_into (mm, e[1], e[1], e[0]);
+          result = e[1];
           btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
           break;
         case BTOR_BV_CONCAT_NODE:
           result = btor_bv_concat (mm, e[1], e[0]);
@@ -1098,12 +1102,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
       }
 
     PUSH_RESULT:
-      if (btor_node_is_inverted (cur))
-      {
-        inv_result = btor_bv_not (mm, result);
-        btor_bv_free (mm, result);
-        result = inv_result;
-      }
+      if (btor_node_is_inverted (cur)) btor_bv_not_into (result, result);
       BTOR_PUSH_STACK (arg_stack, result);
     }
     else
@@ -474,7 +474,8 @@ setup_node_and_add_to_id_table (Btor *btor, void *ptr)
   exp->btor = btor;
   btor->stats.expressions++;
   id = BTOR_COUNT_STACK (btor->nodes_id_table);
-  BTOR_ABORT (id == INT32_MAX, "expression id overflow");
+  /* parent lists store ids tagged with the child position (2 bits) */
+  BTOR_ABORT (id >= (1u << 30), "expression id overflow");
   exp->id = id;
   BTOR_PUSH_STACK (btor->nodes_id_table, exp);
   assert (BTOR_COUNT_STACK (btor->nodes_id_table) == (size_t) exp->id + 1);
@@ -493,7 +494,8 @@ enlarge_nodes_unique_table (Btor *btor)
   BtorMemMgr *mm;
   uint32_t size, new_size, i;
   uint32_t hash;
-  BtorNode *cur, *temp, **new_chains;
+  int32_t *new_chains;
+  BtorNode *cur, *temp;
 
   mm       = btor->mm;
   size     = btor->nodes_unique_table.size;
@@ -501,16 +503,16 @@ enlarge_nodes_unique_table (Btor *btor)
   BTOR_CNEWN (mm, new_chains, new_size);
   for (i = 0; i < size; i++)
   {
-    cur = btor->nodes_unique_table.chains[i];
+    cur = btor_node_get_by_id (btor, btor->nodes_unique_table.chains[i]);
     while (cur)
     {
       assert (btor_node_is_regular (cur));
       assert (!btor_node_is_bv_var (cur));
       assert (!btor_node_is_uf (cur));
-      temp             = cur->next;
+      temp             = btor_node_get_by_id (btor, cur->next);
       hash             = compute_hash_exp (btor, cur, new_size);
       cur->next        = new_chains[hash];
-      new_chains[hash] = cur;
+      new_chains[hash] = cur->id;
       cur              = temp;
     }
   }
@@ -535,14 +537,14 @@ remove_from_nodes_unique_table_exp (Btor *btor, BtorNode *exp)
 
   hash = compute_hash_exp (btor, exp, btor->nodes_unique_table.size);
   prev = 0;
-  cur  = btor->nodes_unique_table.chains[hash];
+  cur  = btor_node_get_by_id (btor, btor->nodes_unique_table.chains[hash]);
 
   while (cur != exp)
   {
     assert (cur);
     assert (btor_node_is_regular (cur));
     prev = cur;
-    cur  = cur->next;
+    cur  = btor_node_get_by_id (btor, cur->next);
   }
   assert (cur);
   if (!prev)
@@ -569,7 +571,7 @@ remove_from_hash_tables (Btor *btor, BtorNode *exp, bool keep_symbol)
   switch (exp->kind)
   {
     case BTOR_VAR_NODE:
-      btor_hashptr_table_remove (btor->bv_vars, exp, 0, 0);
+      btor_hashptrmap_remove (btor->bv_vars, exp, 0, 0);
       break;
     case BTOR_LAMBDA_NODE:
       btor_hashptr_table_remove (btor->lambdas, exp, 0, 0);
@@ -622,10 +624,9 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
   assert (!btor_node_is_args (child) || btor_node_is_args (parent)
           || btor_node_is_apply (parent) || btor_node_is_update (parent));
 
-  (void) btor;
-  uint32_t tag;
   bool insert_beginning = 1;
-  BtorNode *real_child, *first_parent, *last_parent, *tagged_parent;
+  uint32_t first_parent, last_parent, tagged_parent;
+  BtorNode *real_child;
 
   /* set specific flags */
 
@@ -655,7 +656,7 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
 
   real_child     = btor_node_real_addr (child);
   parent->e[pos] = child;
-  tagged_parent  = btor_node_set_tag (parent, pos);
+  tagged_parent  = btor_node_get_parent_id (parent, pos);
 
   assert (!parent->prev_parent[pos]);
   assert (!parent->next_parent[pos]);
@@ -673,9 +674,9 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
     first_parent = real_child->first_parent;
     assert (first_parent);
     parent->next_parent[pos] = first_parent;
-    tag                      = btor_node_get_tag (first_parent);
-    btor_node_real_addr (first_parent)->prev_parent[tag] = tagged_parent;
-    real_child->first_parent                             = tagged_parent;
+    BTOR_PREV_PARENT (btor_node_get_parent_by_id (btor, first_parent)) =
+        tagged_parent;
+    real_child->first_parent = tagged_parent;
   }
   /* add parent at the end of the list */
   else
@@ -683,9 +684,9 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
     last_parent = real_child->last_parent;
     assert (last_parent);
     parent->prev_parent[pos] = last_parent;
-    tag                      = btor_node_get_tag (last_parent);
-    btor_node_real_addr (last_parent)->next_parent[tag] = tagged_parent;
-    real_child->last_parent                             = tagged_parent;
+    BTOR_NEXT_PARENT (btor_node_get_parent_by_id (btor, last_parent)) =
+        tagged_parent;
+    real_child->last_parent = tagged_parent;
   }
 }
 
@@ -702,11 +703,10 @@ disconnect_child_exp (Btor *btor, BtorNode *parent, uint32_t pos)
   assert (!btor_node_is_uf (parent));
   assert (pos <= 2);
 
-  (void) btor;
-  BtorNode *first_parent, *last_parent;
-  BtorNode *real_child, *tagged_parent;
+  uint32_t first_parent, last_parent, tagged_parent;
+  BtorNode *real_child;
 
-  tagged_parent = btor_node_set_tag (parent, pos);
+  tagged_parent = btor_node_get_parent_id (parent, pos);
   real_child    = btor_node_real_addr (parent->e[pos]);
   real_child->parents--;
   first_parent = real_child->first_parent;
@@ -738,24 +738,30 @@ disconnect_child_exp (Btor *btor, BtorNode *parent, uint32_t pos)
   {
     assert (parent->next_parent[pos]);
     assert (!parent->prev_parent[pos]);
-    real_child->first_parent                    = parent->next_parent[pos];
-    BTOR_PREV_PARENT (real_child->first_parent) = 0;
+    real_child->first_parent = parent->next_parent[pos];
+    BTOR_PREV_PARENT (
+        btor_node_get_parent_by_id (btor, real_child->first_parent)) = 0;
   }
   /* is parent last parent in the list? */
   else if (last_parent == tagged_parent)
   {
     assert (!parent->next_parent[pos]);
     assert (parent->prev_parent[pos]);
-    real_child->last_parent                    = parent->prev_parent[pos];
-    BTOR_NEXT_PARENT (real_child->last_parent) = 0;
+    real_child->last_parent = parent->prev_parent[pos];
+    BTOR_NEXT_PARENT (
+        btor_node_get_parent_by_id (btor, real_child->last_parent)) = 0;
   }
   /* detach parent from list */
   else
   {
     assert (parent->next_parent[pos]);
     assert (parent->prev_parent[pos]);
-    BTOR_PREV_PARENT (parent->next_parent[pos]) = parent->prev_parent[pos];
-    BTOR_NEXT_PARENT (parent->prev_parent[pos]) = parent->next_parent[pos];
+    BTOR_PREV_PARENT (
+        btor_node_get_parent_by_id (btor, parent->next_parent[pos])) =
+        parent->prev_parent[pos];
+    BTOR_NEXT_PARENT (
+        btor_node_get_parent_by_id (btor, parent->prev_parent[pos])) =
+        parent->next_parent[pos];
   }
   parent->next_parent[pos] = 0;
   parent->prev_parent[pos] = 0;
@@ -814,8 +820,9 @@ erase_local_data_exp (Btor *btor, BtorNode *exp)
   assert (!btor_node_is_invalid (exp));
 
   BtorMemMgr *mm;
-  BtorPtrHashTable *static_rho;
-  BtorPtrHashTableIterator it;
+  BtorPtrHashMap *static_rho;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
 
   mm = btor->mm;
   //  BTORLOG ("%s: %s", __FUNCTION__, btor_util_node2string (exp));
@@ -837,26 +844,27 @@ erase_local_data_exp (Btor *btor, BtorNode *exp)
         static_rho = btor_node_lambda_get_static_rho (exp);
         if (static_rho)
         {
-          btor_iter_hashptr_init (&it, static_rho);
-          while (btor_iter_hashptr_has_next (&it))
+          btor_iter_hashptrmap_init (&it, static_rho);
+          while (btor_iter_hashptrmap_has_next (&it))
           {
-            btor_node_release (btor, it.bucket->data.as_ptr);
-            btor_node_release (btor, btor_iter_hashptr_next (&it));
+            e = btor_iter_hashptrmap_next_entry (&it);
+            btor_node_release (btor, e->data.as_ptr);
+            btor_node_release (btor, e->key);
           }
-          btor_hashptr_table_delete (static_rho);
+          btor_hashptrmap_delete (static_rho);
           ((BtorLambdaNode *) exp)->static_rho = 0;
         }
       }
       if (exp->rho)
       {
-        btor_hashptr_table_delete (exp->rho);
+        btor_hashptrmap_delete (exp->rho);
         exp->rho = 0;
       }
       break;
     case BTOR_COND_NODE:
       if (btor_node_is_fun_cond (exp) && exp->rho)
       {
-        btor_hashptr_table_delete (exp->rho);
+        btor_hashptrmap_delete (exp->rho);
         exp->rho = 0;
       }
       break;
@@ -1315,7 +1323,7 @@ btor_node_binder_set_body (BtorNode *binder, BtorNode *body)
 
 /*------------------------------------------------------------------------*/
 
-BtorPtrHashTable *
+BtorPtrHashMap *
 btor_node_lambda_get_static_rho (BtorNode *lambda)
 {
   assert (btor_node_is_regular (lambda));
@@ -1324,14 +1332,14 @@ btor_node_lambda_get_static_rho (BtorNode *lambda)
 }
 
 void
-btor_node_lambda_set_static_rho (BtorNode *lambda, BtorPtrHashTable *static_rho)
+btor_node_lambda_set_static_rho (BtorNode *lambda, BtorPtrHashMap *static_rho)
 {
   assert (btor_node_is_regular (lambda));
   assert (btor_node_is_lambda (lambda));
   ((BtorLambdaNode *) lambda)->static_rho = static_rho;
 }
 
-BtorPtrHashTable *
+BtorPtrHashMap *
 btor_node_lambda_copy_static_rho (Btor *btor, BtorNode *lambda)
 {
   assert (btor_node_is_regular (lambda));
@@ -1339,18 +1347,20 @@ btor_node_lambda_copy_static_rho (Btor *btor, BtorNode *lambda)
   assert (btor_node_lambda_get_static_rho (lambda));
 
   BtorNode *data, *key;
-  BtorPtrHashTableIterator it;
-  BtorPtrHashTable *static_rho;
-
-  btor_iter_hashptr_init (&it, btor_node_lambda_get_static_rho (lambda));
-  static_rho = btor_hashptr_table_new (btor->mm,
-                                       (BtorHashPtr) btor_node_hash_by_id,
-                                       (BtorCmpPtr) btor_node_compare_by_id);
-  while (btor_iter_hashptr_has_next (&it))
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMap *static_rho;
+
+  btor_iter_hashptrmap_init (&it, btor_node_lambda_get_static_rho (lambda));
+  static_rho = btor_hashptrmap_new (btor->mm,
+                                    (BtorHashPtr) btor_node_hash_by_id,
+                                    (BtorCmpPtr) btor_node_compare_by_id);
+  while (btor_iter_hashptrmap_has_next (&it))
   {
-    data = btor_node_copy (btor, it.bucket->data.as_ptr);
-    key  = btor_node_copy (btor, btor_iter_hashptr_next (&it));
-    btor_hashptr_table_add (static_rho, key)->data.as_ptr = data;
+    e    = btor_iter_hashptrmap_next_entry (&it);
+    data = btor_node_copy (btor, e->data.as_ptr);
+    key  = btor_node_copy (btor, e->key);
+    btor_hashptrmap_add (static_rho, key)->data.as_ptr = data;
   }
   return static_rho;
 }
@@ -1358,19 +1368,21 @@ btor_node_lambda_copy_static_rho (Btor *btor, BtorNode *lambda)
 void
 btor_node_lambda_delete_static_rho (Btor *btor, BtorNode *lambda)
 {
-  BtorPtrHashTable *static_rho;
-  BtorPtrHashTableIterator it;
+  BtorPtrHashMap *static_rho;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
 
   static_rho = btor_node_lambda_get_static_rho (lambda);
   if (!static_rho) return;
 
-  btor_iter_hashptr_init (&it, static_rho);
-  while (btor_iter_hashptr_has_next (&it))
+  btor_iter_hashptrmap_init (&it, static_rho);
+  while (btor_iter_hashptrmap_has_next (&it))
   {
-    btor_node_release (btor, it.bucket->data.as_ptr);
-    btor_node_release (btor, btor_iter_hashptr_next (&it));
+    e = btor_iter_hashptrmap_next_entry (&it);
+    btor_node_release (btor, e->data.as_ptr);
+    btor_node_release (btor, e->key);
   }
-  btor_hashptr_table_delete (static_rho);
+  btor_hashptrmap_delete (static_rho);
   btor_node_lambda_set_static_rho (lambda, 0);
 }
 
@@ -1487,19 +1499,20 @@ sort_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[])
 /*------------------------------------------------------------------------*/
 
 /* Search for constant expression in hash table. Returns 0 if not found. */
-static BtorNode **
+static int32_t *
 find_const_exp (Btor *btor, BtorBitVector *bits)
 {
   assert (btor);
   assert (bits);
 
-  BtorNode *cur, **result;
+  BtorNode *cur;
+  int32_t *result;
   uint32_t hash;
 
   hash = btor_bv_hash (bits);
   hash &= btor->nodes_unique_table.size - 1;
   result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
+  cur    = btor_node_get_by_id (btor, *result);
   while (cur)
   {
     assert (btor_node_is_regular (cur));
@@ -1510,27 +1523,28 @@ find_const_exp (Btor *btor, BtorBitVector *bits)
     else
     {
       result = &cur->next;
-      cur    = *result;
+      cur    = btor_node_get_by_id (btor, *result);
     }
   }
   return result;
 }
 
 /* Search for slice expression in hash table. Returns 0 if not found. */
-static BtorNode **
+static int32_t *
 find_slice_exp (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
 {
   assert (btor);
   assert (e0);
   assert (upper >= lower);
 
-  BtorNode *cur, **result;
+  BtorNode *cur;
+  int32_t *result;
   uint32_t hash;
 
   hash = hash_slice_exp (e0, upper, lower);
   hash &= btor->nodes_unique_table.size - 1;
   result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
+  cur    = btor_node_get_by_id (btor, *result);
   while (cur)
   {
     assert (btor_node_is_regular (cur));
@@ -1541,19 +1555,20 @@ find_slice_exp (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
     else
     {
       result = &cur->next;
-      cur    = *result;
+      cur    = btor_node_get_by_id (btor, *result);
     }
   }
   return result;
 }
 
-static BtorNode **
+static int32_t *
 find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
 {
   bool equal;
   uint32_t i;
   uint32_t hash;
-  BtorNode *cur, **result;
+  BtorNode *cur;
+  int32_t *result;
 
   assert (kind != BTOR_BV_SLICE_NODE);
   assert (kind != BTOR_CONST_NODE);
@@ -1563,7 +1578,7 @@ find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
   hash &= btor->nodes_unique_table.size - 1;
 
   result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
+  cur    = btor_node_get_by_id (btor, *result);
   while (cur)
   {
     assert (btor_node_is_regular (cur));
@@ -1585,8 +1600,8 @@ find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
                     || !(cur->e[0] == e[1] && cur->e[1] == e[0]));
 #endif
     }
-    result = &(cur->next);
-    cur    = *result;
+    result = &cur->next;
+    cur    = btor_node_get_by_id (btor, *result);
   }
   return result;
 }
@@ -1597,7 +1612,7 @@ static int32_t compare_binder_exp (Btor *btor,
                                    BtorNode *binder,
                                    BtorPtrHashTable *map);
 
-static BtorNode **
+static int32_t *
 find_binder_exp (Btor *btor,
                  BtorNodeKind kind,
                  BtorNode *param,
@@ -1612,14 +1627,15 @@ find_binder_exp (Btor *btor,
   assert (btor_node_is_regular (param));
   assert (btor_node_is_param (param));
 
-  BtorNode *cur, **result;
+  BtorNode *cur;
+  int32_t *result;
   uint32_t hash;
 
   hash = hash_binder_exp (btor, param, body, params);
   if (binder_hash) *binder_hash = hash;
   hash &= btor->nodes_unique_table.size - 1;
   result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
+  cur    = btor_node_get_by_id (btor, *result);
   while (cur)
   {
     assert (btor_node_is_regular (cur));
@@ -1631,10 +1647,11 @@ find_binder_exp (Btor *btor,
     else
     {
       result = &cur->next;
-      cur    = *result;
+      cur    = btor_node_get_by_id (btor, *result);
     }
   }
-  assert (!*result || btor_node_is_binder (*result));
+  assert (!*result
+          || btor_node_is_binder (btor_node_get_by_id (btor, *result)));
   return result;
 }
 
@@ -1742,13 +1759,14 @@ compare_binder_exp (Btor *btor,
 
       if (btor_node_is_binder (real_cur))
       {
-        result = *find_binder_exp (btor,
-                                   real_cur->kind,
-                                   real_cur->e[0],
-                                   real_cur->e[1],
-                                   0,
-                                   0,
-                                   param_map);
+        result = btor_node_get_by_id (btor,
+                                     *find_binder_exp (btor,
+                                                       real_cur->kind,
+                                                       real_cur->e[0],
+                                                       real_cur->e[1],
+                                                       0,
+                                                       0,
+                                                       param_map));
         if (result)
         {
           b->data.as_ptr = result;
@@ -1775,10 +1793,12 @@ compare_binder_exp (Btor *btor,
 
       if (btor_node_is_bv_slice (real_cur))
       {
-        result = *find_slice_exp (btor,
-                                  e[0],
-                                  btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
+        result = btor_node_get_by_id (
+            btor,
+            *find_slice_exp (btor,
+                             e[0],
+                             btor_node_bv_slice_get_upper (real_cur),
+                             btor_node_bv_slice_get_lower (real_cur)));
       }
       else if (btor_node_is_param (real_cur))
       {
@@ -1790,7 +1810,8 @@ compare_binder_exp (Btor *btor,
       else
       {
         assert (!btor_node_is_binder (real_cur));
-        result = *find_bv_exp (btor, real_cur->kind, e, real_cur->arity);
+        result = btor_node_get_by_id (
+            btor, *find_bv_exp (btor, real_cur->kind, e, real_cur->arity));
       }
 
       if (!result)
@@ -1821,7 +1842,7 @@ NOT_EQUAL:
   return equal;
 }
 
-static BtorNode **
+static int32_t *
 find_exp (Btor *btor,
           BtorNodeKind kind,
           BtorNode *e[],
@@ -2165,7 +2186,8 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
 
   uint32_t i;
   uint32_t binder_hash;
-  BtorNode **lookup, *simp_e[3];
+  int32_t *lookup;
+  BtorNode *res, *simp_e[3];
   BtorIntHashTable *params = 0;
 
   for (i = 0; i < arity; i++)
@@ -2192,31 +2214,31 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
     {
       case BTOR_LAMBDA_NODE:
         assert (arity == 2);
-        *lookup = new_lambda_exp_node (btor, simp_e[0], simp_e[1]);
-        btor_hashptr_table_get (btor->lambdas, *lookup)->data.as_int =
+        res = new_lambda_exp_node (btor, simp_e[0], simp_e[1]);
+        btor_hashptr_table_get (btor->lambdas, res)->data.as_int =
             binder_hash;
         break;
       case BTOR_FORALL_NODE:
       case BTOR_EXISTS_NODE:
         assert (arity == 2);
-        *lookup = new_quantifier_exp_node (btor, kind, e[0], e[1]);
-        btor_hashptr_table_get (btor->quantifiers, *lookup)->data.as_int =
+        res = new_quantifier_exp_node (btor, kind, e[0], e[1]);
+        btor_hashptr_table_get (btor->quantifiers, res)->data.as_int =
             binder_hash;
         break;
       case BTOR_ARGS_NODE:
-        *lookup = new_args_exp_node (btor, arity, simp_e);
+        res = new_args_exp_node (btor, arity, simp_e);
         break;
-      default: *lookup = new_node (btor, kind, arity, simp_e);
+      default: res = new_node (btor, kind, arity, simp_e);
     }
 
     if (params)
     {
-      assert (btor_node_is_binder (*lookup));
+      assert (btor_node_is_binder (res));
       if (params->count > 0)
       {
-        btor_hashptr_table_add (btor->parameterized, *lookup)->data.as_ptr =
+        btor_hashptr_table_add (btor->parameterized, res)->data.as_ptr =
             params;
-        (*lookup)->parameterized = 1;
+        res->parameterized = 1;
       }
       else
         btor_hashint_table_delete (params);
@@ -2224,15 +2246,17 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
 
     assert (btor->nodes_unique_table.num_elements < INT32_MAX);
     btor->nodes_unique_table.num_elements++;
-    (*lookup)->unique = 1;
+    res->unique = 1;
+    *lookup     = res->id;
   }
   else
   {
-    inc_exp_ref_counter (btor, *lookup);
+    res = btor_node_get_by_id (btor, *lookup);
+    inc_exp_ref_counter (btor, res);
     if (params) btor_hashint_table_delete (params);
   }
-  assert (btor_node_is_regular (*lookup));
-  return *lookup;
+  assert (btor_node_is_regular (res));
+  return res;
 }
 
 /*------------------------------------------------------------------------*/
@@ -2245,7 +2269,8 @@ btor_node_create_bv_const (Btor *btor, const BtorBitVector *bits)
 
   bool inv;
   BtorBitVector *lookupbits;
-  BtorNode **lookup;
+  int32_t *lookup;
+  BtorNode *res;
 
   /* normalize constants, constants are always even */
   if (btor_bv_get_bit (bits, 0))
@@ -2267,20 +2292,24 @@ btor_node_create_bv_const (Btor *btor, const BtorBitVector *bits)
       enlarge_nodes_unique_table (btor);
       lookup = find_const_exp (btor, lookupbits);
     }
-    *lookup = new_const_exp_node (btor, lookupbits);
+    res = new_const_exp_node (btor, lookupbits);
     assert (btor->nodes_unique_table.num_elements < INT32_MAX);
     btor->nodes_unique_table.num_elements += 1;
-    (*lookup)->unique = 1;
+    res->unique = 1;
+    *lookup     = res->id;
   }
   else
-    inc_exp_ref_counter (btor, *lookup);
+  {
+    res = btor_node_get_by_id (btor, *lookup);
+    inc_exp_ref_counter (btor, res);
+  }
 
-  assert (btor_node_is_regular (*lookup));
+  assert (btor_node_is_regular (res));
 
   btor_bv_free (btor->mm, lookupbits);
 
-  if (inv) return btor_node_invert (*lookup);
-  return *lookup;
+  if (inv) return btor_node_invert (res);
+  return res;
 }
 
 BtorNode *
@@ -2298,7 +2327,7 @@ btor_node_create_var (Btor *btor, BtorSortId sort, const char *symbol)
   exp->bytes = sizeof *exp;
   setup_node_and_add_to_id_table (btor, exp);
   btor_node_set_sort_id ((BtorNode *) exp, btor_sort_copy (btor, sort));
-  (void) btor_hashptr_table_add (btor->bv_vars, exp);
+  (void) btor_hashptrmap_add (btor->bv_vars, exp);
   if (symbol) btor_node_set_symbol (btor, (BtorNode *) exp, symbol);
   return (BtorNode *) exp;
 }
@@ -2354,7 +2383,8 @@ unary_exp_slice_exp (Btor *btor, BtorNode *exp, uint32_t upper, uint32_t lower)
   assert (btor == btor_node_real_addr (exp)->btor);
 
   bool inv;
-  BtorNode **lookup;
+  int32_t *lookup;
+  BtorNode *res;
 
   exp = btor_simplify_exp (btor, exp);
 
@@ -2379,16 +2409,20 @@ unary_exp_slice_exp (Btor *btor, BtorNode *exp, uint32_t upper, uint32_t lower)
       enlarge_nodes_unique_table (btor);
       lookup = find_slice_exp (btor, exp, upper, lower);
     }
-    *lookup = new_slice_exp_node (btor, exp, upper, lower);
+    res = new_slice_exp_node (btor, exp, upper, lower);
     assert (btor->nodes_unique_table.num_elements < INT32_MAX);
     btor->nodes_unique_table.num_elements++;
-    (*lookup)->unique = 1;
+    res->unique = 1;
+    *lookup     = res->id;
   }
   else
-    inc_exp_ref_counter (btor, *lookup);
-  assert (btor_node_is_regular (*lookup));
-  if (inv) return btor_node_invert (*lookup);
-  return *lookup;
+  {
+    res = btor_node_get_by_id (btor, *lookup);
+    inc_exp_ref_counter (btor, res);
+  }
+  assert (btor_node_is_regular (res));
+  if (inv) return btor_node_invert (res);
+  return res;
 }
 
 BtorNode *
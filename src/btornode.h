@@ -17,6 +17,7 @@
 #include "btorsort.h"
 #include "btortypes.h"
 #include "utils/btorhashptr.h"
+#include "utils/btorhashptrmap.h"
 #include "utils/btorqueue.h"
 #include "utils/btorstack.h"
 
@@ -100,24 +101,26 @@ extern const char *const g_btor_op2str[BTOR_NUM_OPS_NODE];
     uint32_t ext_refs;            /* external references counter */        \
     uint32_t parents;             /* number of parents */                  \
     BtorSortId sort_id;           /* sort id */                            \
+    int32_t next;                 /* id of next in unique table */         \
+    uint32_t first_parent;        /* head of parent list (tagged id) */    \
+    uint32_t last_parent;         /* tail of parent list (tagged id) */    \
     union                                                                  \
     {                                                                      \
-      BtorAIGVec *av;        /* synthesized AIG vector */                  \
-      BtorPtrHashTable *rho; /* for finding array conflicts */             \
+      BtorAIGVec *av;      /* synthesized AIG vector */                    \
+      BtorPtrHashMap *rho; /* for finding array conflicts */               \
     };                                                                     \
-    BtorNode *next;         /* next in unique table */                     \
-    BtorNode *simplified;   /* simplified expression */                    \
-    Btor *btor;             /* boolector instance */                       \
-    BtorNode *first_parent; /* head of parent list */                      \
-    BtorNode *last_parent;  /* tail of parent list */                      \
+    BtorNode *simplified; /* simplified expression */                      \
+    Btor *btor;           /* boolector instance */                         \
   }
 
-#define BTOR_BV_ADDITIONAL_NODE_STRUCT                             \
-  struct                                                           \
-  {                                                                \
-    BtorNode *e[3];           /* expression children */            \
-    BtorNode *prev_parent[3]; /* prev in parent list of child i */ \
-    BtorNode *next_parent[3]; /* next in parent list of child i */ \
+/* Parent lists are linked via tagged node ids, i.e., (id << 2) | pos, where
+ * 'pos' is the position of the child in the parent (see btornodeiter.h). */
+#define BTOR_BV_ADDITIONAL_NODE_STRUCT                            \
+  struct                                                          \
+  {                                                               \
+    BtorNode *e[3];          /* expression children */            \
+    uint32_t prev_parent[3]; /* prev in parent list of child i */ \
+    uint32_t next_parent[3]; /* next in parent list of child i */ \
   }
 
 struct BtorBVVarNode
@@ -185,7 +188,7 @@ typedef struct BtorBinderNode BtorBinderNode;
 struct BtorLambdaNode
 {
   BTOR_BINDER_STRUCT;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashMap *static_rho;
 };
 
 typedef struct BtorLambdaNode BtorLambdaNode;
@@ -663,13 +666,13 @@ void btor_node_binder_set_body (BtorNode *binder, BtorNode *body);
 
 /*------------------------------------------------------------------------*/
 
-BtorPtrHashTable *btor_node_lambda_get_static_rho (BtorNode *lambda);
+BtorPtrHashMap *btor_node_lambda_get_static_rho (BtorNode *lambda);
 
 void btor_node_lambda_set_static_rho (BtorNode *lambda,
-                                      BtorPtrHashTable *static_rho);
+                                      BtorPtrHashMap *static_rho);
 
-BtorPtrHashTable *btor_node_lambda_copy_static_rho (Btor *btor,
-                                                    BtorNode *lambda);
+BtorPtrHashMap *btor_node_lambda_copy_static_rho (Btor *btor,
+                                                  BtorNode *lambda);
 
 void btor_node_lambda_delete_static_rho (Btor *btor, BtorNode *lambda);
 
@@ -317,7 +317,23 @@ btor_opt_init_opts (Btor *btor)
                 "picosat",
                 BTOR_SAT_ENGINE_PICOSAT,
                 "use picosat as back end SAT solver");
+  add_opt_help (mm,
+                opts,
+                "ipasir",
+                BTOR_SAT_ENGINE_IPASIR,
+                "use IPASIR solver loaded at runtime, "
+                "given as 'ipasir:<path>'");
   btor->options[BTOR_OPT_SAT_ENGINE].options = opts;
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_PORTFOLIO,
+            false,
+            false,
+            "sat-engine-portfolio",
+            0,
+            0,
+            0,
+            BTOR_SAT_PORTFOLIO_MAX,
+            "number of SAT solver instances run in parallel");
 
   init_opt (btor,
             BTOR_OPT_AUTO_CLEANUP,
@@ -391,6 +407,122 @@ btor_opt_init_opts (Btor *btor)
             0,
             3,
             "rewrite level");
+  init_opt (btor,
+            BTOR_OPT_RW_CACHE_SIZE,
+            false,
+            false,
+            "rw-cache-size",
+            0,
+            32,
+            0,
+            UINT32_MAX,
+            "maximum size of the rewrite cache in MB");
+  init_opt (btor,
+            BTOR_OPT_AIG_REWRITE,
+            false,
+            false,
+            "aig-rewrite",
+            0,
+            0,
+            0,
+            2,
+            "AIG optimization level prior to CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_AIG_FRAIG,
+            false,
+            true,
+            "aig-fraig",
+            0,
+            0,
+            0,
+            1,
+            "merge equivalent AIG nodes prior to CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_MUL_ENC,
+            false,
+            false,
+            "mul-enc",
+            0,
+            BTOR_MUL_ENC_DFLT,
+            BTOR_MUL_ENC_MIN + 1,
+            BTOR_MUL_ENC_MAX - 1,
+            "multiplier encoding");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
+  add_opt_help (
+      mm, opts, "array", BTOR_MUL_ENC_ARRAY, "shift-and-add array multiplier");
+  add_opt_help (mm,
+                opts,
+                "tree",
+                BTOR_MUL_ENC_TREE,
+                "radix-4 Booth partial products with Dadda tree reduction");
+  btor->options[BTOR_OPT_MUL_ENC].options = opts;
+  init_opt (btor,
+            BTOR_OPT_MUL_CSD,
+            false,
+            true,
+            "mul-csd",
+            0,
+            0,
+            0,
+            1,
+            "encode multiplication by constant in canonical signed digits");
+  init_opt (btor,
+            BTOR_OPT_DIV_ENC,
+            false,
+            false,
+            "div-enc",
+            0,
+            BTOR_DIV_ENC_DFLT,
+            BTOR_DIV_ENC_MIN + 1,
+            BTOR_DIV_ENC_MAX - 1,
+            "unsigned division and remainder encoding");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
+  add_opt_help (
+      mm, opts, "circuit", BTOR_DIV_ENC_CIRCUIT, "restoring array divider");
+  add_opt_help (mm,
+                opts,
+                "constraint",
+                BTOR_DIV_ENC_CONSTRAINT,
+                "fresh quotient q and remainder r with a = q * b + r, r < b");
+  btor->options[BTOR_OPT_DIV_ENC].options = opts;
+  init_opt (btor,
+            BTOR_OPT_PREFIX_WIDTH,
+            false,
+            false,
+            "prefix-width",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "minimum width of adders and comparators encoded with "
+            "parallel-prefix networks (0: disable)");
+  init_opt (btor,
+            BTOR_OPT_PREFIX_ENC,
+            false,
+            false,
+            "prefix-enc",
+            0,
+            BTOR_PREFIX_ENC_DFLT,
+            BTOR_PREFIX_ENC_MIN + 1,
+            BTOR_PREFIX_ENC_MAX - 1,
+            "parallel-prefix adder network");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
+  add_opt_help (mm, opts, "bk", BTOR_PREFIX_ENC_BK, "Brent-Kung");
+  add_opt_help (mm, opts, "ks", BTOR_PREFIX_ENC_KS, "Kogge-Stone");
+  btor->options[BTOR_OPT_PREFIX_ENC].options = opts;
+  init_opt (btor,
+            BTOR_OPT_AIG_PG,
+            false,
+            true,
+            "aig-pg",
+            0,
+            0,
+            0,
+            1,
+            "polarity-aware (Plaisted-Greenbaum) CNF encoding of AIGs");
   init_opt (btor,
             BTOR_OPT_SKELETON_PREPROC,
             false,
@@ -632,6 +764,17 @@ btor_opt_init_opts (Btor *btor)
                 "generate lemmas for all conflicts");
   btor->options[BTOR_OPT_FUN_EAGER_LEMMAS].options  = opts;
 
+  init_opt (btor,
+            BTOR_OPT_FUN_PROP_THREADS,
+            false,
+            false,
+            "fun:prop-threads",
+            0,
+            0,
+            0,
+            BTOR_FUN_PROP_THREADS_MAX,
+            "number of threads for parallel conflict detection");
+
   init_opt (btor,
             BTOR_OPT_FUN_STORE_LAMBDAS,
             false,
@@ -1576,7 +1719,10 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
           "SAT solver Lingeling not compiled in, using %s",
           oldval == BTOR_SAT_ENGINE_CADICAL
               ? "Cadical"
-              : (oldval == BTOR_SAT_ENGINE_MINISAT ? "MiniSat" : "PicoSAT"));
+              : (oldval == BTOR_SAT_ENGINE_MINISAT
+                     ? "MiniSat"
+                     : (oldval == BTOR_SAT_ENGINE_IPASIR ? "IPASIR"
+                                                         : "PicoSAT")));
     }
 #endif
 #ifndef BTOR_USE_CADICAL
@@ -1589,7 +1735,10 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
           "SAT solver Cadical not compiled in, using %s",
           oldval == BTOR_SAT_ENGINE_LINGELING
               ? "Lingeling"
-              : (oldval == BTOR_SAT_ENGINE_MINISAT ? "MiniSat" : "PicoSAT"));
+              : (oldval == BTOR_SAT_ENGINE_MINISAT
+                     ? "MiniSat"
+                     : (oldval == BTOR_SAT_ENGINE_IPASIR ? "IPASIR"
+                                                         : "PicoSAT")));
     }
 #endif
 #ifndef BTOR_USE_MINISAT
@@ -1601,8 +1750,10 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
                 "SAT solver Minisat not compiled in, using %s",
                 oldval == BTOR_SAT_ENGINE_CADICAL
                     ? "Cadical"
-                    : (oldval == BTOR_SAT_ENGINE_LINGELING ? "Lingeling"
-                                                           : "PicoSAT"));
+                    : (oldval == BTOR_SAT_ENGINE_LINGELING
+                           ? "Lingeling"
+                           : (oldval == BTOR_SAT_ENGINE_IPASIR ? "IPASIR"
+                                                               : "PicoSAT")));
     }
 #endif
 #ifndef BTOR_USE_PICOSAT
@@ -1614,11 +1765,46 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
                 "SAT solver PicoSAT not compiled in, using %s",
                 oldval == BTOR_SAT_ENGINE_CADICAL
                     ? "Cadical"
-                    : (oldval == BTOR_SAT_ENGINE_LINGELING ? "Lingeling"
-                                                           : "MiniSat"));
+                    : (oldval == BTOR_SAT_ENGINE_LINGELING
+                           ? "Lingeling"
+                           : (oldval == BTOR_SAT_ENGINE_IPASIR ? "IPASIR"
+                                                               : "MiniSat")));
     }
 #endif
+#ifndef BTOR_USE_IPASIR
+    if (val == BTOR_SAT_ENGINE_IPASIR)
+    {
+      val = oldval;
+      BTOR_MSG (btor->msg,
+                1,
+                "IPASIR support not compiled in, using %s",
+                oldval == BTOR_SAT_ENGINE_CADICAL
+                    ? "Cadical"
+                    : (oldval == BTOR_SAT_ENGINE_LINGELING
+                           ? "Lingeling"
+                           : (oldval == BTOR_SAT_ENGINE_MINISAT ? "MiniSat"
+                                                                : "PicoSAT")));
+    }
+#endif
+  }
+#ifndef BTOR_HAVE_PTHREADS
+  else if (opt == BTOR_OPT_SAT_ENGINE_PORTFOLIO)
+  {
+    val = oldval;
+    BTOR_MSG (btor->msg,
+              1,
+              "compiled without pthreads, will not set option to run a "
+              "portfolio of SAT solvers");
   }
+  else if (opt == BTOR_OPT_FUN_PROP_THREADS)
+  {
+    val = oldval;
+    BTOR_MSG (btor->msg,
+              1,
+              "compiled without pthreads, will not set option to check "
+              "function cones in parallel");
+  }
+#endif
 #ifndef BTOR_USE_LINGELING
   else if (opt == BTOR_OPT_SAT_ENGINE_LGL_FORK)
   {
@@ -1629,6 +1815,15 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
               "to clone/fork Lingeling");
   }
 #endif
+  else if (opt == BTOR_OPT_RW_CACHE_SIZE)
+  {
+    /* The rewrite cache is reallocated if it exceeds the new limit. */
+    if (val != oldval && btor->rw_cache)
+    {
+      o->val = val;
+      btor_rw_cache_reset (btor->rw_cache);
+    }
+  }
 #ifndef NDEBUG
   else if (opt == BTOR_OPT_INCREMENTAL)
   {
@@ -1667,6 +1862,8 @@ btor_opt_set_str (Btor *btor, const BtorOption opt, const char *str)
   assert (btor_opt_is_valid (btor, opt));
   assert (opt == BTOR_OPT_SAT_ENGINE);
 
+  if (btor->options[opt].valstr)
+    btor_mem_freestr (btor->mm, btor->options[opt].valstr);
   btor->options[opt].valstr = btor_mem_strdup (btor->mm, str);
 }
 
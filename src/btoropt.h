@@ -59,6 +59,10 @@ typedef struct BtorOptHelp BtorOptHelp;
 
 #define BTOR_PROB_MAX 1000
 
+#define BTOR_SAT_PORTFOLIO_MAX 64
+
+#define BTOR_FUN_PROP_THREADS_MAX 64
+
 enum BtorOptSatEngine
 {
   BTOR_SAT_ENGINE_MIN,
@@ -66,6 +70,7 @@ enum BtorOptSatEngine
   BTOR_SAT_ENGINE_PICOSAT,
   BTOR_SAT_ENGINE_MINISAT,
   BTOR_SAT_ENGINE_CADICAL,
+  BTOR_SAT_ENGINE_IPASIR,
   BTOR_SAT_ENGINE_MAX,
 };
 #ifdef BTOR_USE_LINGELING
@@ -200,6 +205,36 @@ enum BtorOptFunEagerLemmas
 #define BTOR_FUN_EAGER_LEMMAS_DFLT BTOR_FUN_EAGER_LEMMAS_CONF
 typedef enum BtorOptFunEagerLemmas BtorOptFunEagerLemmas;
 
+enum BtorOptMulEnc
+{
+  BTOR_MUL_ENC_MIN,
+  BTOR_MUL_ENC_ARRAY,
+  BTOR_MUL_ENC_TREE,
+  BTOR_MUL_ENC_MAX,
+};
+#define BTOR_MUL_ENC_DFLT BTOR_MUL_ENC_ARRAY
+typedef enum BtorOptMulEnc BtorOptMulEnc;
+
+enum BtorOptDivEnc
+{
+  BTOR_DIV_ENC_MIN,
+  BTOR_DIV_ENC_CIRCUIT,
+  BTOR_DIV_ENC_CONSTRAINT,
+  BTOR_DIV_ENC_MAX,
+};
+#define BTOR_DIV_ENC_DFLT BTOR_DIV_ENC_CIRCUIT
+typedef enum BtorOptDivEnc BtorOptDivEnc;
+
+enum BtorOptPrefixEnc
+{
+  BTOR_PREFIX_ENC_MIN,
+  BTOR_PREFIX_ENC_BK,
+  BTOR_PREFIX_ENC_KS,
+  BTOR_PREFIX_ENC_MAX,
+};
+#define BTOR_PREFIX_ENC_DFLT BTOR_PREFIX_ENC_BK
+typedef enum BtorOptPrefixEnc BtorOptPrefixEnc;
+
 enum BtorOptIncrementalSMT1
 {
   BTOR_INCREMENTAL_SMT1_MIN,
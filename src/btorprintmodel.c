@@ -396,7 +396,11 @@ btor_print_model_aufbv (Btor *btor, const char *format, FILE *file)
 void
 btor_print_model (Btor *btor, const char *format, FILE *file)
 {
-  btor->slv->api.print_model (btor->slv, format, file);
+  /* there is no solver if the result was restored from the result cache */
+  if (btor->slv)
+    btor->slv->api.print_model (btor->slv, format, file);
+  else
+    btor_print_model_aufbv (btor, format, file);
 }
 
 /*------------------------------------------------------------------------*/
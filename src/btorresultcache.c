@@ -0,0 +1,773 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorresultcache.h"
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btormodel.h"
+#include "btorsort.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BTOR_RESULT_CACHE_MAGIC "BTORRC02"
+
+/* Number of slots that are checked for a key. */
+#define BTOR_RESULT_CACHE_PROBES 4
+
+struct BtorResultCacheHeader
+{
+  char magic[8];
+  uint32_t num_slots;
+  uint32_t slot_size;
+  uint8_t reserved[48];
+};
+
+typedef struct BtorResultCacheHeader BtorResultCacheHeader;
+
+/* A slot is empty if 'key' is 0. Slots are only accessed while holding a
+ * lock on the cache file (shared for reading, exclusive for writing). */
+struct BtorResultCacheSlot
+{
+  uint64_t key;
+  uint64_t check;    /* independent second hash of the formula */
+  uint32_t result;
+  uint32_t num_vars; /* number of inputs of the formula */
+  uint32_t num_bits; /* number of model bits, 0 if no model is stored */
+  uint32_t reserved;
+  uint8_t model[BTOR_RESULT_CACHE_MODEL_BITS / 8];
+};
+
+typedef struct BtorResultCacheSlot BtorResultCacheSlot;
+
+/* Structural hash of a node or formula, consisting of the key of the cache
+ * slot and a second hash computed with a different mixing function. */
+struct BtorResultCacheDigest
+{
+  uint64_t key;
+  uint64_t check;
+};
+
+typedef struct BtorResultCacheDigest BtorResultCacheDigest;
+
+BTOR_DECLARE_STACK (BtorResultCacheDigest, BtorResultCacheDigest);
+
+/*------------------------------------------------------------------------*/
+
+static size_t
+file_size (void)
+{
+  return sizeof (BtorResultCacheHeader)
+         + BTOR_RESULT_CACHE_SLOTS * sizeof (BtorResultCacheSlot);
+}
+
+static BtorResultCacheSlot *
+get_slot (BtorResultCache *rc, uint32_t i)
+{
+  return (BtorResultCacheSlot *) (rc->map + sizeof (BtorResultCacheHeader))
+         + (i & (BTOR_RESULT_CACHE_SLOTS - 1));
+}
+
+static BtorResultCacheSlot *
+find_slot (BtorResultCache *rc, uint64_t key)
+{
+  uint32_t i;
+  BtorResultCacheSlot *slot;
+
+  for (i = 0; i < BTOR_RESULT_CACHE_PROBES; i++)
+  {
+    slot = get_slot (rc, (uint32_t) key + i);
+    if (slot->key == key) return slot;
+    if (!slot->key) break;
+  }
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+static inline uint64_t
+hash_mix (uint64_t h, uint64_t v)
+{
+  h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+}
+
+/* Second mixing function with different constants and shifts, used for the
+ * check hash, which is computed independently of the key. */
+static inline uint64_t
+hash_mix2 (uint64_t h, uint64_t v)
+{
+  h = (h << 31 | h >> 33) ^ (v * 0xc2b2ae3d27d4eb4full);
+  h ^= h >> 29;
+  h *= 0x94d049bb133111ebull;
+  h ^= h >> 32;
+  return h;
+}
+
+static void
+digest_mix (BtorResultCacheDigest *d, uint64_t v)
+{
+  d->key   = hash_mix (d->key, v);
+  d->check = hash_mix2 (d->check, v);
+}
+
+static void
+digest_mix_digest (BtorResultCacheDigest *d, const BtorResultCacheDigest *v)
+{
+  d->key   = hash_mix (d->key, v->key);
+  d->check = hash_mix2 (d->check, v->check);
+}
+
+static int32_t
+cmp_digest (const BtorResultCacheDigest *a, const BtorResultCacheDigest *b)
+{
+  if (a->key != b->key) return a->key < b->key ? -1 : 1;
+  if (a->check != b->check) return a->check < b->check ? -1 : 1;
+  return 0;
+}
+
+static uint64_t
+hash_sort (BtorSort *sort)
+{
+  uint32_t i;
+  uint64_t h;
+
+  h = hash_mix (0, sort->kind);
+  switch (sort->kind)
+  {
+    case BTOR_BITVEC_SORT: h = hash_mix (h, sort->bitvec.width); break;
+    case BTOR_ARRAY_SORT:
+      h = hash_mix (h, hash_sort (sort->array.index));
+      h = hash_mix (h, hash_sort (sort->array.element));
+      break;
+    case BTOR_FUN_SORT:
+      h = hash_mix (h, hash_sort (sort->fun.domain));
+      h = hash_mix (h, hash_sort (sort->fun.codomain));
+      break;
+    case BTOR_TUPLE_SORT:
+      for (i = 0; i < sort->tuple.num_elements; i++)
+        h = hash_mix (h, hash_sort (sort->tuple.elements[i]));
+      break;
+    default: break;
+  }
+  return h;
+}
+
+/* Digest of node 'exp' with already hashed children 'e'. Inputs are
+ * identified by 'in' (see hash_dag). */
+static BtorResultCacheDigest
+hash_node (Btor *btor,
+           BtorNode *exp,
+           BtorResultCacheDigest *e,
+           const BtorResultCacheDigest *in)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i;
+  BtorResultCacheDigest d, tmp;
+  BtorBitVector *bits;
+
+  d.key = d.check = exp->kind;
+  digest_mix (&d,
+              hash_sort (btor_sort_get_by_id (btor,
+                                              btor_node_get_sort_id (exp))));
+
+  if (btor_node_is_bv_const (exp))
+  {
+    bits = btor_node_bv_const_get_bits (exp);
+    for (i = 0; i < bits->len; i++) digest_mix (&d, bits->bits[i]);
+  }
+  else if (btor_node_is_bv_slice (exp))
+  {
+    digest_mix (&d, btor_node_bv_slice_get_upper (exp));
+    digest_mix (&d, btor_node_bv_slice_get_lower (exp));
+  }
+  else if (exp->arity == 0)
+    digest_mix_digest (&d, in);
+
+  for (i = 0; i < exp->arity; i++)
+  {
+    if (!btor_node_is_inverted (exp->e[i])) continue;
+    e[i].key   = ~e[i].key;
+    e[i].check = ~e[i].check;
+  }
+  /* Digest of commutative nodes does not depend on the order of children. */
+  if (btor_node_is_binary_commutative (exp) && cmp_digest (&e[0], &e[1]) > 0)
+  {
+    tmp  = e[0];
+    e[0] = e[1];
+    e[1] = tmp;
+  }
+  for (i = 0; i < exp->arity; i++) digest_mix_digest (&d, &e[i]);
+  return d;
+}
+
+/* Hash all nodes reachable from 'roots' in post order (children from left to
+ * right). Inputs are hashed as follows:
+ * - if 'inputs' is not 0, inputs are numbered in the order of their first
+ *   occurrence and collected in 'inputs'
+ * - else if 'colors' is not 0, an input is hashed by its color (see
+ *   color_inputs), which maps the node id to a position in 'color_digests'
+ * - otherwise, all inputs of the same sort get the same digest.
+ * The digests of the roots are stored in 'root_digests'. If 'nodes' and
+ * 'digests' are not 0, the visited nodes and their digests are stored in post
+ * order. */
+static void
+hash_dag (Btor *btor,
+          BtorNodePtrStack *roots,
+          BtorIntStack *inputs,
+          BtorIntHashTable *colors,
+          BtorResultCacheDigestStack *color_digests,
+          BtorResultCacheDigestStack *root_digests,
+          BtorNodePtrStack *nodes,
+          BtorResultCacheDigestStack *digests)
+{
+  uint32_t i, j, num_params;
+  BtorResultCacheDigest d, in, e[3];
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorResultCacheDigestStack local;
+  BtorIntHashTable *cache;
+  BtorHashTableData *data;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_INIT_STACK (btor->mm, local);
+  if (!digests) digests = &local;
+  cache      = btor_hashint_map_new (btor->mm);
+  num_params = 0;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (*roots, i));
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+      assert (!btor_node_is_proxy (cur));
+      data = btor_hashint_map_get (cache, cur->id);
+
+      if (!data)
+      {
+        btor_hashint_map_add (cache, cur->id)->as_int = -1;
+        BTOR_PUSH_STACK (visit, cur);
+        for (j = cur->arity; j > 0; j--) BTOR_PUSH_STACK (visit, cur->e[j - 1]);
+      }
+      else if (data->as_int == -1)
+      {
+        in.key = in.check = 0;
+        if (cur->arity == 0 && !btor_node_is_bv_const (cur))
+        {
+          if (btor_node_is_param (cur))
+          {
+            if (inputs) in.key = in.check = num_params++;
+          }
+          else if (inputs)
+          {
+            in.key = in.check = BTOR_COUNT_STACK (*inputs);
+            BTOR_PUSH_STACK (*inputs, cur->id);
+          }
+          else if (colors)
+            in = BTOR_PEEK_STACK (
+                *color_digests,
+                btor_hashint_map_get (colors, cur->id)->as_int);
+        }
+        for (j = 0; j < cur->arity; j++)
+        {
+          e[j] = BTOR_PEEK_STACK (
+              *digests,
+              btor_hashint_map_get (cache, btor_node_real_addr (cur->e[j])->id)
+                  ->as_int);
+        }
+        d = hash_node (btor, cur, e, &in);
+        /* 'data' may be invalid due to adding children to the cache */
+        btor_hashint_map_get (cache, cur->id)->as_int =
+            BTOR_COUNT_STACK (*digests);
+        BTOR_PUSH_STACK (*digests, d);
+        if (nodes) BTOR_PUSH_STACK (*nodes, cur);
+      }
+    }
+    cur = btor_node_real_addr (BTOR_PEEK_STACK (*roots, i));
+    d   = BTOR_PEEK_STACK (*digests,
+                         btor_hashint_map_get (cache, cur->id)->as_int);
+    if (btor_node_is_inverted (BTOR_PEEK_STACK (*roots, i)))
+    {
+      d.key   = ~d.key;
+      d.check = ~d.check;
+    }
+    BTOR_PUSH_STACK (*root_digests, d);
+  }
+
+  btor_hashint_map_delete (cache);
+  BTOR_RELEASE_STACK (local);
+  BTOR_RELEASE_STACK (visit);
+}
+
+/* Color inputs by the positions they occur in: the color of a node is the
+ * (order independent) sum over all its occurrences as child of a node,
+ * combined with the digest and color of that parent and the child position.
+ * Roots are colored by their digest. 'nodes' and 'digests' are the nodes
+ * and digests in post order as computed by hash_dag. The colors of inputs
+ * are stored in 'colors' and 'color_digests'. */
+static void
+color_inputs (Btor *btor,
+              BtorNodePtrStack *roots,
+              BtorResultCacheDigestStack *root_digests,
+              BtorNodePtrStack *nodes,
+              BtorResultCacheDigestStack *digests,
+              BtorIntHashTable *colors,
+              BtorResultCacheDigestStack *color_digests)
+{
+  uint32_t i, j, pos;
+  BtorResultCacheDigest c, d, *pc;
+  BtorNode *cur, *child;
+  BtorResultCacheDigestStack ctx;
+  BtorIntHashTable *index;
+
+  BTOR_INIT_STACK (btor->mm, ctx);
+  index = btor_hashint_map_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    btor_hashint_map_add (index, BTOR_PEEK_STACK (*nodes, i)->id)->as_int = i;
+    c.key = c.check = 0;
+    BTOR_PUSH_STACK (ctx, c);
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    cur = btor_node_real_addr (BTOR_PEEK_STACK (*roots, i));
+    pc  = ctx.start + btor_hashint_map_get (index, cur->id)->as_int;
+    d   = BTOR_PEEK_STACK (*root_digests, i);
+    pc->key += hash_mix (d.key, 1);
+    pc->check += hash_mix2 (d.check, 1);
+  }
+
+  /* Parents are visited before their children in reversed post order. */
+  for (i = BTOR_COUNT_STACK (*nodes); i > 0; i--)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i - 1);
+    c   = BTOR_PEEK_STACK (ctx, i - 1);
+    digest_mix_digest (&c, digests->start + i - 1);
+    for (j = 0; j < cur->arity; j++)
+    {
+      child = cur->e[j];
+      d     = c;
+      digest_mix (&d,
+                  (btor_node_is_binary_commutative (cur) ? 0 : j + 1) * 2
+                      + btor_node_is_inverted (child));
+      pos = btor_hashint_map_get (index, btor_node_real_addr (child)->id)
+                ->as_int;
+      pc = ctx.start + pos;
+      pc->key += d.key;
+      pc->check += d.check;
+    }
+    if (cur->arity == 0 && !btor_node_is_bv_const (cur)
+        && !btor_node_is_param (cur))
+    {
+      btor_hashint_map_add (colors, cur->id)->as_int =
+          BTOR_COUNT_STACK (*color_digests);
+      BTOR_PUSH_STACK (*color_digests, BTOR_PEEK_STACK (ctx, i - 1));
+    }
+  }
+
+  btor_hashint_map_delete (index);
+  BTOR_RELEASE_STACK (ctx);
+}
+
+struct BtorResultCacheRoot
+{
+  BtorResultCacheDigest digest;
+  BtorNode *exp;
+};
+
+typedef struct BtorResultCacheRoot BtorResultCacheRoot;
+
+static int32_t
+cmp_root (const void *p, const void *q)
+{
+  const BtorResultCacheRoot *a = p, *b = q;
+  return cmp_digest (&a->digest, &b->digest);
+}
+
+/* Collect all constraints and sort them w.r.t. to their digest, where inputs
+ * are hashed by their color (see color_inputs) rather than their position.
+ * This makes the key independent from the order in which the constraints
+ * and inputs were created. Constraints that only differ in inputs with the
+ * same color are left in the order they were added, at worst this yields a
+ * different key (and a cache miss) for the same formula. */
+static void
+collect_roots (Btor *btor, BtorNodePtrStack *roots)
+{
+  uint32_t i, n;
+  BtorNode *cur;
+  BtorResultCacheRoot *sorted;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache, *colors;
+  BtorResultCacheDigestStack digests, root_digests, color_digests;
+  BtorNodePtrStack nodes;
+
+  cache = btor_hashint_table_new (btor->mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->embedded_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_pointer_chase_simplified_exp (btor,
+                                             btor_iter_hashptr_next (&it));
+    if (btor_hashint_table_contains (cache, btor_node_get_id (cur))) continue;
+    btor_hashint_table_add (cache, btor_node_get_id (cur));
+    BTOR_PUSH_STACK (*roots, cur);
+  }
+  btor_hashint_table_delete (cache);
+
+  n = BTOR_COUNT_STACK (*roots);
+  if (n < 2) return;
+
+  BTOR_INIT_STACK (btor->mm, nodes);
+  BTOR_INIT_STACK (btor->mm, digests);
+  BTOR_INIT_STACK (btor->mm, root_digests);
+  BTOR_INIT_STACK (btor->mm, color_digests);
+  colors = btor_hashint_map_new (btor->mm);
+
+  hash_dag (btor, roots, 0, 0, 0, &root_digests, &nodes, &digests);
+  color_inputs (btor,
+                roots,
+                &root_digests,
+                &nodes,
+                &digests,
+                colors,
+                &color_digests);
+  BTOR_RESET_STACK (root_digests);
+  hash_dag (btor, roots, 0, colors, &color_digests, &root_digests, 0, 0);
+
+  BTOR_NEWN (btor->mm, sorted, n);
+  for (i = 0; i < n; i++)
+  {
+    sorted[i].digest = BTOR_PEEK_STACK (root_digests, i);
+    sorted[i].exp    = BTOR_PEEK_STACK (*roots, i);
+  }
+  qsort (sorted, n, sizeof (BtorResultCacheRoot), cmp_root);
+  for (i = 0; i < n; i++) BTOR_POKE_STACK (*roots, i, sorted[i].exp);
+  BTOR_DELETEN (btor->mm, sorted, n);
+
+  btor_hashint_map_delete (colors);
+  BTOR_RELEASE_STACK (color_digests);
+  BTOR_RELEASE_STACK (root_digests);
+  BTOR_RELEASE_STACK (digests);
+  BTOR_RELEASE_STACK (nodes);
+}
+
+/* Compute the key and check hash of the current formula and the inputs in
+ * canonical order. Determines if a model for the formula can be cached. */
+static void
+compute_key (BtorResultCache *rc, BtorNodePtrStack *roots)
+{
+  uint32_t i, num_bits;
+  Btor *btor;
+  BtorNode *cur;
+  BtorResultCacheDigest d;
+  BtorResultCacheDigestStack digests;
+
+  btor = rc->btor;
+  BTOR_RESET_STACK (rc->vars);
+  BTOR_INIT_STACK (btor->mm, digests);
+
+  collect_roots (btor, roots);
+  hash_dag (btor, roots, &rc->vars, 0, 0, &digests, 0, 0);
+
+  d.key = d.check = BTOR_COUNT_STACK (*roots);
+  digest_mix (&d, BTOR_COUNT_STACK (rc->vars));
+  for (i = 0; i < BTOR_COUNT_STACK (digests); i++)
+    digest_mix_digest (&d, digests.start + i);
+  BTOR_RELEASE_STACK (digests);
+  rc->key   = d.key ? d.key : 1;
+  rc->check = d.check;
+
+  /* Models are only cached for bit-vector formulas. */
+  rc->model = btor->ufs->count == 0 && btor->lambdas->count == 0
+              && btor->quantifiers->count == 0;
+  for (i = 0, num_bits = 0; rc->model && i < BTOR_COUNT_STACK (rc->vars); i++)
+  {
+    cur = btor_node_get_by_id (btor, BTOR_PEEK_STACK (rc->vars, i));
+    if (!btor_node_is_bv_var (cur)
+        || (num_bits += btor_node_bv_get_width (btor, cur))
+               > BTOR_RESULT_CACHE_MODEL_BITS)
+      rc->model = false;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Restore the model stored in 'slot'. Returns false if the model does not
+ * satisfy the current formula (e.g., in case of a hash collision). */
+static bool
+restore_model (BtorResultCache *rc,
+               BtorResultCacheSlot *slot,
+               BtorNodePtrStack *roots)
+{
+  uint32_t i, j, pos, width;
+  bool res;
+  Btor *btor;
+  BtorNode *cur;
+  BtorBitVector *bv;
+  const BtorBitVector *val;
+  BtorPtrHashMapIterator it;
+
+  btor = rc->btor;
+
+  if (!rc->model || slot->num_vars != BTOR_COUNT_STACK (rc->vars))
+    return false;
+  for (i = 0, pos = 0; i < BTOR_COUNT_STACK (rc->vars); i++)
+  {
+    cur = btor_node_get_by_id (btor, BTOR_PEEK_STACK (rc->vars, i));
+    pos += btor_node_bv_get_width (btor, cur);
+  }
+  if (pos != slot->num_bits) return false;
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  btor_model_init_fun (btor, &btor->fun_model);
+
+  for (i = 0, pos = 0; i < BTOR_COUNT_STACK (rc->vars); i++)
+  {
+    cur   = btor_node_get_by_id (btor, BTOR_PEEK_STACK (rc->vars, i));
+    width = btor_node_bv_get_width (btor, cur);
+    bv    = btor_bv_new (btor->mm, width);
+    for (j = 0; j < width; j++, pos++)
+      btor_bv_set_bit (bv, j, (slot->model[pos / 8] >> (pos % 8)) & 1);
+    btor_model_add_to_bv (btor, btor->bv_model, cur, bv);
+    btor_bv_free (btor->mm, bv);
+  }
+
+  /* All other inputs are not constrained. */
+  btor_iter_hashptrmap_init (&it, btor->bv_vars);
+  while (btor_iter_hashptrmap_has_next (&it))
+  {
+    cur = btor_iter_hashptrmap_next (&it);
+    if (btor_node_is_proxy (cur)
+        || btor_hashint_map_contains (btor->bv_model, cur->id))
+      continue;
+    bv = btor_bv_new (btor->mm, btor_node_bv_get_width (btor, cur));
+    btor_model_add_to_bv (btor, btor->bv_model, cur, bv);
+    btor_bv_free (btor->mm, bv);
+  }
+
+  btor_model_generate (btor,
+                       btor->bv_model,
+                       btor->fun_model,
+                       btor_opt_get (btor, BTOR_OPT_MODEL_GEN) == 2);
+
+  for (i = 0, res = true; res && i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    val = btor_model_get_bv (btor, BTOR_PEEK_STACK (*roots, i));
+    res = val && btor_bv_is_true (val);
+  }
+  if (!res) btor_model_delete (btor);
+  return res;
+}
+
+static void
+save_model (BtorResultCache *rc, BtorResultCacheSlot *slot)
+{
+  uint32_t i, j, pos, width;
+  Btor *btor;
+  BtorNode *cur;
+  const BtorBitVector *bv;
+
+  btor = rc->btor;
+
+  memset (slot->model, 0, sizeof (slot->model));
+  for (i = 0, pos = 0; i < BTOR_COUNT_STACK (rc->vars); i++)
+  {
+    cur = btor_node_get_by_id (btor, BTOR_PEEK_STACK (rc->vars, i));
+    if (!cur || !(bv = btor_model_get_bv (btor, cur)))
+    {
+      slot->num_bits = 0;
+      return;
+    }
+    width = bv->width;
+    for (j = 0; j < width; j++, pos++)
+      slot->model[pos / 8] |= btor_bv_get_bit (bv, j) << (pos % 8);
+  }
+  slot->num_bits = pos;
+}
+
+/*------------------------------------------------------------------------*/
+
+BtorResultCache *
+btor_result_cache_new (Btor *btor, const char *path)
+{
+  assert (btor);
+  assert (path);
+
+  int fd;
+  struct stat st;
+  void *map;
+  bool valid;
+  BtorResultCache *rc;
+  BtorResultCacheHeader *header;
+
+  fd = open (path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) return 0;
+
+  /* Lock the file before checking its size, another process might be about
+   * to initialize it. */
+  if (flock (fd, LOCK_EX) || fstat (fd, &st)
+      || (st.st_size && (size_t) st.st_size != file_size ())
+      || (!st.st_size && ftruncate (fd, file_size ())))
+  {
+    close (fd);
+    return 0;
+  }
+
+  map = mmap (0, file_size (), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED)
+  {
+    close (fd);
+    return 0;
+  }
+
+  header = map;
+  valid  = true;
+  if (!st.st_size)
+  {
+    memcpy (header->magic, BTOR_RESULT_CACHE_MAGIC, sizeof (header->magic));
+    header->num_slots = BTOR_RESULT_CACHE_SLOTS;
+    header->slot_size = sizeof (BtorResultCacheSlot);
+  }
+  else if (memcmp (
+               header->magic, BTOR_RESULT_CACHE_MAGIC, sizeof (header->magic))
+           || header->num_slots != BTOR_RESULT_CACHE_SLOTS
+           || header->slot_size != sizeof (BtorResultCacheSlot))
+    valid = false;
+  flock (fd, LOCK_UN);
+
+  if (!valid)
+  {
+    munmap (map, file_size ());
+    close (fd);
+    return 0;
+  }
+
+  BTOR_CNEW (btor->mm, rc);
+  rc->btor     = btor;
+  rc->fd       = fd;
+  rc->map      = map;
+  rc->map_size = file_size ();
+  BTOR_INIT_STACK (btor->mm, rc->vars);
+  return rc;
+}
+
+void
+btor_result_cache_delete (BtorResultCache *rc)
+{
+  assert (rc);
+
+  munmap (rc->map, rc->map_size);
+  close (rc->fd);
+  BTOR_RELEASE_STACK (rc->vars);
+  BTOR_DELETE (rc->btor->mm, rc);
+}
+
+BtorSolverResult
+btor_result_cache_lookup (BtorResultCache *rc)
+{
+  assert (rc);
+
+  bool found;
+  BtorSolverResult res;
+  BtorNodePtrStack roots;
+  BtorResultCacheSlot *slot, copy;
+
+  BTOR_INIT_STACK (rc->btor->mm, roots);
+  compute_key (rc, &roots);
+
+  /* Copy the slot while holding the lock, since other processes may
+   * overwrite it concurrently. */
+  found = false;
+  if (!flock (rc->fd, LOCK_SH))
+  {
+    if ((slot = find_slot (rc, rc->key)))
+    {
+      memcpy (&copy, slot, sizeof (copy));
+      found = true;
+    }
+    flock (rc->fd, LOCK_UN);
+  }
+
+  /* Results are only used if the check hash matches, too. This protects
+   * UNSAT results (and SAT results without model) from key collisions. */
+  res = BTOR_RESULT_UNKNOWN;
+  if (found && copy.check == rc->check
+      && (copy.result == BTOR_RESULT_SAT || copy.result == BTOR_RESULT_UNSAT))
+  {
+    res = copy.result;
+    if (res == BTOR_RESULT_SAT && btor_opt_get (rc->btor, BTOR_OPT_MODEL_GEN)
+        && !restore_model (rc, &copy, &roots))
+      res = BTOR_RESULT_UNKNOWN;
+  }
+  BTOR_RELEASE_STACK (roots);
+
+  if (res == BTOR_RESULT_UNKNOWN)
+    rc->num_misses++;
+  else
+  {
+    rc->num_hits++;
+    rc->key = 0;
+  }
+  return res;
+}
+
+void
+btor_result_cache_store (BtorResultCache *rc, BtorSolverResult res)
+{
+  assert (rc);
+
+  uint32_t i;
+  BtorResultCacheSlot *slot, copy;
+
+  if (!rc->key) return;
+  if (res != BTOR_RESULT_SAT && res != BTOR_RESULT_UNSAT)
+  {
+    rc->key = 0;
+    return;
+  }
+
+  memset (&copy, 0, sizeof (copy));
+  copy.key      = rc->key;
+  copy.check    = rc->check;
+  copy.result   = res;
+  copy.num_vars = BTOR_COUNT_STACK (rc->vars);
+  if (res == BTOR_RESULT_SAT && rc->model
+      && btor_opt_get (rc->btor, BTOR_OPT_MODEL_GEN))
+    save_model (rc, &copy);
+  rc->key = 0;
+
+  if (flock (rc->fd, LOCK_EX)) return;
+
+  /* Use the slot of the key if it exists, the first free slot otherwise. If
+   * there is no free slot, the first slot is overwritten. */
+  if (!(slot = find_slot (rc, copy.key)))
+  {
+    for (i = 0; i < BTOR_RESULT_CACHE_PROBES; i++)
+    {
+      slot = get_slot (rc, (uint32_t) copy.key + i);
+      if (!slot->key) break;
+    }
+    if (slot->key) slot = get_slot (rc, (uint32_t) copy.key);
+  }
+  memcpy (slot, &copy, sizeof (copy));
+
+  flock (rc->fd, LOCK_UN);
+  rc->num_stores++;
+}
@@ -0,0 +1,59 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORRESULTCACHE_H_INCLUDED
+#define BTORRESULTCACHE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "btortypes.h"
+#include "utils/btorstack.h"
+
+/* Number of slots of a result cache file (power of 2). */
+#define BTOR_RESULT_CACHE_SLOTS (1u << 12)
+/* Maximum number of model bits stored per slot. */
+#define BTOR_RESULT_CACHE_MODEL_BITS 4096
+
+/* Persistent cache that maps the canonical structural hash of the simplified
+ * input formula to its result (SAT/UNSAT) and, for satisfiable bit-vector
+ * formulas with at most BTOR_RESULT_CACHE_MODEL_BITS input bits, to a model.
+ * The cache lives in a memory-mapped file and can be shared between
+ * subsequent and concurrent runs, accesses are serialized via flock. A
+ * second, independently computed hash is stored with each result and must
+ * match before the result is used, cached models are checked as well. */
+struct BtorResultCache
+{
+  Btor *btor;
+  int fd;            /* file descriptor of the cache file, used for locking */
+  uint8_t *map;      /* memory-mapped cache file */
+  size_t map_size;   /* size of the cache file in Byte */
+  uint64_t key;      /* key of the last lookup, 0 if there is none */
+  uint64_t check;    /* check hash of the last lookup */
+  BtorIntStack vars; /* inputs of the last lookup in canonical order */
+  bool model;        /* can the model of the last lookup be cached? */
+  uint64_t num_hits; /* number of lookups that returned a result */
+  uint64_t num_misses;
+  uint64_t num_stores;
+};
+
+typedef struct BtorResultCache BtorResultCache;
+
+/* Open (and create if it does not exist) the cache file 'path'. Returns 0 if
+ * the file could not be opened or is not a valid cache file. */
+BtorResultCache *btor_result_cache_new (Btor *btor, const char *path);
+
+/* Unmap the cache file and delete the cache. */
+void btor_result_cache_delete (BtorResultCache *rc);
+
+/* Look up the current (simplified) formula. Returns BTOR_RESULT_UNKNOWN on a
+ * miss. On a BTOR_RESULT_SAT hit with model generation enabled the model is
+ * restored, a hit without (valid) cached model counts as miss in that case. */
+BtorSolverResult btor_result_cache_lookup (BtorResultCache *rc);
+
+/* Store result 'res' for the formula of the last lookup. */
+void btor_result_cache_store (BtorResultCache *rc, BtorSolverResult res);
+
+#endif
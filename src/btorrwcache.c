@@ -9,34 +9,32 @@
 #include "btorrwcache.h"
 #include "btorcore.h"
 
-static uint32_t hash_primes[] = {
-    333444569u, 76891121u, 456790003u, 2654435761u};
+#include <string.h>
 
-int32_t
-compare_rw_cache_tuple (const BtorRwCacheTuple *t0, const BtorRwCacheTuple *t1)
-{
-  assert (t0);
-  assert (t1);
+#define BTOR_RW_CACHE_INIT_SETS 256
 
-  if (t0->kind == t1->kind && t0->n[0] == t1->n[0] && t0->n[1] == t1->n[1]
-      && t0->n[2] == t1->n[2])
-  {
-    return 0;
-  }
-  return 1;
-}
+static uint32_t hash_primes[] = {
+    333444569u, 76891121u, 456790003u, 2654435761u};
 
-uint32_t
-hash_rw_cache_tuple (const BtorRwCacheTuple *t)
+static uint32_t
+hash_rw_cache_tuple (BtorNodeKind kind,
+                     int32_t nid0,
+                     int32_t nid1,
+                     int32_t nid2)
 {
   uint32_t hash;
-  hash = hash_primes[0] * (uint32_t) t->kind;
-  hash += hash_primes[1] * (uint32_t) t->n[0];
-  hash += hash_primes[2] * (uint32_t) t->n[1];
-  hash += hash_primes[3] * (uint32_t) t->n[2];
+  hash = hash_primes[0] * (uint32_t) kind;
+  hash += hash_primes[1] * (uint32_t) nid0;
+  hash += hash_primes[2] * (uint32_t) nid1;
+  hash += hash_primes[3] * (uint32_t) nid2;
+  /* sets are selected with the lower bits */
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3bu;
+  hash ^= hash >> 16;
   return hash;
 }
 
+#ifndef NDEBUG
 static bool
 is_valid_node (Btor *btor, int32_t id)
 {
@@ -47,6 +45,102 @@ is_valid_node (Btor *btor, int32_t id)
   }
   return true;
 }
+#endif
+
+/* Maximum number of sets w.r.t. to the memory limit. */
+static uint32_t
+max_sets (BtorRwCache *rwc)
+{
+  uint64_t limit, res;
+
+  limit = (uint64_t) btor_opt_get (rwc->btor, BTOR_OPT_RW_CACHE_SIZE) << 20;
+  limit /= BTOR_RW_CACHE_WAYS * sizeof (BtorRwCacheTuple);
+  for (res = 1; 2 * res <= limit && 2 * res <= (1u << 31); res *= 2)
+    ;
+  return res <= limit ? res : 0;
+}
+
+static BtorRwCacheTuple *
+find_set (BtorRwCache *rwc,
+          BtorNodeKind kind,
+          int32_t nid0,
+          int32_t nid1,
+          int32_t nid2)
+{
+  uint32_t h = hash_rw_cache_tuple (kind, nid0, nid1, nid2);
+  return rwc->cache + (h & (rwc->num_sets - 1)) * BTOR_RW_CACHE_WAYS;
+}
+
+static inline bool
+match (BtorRwCache *rwc,
+       BtorRwCacheTuple *t,
+       BtorNodeKind kind,
+       int32_t nid0,
+       int32_t nid1,
+       int32_t nid2)
+{
+  return t->version == rwc->version && t->kind == kind && t->n[0] == nid0
+         && t->n[1] == nid1 && t->n[2] == nid2;
+}
+
+/* Move entry 'i' of 'set' to the front, i.e., mark it as most recently used. */
+static void
+move_to_front (BtorRwCacheTuple *set, uint32_t i)
+{
+  BtorRwCacheTuple t;
+
+  if (i == 0) return;
+  t = set[i];
+  memmove (set + 1, set, i * sizeof (BtorRwCacheTuple));
+  set[0] = t;
+}
+
+/* Insert 'entry' as most recently used entry of its set. */
+static void
+insert (BtorRwCache *rwc, BtorRwCacheTuple *entry)
+{
+  BtorRwCacheTuple *set, *last;
+
+  set  = find_set (rwc, entry->kind, entry->n[0], entry->n[1], entry->n[2]);
+  last = set + BTOR_RW_CACHE_WAYS - 1;
+  if (last->version == rwc->version)
+    rwc->num_evict++;
+  else
+    rwc->count++;
+  move_to_front (set, BTOR_RW_CACHE_WAYS - 1);
+  set[0] = *entry;
+}
+
+static void
+grow (BtorRwCache *rwc, uint32_t new_num_sets)
+{
+  assert (new_num_sets > rwc->num_sets);
+
+  uint32_t i, j, num_sets, version;
+  BtorRwCacheTuple *cache, *set;
+
+  cache    = rwc->cache;
+  num_sets = rwc->num_sets;
+  version  = rwc->version;
+
+  BTOR_CNEWN (rwc->btor->mm, rwc->cache, new_num_sets * BTOR_RW_CACHE_WAYS);
+  rwc->num_sets = new_num_sets;
+  rwc->version  = 1;
+  rwc->count    = 0;
+
+  /* Insert least recently used entries first to preserve the order. */
+  for (i = 0; i < num_sets; i++)
+  {
+    set = cache + i * BTOR_RW_CACHE_WAYS;
+    for (j = BTOR_RW_CACHE_WAYS; j > 0; j--)
+    {
+      if (set[j - 1].version != version) continue;
+      set[j - 1].version = rwc->version;
+      insert (rwc, set + j - 1);
+    }
+  }
+  BTOR_DELETEN (rwc->btor->mm, cache, num_sets * BTOR_RW_CACHE_WAYS);
+}
 
 int32_t
 btor_rw_cache_get (BtorRwCache *rwc,
@@ -65,12 +159,27 @@ btor_rw_cache_get (BtorRwCache *rwc,
   }
 #endif
 
-  BtorRwCacheTuple t   = {.kind = kind, .n = {nid0, nid1, nid2}};
-  BtorPtrHashBucket *b = btor_hashptr_table_get (rwc->cache, &t);
-  if (b)
+  uint32_t i;
+  BtorRwCacheTuple *set;
+
+  if (!rwc->cache) return 0;
+
+  set = find_set (rwc, kind, nid0, nid1, nid2);
+  for (i = 0; i < BTOR_RW_CACHE_WAYS; i++)
   {
-    BtorRwCacheTuple *cached = b->key;
-    return cached->result;
+    if (!match (rwc, set + i, kind, nid0, nid1, nid2)) continue;
+
+    /* Node ids are never reused, the result node was deallocated if its id
+     * does not map to a node anymore. */
+    if (!btor_node_get_by_id (rwc->btor, set[i].result))
+    {
+      set[i].version = 0;
+      rwc->count--;
+      rwc->num_stale++;
+      return 0;
+    }
+    move_to_front (set, i);
+    return set[0].result;
   }
   return 0;
 }
@@ -96,144 +205,126 @@ btor_rw_cache_add (BtorRwCache *rwc,
   }
 #endif
 
-  /* The bruttomesso benchmark family produces extremely many distinct slice
-   * nodes that let's the cache grow to several GB in some cases. For now, we
-   * will disable caching of slice nodes until we find a better solution.
-   * Note: Calling btor_rw_cache_gc(...) does not help here. */
-  if (kind == BTOR_BV_SLICE_NODE)
-  {
-    return;
-  }
+  uint32_t i, limit;
+  BtorRwCacheTuple *set, t;
+
+  if (!rwc->cache) return;
 
-  int32_t cached_result_id;
-  if ((cached_result_id = btor_rw_cache_get (rwc, kind, nid0, nid1, nid2)))
+  set = find_set (rwc, kind, nid0, nid1, nid2);
+  for (i = 0; i < BTOR_RW_CACHE_WAYS; i++)
   {
-    /* This can only happen if the node corresponding to cached_result_id does
-     * not exist anymore (= deallocated). */
-    if (cached_result_id != result)
+    if (!match (rwc, set + i, kind, nid0, nid1, nid2)) continue;
+    /* This can only happen if the node corresponding to the cached result
+     * does not exist anymore (= deallocated). */
+    if (set[i].result != result)
     {
-      assert (btor_node_get_by_id (rwc->btor, cached_result_id) == 0);
-      BtorRwCacheTuple t   = {.kind = kind, .n = {nid0, nid1, nid2}};
-      BtorPtrHashBucket *b = btor_hashptr_table_get (rwc->cache, &t);
-      assert (b);
-      BtorRwCacheTuple *cached = b->key;
-      cached->result           = result;  // Update the result
+      assert (btor_node_get_by_id (rwc->btor, set[i].result) == 0);
+      set[i].result = result;
       rwc->num_update++;
     }
+    move_to_front (set, i);
     return;
   }
 
-  BtorRwCacheTuple *t;
-  BTOR_CNEW (rwc->btor->mm, t);
-  t->kind   = kind;
-  t->n[0]   = nid0;
-  t->n[1]   = nid1;
-  t->n[2]   = nid2;
-  t->result = result;
-  rwc->num_add++;
-
-  btor_hashptr_table_add (rwc->cache, t);
-
-  if (rwc->num_add % 100000 == 0)
+  /* Grow the cache if it is 3/4 full and the memory limit allows it. */
+  if (4 * rwc->count >= 3 * (uint64_t) rwc->num_sets * BTOR_RW_CACHE_WAYS)
   {
-    btor_rw_cache_gc (rwc);
+    limit = max_sets (rwc);
+    if (limit > rwc->num_sets) grow (rwc, 2 * rwc->num_sets);
   }
+
+  t.kind    = kind;
+  t.n[0]    = nid0;
+  t.n[1]    = nid1;
+  t.n[2]    = nid2;
+  t.result  = result;
+  t.version = rwc->version;
+  insert (rwc, &t);
+  rwc->num_add++;
 }
 
 void
 btor_rw_cache_init (BtorRwCache *rwc, Btor *btor)
 {
   assert (rwc);
+
+  uint32_t limit;
+
   rwc->btor       = btor;
-  rwc->cache      = btor_hashptr_table_new (btor->mm,
-                                       (BtorHashPtr) hash_rw_cache_tuple,
-                                       (BtorCmpPtr) compare_rw_cache_tuple);
+  rwc->cache      = 0;
+  rwc->num_sets   = 0;
+  rwc->version    = 1;
+  rwc->count      = 0;
   rwc->num_add    = 0;
   rwc->num_get    = 0;
   rwc->num_update = 0;
-  rwc->num_remove = 0;
-}
-
-void
-btor_rw_cache_delete (BtorRwCache *rwc)
-{
-  assert (rwc);
+  rwc->num_evict  = 0;
+  rwc->num_stale  = 0;
 
-  BtorPtrHashTableIterator it;
-  BtorRwCacheTuple *t;
-
-  btor_iter_hashptr_init (&it, rwc->cache);
-  while (btor_iter_hashptr_has_next (&it))
+  limit = max_sets (rwc);
+  if (limit)
   {
-    t = btor_iter_hashptr_next (&it);
-    BTOR_DELETE (rwc->btor->mm, t);
+    rwc->num_sets =
+        limit < BTOR_RW_CACHE_INIT_SETS ? limit : BTOR_RW_CACHE_INIT_SETS;
+    BTOR_CNEWN (btor->mm, rwc->cache, rwc->num_sets * BTOR_RW_CACHE_WAYS);
   }
-  btor_hashptr_table_delete (rwc->cache);
 }
 
 void
-btor_rw_cache_reset (BtorRwCache *rwc)
+btor_rw_cache_delete (BtorRwCache *rwc)
 {
   assert (rwc);
-  assert (rwc->btor->mm);
-  assert (rwc->cache);
 
-  Btor *btor = rwc->btor;
-  btor_rw_cache_delete (rwc);
-  btor_rw_cache_init (rwc, btor);
+  if (rwc->cache)
+    BTOR_DELETEN (
+        rwc->btor->mm, rwc->cache, rwc->num_sets * BTOR_RW_CACHE_WAYS);
+  rwc->cache    = 0;
+  rwc->num_sets = 0;
+  rwc->count    = 0;
 }
 
 void
-btor_rw_cache_gc (BtorRwCache *rwc)
+btor_rw_cache_reset (BtorRwCache *rwc)
 {
+  assert (rwc);
   assert (rwc->btor->mm);
-  assert (rwc->cache);
-
-  bool remove;
-  BtorPtrHashTableIterator it;
-  BtorRwCacheTuple *t;
-  BtorNodeKind kind;
 
-  Btor *btor            = rwc->btor;
-  BtorPtrHashTable *old = rwc->cache;
+  uint64_t num_add, num_get, num_update, num_evict, num_stale;
 
-  rwc->cache = btor_hashptr_table_new (btor->mm, old->hash, old->cmp);
-
-  /* We remove all cache entries that store invalid children node ids. An
-   * invalid node is either a node that does not exist anymore (deallocated) or
-   * if the node id belongs to a proxy node. Proxy nodes are never used to
-   * query the cache and are therefore useless cache entries. */
-  btor_iter_hashptr_init (&it, old);
-  while (btor_iter_hashptr_has_next (&it))
+  /* Invalidate all entries by increasing the version if the cache size still
+   * complies with the memory limit. */
+  if (rwc->cache && rwc->num_sets <= max_sets (rwc))
   {
-    t = btor_iter_hashptr_next (&it);
-    kind = t->kind;
-
-    remove = !is_valid_node (btor, t->n[0]);
-
-    if (!remove && kind != BTOR_BV_SLICE_NODE)
+    rwc->version += 1;
+    if (rwc->version == 0)
     {
-      if (t->n[1])
-      {
-        remove = remove || !is_valid_node (btor, t->n[1]);
-      }
-      if (!remove && t->n[2])
-      {
-        remove = remove || !is_valid_node (btor, t->n[2]);
-      }
-
-      remove = remove || !btor_node_get_by_id (btor, t->result);
-    }
-
-    if (remove)
-    {
-      BTOR_DELETE (btor->mm, t);
-      rwc->num_remove++;
-    }
-    else
-    {
-      btor_hashptr_table_add (rwc->cache, t);
+      memset (rwc->cache,
+              0,
+              rwc->num_sets * BTOR_RW_CACHE_WAYS * sizeof (BtorRwCacheTuple));
+      rwc->version = 1;
     }
+    rwc->count = 0;
+    return;
   }
-  btor_hashptr_table_delete (old);
+
+  num_add    = rwc->num_add;
+  num_get    = rwc->num_get;
+  num_update = rwc->num_update;
+  num_evict  = rwc->num_evict;
+  num_stale  = rwc->num_stale;
+  btor_rw_cache_delete (rwc);
+  btor_rw_cache_init (rwc, rwc->btor);
+  rwc->num_add    = num_add;
+  rwc->num_get    = num_get;
+  rwc->num_update = num_update;
+  rwc->num_evict  = num_evict;
+  rwc->num_stale  = num_stale;
+}
+
+size_t
+btor_rw_cache_size (const BtorRwCache *rwc)
+{
+  assert (rwc);
+  return sizeof (*rwc)
+         + rwc->num_sets * BTOR_RW_CACHE_WAYS * sizeof (BtorRwCacheTuple);
 }
@@ -10,10 +10,13 @@
 #define BTORRWCACHE_H_INCLUDED
 
 #include "btornode.h"
-#include "utils/btorhashptr.h"
+
+/* Number of entries per cache set. */
+#define BTOR_RW_CACHE_WAYS 4
 
 /* Cache entry that stores the result of rewriting a node with kind 'kind' and
- * it's children 'n'.
+ * it's children 'n'. An entry is only valid if 'version' matches the version
+ * of the cache.
  * Note: In the case of BTOR_SLICE_NODE n[1] and n[2] are the upper and lower
  * indices. */
 struct BtorRwCacheTuple
@@ -21,20 +24,29 @@ struct BtorRwCacheTuple
   BtorNodeKind kind;
   int32_t n[3];
   int32_t result;
+  uint32_t version;
 };
 
 typedef struct BtorRwCacheTuple BtorRwCacheTuple;
 
-/* Stores all cache entries and some statistics. Note that the statistics are
- * not reset if btor_rw_cache_reset() or btor_rw_cache_gc() is called. */
+/* Set-associative cache of 'num_sets' * BTOR_RW_CACHE_WAYS entries. Entries
+ * of a set are kept in most recently used order. The number of sets is
+ * doubled if the cache fills up until the memory limit given by option
+ * BTOR_OPT_RW_CACHE_SIZE is reached, then the least recently used entry of a
+ * set is evicted. Note that the statistics are not reset if
+ * btor_rw_cache_reset() is called. */
 struct BtorRwCache
 {
   Btor *btor;
-  BtorPtrHashTable *cache;  /* Hash table of BtorRwCacheTuple. */
+  BtorRwCacheTuple *cache;  /* num_sets * BTOR_RW_CACHE_WAYS entries. */
+  uint32_t num_sets;        /* Number of sets (power of 2). */
+  uint32_t version;         /* Current version, 0 marks empty entries. */
+  uint64_t count;           /* Number of valid entries. */
   uint64_t num_add;         /* Number of cached rewrite rules. */
   uint64_t num_get;         /* Number of cache checks. */
   uint64_t num_update;      /* Number of updated cache entries. */
-  uint64_t num_remove;      /* Number of removed cache entries (GC). */
+  uint64_t num_evict;       /* Number of evicted cache entries. */
+  uint64_t num_stale;       /* Number of entries with deallocated results. */
 };
 
 typedef struct BtorRwCache BtorRwCache;
@@ -63,8 +75,7 @@ void btor_rw_cache_delete (BtorRwCache *cache);
 /* Reset the rewrite cache. */
 void btor_rw_cache_reset (BtorRwCache *cache);
 
-/* Remove all cache entries that contain invalid nodes (= deallocated) or
- * proxies as children. */
-void btor_rw_cache_gc (BtorRwCache *cache);
+/* Returns the size of the rewrite cache in Byte. */
+size_t btor_rw_cache_size (const BtorRwCache *cache);
 
 #endif
@@ -12,9 +12,11 @@
 #include "btorsat.h"
 
 #include "sat/btorcadical.h"
+#include "sat/btoripasir.h"
 #include "sat/btorlgl.h"
 #include "sat/btorminisat.h"
 #include "sat/btorpicosat.h"
+#include "sat/btorportfolio.h"
 
 #include "btorabort.h"
 #include "btorcore.h"
@@ -32,6 +34,10 @@
 #error "no SAT solver configured"
 #endif
 
+/* number of buffered literals that triggers handing clauses to the SAT
+ * solver */
+#define BTOR_SAT_CLAUSE_BUF_SIZE (1 << 16)
+
 /*------------------------------------------------------------------------*/
 /* wrapper functions for SAT solver API                                   */
 /*------------------------------------------------------------------------*/
@@ -43,6 +49,17 @@ add (BtorSATMgr *smgr, int32_t lit)
   smgr->api.add (smgr, lit);
 }
 
+static inline void
+add_lits (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  size_t i;
+
+  if (smgr->api.add_lits)
+    smgr->api.add_lits (smgr, lits, n);
+  else
+    for (i = 0; i < n; i++) add (smgr, lits[i]);
+}
+
 static inline void
 assume (BtorSATMgr *smgr, int32_t lit)
 {
@@ -158,6 +175,23 @@ stats (BtorSATMgr *smgr)
 
 /*------------------------------------------------------------------------*/
 
+/* Hands all buffered clauses to the SAT solver. */
+static void
+flush (BtorSATMgr *smgr)
+{
+  assert (smgr);
+
+  size_t n;
+
+  n = BTOR_COUNT_STACK (smgr->clause_buf);
+  if (!n) return;
+  assert (BTOR_TOP_STACK (smgr->clause_buf) == 0);
+  add_lits (smgr, smgr->clause_buf.start, n);
+  BTOR_RESET_STACK (smgr->clause_buf);
+}
+
+/*------------------------------------------------------------------------*/
+
 BtorSATMgr *
 btor_sat_mgr_new (Btor *btor)
 {
@@ -168,6 +202,7 @@ btor_sat_mgr_new (Btor *btor)
   BTOR_CNEW (btor->mm, smgr);
   smgr->btor   = btor;
   smgr->output = stdout;
+  BTOR_INIT_STACK (btor->mm, smgr->clause_buf);
   return smgr;
 }
 
@@ -208,16 +243,20 @@ btor_sat_mgr_clone (Btor *btor, BtorSATMgr *smgr)
   BTOR_ABORT (!btor_sat_mgr_has_clone_support (smgr),
               "SAT solver does not support cloning");
 
+  flush (smgr);
+
   mm = btor->mm;
   BTOR_NEW (mm, res);
   res->solver = clone (smgr, mm);
   res->btor   = btor;
   assert (mm->sat_allocated == smgr->btor->mm->sat_allocated);
   res->name = smgr->name;
+  BTOR_INIT_STACK (mm, res->clause_buf);
   memcpy (&res->inc_required,
           &smgr->inc_required,
           (char *) smgr + sizeof (*smgr) - (char *) &smgr->inc_required);
   BTOR_CLR (&res->term);
+  BTOR_CLR (&res->learn);
   return res;
 }
 
@@ -249,6 +288,7 @@ btor_sat_mgr_release_cnf_id (BtorSATMgr *smgr, int32_t lit)
   if (!smgr->initialized) return;
   assert (abs (lit) <= smgr->maxvar);
   if (abs (lit) == smgr->true_lit) return;
+  flush (smgr);
   melt (smgr, lit);
 }
 
@@ -260,6 +300,7 @@ btor_sat_mgr_delete (BtorSATMgr *smgr)
    * reset_sat has not been called
    */
   if (smgr->initialized) btor_sat_reset (smgr);
+  BTOR_RELEASE_STACK (smgr->clause_buf);
   BTOR_DELETE (smgr->btor->mm, smgr);
 }
 
@@ -287,7 +328,7 @@ btor_sat_set_output (BtorSATMgr *smgr, FILE *output)
 }
 
 void
-btor_sat_enable_solver (BtorSATMgr *smgr)
+btor_sat_enable_engine (BtorSATMgr *smgr)
 {
   assert (smgr);
 
@@ -307,9 +348,24 @@ btor_sat_enable_solver (BtorSATMgr *smgr)
 #endif
 #ifdef BTOR_USE_CADICAL
     case BTOR_SAT_ENGINE_CADICAL: btor_sat_enable_cadical (smgr); break;
+#endif
+#ifdef BTOR_USE_IPASIR
+    case BTOR_SAT_ENGINE_IPASIR: btor_sat_enable_ipasir (smgr); break;
 #endif
     default: BTOR_ABORT (1, "no sat solver configured");
   }
+}
+
+void
+btor_sat_enable_solver (BtorSATMgr *smgr)
+{
+  assert (smgr);
+
+  btor_sat_enable_engine (smgr);
+#ifdef BTOR_HAVE_PTHREADS
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO) > 1)
+    btor_sat_enable_portfolio (smgr);
+#endif
 
   BTOR_MSG (smgr->btor->msg,
             1,
@@ -347,6 +403,7 @@ void
 btor_sat_print_stats (BtorSATMgr *smgr)
 {
   if (!smgr || !smgr->initialized) return;
+  flush (smgr);
   stats (smgr);
   BTOR_MSG (smgr->btor->msg,
             1,
@@ -362,8 +419,11 @@ btor_sat_add (BtorSATMgr *smgr, int32_t lit)
   assert (smgr->initialized);
   assert (abs (lit) <= smgr->maxvar);
   assert (!smgr->satcalls || smgr->inc_required);
-  if (!lit) smgr->clauses++;
-  add (smgr, lit);
+  BTOR_PUSH_STACK (smgr->clause_buf, lit);
+  if (lit) return;
+  smgr->clauses++;
+  if (BTOR_COUNT_STACK (smgr->clause_buf) >= BTOR_SAT_CLAUSE_BUF_SIZE)
+    flush (smgr);
 }
 
 BtorSolverResult
@@ -383,6 +443,7 @@ btor_sat_check_sat (BtorSATMgr *smgr, int32_t limit)
             limit);
   assert (!smgr->satcalls || smgr->inc_required);
   smgr->satcalls++;
+  flush (smgr);
   setterm (smgr);
   sat_res = sat (smgr, limit);
   smgr->sat_time += btor_util_time_stamp () - start;
@@ -402,6 +463,7 @@ btor_sat_deref (BtorSATMgr *smgr, int32_t lit)
   assert (smgr != NULL);
   assert (smgr->initialized);
   assert (abs (lit) <= smgr->maxvar);
+  flush (smgr);
   return deref (smgr, lit);
 }
 
@@ -412,6 +474,7 @@ btor_sat_repr (BtorSATMgr *smgr, int32_t lit)
   assert (smgr != NULL);
   assert (smgr->initialized);
   assert (abs (lit) <= smgr->maxvar);
+  flush (smgr);
   return repr (smgr, lit);
 }
 
@@ -421,6 +484,7 @@ btor_sat_reset (BtorSATMgr *smgr)
   assert (smgr != NULL);
   assert (smgr->initialized);
   BTOR_MSG (smgr->btor->msg, 2, "resetting %s", smgr->name);
+  BTOR_RELEASE_STACK (smgr->clause_buf);
   reset (smgr);
   smgr->solver      = 0;
   smgr->initialized = false;
@@ -433,6 +497,7 @@ btor_sat_fixed (BtorSATMgr *smgr, int32_t lit)
   assert (smgr != NULL);
   assert (smgr->initialized);
   assert (abs (lit) <= smgr->maxvar);
+  flush (smgr);
   res = fixed (smgr, lit);
   return res;
 }
@@ -446,6 +511,7 @@ btor_sat_assume (BtorSATMgr *smgr, int32_t lit)
   assert (smgr->initialized);
   assert (abs (lit) <= smgr->maxvar);
   assert (!smgr->satcalls || smgr->inc_required);
+  flush (smgr);
   assume (smgr, lit);
 }
 
@@ -456,5 +522,6 @@ btor_sat_failed (BtorSATMgr *smgr, int32_t lit)
   assert (smgr != NULL);
   assert (smgr->initialized);
   assert (abs (lit) <= smgr->maxvar);
+  flush (smgr);
   return failed (smgr, lit);
 }
@@ -14,6 +14,7 @@
 
 #include "btortypes.h"
 #include "utils/btormem.h"
+#include "utils/btorstack.h"
 
 #include <stdbool.h>
 #include <stdio.h>
@@ -31,6 +32,11 @@ struct BtorSATMgr
 
   const char *name; /* solver name */
 
+  /* Literals of complete, 0-terminated clauses that have not been handed
+   * to the SAT solver yet (see btor_sat_add).  Not copied when cloning,
+   * the buffer is flushed beforehand. */
+  BtorIntStack clause_buf;
+
   /* Note: do not change order! (btor_sat_mgr_clone relies on inc_required
    * to come first of all fields following below.) */
   bool inc_required;
@@ -53,9 +59,21 @@ struct BtorSATMgr
     void *state;
   } term;
 
+  struct
+  {
+    /* called with every learned clause of at most 'max_size' literals,
+     * the clause is 0-terminated and only valid during the call */
+    void (*fun) (void *, const int32_t *);
+    void *state;
+    uint32_t max_size;
+  } learn;
+
   struct
   {
     void (*add) (BtorSATMgr *, int32_t); /* required */
+    /* add n literals forming a sequence of 0-terminated clauses, only set
+     * if the backend has a bulk interface (falls back to 'add' otherwise) */
+    void (*add_lits) (BtorSATMgr *, const int32_t *, size_t);
     void (*assume) (BtorSATMgr *, int32_t);
     int32_t (*deref) (BtorSATMgr *, int32_t); /* required */
     void (*enable_verbosity) (BtorSATMgr *, int32_t);
@@ -72,6 +90,12 @@ struct BtorSATMgr
     void (*stats) (BtorSATMgr *);
     void *(*clone) (BtorSATMgr *, BtorMemMgr *);
     void (*setterm) (BtorSATMgr *);
+    /* install the 'learn' callback, only used by the portfolio and called
+     * from the thread running the instance */
+    void (*setlearn) (BtorSATMgr *);
+    /* configure instance i > 0 of a portfolio differently (e.g. seed,
+     * default phase), must be called before adding clauses */
+    void (*diversify) (BtorSATMgr *, uint32_t);
   } api;
 };
 
@@ -108,8 +132,13 @@ void btor_sat_mgr_release_cnf_id (BtorSATMgr *smgr, int32_t);
 int32_t btor_get_last_cnf_id_sat_mgr (BtorSATMgr * smgr);
 #endif
 
+/* Enables the SAT solver selected via BTOR_OPT_SAT_ENGINE, wrapped into a
+ * portfolio if BTOR_OPT_SAT_ENGINE_PORTFOLIO > 1. */
 void btor_sat_enable_solver (BtorSATMgr *smgr);
 
+/* Enables the SAT solver selected via BTOR_OPT_SAT_ENGINE (no portfolio). */
+void btor_sat_enable_engine (BtorSATMgr *smgr);
+
 /* Inits the SAT solver. */
 void btor_sat_init (BtorSATMgr *smgr);
 
@@ -124,6 +153,8 @@ void btor_sat_print_stats (BtorSATMgr *smgr);
 
 /* Adds literal to the current clause of the SAT solver.
  * 0 terminates the current clause.
+ * Clauses are buffered and handed to the SAT solver in bulk, the buffer is
+ * flushed before any other call to the SAT solver.
  */
 void btor_sat_add (BtorSATMgr *smgr, int32_t lit);
 
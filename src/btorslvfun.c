@@ -28,6 +28,14 @@
 #include "utils/btorstack.h"
 #include "utils/btorutil.h"
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* number of sat calls a lemma is kept in the lemma cache (and assumed again)
+ * in assume_lemmas mode after it was derived */
+#define BTOR_FUN_LEMMAS_MAX_AGE 32
+
 /*------------------------------------------------------------------------*/
 
 static BtorFunSolver *
@@ -48,12 +56,36 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   memcpy (res, slv, sizeof (BtorFunSolver));
 
   res->btor   = clone;
-  res->lemmas = btor_hashptr_table_clone (
-      clone->mm, slv->lemmas, btor_clone_key_as_node, 0, exp_map, 0);
+  res->lemmas = btor_hashptr_table_clone (clone->mm,
+                                          slv->lemmas,
+                                          btor_clone_key_as_node,
+                                          btor_clone_data_as_int,
+                                          exp_map,
+                                          0);
 
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
 
+  btor_clone_node_ptr_stack (
+      clone->mm, &slv->init_apps, &res->init_apps, exp_map, false);
+  res->init_apps_cache = btor_hashint_table_clone (clone->mm,
+                                                   slv->init_apps_cache);
+  res->init_apps_roots = btor_hashptr_table_clone (clone->mm,
+                                                   slv->init_apps_roots,
+                                                   btor_clone_key_as_node,
+                                                   0,
+                                                   exp_map,
+                                                   0);
+
+  btor_clone_node_ptr_stack (
+      clone->mm, &slv->rho_funs, &res->rho_funs, exp_map, false);
+  res->rho_values = btor_hashptr_table_clone (clone->mm,
+                                              slv->rho_values,
+                                              btor_clone_key_as_node,
+                                              btor_clone_data_as_bv_ptr,
+                                              exp_map,
+                                              0);
+
   if (slv->score)
   {
     h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -117,6 +149,34 @@ delete_fun_solver (BtorFunSolver *slv)
     btor_node_release (btor, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (slv->lemmas);
 
+  btor_iter_hashptr_init (&it, slv->init_apps_roots);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (slv->init_apps_roots);
+  btor_hashint_table_delete (slv->init_apps_cache);
+  while (!BTOR_EMPTY_STACK (slv->init_apps))
+    btor_node_release (btor, BTOR_POP_STACK (slv->init_apps));
+  BTOR_RELEASE_STACK (slv->init_apps);
+
+  while (!BTOR_EMPTY_STACK (slv->rho_funs))
+  {
+    exp = BTOR_POP_STACK (slv->rho_funs);
+    if (exp->rho)
+    {
+      btor_hashptrmap_delete (exp->rho);
+      exp->rho = 0;
+    }
+    btor_node_release (btor, exp);
+  }
+  BTOR_RELEASE_STACK (slv->rho_funs);
+  btor_iter_hashptr_init (&it, slv->rho_values);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_bv_free (btor->mm, it.bucket->data.as_ptr);
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (slv->rho_values);
+
   if (slv->score)
   {
     btor_iter_hashptr_init (&it, slv->score);
@@ -233,6 +293,7 @@ configure_sat_mgr (Btor *btor)
   /* default to CaDiCaL if we have non-incremental QF_BV */
   if (!smgr->inc_required
       && btor_opt_get (btor, BTOR_OPT_SAT_ENGINE) != BTOR_SAT_ENGINE_CADICAL
+      && btor_opt_get (btor, BTOR_OPT_SAT_ENGINE) != BTOR_SAT_ENGINE_IPASIR
       && btor_opt_get (btor, BTOR_OPT_DEFAULT_TO_CADICAL))
   {
     BTOR_MSG (btor->msg, 1, "no functions found, defaulting to CaDiCaL");
@@ -368,7 +429,9 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   btor_opt_set (clone, BTOR_OPT_FUN_DUAL_PROP, 0);
 
   assert (!btor_sat_is_initialized (btor_get_sat_mgr (clone)));
-  btor_opt_set_str (clone, BTOR_OPT_SAT_ENGINE, "plain=1");
+  /* the option string of an IPASIR engine holds the library path */
+  if (btor_opt_get (clone, BTOR_OPT_SAT_ENGINE) != BTOR_SAT_ENGINE_IPASIR)
+    btor_opt_set_str (clone, BTOR_OPT_SAT_ENGINE, "plain=1");
   configure_sat_mgr (clone);
 
   btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
@@ -937,6 +1000,90 @@ add_lemma_to_dual_prop_clone (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
+static void
+reset_init_apps (BtorFunSolver *slv)
+{
+  Btor *btor;
+  BtorPtrHashTableIterator it;
+
+  btor = slv->btor;
+  btor_iter_hashptr_init (&it, slv->init_apps_roots);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  while (!BTOR_EMPTY_STACK (slv->init_apps))
+    btor_node_release (btor, BTOR_POP_STACK (slv->init_apps));
+  btor_hashptr_table_delete (slv->init_apps_roots);
+  slv->init_apps_roots =
+      btor_hashptr_table_new (btor->mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
+  btor_hashint_table_delete (slv->init_apps_cache);
+  slv->init_apps_cache = btor_hashint_table_new (btor->mm);
+}
+
+/* Discard the initial applies collected in previous sat calls if any of the
+ * constraints they were collected from was removed from the formula (e.g.,
+ * rewritten due to new top level substitutions). */
+static void
+check_init_apps (BtorFunSolver *slv)
+{
+  Btor *btor;
+  BtorNode *cur;
+  BtorPtrHashTableIterator it;
+
+  btor = slv->btor;
+  btor_iter_hashptr_init (&it, slv->init_apps_roots);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor_node_real_addr (cur)->simplified
+        || !btor_hashptr_table_get (btor->synthesized_constraints, cur))
+    {
+      reset_init_apps (slv);
+      break;
+    }
+  }
+}
+
+static void
+collect_initial_applies (Btor *btor,
+                         BtorNode *root,
+                         BtorNodePtrStack *applies,
+                         BtorIntHashTable *cache,
+                         BtorIntHashTable *skip)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack stack;
+
+  BTOR_INIT_STACK (btor->mm, stack);
+  BTOR_PUSH_STACK (stack, root);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (stack));
+
+    if (btor_hashint_table_contains (cache, cur->id)
+        || (skip && btor_hashint_table_contains (skip, cur->id)))
+      continue;
+
+    btor_hashint_table_add (cache, cur->id);
+
+    if (btor_node_is_apply (cur) && !cur->parameterized)
+    {
+      BTORLOG (1, "initial apply: %s", btor_util_node2string (cur));
+      BTOR_PUSH_STACK (*applies, cur);
+      continue;
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (stack);
+}
+
+/* The initial applies below the synthesized constraints are collected
+ * incrementally in 'slv->init_apps', i.e., only new constraints are
+ * searched, also across sat calls (see check_init_apps). The applies below
+ * the assumptions of the current sat call are collected in 'applies'. */
 static void
 search_initial_applies_bv_skeleton (Btor *btor,
                                     BtorNodePtrStack *applies,
@@ -950,48 +1097,37 @@ search_initial_applies_bv_skeleton (Btor *btor,
   double start;
   uint32_t i;
   BtorNode *cur;
-  BtorNodePtrStack stack;
   BtorPtrHashTableIterator it;
-  BtorMemMgr *mm;
+  BtorFunSolver *slv;
 
   start = btor_util_time_stamp ();
+  slv   = BTOR_FUN_SOLVER (btor);
 
   BTORLOG (1, "");
   BTORLOG (1, "*** search initial applies");
 
-  mm = btor->mm;
-  BTOR_INIT_STACK (mm, stack);
-
   btor_iter_hashptr_init (&it, btor->synthesized_constraints);
-  btor_iter_hashptr_queue (&it, btor->assumptions);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur = btor_iter_hashptr_next (&it);
-    BTOR_PUSH_STACK (stack, cur);
-
-    while (!BTOR_EMPTY_STACK (stack))
-    {
-      cur = btor_node_real_addr (BTOR_POP_STACK (stack));
-
-      if (btor_hashint_table_contains (cache, cur->id)) continue;
-
-      btor_hashint_table_add (cache, cur->id);
-
-      if (btor_node_is_apply (cur) && !cur->parameterized)
-      {
-        //	      assert (btor_node_is_synth (cur));
-        BTORLOG (1, "initial apply: %s", btor_util_node2string (cur));
-        BTOR_PUSH_STACK (*applies, cur);
-        continue;
-      }
-
-      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
-    }
+    if (btor_hashptr_table_get (slv->init_apps_roots, cur)) continue;
+    btor_hashptr_table_add (slv->init_apps_roots, btor_node_copy (btor, cur));
+    i = BTOR_COUNT_STACK (slv->init_apps);
+    collect_initial_applies (
+        btor, cur, &slv->init_apps, slv->init_apps_cache, 0);
+    for (; i < BTOR_COUNT_STACK (slv->init_apps); i++)
+      btor_node_copy (btor, BTOR_PEEK_STACK (slv->init_apps, i));
   }
 
-  BTOR_RELEASE_STACK (stack);
-  BTOR_FUN_SOLVER (btor)->time.search_init_apps +=
-      btor_util_time_stamp () - start;
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    collect_initial_applies (btor,
+                             btor_iter_hashptr_next (&it),
+                             applies,
+                             cache,
+                             slv->init_apps_cache);
+
+  slv->time.search_init_apps += btor_util_time_stamp () - start;
 }
 
 static void
@@ -1410,6 +1546,24 @@ mk_premise (Btor *btor, BtorNode *args, BtorNode *prem[], uint32_t num_prem)
   return res;
 }
 
+/* Add 'lemma' to the lemma cache, returns false if it was already cached. */
+static bool
+cache_lemma (BtorFunSolver *slv, BtorNode *lemma)
+{
+  bool res;
+  BtorPtrHashBucket *b;
+
+  res = false;
+  if (!(b = btor_hashptr_table_get (slv->lemmas, lemma)))
+  {
+    b   = btor_hashptr_table_add (slv->lemmas,
+                                btor_node_copy (slv->btor, lemma));
+    res = true;
+  }
+  b->data.as_int = slv->sat_calls;
+  return res;
+}
+
 static void
 add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
 {
@@ -1505,9 +1659,8 @@ add_lemma (Btor *btor, BtorNode *fun, BtorNode *app1, BtorNode *app2)
     btor_node_release (btor, con);
   }
 
-  if (!btor_hashptr_table_get (slv->lemmas, lemma))
+  if (cache_lemma (slv, lemma))
   {
-    btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
     BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
     slv->stats.lod_refinements++;
     slv->stats.lemmas_size_sum += lemma_size;
@@ -1643,7 +1796,7 @@ propagate (Btor *btor,
   BtorFunSolver *slv;
   BtorNode *fun, *app, *args, *fun_value, *cur;
   BtorNode *hashed_app;
-  BtorPtrHashBucket *b;
+  BtorPtrHashMapEntry *e;
   BtorPtrHashTableIterator it;
   BtorPtrHashTable *conds;
   BtorIntHashTable *conf_apps;
@@ -1690,18 +1843,18 @@ propagate (Btor *btor,
 
     if (!fun->rho)
     {
-      fun->rho = btor_hashptr_table_new (mm,
-                                         (BtorHashPtr) hash_args_assignment,
-                                         (BtorCmpPtr) compare_args_assignments);
+      fun->rho = btor_hashptrmap_new (mm,
+                                      (BtorHashPtr) hash_args_assignment,
+                                      (BtorCmpPtr) compare_args_assignments);
       if (!btor_hashptr_table_get (cleanup_table, fun))
         btor_hashptr_table_add (cleanup_table, fun);
     }
     else
     {
-      b = btor_hashptr_table_get (fun->rho, args);
-      if (b)
+      e = btor_hashptrmap_get (fun->rho, args);
+      if (e)
       {
-        hashed_app = (BtorNode *) b->data.as_ptr;
+        hashed_app = (BtorNode *) e->data.as_ptr;
         assert (btor_node_is_regular (hashed_app));
         assert (btor_node_is_apply (hashed_app));
 
@@ -1732,8 +1885,8 @@ propagate (Btor *btor,
       }
     }
     assert (fun->rho);
-    assert (!btor_hashptr_table_get (fun->rho, args));
-    btor_hashptr_table_add (fun->rho, args)->data.as_ptr = app;
+    assert (!btor_hashptrmap_get (fun->rho, args));
+    btor_hashptrmap_add (fun->rho, args)->data.as_ptr = app;
     BTORLOG (1,
              "  save app: %s (%s)",
              btor_util_node2string (args),
@@ -1882,128 +2035,813 @@ propagate (Btor *btor,
   slv->time.prop += btor_util_time_stamp () - start;
 }
 
-/* generate hash table for function 'fun' consisting of all rho and static_rho
- * hash tables. */
-static BtorPtrHashTable *
-generate_table (Btor *btor, BtorNode *fun)
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_HAVE_PTHREADS
+/*------------------------------------------------------------------------*/
+
+/* Parallel conflict detection (BTOR_OPT_FUN_PROP_THREADS).
+ *
+ * The (app, fun) pairs to be propagated are partitioned by function cone,
+ * i.e., by the connected components of the graph of functions that are
+ * linked via the function children of ite and update nodes. An apply is only
+ * propagated down within the cone of its function, hence the partitions can
+ * be checked independently.  Each partition maintains its own rho tables,
+ * which map the assignment of the arguments to the first apply propagated
+ * to a function.  The partitions are statically assigned to worker threads.
+ * Each worker evaluates synthesized nodes on a read-only snapshot of the
+ * SAT assignment taken before the workers start and caches the values on
+ * its own.  Only nodes that are not synthesized are evaluated on the shared
+ * bit vector model, which is locked.  The values computed by the workers
+ * are merged into the bit vector model at the end.  Applies found in the
+ * arguments of another partition are forwarded to that partition in the
+ * next round.  The conflicts of all partitions are turned into lemmas in
+ * one batch by the calling thread.
+ *
+ * Cones that contain lambdas (or parameterized functions) require partial
+ * beta reduction, which creates nodes, and are skipped.  If no conflict is
+ * found, the caller falls back to the sequential propagation, which also
+ * builds the rho tables required for model generation.  */
+
+typedef struct BtorFunPropCtx BtorFunPropCtx;
+typedef struct BtorFunPropWorker BtorFunPropWorker;
+typedef struct BtorFunPropPartition BtorFunPropPartition;
+
+BTOR_DECLARE_STACK (BtorFunPropPartitionPtr, BtorFunPropPartition *);
+
+struct BtorFunPropPartition
 {
-  uint32_t i;
-  BtorMemMgr *mm;
-  BtorNode *cur, *value, *args;
-  BtorPtrHashTable *table, *rho, *static_rho;
-  BtorNodePtrStack visit;
-  BtorIntHashTable *cache;
-  BtorPtrHashTableIterator it;
-  BtorBitVector *evalbv;
+  int32_t id;
+  BtorFunPropWorker *worker;  /* owns all memory of the partition */
+  BtorNodePtrStack stack;     /* (app, fun) pairs, 'fun' on top */
+  BtorNodePtrStack outbox;    /* (app, fun) pairs for other partitions */
+  BtorNodePtrStack conflicts; /* (fun, app1, app2) triples, 'app2' may be 0 */
+  BtorIntHashTable *seen;     /* applies that entered the partition */
+  BtorIntHashTable *search_cache;
+  BtorIntHashTable *conf_apps;
+  BtorPtrHashTable *rho; /* fun -> (arguments assignment -> apply) */
+  uint_least64_t propagations;
+  uint_least64_t propagations_down;
+  bool done; /* stopped at first conflict */
+};
 
-  mm    = btor->mm;
-  table = btor_hashptr_table_new (mm,
-                                  (BtorHashPtr) hash_args_assignment,
-                                  (BtorCmpPtr) compare_args_assignments);
-  cache = btor_hashint_table_new (mm);
+struct BtorFunPropWorker
+{
+  BtorFunPropCtx *ctx;
+  uint32_t id;
+  BtorMemMgr *mm;
+  BtorIntHashTable *values;    /* (signed) node id -> assignment */
+  BtorIntHashTable *aig_cache; /* see btor_aig_get_snapshot_assignment */
+};
 
-  BTOR_INIT_STACK (mm, visit);
-  BTOR_PUSH_STACK (visit, fun);
+struct BtorFunPropCtx
+{
+  Btor *btor;
+  uint32_t eager_lemmas;
+  uint32_t num_workers;
+  BtorFunPropWorker *workers;
+  BtorFunPropPartitionPtrStack partitions;
+  BtorIntHashTable *partition_of; /* fun id -> partition id, -1: skipped */
+  const int8_t *assignment;       /* snapshot of the SAT assignment */
+  pthread_mutex_t model_mutex;    /* guards the bit vector model */
+};
+
+/* Add the values of regular nodes computed by the workers to the bit vector
+ * model (while no workers are running). */
+static void
+prop_merge_values (BtorFunPropCtx *ctx)
+{
+  uint32_t i;
+  int32_t id;
+  Btor *btor;
+  BtorFunPropWorker *w;
+  BtorIntHashTableIterator it;
 
-  while (!BTOR_EMPTY_STACK (visit))
+  btor = ctx->btor;
+  for (i = 0; i < ctx->num_workers; i++)
   {
-    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    w = &ctx->workers[i];
+    btor_iter_hashint_init (&it, w->values);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      id = btor_iter_hashint_next (&it);
+      if (id < 0 || btor_hashint_map_contains (btor->bv_model, id)) continue;
+      btor_model_add_to_bv (btor,
+                            btor->bv_model,
+                            btor_node_get_by_id (btor, id),
+                            btor_hashint_map_get (w->values, id)->as_ptr);
+    }
+  }
+}
 
-    if (btor_hashint_table_contains (cache, cur->id)
-        || (!btor_node_is_fun (cur) && !cur->parameterized))
-      continue;
+/* Determine the partition of 'fun'. If 'fun' was not seen yet, its whole
+ * function cone is collected and a new partition is created. Returns -1 if
+ * the cone has to be checked sequentially. Must not be called while workers
+ * are running. */
+static int32_t
+prop_partition_of (BtorFunPropCtx *ctx, BtorNode *fun)
+{
+  assert (ctx);
+  assert (fun);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_fun (fun));
 
-    btor_hashint_table_add (cache, cur->id);
+  bool skip;
+  int32_t id;
+  uint32_t i;
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorNode *cur, *parent;
+  BtorNodePtrStack visit, cone;
+  BtorNodeIterator it;
+  BtorHashTableData *d;
+  BtorFunPropPartition *part;
+  BtorFunPropWorker *w;
 
-    /* NOTE: all encountered lambda nodes need to be arrays,
-     *       in any other case we fully support equality over UFs and
-     *       conditionals. */
-    if (btor_node_is_fun (cur))
-    {
-      rho        = cur->rho;
-      static_rho = 0;
+  if ((d = btor_hashint_map_get (ctx->partition_of, fun->id)))
+    return d->as_int;
 
-      if (btor_node_is_lambda (cur))
-      {
-        assert (cur->is_array);
-        static_rho = btor_node_lambda_get_static_rho (cur);
-        assert (!btor_node_real_addr (cur->e[1])->parameterized || static_rho);
-      }
-      else if (btor_node_is_fun_cond (cur))
-      {
-        evalbv = get_bv_assignment (btor, cur->e[0]);
-        if (btor_bv_is_true (evalbv))
-          BTOR_PUSH_STACK (visit, cur->e[1]);
-        else
-          BTOR_PUSH_STACK (visit, cur->e[2]);
-        btor_bv_free (mm, evalbv);
-      }
-      else if (btor_node_is_update (cur))
-      {
-        if (!btor_hashptr_table_get (table, cur->e[1]))
-          btor_hashptr_table_add (table, cur->e[1])->data.as_ptr = cur->e[2];
-        BTOR_PUSH_STACK (visit, cur->e[0]);
-      }
+  btor = ctx->btor;
+  mm   = btor->mm;
+  id   = BTOR_COUNT_STACK (ctx->partitions);
+  skip = false;
 
-      if (rho)
-      {
-        btor_iter_hashptr_init (&it, rho);
-        if (static_rho) btor_iter_hashptr_queue (&it, static_rho);
-      }
-      else if (static_rho)
-        btor_iter_hashptr_init (&it, static_rho);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, cone);
+  BTOR_PUSH_STACK (visit, fun);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (btor_node_is_regular (cur));
+    assert (btor_node_is_fun (cur));
 
-      if (rho || static_rho)
-      {
-        while (btor_iter_hashptr_has_next (&it))
-        {
-          value = it.bucket->data.as_ptr;
-          assert (!btor_node_is_proxy (value));
-          args = btor_iter_hashptr_next (&it);
-          assert (!btor_node_is_proxy (args));
+    if (btor_hashint_map_contains (ctx->partition_of, cur->id)) continue;
+    btor_hashint_map_add (ctx->partition_of, cur->id)->as_int = id;
+    BTOR_PUSH_STACK (cone, cur);
 
-          if (!btor_hashptr_table_get (table, args))
-            btor_hashptr_table_add (table, args)->data.as_ptr = value;
-        }
-      }
+    if (btor_node_is_lambda (cur) || cur->parameterized) skip = true;
 
-      /* child already pushed w.r.t. evaluation of condition */
-      if (btor_node_is_fun_cond (cur) || btor_node_is_update (cur)) continue;
+    if (btor_node_is_fun_cond (cur))
+    {
+      BTOR_PUSH_STACK (visit, cur->e[1]);
+      BTOR_PUSH_STACK (visit, cur->e[2]);
     }
+    else if (btor_node_is_update (cur))
+      BTOR_PUSH_STACK (visit, cur->e[0]);
 
-    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+    btor_iter_parent_init (&it, cur);
+    while (btor_iter_parent_has_next (&it))
+    {
+      parent = btor_iter_parent_next (&it);
+      if ((btor_node_is_fun_cond (parent)
+           && (parent->e[1] == cur || parent->e[2] == cur))
+          || (btor_node_is_update (parent) && parent->e[0] == cur))
+        BTOR_PUSH_STACK (visit, parent);
+    }
   }
 
+  if (skip)
+  {
+    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+      btor_hashint_map_get (ctx->partition_of, BTOR_PEEK_STACK (cone, i)->id)
+          ->as_int = -1;
+    id = -1;
+  }
+  else
+  {
+    w = &ctx->workers[id % ctx->num_workers];
+    BTOR_CNEW (w->mm, part);
+    part->id     = id;
+    part->worker = w;
+    BTOR_INIT_STACK (w->mm, part->stack);
+    BTOR_INIT_STACK (w->mm, part->outbox);
+    BTOR_INIT_STACK (w->mm, part->conflicts);
+    part->seen         = btor_hashint_table_new (w->mm);
+    part->search_cache = btor_hashint_table_new (w->mm);
+    part->conf_apps    = btor_hashint_table_new (w->mm);
+    part->rho          = btor_hashptr_table_new (w->mm,
+                                        (BtorHashPtr) btor_node_hash_by_id,
+                                        (BtorCmpPtr) btor_node_compare_by_id);
+    BTOR_PUSH_STACK (ctx->partitions, part);
+  }
   BTOR_RELEASE_STACK (visit);
-  btor_hashint_table_delete (cache);
-
-  return table;
+  BTOR_RELEASE_STACK (cone);
+  return id;
 }
 
+/* Hand (app, fun) over to the partition of 'fun'. */
 static void
-add_extensionality_lemmas (Btor *btor)
+prop_route (BtorFunPropCtx *ctx, BtorNode *app, BtorNode *fun)
 {
-  assert (btor);
-  assert (btor->slv);
-  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
-
-  double start, delta;
-  bool skip;
-  BtorBitVector *evalbv;
-  uint32_t num_lemmas = 0;
-  BtorNode *cur, *cur_args, *app0, *app1, *eq, *con, *value;
-  BtorPtrHashTableIterator it;
-  BtorPtrHashTable *table0, *table1, *conflicts;
-  BtorPtrHashTableIterator hit;
-  BtorNodePtrStack feqs;
-  BtorMemMgr *mm;
-  BtorPtrHashBucket *b;
-  BtorFunSolver *slv;
+  int32_t id;
+  BtorFunPropPartition *part;
+
+  id = prop_partition_of (ctx, fun);
+  if (id < 0) return;
+  part = BTOR_PEEK_STACK (ctx->partitions, id);
+  if (part->done || btor_hashint_table_contains (part->seen, app->id)) return;
+  btor_hashint_table_add (part->seen, app->id);
+  BTOR_PUSH_STACK (part->stack, app);
+  BTOR_PUSH_STACK (part->stack, fun);
+}
 
-  start = btor_util_time_stamp ();
+/* Mirrors get_bv_assignment, but synthesized nodes are evaluated on the
+ * snapshot of the SAT assignment without locking. */
+static const BtorBitVector *
+prop_get_value (BtorFunPropWorker *w, BtorNode *exp)
+{
+  int32_t id, bit;
+  uint32_t i, j, width;
+  Btor *btor;
+  BtorNode *real_exp;
+  BtorAIGVec *av;
+  BtorAIGMgr *amgr;
+  BtorBitVector *bv, *res;
+  BtorHashTableData *d;
 
-  BTORLOG (1, "");
-  BTORLOG (1, "*** %s", __FUNCTION__);
+  id = btor_node_get_id (exp);
+  if ((d = btor_hashint_map_get (w->values, id))) return d->as_ptr;
+
+  btor     = w->ctx->btor;
+  real_exp = btor_node_real_addr (exp);
+  if (btor_node_is_synth (real_exp))
+  {
+    amgr  = btor_get_aig_mgr (btor);
+    av    = real_exp->av;
+    width = av->width;
+    res   = btor_bv_new (w->mm, width);
+    for (i = 0, j = width - 1; i < width; i++, j--)
+    {
+      bit = btor_aig_get_snapshot_assignment (
+          amgr, av->aigs[j], w->ctx->assignment, w->aig_cache);
+      if (btor_node_is_inverted (exp)) bit = -bit;
+      btor_bv_set_bit (res, i, bit == 1 ? 1 : 0);
+    }
+  }
+  else if (btor_node_is_bv_const (real_exp))
+  {
+    if (btor_node_is_inverted (exp))
+      res = btor_bv_not (w->mm, btor_node_bv_const_get_bits (real_exp));
+    else
+      res = btor_bv_copy (w->mm, btor_node_bv_const_get_bits (real_exp));
+  }
+  else
+  {
+    pthread_mutex_lock (&w->ctx->model_mutex);
+    bv  = get_bv_assignment (btor, exp);
+    res = btor_bv_copy (w->mm, bv);
+    btor_bv_free (btor->mm, bv);
+    pthread_mutex_unlock (&w->ctx->model_mutex);
+  }
+  btor_hashint_map_add (w->values, id)->as_ptr = res;
+  return res;
+}
+
+static bool
+prop_equal_values (BtorFunPropWorker *w, BtorNode *exp0, BtorNode *exp1)
+{
+  return btor_bv_compare (prop_get_value (w, exp0), prop_get_value (w, exp1))
+         == 0;
+}
+
+/* Mirrors compare_args_assignments. */
+static bool
+prop_equal_args (BtorFunPropWorker *w, BtorNode *e0, BtorNode *e1)
+{
+  assert (btor_node_is_regular (e0));
+  assert (btor_node_is_regular (e1));
+  assert (btor_node_is_args (e0));
+  assert (btor_node_is_args (e1));
+
+  BtorArgsIterator it0, it1;
+
+  if (btor_node_get_sort_id (e0) != btor_node_get_sort_id (e1)) return false;
+  if (e0 == e1) return true;
+
+  btor_iter_args_init (&it0, e0);
+  btor_iter_args_init (&it1, e1);
+  while (btor_iter_args_has_next (&it0))
+  {
+    assert (btor_iter_args_has_next (&it1));
+    if (!prop_equal_values (
+            w, btor_iter_args_next (&it0), btor_iter_args_next (&it1)))
+      return false;
+  }
+  return true;
+}
+
+static BtorBitVectorTuple *
+prop_args_tuple (BtorFunPropWorker *w, BtorNode *args)
+{
+  uint32_t i, arity;
+  BtorArgsIterator it;
+  BtorBitVectorTuple *res;
+
+  arity = 0;
+  btor_iter_args_init (&it, args);
+  while (btor_iter_args_has_next (&it))
+  {
+    btor_iter_args_next (&it);
+    arity++;
+  }
+
+  res = btor_bv_new_tuple (w->mm, arity);
+  i   = 0;
+  btor_iter_args_init (&it, args);
+  while (btor_iter_args_has_next (&it))
+    btor_bv_add_to_tuple (
+        w->mm, res, prop_get_value (w, btor_iter_args_next (&it)), i++);
+  return res;
+}
+
+/* Mirrors push_applies_for_propagation. Applies of functions in the same
+ * cone are pushed onto the partition's stack, all others are forwarded. */
+static void
+prop_push_applies (BtorFunPropPartition *part, BtorNode *exp)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorHashTableData *d;
+  BtorFunPropWorker *w;
+
+  w = part->worker;
+  BTOR_INIT_STACK (w->mm, visit);
+  BTOR_PUSH_STACK (visit, exp);
+  do
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    assert (!cur->parameterized);
+    assert (!btor_node_is_fun (cur));
+
+    if (!cur->apply_below
+        || btor_hashint_table_contains (part->search_cache, cur->id)
+        || btor_node_is_fun_eq (cur))
+      continue;
+
+    btor_hashint_table_add (part->search_cache, cur->id);
+
+    if (btor_node_is_apply (cur))
+    {
+      d = btor_hashint_map_get (w->ctx->partition_of, cur->e[0]->id);
+      if (d && d->as_int == part->id)
+      {
+        if (!btor_hashint_table_contains (part->seen, cur->id))
+        {
+          btor_hashint_table_add (part->seen, cur->id);
+          BTOR_PUSH_STACK (part->stack, cur);
+          BTOR_PUSH_STACK (part->stack, cur->e[0]);
+        }
+      }
+      else
+      {
+        BTOR_PUSH_STACK (part->outbox, cur);
+        BTOR_PUSH_STACK (part->outbox, cur->e[0]);
+      }
+      continue;
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  } while (!BTOR_EMPTY_STACK (visit));
+  BTOR_RELEASE_STACK (visit);
+}
+
+/* Mirrors find_conflict_app. */
+static bool
+prop_find_conflict_app (BtorFunPropPartition *part, BtorNode *app)
+{
+  bool res = false;
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorIntHashTable *cache;
+  BtorNodePtrStack visit;
+  BtorNode *cur;
+
+  mm    = part->worker->mm;
+  cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, app->e[1]);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+
+    if (!cur->apply_below || btor_node_is_fun (cur)
+        || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (btor_hashint_table_contains (part->conf_apps, cur->id))
+    {
+      res = true;
+      break;
+    }
+    if (btor_node_is_apply (cur)) continue;
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
+  return res;
+}
+
+/* Mirrors propagate for partitions without lambdas. Only conflicts are
+ * recorded, lemmas are generated after all workers are finished. */
+static void
+prop_partition (BtorFunPropPartition *part)
+{
+  bool restart;
+  BtorMemMgr *mm;
+  BtorFunPropWorker *w;
+  BtorNode *fun, *app, *args, *hashed_app;
+  BtorPtrHashTable *rho;
+  BtorPtrHashBucket *b;
+  BtorBitVectorTuple *t;
+
+  w  = part->worker;
+  mm = w->mm;
+
+  while (!part->done && !BTOR_EMPTY_STACK (part->stack))
+  {
+    fun = BTOR_POP_STACK (part->stack);
+    assert (btor_node_is_regular (fun));
+    assert (btor_node_is_fun (fun));
+    assert (!btor_node_is_lambda (fun));
+    assert (!BTOR_EMPTY_STACK (part->stack));
+    app = BTOR_POP_STACK (part->stack);
+    assert (btor_node_is_regular (app));
+    assert (btor_node_is_apply (app));
+
+    part->propagations++;
+
+    args = app->e[1];
+    prop_push_applies (part, args);
+
+    if (!(b = btor_hashptr_table_get (part->rho, fun)))
+    {
+      b = btor_hashptr_table_add (part->rho, fun);
+      b->data.as_ptr =
+          btor_hashptr_table_new (mm,
+                                  (BtorHashPtr) btor_bv_hash_tuple,
+                                  (BtorCmpPtr) btor_bv_compare_tuple);
+    }
+    rho = b->data.as_ptr;
+
+    t = prop_args_tuple (w, args);
+    if ((b = btor_hashptr_table_get (rho, t)))
+    {
+      btor_bv_free_tuple (mm, t);
+      hashed_app = b->data.as_ptr;
+
+      /* function congruence conflict */
+      if (!prop_equal_values (w, hashed_app, app))
+      {
+        restart = true;
+        if (w->ctx->eager_lemmas == BTOR_FUN_EAGER_LEMMAS_CONF)
+        {
+          btor_hashint_table_add (part->conf_apps, app->id);
+          restart = prop_find_conflict_app (part, app);
+        }
+        else if (w->ctx->eager_lemmas == BTOR_FUN_EAGER_LEMMAS_ALL)
+          restart = false;
+        BTOR_PUSH_STACK (part->conflicts, fun);
+        BTOR_PUSH_STACK (part->conflicts, hashed_app);
+        BTOR_PUSH_STACK (part->conflicts, app);
+        /* stop at first conflict */
+        if (restart) part->done = true;
+      }
+      continue;
+    }
+    btor_hashptr_table_add (rho, t)->data.as_ptr = app;
+
+    /* skip array vars/uf */
+    if (btor_node_is_uf (fun)) continue;
+
+    if (btor_node_is_fun_cond (fun))
+    {
+      prop_push_applies (part, fun->e[0]);
+      /* propagate over function ite */
+      BTOR_PUSH_STACK (part->stack, app);
+      if (btor_bv_is_true (prop_get_value (w, fun->e[0])))
+        BTOR_PUSH_STACK (part->stack, fun->e[1]);
+      else
+        BTOR_PUSH_STACK (part->stack, fun->e[2]);
+      continue;
+    }
+
+    assert (btor_node_is_update (fun));
+    if (prop_equal_args (w, fun->e[1], args))
+    {
+      if (!prop_equal_values (w, app, fun->e[2]))
+      {
+        BTOR_PUSH_STACK (part->conflicts, fun);
+        BTOR_PUSH_STACK (part->conflicts, app);
+        BTOR_PUSH_STACK (part->conflicts, (BtorNode *) 0);
+      }
+    }
+    else
+    {
+      BTOR_PUSH_STACK (part->stack, app);
+      BTOR_PUSH_STACK (part->stack, fun->e[0]);
+      part->propagations_down++;
+    }
+    prop_push_applies (part, fun->e[1]);
+    prop_push_applies (part, fun->e[2]);
+  }
+}
+
+static void *
+prop_worker (void *arg)
+{
+  uint32_t i;
+  BtorFunPropWorker *w;
+  BtorFunPropCtx *ctx;
+
+  w   = arg;
+  ctx = w->ctx;
+  for (i = w->id; i < BTOR_COUNT_STACK (ctx->partitions); i += ctx->num_workers)
+    prop_partition (BTOR_PEEK_STACK (ctx->partitions, i));
+  return 0;
+}
+
+static void
+prop_delete_partition (BtorFunPropPartition *part)
+{
+  BtorMemMgr *mm;
+  BtorPtrHashTable *rho;
+  BtorPtrHashTableIterator it, rit;
+
+  mm = part->worker->mm;
+  btor_iter_hashptr_init (&it, part->rho);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    rho = it.bucket->data.as_ptr;
+    (void) btor_iter_hashptr_next (&it);
+    btor_iter_hashptr_init (&rit, rho);
+    while (btor_iter_hashptr_has_next (&rit))
+      btor_bv_free_tuple (mm, btor_iter_hashptr_next (&rit));
+    btor_hashptr_table_delete (rho);
+  }
+  btor_hashptr_table_delete (part->rho);
+  btor_hashint_table_delete (part->seen);
+  btor_hashint_table_delete (part->search_cache);
+  btor_hashint_table_delete (part->conf_apps);
+  BTOR_RELEASE_STACK (part->stack);
+  BTOR_RELEASE_STACK (part->outbox);
+  BTOR_RELEASE_STACK (part->conflicts);
+  BTOR_DELETE (mm, part);
+}
+
+/* Check the (app, fun) pairs on 'prop_stack' (which is left untouched) for
+ * conflicts with 'num_threads' worker threads and add a lemma for each
+ * conflict found. */
+static void
+propagate_parallel (Btor *btor,
+                    BtorNodePtrStack *prop_stack,
+                    uint32_t num_threads)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (prop_stack);
+  assert (num_threads > 0);
+
+  bool forwarded;
+  double start;
+  uint32_t i, j;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+  BtorFunPropCtx ctx;
+  BtorFunPropWorker *w;
+  BtorFunPropPartition *part;
+  BtorIntHashTableIterator it;
+  BtorNode *fun, *app1, *app2;
+  pthread_t *threads;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+  slv   = BTOR_FUN_SOLVER (btor);
+
+  ctx.btor         = btor;
+  ctx.eager_lemmas = btor_opt_get (btor, BTOR_OPT_FUN_EAGER_LEMMAS);
+  ctx.num_workers  = num_threads;
+  ctx.partition_of = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, ctx.partitions);
+  ctx.assignment   = btor_aig_snapshot_assignment (btor_get_aig_mgr (btor), mm);
+  pthread_mutex_init (&ctx.model_mutex, 0);
+  BTOR_CNEWN (mm, ctx.workers, num_threads);
+  BTOR_CNEWN (mm, threads, num_threads);
+  for (i = 0; i < num_threads; i++)
+  {
+    w            = &ctx.workers[i];
+    w->ctx       = &ctx;
+    w->id        = i;
+    w->mm        = btor_mem_mgr_new_pooled ();
+    w->values    = btor_hashint_map_new (w->mm);
+    w->aig_cache = btor_hashint_map_new (w->mm);
+  }
+
+  for (i = BTOR_COUNT_STACK (*prop_stack); i > 0; i -= 2)
+    prop_route (&ctx,
+                BTOR_PEEK_STACK (*prop_stack, i - 2),
+                BTOR_PEEK_STACK (*prop_stack, i - 1));
+
+  do
+  {
+    if (num_threads == 1)
+      prop_worker (&ctx.workers[0]);
+    else
+    {
+      for (i = 0; i < num_threads; i++)
+        pthread_create (&threads[i], 0, prop_worker, &ctx.workers[i]);
+      for (i = 0; i < num_threads; i++) pthread_join (threads[i], 0);
+    }
+
+    /* forward applies to their partitions (in a deterministic order,
+     * independent of the number of threads) */
+    forwarded = false;
+    for (i = 0; i < BTOR_COUNT_STACK (ctx.partitions); i++)
+    {
+      part = BTOR_PEEK_STACK (ctx.partitions, i);
+      for (j = 0; j < BTOR_COUNT_STACK (part->outbox); j += 2)
+        prop_route (&ctx,
+                    BTOR_PEEK_STACK (part->outbox, j),
+                    BTOR_PEEK_STACK (part->outbox, j + 1));
+      BTOR_RESET_STACK (part->outbox);
+    }
+    for (i = 0; i < BTOR_COUNT_STACK (ctx.partitions); i++)
+    {
+      part = BTOR_PEEK_STACK (ctx.partitions, i);
+      if (!part->done && !BTOR_EMPTY_STACK (part->stack)) forwarded = true;
+    }
+  } while (forwarded);
+
+  for (i = 0; i < BTOR_COUNT_STACK (ctx.partitions); i++)
+  {
+    part = BTOR_PEEK_STACK (ctx.partitions, i);
+    slv->stats.propagations += part->propagations;
+    slv->stats.propagations_down += part->propagations_down;
+    for (j = 0; j < BTOR_COUNT_STACK (part->conflicts); j += 3)
+    {
+      fun  = BTOR_PEEK_STACK (part->conflicts, j);
+      app1 = BTOR_PEEK_STACK (part->conflicts, j + 1);
+      app2 = BTOR_PEEK_STACK (part->conflicts, j + 2);
+      if (app2)
+        slv->stats.function_congruence_conflicts++;
+      else
+        slv->stats.beta_reduction_conflicts++;
+      add_lemma (btor, fun, app1, app2);
+    }
+    prop_delete_partition (part);
+  }
+
+  prop_merge_values (&ctx);
+  for (i = 0; i < num_threads; i++)
+  {
+    w = &ctx.workers[i];
+    btor_hashint_map_delete (w->aig_cache);
+    btor_iter_hashint_init (&it, w->values);
+    while (btor_iter_hashint_has_next (&it))
+      btor_bv_free (w->mm, btor_iter_hashint_next_data (&it)->as_ptr);
+    btor_hashint_map_delete (w->values);
+    btor_mem_mgr_delete (w->mm);
+  }
+  BTOR_DELETEN (mm, ctx.workers, num_threads);
+  BTOR_DELETEN (mm, threads, num_threads);
+  BTOR_RELEASE_STACK (ctx.partitions);
+  btor_hashint_map_delete (ctx.partition_of);
+  btor_aig_delete_snapshot (
+      btor_get_aig_mgr (btor), mm, (int8_t *) ctx.assignment);
+  pthread_mutex_destroy (&ctx.model_mutex);
+  slv->time.prop_par += btor_util_time_stamp () - start;
+}
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
+
+/* generate hash table for function 'fun' consisting of all rho and static_rho
+ * hash tables. */
+static BtorPtrHashTable *
+generate_table (Btor *btor, BtorNode *fun)
+{
+  uint32_t i;
+  BtorMemMgr *mm;
+  BtorNode *cur, *value, *args;
+  BtorPtrHashTable *table;
+  BtorPtrHashMap *rho, *static_rho;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
+  BtorBitVector *evalbv;
+
+  mm    = btor->mm;
+  table = btor_hashptr_table_new (mm,
+                                  (BtorHashPtr) hash_args_assignment,
+                                  (BtorCmpPtr) compare_args_assignments);
+  cache = btor_hashint_table_new (mm);
+
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, fun);
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+
+    if (btor_hashint_table_contains (cache, cur->id)
+        || (!btor_node_is_fun (cur) && !cur->parameterized))
+      continue;
+
+    btor_hashint_table_add (cache, cur->id);
+
+    /* NOTE: all encountered lambda nodes need to be arrays,
+     *       in any other case we fully support equality over UFs and
+     *       conditionals. */
+    if (btor_node_is_fun (cur))
+    {
+      rho        = cur->rho;
+      static_rho = 0;
+
+      if (btor_node_is_lambda (cur))
+      {
+        assert (cur->is_array);
+        static_rho = btor_node_lambda_get_static_rho (cur);
+        assert (!btor_node_real_addr (cur->e[1])->parameterized || static_rho);
+      }
+      else if (btor_node_is_fun_cond (cur))
+      {
+        evalbv = get_bv_assignment (btor, cur->e[0]);
+        if (btor_bv_is_true (evalbv))
+          BTOR_PUSH_STACK (visit, cur->e[1]);
+        else
+          BTOR_PUSH_STACK (visit, cur->e[2]);
+        btor_bv_free (mm, evalbv);
+      }
+      else if (btor_node_is_update (cur))
+      {
+        if (!btor_hashptr_table_get (table, cur->e[1]))
+          btor_hashptr_table_add (table, cur->e[1])->data.as_ptr = cur->e[2];
+        BTOR_PUSH_STACK (visit, cur->e[0]);
+      }
+
+      if (rho)
+      {
+        btor_iter_hashptrmap_init (&it, rho);
+        if (static_rho) btor_iter_hashptrmap_queue (&it, static_rho);
+      }
+      else if (static_rho)
+        btor_iter_hashptrmap_init (&it, static_rho);
+
+      if (rho || static_rho)
+      {
+        while (btor_iter_hashptrmap_has_next (&it))
+        {
+          e     = btor_iter_hashptrmap_next_entry (&it);
+          value = e->data.as_ptr;
+          assert (!btor_node_is_proxy (value));
+          args = e->key;
+          assert (!btor_node_is_proxy (args));
+
+          if (!btor_hashptr_table_get (table, args))
+            btor_hashptr_table_add (table, args)->data.as_ptr = value;
+        }
+      }
+
+      /* child already pushed w.r.t. evaluation of condition */
+      if (btor_node_is_fun_cond (cur) || btor_node_is_update (cur)) continue;
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+
+  return table;
+}
+
+static void
+add_extensionality_lemmas (Btor *btor)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+
+  double start, delta;
+  bool skip;
+  BtorBitVector *evalbv;
+  uint32_t num_lemmas = 0;
+  BtorNode *cur, *cur_args, *app0, *app1, *eq, *con, *value;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashTable *table0, *table1, *conflicts;
+  BtorPtrHashTableIterator hit;
+  BtorNodePtrStack feqs;
+  BtorMemMgr *mm;
+  BtorPtrHashBucket *b;
+  BtorFunSolver *slv;
+
+  start = btor_util_time_stamp ();
+
+  BTORLOG (1, "");
+  BTORLOG (1, "*** %s", __FUNCTION__);
 
   slv = BTOR_FUN_SOLVER (btor);
   mm  = btor->mm;
@@ -2074,9 +2912,8 @@ add_extensionality_lemmas (Btor *btor)
       con      = btor_exp_implies (btor, cur, eq);
 
       /* add instantiation of extensionality lemma */
-      if (!btor_hashptr_table_get (slv->lemmas, con))
+      if (cache_lemma (slv, con))
       {
-        btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, con));
         BTOR_PUSH_STACK (slv->cur_lemmas, con);
         slv->stats.extensionality_lemmas++;
         slv->stats.lod_refinements++;
@@ -2103,6 +2940,289 @@ add_extensionality_lemmas (Btor *btor)
   slv->time.check_extensionality += delta;
 }
 
+static void
+push_initial_applies (BtorNodePtrStack *prop_stack, BtorNodePtrStack *applies)
+{
+  int32_t i;
+  BtorNode *app;
+
+  for (i = BTOR_COUNT_STACK (*applies) - 1; i >= 0; i--)
+  {
+    app = BTOR_PEEK_STACK (*applies, i);
+    assert (btor_node_is_regular (app));
+    assert (btor_node_is_apply (app));
+    assert (!app->parameterized);
+    assert (!app->propagated);
+    BTOR_PUSH_STACK (*prop_stack, app);
+    BTOR_PUSH_STACK (*prop_stack, app->e[0]);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* The rho tables of a consistent sat call only depend on the assignments of
+ * the applies, arguments, function conditions and update indices and values
+ * they were built from.  These assignments are recorded in 'slv->rho_values'
+ * and the rho tables are kept for the next sat call.  Function cones
+ * (functions connected via function conditionals and updates) whose recorded
+ * assignments did not change keep their rho tables in the first consistency
+ * check of the next sat call, all other cones are propagated from scratch.
+ * Propagation over lambdas depends on the assignment of the whole function
+ * body, hence rho tables are only kept if the formula contains no lambdas. */
+
+static void
+record_rho_value (Btor *btor, BtorNode *exp)
+{
+  BtorPtrHashTable *values;
+
+  values = BTOR_FUN_SOLVER (btor)->rho_values;
+  exp    = btor_node_real_addr (exp);
+  if (btor_hashptr_table_get (values, exp)) return;
+  btor_hashptr_table_add (values, btor_node_copy (btor, exp))->data.as_ptr =
+      get_bv_assignment (btor, exp);
+}
+
+static void
+record_rho_args_values (Btor *btor, BtorNode *args)
+{
+  BtorArgsIterator it;
+
+  btor_iter_args_init (&it, args);
+  while (btor_iter_args_has_next (&it))
+    record_rho_value (btor, btor_iter_args_next (&it));
+}
+
+static void
+keep_rho (Btor *btor, BtorNode *fun)
+{
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_fun (fun));
+  assert (!btor_node_is_lambda (fun));
+  assert (fun->rho);
+
+  BtorNode *app;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMapIterator it;
+
+  btor_iter_hashptrmap_init (&it, fun->rho);
+  while (btor_iter_hashptrmap_has_next (&it))
+  {
+    e   = btor_iter_hashptrmap_next_entry (&it);
+    app = e->data.as_ptr;
+    record_rho_value (btor, app);
+    record_rho_args_values (btor, e->key);
+  }
+  if (btor_node_is_fun_cond (fun))
+    record_rho_value (btor, fun->e[0]);
+  else if (btor_node_is_update (fun))
+  {
+    record_rho_args_values (btor, fun->e[1]);
+    record_rho_value (btor, fun->e[2]);
+  }
+  BTOR_PUSH_STACK (BTOR_FUN_SOLVER (btor)->rho_funs,
+                   btor_node_copy (btor, fun));
+}
+
+static void
+release_kept_rhos (Btor *btor, BtorNodePtrStack *funs, BtorPtrHashTable *values)
+{
+  BtorPtrHashTableIterator it;
+
+  while (!BTOR_EMPTY_STACK (*funs))
+    btor_node_release (btor, BTOR_POP_STACK (*funs));
+  BTOR_RELEASE_STACK (*funs);
+  btor_iter_hashptr_init (&it, values);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_bv_free (btor->mm, it.bucket->data.as_ptr);
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (values);
+}
+
+static bool
+rho_args_changed (BtorNode *args, BtorIntHashTable *changed)
+{
+  BtorArgsIterator it;
+
+  btor_iter_args_init (&it, args);
+  while (btor_iter_args_has_next (&it))
+  {
+    if (btor_hashint_table_contains (
+            changed, btor_node_real_addr (btor_iter_args_next (&it))->id))
+      return true;
+  }
+  return false;
+}
+
+static bool
+rho_changed (BtorNode *fun, BtorIntHashTable *changed)
+{
+  BtorNode *app;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMapIterator it;
+
+  if (fun->simplified) return true;
+
+  btor_iter_hashptrmap_init (&it, fun->rho);
+  while (btor_iter_hashptrmap_has_next (&it))
+  {
+    e   = btor_iter_hashptrmap_next_entry (&it);
+    app = e->data.as_ptr;
+    if (btor_hashint_table_contains (changed, app->id)
+        || rho_args_changed (e->key, changed))
+      return true;
+  }
+  if (btor_node_is_fun_cond (fun))
+    return btor_hashint_table_contains (changed,
+                                        btor_node_real_addr (fun->e[0])->id);
+  if (btor_node_is_update (fun))
+    return rho_args_changed (fun->e[1], changed)
+           || btor_hashint_table_contains (
+                  changed, btor_node_real_addr (fun->e[2])->id);
+  return false;
+}
+
+static int32_t
+find_rho_cone (BtorIntHashTable *cones, int32_t id)
+{
+  int32_t next;
+
+  while ((next = btor_hashint_map_get (cones, id)->as_int) != id) id = next;
+  return id;
+}
+
+static void
+merge_rho_cones (BtorIntHashTable *cones, BtorNode *fun0, BtorNode *fun1)
+{
+  if (!btor_hashint_map_contains (cones, fun1->id)) return;
+  btor_hashint_map_get (cones, find_rho_cone (cones, fun0->id))->as_int =
+      find_rho_cone (cones, fun1->id);
+}
+
+static void
+reuse_kept_rhos (Btor *btor,
+                 BtorNodePtrStack *funs,
+                 BtorPtrHashTable *values,
+                 BtorNodePtrStack *prop_stack,
+                 BtorPtrHashTable *cleanup_table,
+                 BtorIntHashTable *apply_search_cache)
+{
+  uint32_t i;
+  bool reuse;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+  BtorNode *fun, *app, *cur;
+  BtorBitVector *bv, *kept_bv;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMapIterator mit;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *changed, *cones, *dirty;
+
+  mm  = btor->mm;
+  slv = BTOR_FUN_SOLVER (btor);
+
+  BTORLOG (1, "");
+  BTORLOG (1, "*** %s", __FUNCTION__);
+
+  /* assignments that changed since the rho tables were built */
+  changed = btor_hashint_table_new (mm);
+  btor_iter_hashptr_init (&it, values);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    kept_bv = it.bucket->data.as_ptr;
+    cur     = btor_iter_hashptr_next (&it);
+    if (cur->simplified)
+    {
+      btor_hashint_table_add (changed, cur->id);
+      continue;
+    }
+    bv = get_bv_assignment (btor, cur);
+    if (btor_bv_compare (bv, kept_bv))
+      btor_hashint_table_add (changed, cur->id);
+    btor_bv_free (mm, bv);
+  }
+
+  /* partition functions into cones */
+  cones = btor_hashint_map_new (mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*funs); i++)
+  {
+    fun = BTOR_PEEK_STACK (*funs, i);
+    if (fun->rho) btor_hashint_map_add (cones, fun->id)->as_int = fun->id;
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (*funs); i++)
+  {
+    fun = BTOR_PEEK_STACK (*funs, i);
+    if (!fun->rho) continue;
+    if (btor_node_is_fun_cond (fun))
+    {
+      merge_rho_cones (cones, fun, fun->e[1]);
+      merge_rho_cones (cones, fun, fun->e[2]);
+    }
+    else if (btor_node_is_update (fun))
+      merge_rho_cones (cones, fun, fun->e[0]);
+  }
+
+  dirty = btor_hashint_table_new (mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*funs); i++)
+  {
+    fun = BTOR_PEEK_STACK (*funs, i);
+    if (fun->rho && rho_changed (fun, changed))
+      btor_hashint_table_add (dirty, find_rho_cone (cones, fun->id));
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (*funs); i++)
+  {
+    fun = BTOR_PEEK_STACK (*funs, i);
+    /* rho was deleted when 'fun' was turned into a proxy */
+    if (!fun->rho) continue;
+
+    reuse = !btor_hashint_table_contains (dirty,
+                                          find_rho_cone (cones, fun->id));
+    if (!reuse)
+    {
+      btor_hashptrmap_delete (fun->rho);
+      fun->rho = 0;
+      continue;
+    }
+
+    BTORLOG (1, "  reuse rho: %s", btor_util_node2string (fun));
+    slv->stats.reused_rhos++;
+    assert (!btor_hashptr_table_get (cleanup_table, fun));
+    btor_hashptr_table_add (cleanup_table, fun);
+
+    /* the applies in 'fun->rho' are consistent, but the applies below their
+     * arguments (and conditions/updates of 'fun') still have to be checked */
+    btor_iter_hashptrmap_init (&mit, fun->rho);
+    while (btor_iter_hashptrmap_has_next (&mit))
+    {
+      e   = btor_iter_hashptrmap_next_entry (&mit);
+      app = e->data.as_ptr;
+      if (!app->propagated)
+      {
+        app->propagated = 1;
+        btor_hashptr_table_add (cleanup_table, app);
+      }
+      push_applies_for_propagation (
+          btor, e->key, prop_stack, apply_search_cache);
+    }
+    if (btor_node_is_fun_cond (fun))
+      push_applies_for_propagation (
+          btor, fun->e[0], prop_stack, apply_search_cache);
+    else if (btor_node_is_update (fun))
+    {
+      push_applies_for_propagation (
+          btor, fun->e[1], prop_stack, apply_search_cache);
+      push_applies_for_propagation (
+          btor, fun->e[2], prop_stack, apply_search_cache);
+    }
+  }
+
+  btor_hashint_table_delete (dirty);
+  btor_hashint_map_delete (cones);
+  btor_hashint_table_delete (changed);
+}
+
 static void
 check_and_resolve_conflicts (Btor *btor,
                              Btor *clone,
@@ -2116,14 +3236,14 @@ check_and_resolve_conflicts (Btor *btor,
   assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
 
   double start, start_cleanup;
-  bool found_conflicts;
-  int32_t i;
+  bool found_conflicts, keep;
   BtorMemMgr *mm;
   BtorFunSolver *slv;
-  BtorNode *app, *cur;
+  BtorNode *cur;
   BtorNodePtrStack prop_stack;
   BtorNodePtrStack top_applies;
-  BtorPtrHashTable *cleanup_table;
+  BtorNodePtrStack kept_funs;
+  BtorPtrHashTable *cleanup_table, *kept_values;
   BtorIntHashTable *apply_search_cache;
   BtorPtrHashTableIterator pit;
   BtorIntHashTableIterator iit;
@@ -2178,17 +3298,38 @@ check_and_resolve_conflicts (Btor *btor,
   else
     search_initial_applies_bv_skeleton (btor, init_apps, init_apps_cache);
 
-  for (i = BTOR_COUNT_STACK (*init_apps) - 1; i >= 0; i--)
+  push_initial_applies (&prop_stack, init_apps);
+  /* initial applies of the synthesized constraints */
+  if (!clone && !btor_opt_get (btor, BTOR_OPT_FUN_JUST))
+    push_initial_applies (&prop_stack, &slv->init_apps);
+
+  /* the rho tables of this consistency check are kept again during cleanup
+   * (see keep_rho) */
+  kept_funs   = slv->rho_funs;
+  kept_values = slv->rho_values;
+  BTOR_INIT_STACK (mm, slv->rho_funs);
+  slv->rho_values =
+      btor_hashptr_table_new (mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
+  if (!BTOR_EMPTY_STACK (kept_funs))
+    reuse_kept_rhos (btor,
+                     &kept_funs,
+                     kept_values,
+                     &prop_stack,
+                     cleanup_table,
+                     apply_search_cache);
+
+#ifdef BTOR_HAVE_PTHREADS
+  /* check function cones in parallel first, fall back to sequential
+   * propagation (which also builds the model) if no conflict was found */
+  if (btor_opt_get (btor, BTOR_OPT_FUN_PROP_THREADS) > 0)
   {
-    app = BTOR_PEEK_STACK (*init_apps, i);
-    assert (btor_node_is_regular (app));
-    assert (btor_node_is_apply (app));
-    assert (!app->parameterized);
-    assert (!app->propagated);
-    BTOR_PUSH_STACK (prop_stack, app);
-    BTOR_PUSH_STACK (prop_stack, app->e[0]);
+    propagate_parallel (
+        btor, &prop_stack, btor_opt_get (btor, BTOR_OPT_FUN_PROP_THREADS));
+    if (BTOR_COUNT_STACK (slv->cur_lemmas) > 0) BTOR_RESET_STACK (prop_stack);
   }
-
+#endif
   propagate (btor, &prop_stack, cleanup_table, apply_search_cache);
   found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
 
@@ -2217,6 +3358,7 @@ check_and_resolve_conflicts (Btor *btor,
   }
 
   start_cleanup = btor_util_time_stamp ();
+  keep          = btor->lambdas->count == 0;
   btor_iter_hashptr_init (&pit, cleanup_table);
   while (btor_iter_hashptr_has_next (&pit))
   {
@@ -2236,9 +3378,11 @@ check_and_resolve_conflicts (Btor *btor,
 
       if (found_conflicts)
       {
-        btor_hashptr_table_delete (cur->rho);
+        btor_hashptrmap_delete (cur->rho);
         cur->rho = 0;
       }
+      else if (keep)
+        keep_rho (btor, cur);
       else
       {
         /* remember functions for incremental usage (and prevent
@@ -2249,6 +3393,7 @@ check_and_resolve_conflicts (Btor *btor,
       }
     }
   }
+  release_kept_rhos (btor, &kept_funs, kept_values);
   slv->time.prop_cleanup += btor_util_time_stamp () - start_cleanup;
   btor_hashptr_table_delete (cleanup_table);
   BTOR_RELEASE_STACK (prop_stack);
@@ -2257,20 +3402,36 @@ check_and_resolve_conflicts (Btor *btor,
   slv->time.check_consistency += btor_util_time_stamp () - start;
 }
 
+/* Lemmas are valid independent of the formula, hence lemmas that were only
+ * assumed in previous sat calls are assumed again rather than being derived
+ * again via refinement.  Lemmas derived more than BTOR_FUN_LEMMAS_MAX_AGE sat
+ * calls ago are dropped from the cache (and derived again if required). */
 static void
-reset_lemma_cache (BtorFunSolver *slv)
+assume_cached_lemmas (BtorFunSolver *slv)
 {
   Btor *btor;
+  BtorNode *lemma;
+  BtorNodePtrStack old;
   BtorPtrHashTableIterator it;
+
   btor = slv->btor;
+  BTOR_INIT_STACK (btor->mm, old);
   btor_iter_hashptr_init (&it, slv->lemmas);
   while (btor_iter_hashptr_has_next (&it))
-    btor_node_release (btor, btor_iter_hashptr_next (&it));
-  btor_hashptr_table_delete (slv->lemmas);
-
-  slv->lemmas = btor_hashptr_table_new (btor->mm,
-                                        (BtorHashPtr) btor_node_hash_by_id,
-                                        (BtorCmpPtr) btor_node_compare_by_id);
+  {
+    if (slv->sat_calls - (uint32_t) it.bucket->data.as_int
+        > BTOR_FUN_LEMMAS_MAX_AGE)
+      BTOR_PUSH_STACK (old, btor_iter_hashptr_next (&it));
+    else
+      btor_assume_exp (btor, btor_iter_hashptr_next (&it));
+  }
+  while (!BTOR_EMPTY_STACK (old))
+  {
+    lemma = BTOR_POP_STACK (old);
+    btor_hashptr_table_remove (slv->lemmas, lemma, 0, 0);
+    btor_node_release (btor, lemma);
+  }
+  BTOR_RELEASE_STACK (old);
 }
 
 static BtorSolverResult
@@ -2357,7 +3518,9 @@ sat_fun_solver (BtorFunSolver *slv)
 
   configure_sat_mgr (btor);
 
-  if (slv->assume_lemmas) reset_lemma_cache (slv);
+  slv->sat_calls++;
+  check_init_apps (slv);
+  if (slv->assume_lemmas) assume_cached_lemmas (slv);
 
   if (btor->feqs->count > 0) add_function_inequality_constraints (btor);
 
@@ -2543,6 +3706,7 @@ print_stats_fun_solver (BtorFunSolver *slv)
   BTOR_MSG (btor->msg, 1, "%7lld propagations", slv->stats.propagations);
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
+  BTOR_MSG (btor->msg, 1, "%7u reused rho tables", slv->stats.reused_rhos);
 
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
@@ -2618,6 +3782,11 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
               slv->time.search_init_apps_collect_fa_cone);
   }
 
+  if (btor_opt_get (btor, BTOR_OPT_FUN_PROP_THREADS))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds parallel propagation",
+              slv->time.prop_par);
   BTOR_MSG (btor->msg, 1, "  %.2f seconds propagation", slv->time.prop);
   BTOR_MSG (
       btor->msg, 1, "    %.2f seconds expression evaluation", slv->time.eval);
@@ -2684,6 +3853,19 @@ btor_new_fun_solver (Btor *btor)
                                         (BtorCmpPtr) btor_node_compare_by_id);
   BTOR_INIT_STACK (btor->mm, slv->cur_lemmas);
 
+  BTOR_INIT_STACK (btor->mm, slv->init_apps);
+  slv->init_apps_cache = btor_hashint_table_new (btor->mm);
+  slv->init_apps_roots =
+      btor_hashptr_table_new (btor->mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
+
+  BTOR_INIT_STACK (btor->mm, slv->rho_funs);
+  slv->rho_values =
+      btor_hashptr_table_new (btor->mm,
+                              (BtorHashPtr) btor_node_hash_by_id,
+                              (BtorCmpPtr) btor_node_compare_by_id);
+
   BTOR_INIT_STACK (btor->mm, slv->stats.lemmas_size);
 
   BTOR_MSG (btor->msg, 1, "enabled core engine");
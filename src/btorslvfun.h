@@ -25,10 +25,22 @@ struct BtorFunSolver
 
   BtorPtrHashTable *score; /* dcr score */
 
+  /* initial applies in the bv skeleton (synthesized constraints), kept
+   * across sat calls and extended with the applies of new constraints */
+  BtorNodePtrStack init_apps;
+  BtorIntHashTable *init_apps_cache;
+  BtorPtrHashTable *init_apps_roots; /* constraints already searched */
+
+  /* rho tables kept from the last consistency check, together with the
+   * assignments they were built from (see keep_rho) */
+  BtorNodePtrStack rho_funs;
+  BtorPtrHashTable *rho_values;
+
   // TODO (ma): make options for these
   int32_t lod_limit;
   int32_t sat_limit;
   bool assume_lemmas;
+  uint32_t sat_calls; /* for aging the lemma cache in assume_lemmas mode */
 
   struct
   {
@@ -54,6 +66,7 @@ struct BtorFunSolver
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
     uint_least64_t propagations_down;
+    uint32_t reused_rhos; /* rho tables kept across sat calls */
   } stats;
 
   struct
@@ -72,6 +85,7 @@ struct BtorFunSolver
     double find_prop_app;
     double check_consistency;
     double prop;
+    double prop_par;
     double betap;
     double find_conf_app;
     double check_extensionality;
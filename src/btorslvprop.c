@@ -169,6 +169,7 @@ move (Btor *btor, uint32_t nmoves)
       slv->roots,
       btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT) ? slv->score : 0,
       exps,
+      slv->adj,
       true,
       &slv->stats.updates,
       &slv->time.update_cone,
@@ -200,6 +201,7 @@ clone_prop_solver (Btor *clone, BtorPropSolver *slv, BtorNodeMap *exp_map)
   memcpy (res, slv, sizeof (BtorPropSolver));
 
   res->btor  = clone;
+  res->adj   = 0;
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
   res->score =
       btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
@@ -217,6 +219,7 @@ delete_prop_solver (BtorPropSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  assert (!slv->adj);
 
   BTOR_DELETE (slv->btor->mm, slv);
 }
@@ -257,6 +260,10 @@ sat_prop_solver_aux (Btor *btor)
       goto UNSAT;
   }
 
+  /* the formula does not change during local search */
+  assert (!slv->adj);
+  slv->adj = btor_node_adj_new (btor);
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -351,6 +358,11 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->adj)
+  {
+    btor_node_adj_delete (slv->adj);
+    slv->adj = 0;
+  }
   return sat_result;
 }
 
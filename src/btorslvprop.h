@@ -13,6 +13,7 @@
 #include "btorslv.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
+#include "utils/btornodeadj.h"
 
 struct BtorPropSolver
 {
@@ -20,6 +21,7 @@ struct BtorPropSolver
 
   BtorIntHashTable *roots; /* map: maintains 'selected' */
   BtorIntHashTable *score;
+  BtorNodeAdj *adj; /* parent snapshot, only maintained during sat */
 
   /* current probability for selecting the cond when either the
    * 'then' or 'else' branch is const (path selection) */
@@ -529,7 +529,47 @@ update_roots_table (Btor *btor,
   }
 }
 
-/* Note: 'roots' will only be updated if 'update_roots' is true.
+/* Compute the assignment of 'exp' w.r.t. the assignments 'e' of its children
+ * into 'dst'. */
+static void
+compute_assignment_into (BtorMemMgr *mm,
+                         BtorNode *exp,
+                         BtorBitVector *dst,
+                         const BtorBitVector *e[])
+{
+  assert (mm);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (dst);
+  assert (e);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: btor_bv_add_into (dst, e[0], e[1]); break;
+    case BTOR_BV_AND_NODE: btor_bv_and_into (dst, e[0], e[1]); break;
+    case BTOR_BV_EQ_NODE: btor_bv_eq_into (dst, e[0], e[1]); break;
+    case BTOR_BV_ULT_NODE: btor_bv_ult_into (dst, e[0], e[1]); break;
+    case BTOR_BV_SLL_NODE: btor_bv_sll_into (dst, e[0], e[1]); break;
+    case BTOR_BV_SRL_NODE: btor_bv_srl_into (dst, e[0], e[1]); break;
+    case BTOR_BV_MUL_NODE: btor_bv_mul_into (mm, dst, e[0], e[1]); break;
+    case BTOR_BV_UDIV_NODE: btor_bv_udiv_into (mm, dst, e[0], e[1]); break;
+    case BTOR_BV_UREM_NODE: btor_bv_urem_into (mm, dst, e[0], e[1]); break;
+    case BTOR_BV_CONCAT_NODE: btor_bv_concat_into (dst, e[0], e[1]); break;
+    case BTOR_BV_SLICE_NODE:
+      btor_bv_slice_into (dst,
+                          e[0],
+                          btor_node_bv_slice_get_upper (exp),
+                          btor_node_bv_slice_get_lower (exp));
+      break;
+    default:
+      assert (btor_node_is_cond (exp));
+      btor_bv_ite_into (dst, e[0], e[1], e[2]);
+  }
+}
+
+/* Note: 'adj' is an optional parent snapshot of the current formula, the
+ *       parent lists of the nodes are traversed if it is not given.
+ * Note: 'roots' will only be updated if 'update_roots' is true.
  *         + PROP engine: always
  *         + SLS  engine: only if an actual move is performed
  *                        (not during neighborhood exploration, 'try_move')
@@ -545,6 +585,7 @@ btor_propsls_update_cone (Btor *btor,
                           BtorIntHashTable *roots,
                           BtorIntHashTable *score,
                           BtorIntHashTable *exps,
+                          const BtorNodeAdj *adj,
                           bool update_roots,
                           uint64_t *stats_updates,
                           double *time_update_cone,
@@ -566,15 +607,18 @@ btor_propsls_update_cone (Btor *btor,
   assert (time_update_cone_model_gen);
 
   double start, delta;
-  uint32_t i, j;
+  uint32_t i, j, n;
   int32_t id;
+  const int32_t *parents;
   BtorNode *exp, *cur;
   BtorNodeIterator nit;
   BtorIntHashTableIterator iit;
   BtorHashTableData *d;
   BtorNodePtrStack stack, cone;
   BtorIntHashTable *cache;
-  BtorBitVector *bv, *e[3], *ass;
+  BtorBitVector *bv, *ass, *tmp[3];
+  const BtorBitVector *e[3];
+  BtorBitVectorInline ibv;
   BtorMemMgr *mm;
 
   start = delta = btor_util_time_stamp ();
@@ -624,9 +668,20 @@ btor_propsls_update_cone (Btor *btor,
     *stats_updates += 1;
 
     /* push parents */
-    btor_iter_parent_init (&nit, cur);
-    while (btor_iter_parent_has_next (&nit))
-      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+    if (adj)
+    {
+      assert (btor_node_adj_get_num_parents (adj, cur->id) == cur->parents);
+      n       = btor_node_adj_get_num_parents (adj, cur->id);
+      parents = btor_node_adj_get_parents (adj, cur->id);
+      for (j = 0; j < n; j++)
+        BTOR_PUSH_STACK (stack, btor_node_get_by_id (btor, parents[j]));
+    }
+    else
+    {
+      btor_iter_parent_init (&nit, cur);
+      while (btor_iter_parent_has_next (&nit))
+        BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+    }
   }
   BTOR_RELEASE_STACK (stack);
   btor_hashint_table_delete (cache);
@@ -653,13 +708,9 @@ btor_propsls_update_cone (Btor *btor,
       /* old assignment != new assignment */
       update_roots_table (btor, roots, exp, ass);
     }
-    btor_bv_free (mm, d->as_ptr);
-    d->as_ptr = btor_bv_copy (mm, ass);
+    btor_bv_copy_into (d->as_ptr, ass);
     if ((d = btor_hashint_map_get (bv_model, -exp->id)))
-    {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = btor_bv_not (mm, ass);
-    }
+      btor_bv_not_into (d->as_ptr, ass);
 
     /* update score */
     if (score && btor_node_bv_get_width (btor, exp) == 1)
@@ -690,89 +741,79 @@ btor_propsls_update_cone (Btor *btor,
     assert (btor_node_is_regular (cur));
     for (j = 0; j < cur->arity; j++)
     {
+      tmp[j] = 0;
       if (btor_node_is_bv_const (cur->e[j]))
       {
-        e[j] =
-            btor_node_is_inverted (cur->e[j])
-                ? btor_bv_copy (mm, btor_node_bv_const_get_invbits (cur->e[j]))
-                : btor_bv_copy (mm, btor_node_bv_const_get_bits (cur->e[j]));
+        e[j] = btor_node_is_inverted (cur->e[j])
+                   ? btor_node_bv_const_get_invbits (cur->e[j])
+                   : btor_node_bv_const_get_bits (cur->e[j]);
       }
       else
       {
-        d = btor_hashint_map_get (bv_model,
-                                  btor_node_real_addr (cur->e[j])->id);
-        /* Note: generate model enabled branch for ite (and does not
-         * generate model for nodes in the branch, hence !b may happen */
-        if (!d)
-          e[j] = btor_model_recursively_compute_assignment (
-              btor, bv_model, btor->fun_model, cur->e[j]);
+        id = btor_node_get_id (cur->e[j]);
+        if ((d = btor_hashint_map_get (bv_model, id)))
+          e[j] = d->as_ptr;
+        else if (id < 0 && (d = btor_hashint_map_get (bv_model, -id)))
+        {
+          /* cache assignment of inverted child, kept up to date below */
+          bv = btor_bv_not (mm, d->as_ptr);
+          btor_node_copy (btor, cur->e[j]);
+          btor_hashint_map_add (bv_model, id)->as_ptr = bv;
+          e[j] = bv;
+        }
         else
-          e[j] = btor_node_is_inverted (cur->e[j])
-                     ? btor_bv_not (mm, d->as_ptr)
-                     : btor_bv_copy (mm, d->as_ptr);
+        {
+          /* Note: generate model enabled branch for ite (and does not
+           * generate model for nodes in the branch, hence !b may happen */
+          tmp[j] = btor_model_recursively_compute_assignment (
+              btor, bv_model, btor->fun_model, cur->e[j]);
+          e[j] = tmp[j];
+        }
       }
     }
-    switch (cur->kind)
-    {
-      case BTOR_BV_ADD_NODE: bv = btor_bv_add (mm, e[0], e[1]); break;
-      case BTOR_BV_AND_NODE: bv = btor_bv_and (mm, e[0], e[1]); break;
-      case BTOR_BV_EQ_NODE: bv = btor_bv_eq (mm, e[0], e[1]); break;
-      case BTOR_BV_ULT_NODE: bv = btor_bv_ult (mm, e[0], e[1]); break;
-      case BTOR_BV_SLL_NODE: bv = btor_bv_sll (mm, e[0], e[1]); break;
-      case BTOR_BV_SRL_NODE: bv = btor_bv_srl (mm, e[0], e[1]); break;
-      case BTOR_BV_MUL_NODE: bv = btor_bv_mul (mm, e[0], e[1]); break;
-      case BTOR_BV_UDIV_NODE: bv = btor_bv_udiv (mm, e[0], e[1]); break;
-      case BTOR_BV_UREM_NODE: bv = btor_bv_urem (mm, e[0], e[1]); break;
-      case BTOR_BV_CONCAT_NODE: bv = btor_bv_concat (mm, e[0], e[1]); break;
-      case BTOR_BV_SLICE_NODE:
-        bv = btor_bv_slice (mm,
-                            e[0],
-                            btor_node_bv_slice_get_upper (cur),
-                            btor_node_bv_slice_get_lower (cur));
-        break;
-      default:
-        assert (btor_node_is_cond (cur));
-        bv = btor_bv_is_true (e[0]) ? btor_bv_copy (mm, e[1])
-                                    : btor_bv_copy (mm, e[2]);
-    }
 
     /* update assignment */
 
     d = btor_hashint_map_get (bv_model, cur->id);
 
-    /* update roots table */
-    if (update_roots
-        && (cur->constraint || btor_hashptr_table_get (btor->assumptions, cur)
-            || btor_hashptr_table_get (btor->assumptions,
-                                       btor_node_invert (cur))))
-    {
-      assert (d); /* must be contained, is root */
-      /* old assignment != new assignment */
-      if (btor_bv_compare (d->as_ptr, bv))
-        update_roots_table (btor, roots, cur, bv);
-    }
-
-    /* update assignments */
     /* Note: generate model enabled branch for ite (and does not generate
      *       model for nodes in the branch, hence !b may happen */
     if (!d)
     {
+      bv = btor_bv_new (mm, btor_node_bv_get_width (btor, cur));
+      compute_assignment_into (mm, cur, bv, e);
       btor_node_copy (btor, cur);
       btor_hashint_map_add (bv_model, cur->id)->as_ptr = bv;
     }
+    /* update roots table */
+    else if (update_roots
+             && (cur->constraint
+                 || btor_hashptr_table_get (btor->assumptions, cur)
+                 || btor_hashptr_table_get (btor->assumptions,
+                                            btor_node_invert (cur))))
+    {
+      /* roots are Boolean, compute new assignment into temporary first,
+       * the roots table is updated w.r.t. the old assignment */
+      bv = btor_bv_init_inline (&ibv, 0, 1);
+      compute_assignment_into (mm, cur, bv, e);
+      /* old assignment != new assignment */
+      if (btor_bv_compare (d->as_ptr, bv))
+        update_roots_table (btor, roots, cur, bv);
+      bv = d->as_ptr;
+      btor_bv_copy_into (bv, &ibv.bv);
+    }
     else
     {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = bv;
+      bv = d->as_ptr;
+      compute_assignment_into (mm, cur, bv, e);
     }
 
     if ((d = btor_hashint_map_get (bv_model, -cur->id)))
-    {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = btor_bv_not (mm, bv);
-    }
+      btor_bv_not_into (d->as_ptr, bv);
+
     /* cleanup */
-    for (j = 0; j < cur->arity; j++) btor_bv_free (mm, e[j]);
+    for (j = 0; j < cur->arity; j++)
+      if (tmp[j]) btor_bv_free (mm, tmp[j]);
   }
   *time_update_cone_model_gen += btor_util_time_stamp () - delta;
 
@@ -1824,6 +1865,7 @@ cons_sll_bv (Btor *btor,
 
   uint32_t i, s, bw, sbw, ctz_bvsll;
   BtorBitVector *res, *from, *to, *shift;
+  BtorBitVectorInline ifrom, ito;
   BtorMemMgr *mm;
 
   (void) sll;
@@ -1842,12 +1884,10 @@ cons_sll_bv (Btor *btor,
   sbw = btor_util_log_2 (bw);
 
   ctz_bvsll = btor_bv_get_num_trailing_zeros (bvsll);
-  from      = btor_bv_new (mm, sbw);
-  to        = btor_bv_uint64_to_bv (
-      mm, ctz_bvsll == bw ? ctz_bvsll - 1 : ctz_bvsll, sbw);
+  from      = btor_bv_init_inline (&ifrom, 0, sbw);
+  to        = btor_bv_init_inline (
+      &ito, ctz_bvsll == bw ? ctz_bvsll - 1 : ctz_bvsll, sbw);
   shift = btor_bv_new_random_range (mm, &btor->rng, sbw, from, to);
-  btor_bv_free (mm, from);
-  btor_bv_free (mm, to);
 
   if (eidx)
   {
@@ -1884,6 +1924,7 @@ cons_srl_bv (Btor *btor,
 
   uint32_t i, s, bw, sbw;
   BtorBitVector *res, *from, *to, *shift;
+  BtorBitVectorInline ifrom, ito;
   BtorMemMgr *mm;
 
   (void) srl;
@@ -1904,11 +1945,9 @@ cons_srl_bv (Btor *btor,
   for (i = 0; i < bw; i++)
     if (btor_bv_get_bit (bvsrl, bw - 1 - i)) break;
 
-  from  = btor_bv_new (mm, sbw);
-  to    = btor_bv_uint64_to_bv (mm, i == bw ? i - 1 : i, sbw);
+  from  = btor_bv_init_inline (&ifrom, 0, sbw);
+  to    = btor_bv_init_inline (&ito, i == bw ? i - 1 : i, sbw);
   shift = btor_bv_new_random_range (mm, &btor->rng, sbw, from, to);
-  btor_bv_free (mm, from);
-  btor_bv_free (mm, to);
 
   if (eidx)
   {
@@ -2777,6 +2816,7 @@ inv_sll_bv (Btor *btor,
   uint32_t i, j, ctz_bve, ctz_bvsll, shift, sbw;
   BtorNode *e;
   BtorBitVector *res, *tmp, *bvmax;
+  BtorBitVectorInline imax, ishift;
   BtorMemMgr *mm;
 #ifndef NDEBUG
   bool is_inv = true;
@@ -2843,11 +2883,9 @@ inv_sll_bv (Btor *btor,
           /* x...x0 << e[1] = 0...0
            * -> choose random shift <= res < bw
            * ---------------------------------------------------------------- */
-          bvmax = btor_bv_ones (mm, sbw);
-          tmp   = btor_bv_uint64_to_bv (mm, (uint64_t) shift, sbw);
+          bvmax = btor_bv_init_inline (&imax, UINT64_MAX, sbw);
+          tmp   = btor_bv_init_inline (&ishift, shift, sbw);
           res   = btor_bv_new_random_range (mm, &btor->rng, sbw, tmp, bvmax);
-          btor_bv_free (mm, bvmax);
-          btor_bv_free (mm, tmp);
         }
         else
         {
@@ -2925,6 +2963,7 @@ inv_srl_bv (Btor *btor,
   uint32_t i, j, clz_bve, clz_bvsrl, shift, sbw;
   BtorNode *e;
   BtorBitVector *res, *bvmax, *tmp;
+  BtorBitVectorInline imax, ishift;
   BtorMemMgr *mm;
 #ifndef NDEBUG
   bool is_inv = true;
@@ -2992,11 +3031,9 @@ inv_srl_bv (Btor *btor,
           /* x...x0 >> e[1] = 0...0
            * -> choose random shift <= res < bw
            * ---------------------------------------------------------------- */
-          bvmax = btor_bv_ones (mm, sbw);
-          tmp   = btor_bv_uint64_to_bv (mm, (uint64_t) shift, sbw);
+          bvmax = btor_bv_init_inline (&imax, UINT64_MAX, sbw);
+          tmp   = btor_bv_init_inline (&ishift, shift, sbw);
           res   = btor_bv_new_random_range (mm, &btor->rng, sbw, tmp, bvmax);
-          btor_bv_free (mm, bvmax);
-          btor_bv_free (mm, tmp);
         }
         else
         {
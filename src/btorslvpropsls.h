@@ -18,6 +18,7 @@
 #include "btornode.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
+#include "utils/btornodeadj.h"
 
 /*------------------------------------------------------------------------*/
 
@@ -30,6 +31,7 @@ void btor_propsls_update_cone (Btor* btor,
                                BtorIntHashTable* roots,
                                BtorIntHashTable* score,
                                BtorIntHashTable* exps,
+                               const BtorNodeAdj* adj,
                                bool update_roots,
                                uint64_t* stats_updates,
                                double* time_update_cone,
@@ -1076,11 +1076,13 @@ mk_concrete_lambda_model (Btor *btor, const BtorPtrHashTable *model)
   BtorBitVectorTuple *args_tuple;
   BtorSortId dsortid, cdsortid, funsortid;
   BtorSortIdStack tup_sorts;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashMap *static_rho;
+  BtorPtrHashMapIterator rit;
+  BtorPtrHashMapEntry *e;
   BtorMemMgr *mm;
 
   mm         = btor->mm;
-  static_rho = btor_hashptr_table_new (mm, 0, 0);
+  static_rho = btor_hashptrmap_new (mm, 0, 0);
   BTOR_INIT_STACK (mm, params);
   BTOR_INIT_STACK (mm, consts);
   BTOR_INIT_STACK (mm, tup_sorts);
@@ -1165,7 +1167,7 @@ mk_concrete_lambda_model (Btor *btor, const BtorPtrHashTable *model)
     ite  = btor_exp_cond (btor, cond, e_if, e_else);
 
     /* add to static rho */
-    btor_hashptr_table_add (static_rho, args)->data.as_ptr =
+    btor_hashptrmap_add (static_rho, args)->data.as_ptr =
         btor_node_copy (btor, e_if);
 
     btor_node_release (btor, cond);
@@ -1191,13 +1193,14 @@ mk_concrete_lambda_model (Btor *btor, const BtorPtrHashTable *model)
   /* res already exists */
   if (((BtorLambdaNode *) res)->static_rho)
   {
-    btor_iter_hashptr_init (&it, static_rho);
-    while (btor_iter_hashptr_has_next (&it))
+    btor_iter_hashptrmap_init (&rit, static_rho);
+    while (btor_iter_hashptrmap_has_next (&rit))
     {
-      btor_node_release (btor, it.bucket->data.as_ptr);
-      btor_node_release (btor, btor_iter_hashptr_next (&it));
+      e = btor_iter_hashptrmap_next_entry (&rit);
+      btor_node_release (btor, e->data.as_ptr);
+      btor_node_release (btor, e->key);
     }
-    btor_hashptr_table_delete (static_rho);
+    btor_hashptrmap_delete (static_rho);
   }
   else
     ((BtorLambdaNode *) res)->static_rho = static_rho;
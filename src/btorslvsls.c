@@ -347,6 +347,7 @@ try_move (Btor *btor,
                             slv->roots,
                             score,
                             cans,
+                            slv->adj,
                             false,
                             &slv->stats.updates,
                             &slv->time.update_cone,
@@ -1256,6 +1257,7 @@ move (Btor *btor, uint32_t nmoves)
                             slv->roots,
                             slv->score,
                             slv->max_cans,
+                            slv->adj,
                             true,
                             &slv->stats.updates,
                             &slv->time.update_cone,
@@ -1376,6 +1378,7 @@ clone_sls_solver (Btor *clone, BtorSLSSolver *slv, BtorNodeMap *exp_map)
   memcpy (res, slv, sizeof (BtorSLSSolver));
 
   res->btor  = clone;
+  res->adj   = 0;
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
   res->score =
       btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
@@ -1425,6 +1428,7 @@ delete_sls_solver (BtorSLSSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  assert (!slv->adj);
   if (slv->weights)
   {
     btor_iter_hashint_init (&it, slv->weights);
@@ -1536,6 +1540,10 @@ sat_sls_solver (BtorSLSSolver *slv)
 
   if (!slv->score) slv->score = btor_hashint_map_new (btor->mm);
 
+  /* the formula does not change during local search */
+  assert (!slv->adj);
+  slv->adj = btor_node_adj_new (btor);
+
   for (;;)
   {
     if (btor_terminate (btor))
@@ -1631,6 +1639,11 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->adj)
+  {
+    btor_node_adj_delete (slv->adj);
+    slv->adj = 0;
+  }
   return sat_result;
 }
 
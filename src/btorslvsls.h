@@ -16,6 +16,7 @@
 
 #include "btorslv.h"
 #include "utils/btorhashint.h"
+#include "utils/btornodeadj.h"
 #include "utils/btorstack.h"
 
 enum BtorSLSMoveKind
@@ -61,6 +62,7 @@ struct BtorSLSSolver
                                 but does not maintain anything */
   BtorIntHashTable *weights; /* also maintains assertion weights */
   BtorIntHashTable *score;   /* sls score */
+  BtorNodeAdj *adj;          /* parent snapshot, only maintained during sat */
 
   uint32_t nflips; /* limit, disabled if 0 */
   bool terminate;
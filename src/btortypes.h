@@ -171,9 +171,29 @@ enum BtorOption
         `MiniSat <https://github.com/niklasso/minisat>`_
       * BTOR_SAT_ENGINE_PICOSAT:
         `PicoSAT <http://fmv.jku.at/picosat/>`_
+      * BTOR_SAT_ENGINE_IPASIR:
+        any SAT solver implementing the
+        `IPASIR <https://github.com/biotomas/ipasir>`_ interface, loaded at
+        runtime from the shared library given via
+        boolector_set_sat_solver (``ipasir:<path>``)
   */
   BTOR_OPT_SAT_ENGINE,
 
+  /*!
+    * **BTOR_OPT_SAT_ENGINE_PORTFOLIO**
+
+      | Set the number of differently configured instances of the SAT solver
+        that run in parallel threads on each SAT call (0 or 1 disables the
+        portfolio). The first instance that determines a result wins, root
+        level units are shared among the instances.
+      | Requires a SAT solver that supports termination callbacks (CaDiCaL,
+        Lingeling, PicoSAT) and Boolector to be compiled with pthreads.
+      | This option cannot be changed after the first call to
+        boolector_sat().
+      | Disabled by default.
+  */
+  BTOR_OPT_SAT_ENGINE_PORTFOLIO,
+
   /*!
     * **BTOR_OPT_AUTO_CLEANUP**
 
@@ -246,6 +266,110 @@ enum BtorOption
   */
   BTOR_OPT_REWRITE_LEVEL,
 
+  /*!
+    * **BTOR_OPT_RW_CACHE_SIZE**
+
+      | Set the maximum size of the rewrite cache in MB.
+      | Boolector uses 32 MB by default, a size of 0 disables the rewrite
+        cache.
+  */
+  BTOR_OPT_RW_CACHE_SIZE,
+
+  /*!
+    * **BTOR_OPT_AIG_REWRITE**
+
+      | Set the level of AIG optimization applied prior to CNF encoding.
+      | Boolector uses level 0 by default.
+
+      * 0: no AIG optimization
+      * 1: DAG-aware cut-based AIG rewriting
+      * 2: AND tree balancing and DAG-aware cut-based AIG rewriting
+  */
+  BTOR_OPT_AIG_REWRITE,
+
+  /*!
+    * **BTOR_OPT_AIG_FRAIG**
+
+      | Enable (``value``: 1) or disable (``value``: 0) SAT sweeping of the
+        AIGs prior to CNF encoding, i.e., merge AIG nodes that are proven
+        to be equivalent after random simulation (useful for miters).
+      | Disabled by default.
+  */
+  BTOR_OPT_AIG_FRAIG,
+
+  /*!
+    * **BTOR_OPT_MUL_ENC**
+
+      | Select the encoding of multiplication into AIGs.
+
+      * BTOR_MUL_ENC_ARRAY [default]:
+        shift-and-add array multiplier
+      * BTOR_MUL_ENC_TREE:
+        radix-4 Booth partial products reduced by a Dadda tree
+  */
+  BTOR_OPT_MUL_ENC,
+
+  /*!
+    * **BTOR_OPT_MUL_CSD**
+
+      | Enable (``value``: 1) or disable (``value``: 0) encoding
+        multiplications with a constant operand as a sum of shifted terms
+        of its canonical signed digit representation.
+      | Disabled by default.
+  */
+  BTOR_OPT_MUL_CSD,
+
+  /*!
+    * **BTOR_OPT_DIV_ENC**
+
+      | Select the encoding of unsigned division and remainder.
+
+      * BTOR_DIV_ENC_CIRCUIT [default]:
+        restoring array divider circuit
+      * BTOR_DIV_ENC_CONSTRAINT:
+        fresh variables for quotient q and remainder r of a / b with
+        constraint a = q * b + r, r < b (the circuit is used for constant
+        divisors and if the SAT solver is not initialized)
+  */
+  BTOR_OPT_DIV_ENC,
+
+  /*!
+    * **BTOR_OPT_PREFIX_WIDTH**
+
+      | Encode adders and unsigned comparators of at least the given width
+        with parallel-prefix networks of logarithmic depth instead of
+        ripple-carry chains (``value``: 0 disables prefix networks).
+      | Disabled by default.
+  */
+  BTOR_OPT_PREFIX_WIDTH,
+
+  /*!
+    * **BTOR_OPT_PREFIX_ENC**
+
+      | Select the parallel-prefix network for adders (see
+        BTOR_OPT_PREFIX_WIDTH).
+
+      * BTOR_PREFIX_ENC_BK [default]:
+        Brent-Kung, 2 * log2 (width) levels, less than 2 * width operators
+      * BTOR_PREFIX_ENC_KS:
+        Kogge-Stone, log2 (width) levels, width * log2 (width) operators
+  */
+  BTOR_OPT_PREFIX_ENC,
+
+  /*!
+    * **BTOR_OPT_AIG_PG**
+
+      | Enable (``value``: 1) or disable (``value``: 0) polarity-aware
+        (Plaisted-Greenbaum) CNF encoding of AIGs. Only the clauses
+        required by the polarities in which an AIG occurs in assertions,
+        assumptions and lemmas are generated, and AIG vectors of
+        synthesized expressions are not encoded eagerly.
+      | This option cannot be changed after the first call to
+        boolector_sat().
+      | Disabled by default.
+  */
+  BTOR_OPT_AIG_PG,
+
   /*!
     * **BTOR_OPT_SKELETON_PREPROC**
 
@@ -417,6 +541,19 @@ enum BtorOption
   */
   BTOR_OPT_FUN_EAGER_LEMMAS,
 
+  /*!
+    * **BTOR_OPT_FUN_PROP_THREADS**
+
+      | Set the number of threads used to check the function cones of the
+        current model for conflicts in parallel before the sequential
+        consistency check (0 disables parallel checking). The lemmas found
+        in all cones are added in one refinement iteration.
+      | Cones that contain lambdas are only checked sequentially.
+      | Requires Boolector to be compiled with pthreads.
+      | Disabled by default.
+  */
+  BTOR_OPT_FUN_PROP_THREADS,
+
   BTOR_OPT_FUN_STORE_LAMBDAS,
 
   /* --------------------------------------------------------------------- */
@@ -670,6 +670,11 @@ NEXT:
       PARSE_ARGS1 (tok, str);
       boolector_set_sat_solver (btor, arg1_str);
     }
+    else if (!strcmp (tok, "set_result_cache"))
+    {
+      PARSE_ARGS1 (tok, str);
+      boolector_set_result_cache (btor, arg1_str);
+    }
     else if (!strcmp (tok, "set_opt"))
     {
       PARSE_ARGS2 (tok, str, int);
@@ -315,7 +315,9 @@ bdcnode (BtorDumpContext *bdc, BtorNode *node, FILE *file)
   BtorNode *n, *index, *value;
   BtorArgsIterator ait;
   BtorNodeIterator nit;
-  BtorPtrHashTable *rho;
+  BtorPtrHashMapIterator rit;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMap *rho;
   BtorBitVector *bits;
 
   node  = btor_node_real_addr (node);
@@ -491,8 +493,10 @@ bdcnode (BtorDumpContext *bdc, BtorNode *node, FILE *file)
     assert (btor_node_fun_get_arity (bdc->btor, node) == 1);
     rho = btor_node_lambda_get_static_rho (node);
     assert (rho->count == 1);
-    index = rho->first->key;
-    value = rho->first->data.as_ptr;
+    btor_iter_hashptrmap_init (&rit, rho);
+    e     = btor_iter_hashptrmap_next_entry (&rit);
+    index = e->key;
+    value = e->data.as_ptr;
     assert (value);
     assert (btor_node_is_regular (index));
     assert (btor_node_is_args (index));
@@ -573,8 +573,9 @@ expand_lambda (BtorSMTDumpContext *sdc,
   assert (btor_node_is_array (exp));
 
   uint32_t i;
-  BtorPtrHashTableIterator it;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMap *static_rho;
   BtorNode *index, *value, *cur;
   BtorNodePtrStack visit;
   BtorIntHashTable *cache;
@@ -601,11 +602,12 @@ expand_lambda (BtorSMTDumpContext *sdc,
       static_rho = btor_node_lambda_get_static_rho (cur);
       assert (static_rho);
 
-      btor_iter_hashptr_init (&it, static_rho);
-      while (btor_iter_hashptr_has_next (&it))
+      btor_iter_hashptrmap_init (&it, static_rho);
+      while (btor_iter_hashptrmap_has_next (&it))
       {
-        value = it.bucket->data.as_ptr;
-        index = btor_iter_hashptr_next (&it);
+        e     = btor_iter_hashptrmap_next_entry (&it);
+        value = e->data.as_ptr;
+        index = e->key;
         assert (btor_node_is_args (index));
         assert (btor_node_args_get_arity (sdc->btor, index) == 1);
         BTOR_PUSH_STACK (*indices, index->e[0]);
@@ -1513,8 +1515,10 @@ dump_smt (BtorSMTDumpContext *sdc)
   BtorNodePtrStack visit, all, vars, shared, ufs, larr;
   BtorPtrHashBucket *b;
   BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator rit;
+  BtorPtrHashMapEntry *re;
   BtorArgsIterator ait;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashMap *static_rho;
 
   mm = sdc->btor->mm;
   BTOR_INIT_STACK (mm, visit);
@@ -1567,11 +1571,12 @@ dump_smt (BtorSMTDumpContext *sdc)
     static_rho = btor_node_lambda_get_static_rho (cur);
     assert (static_rho);
 
-    btor_iter_hashptr_init (&it, static_rho);
-    while (btor_iter_hashptr_has_next (&it))
+    btor_iter_hashptrmap_init (&rit, static_rho);
+    while (btor_iter_hashptrmap_has_next (&rit))
     {
-      value = btor_node_real_addr (it.bucket->data.as_ptr);
-      index = btor_node_real_addr (btor_iter_hashptr_next (&it));
+      re    = btor_iter_hashptrmap_next_entry (&rit);
+      value = btor_node_real_addr (re->data.as_ptr);
+      index = btor_node_real_addr (re->key);
       assert (btor_node_is_args (index));
       assert (btor_node_args_get_arity (sdc->btor, index) == 1);
       if (!(b = btor_hashptr_table_get (sdc->dump, value)))
@@ -0,0 +1,229 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2017 Mathias Preiner.
+ *  Copyright (C) 2017 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifdef BTOR_USE_CADICAL
+
+#include "cadical.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" {
+
+#include "btorabort.h"
+#include "btorsat.h"
+#include "sat/btorcadical.h"
+
+/*------------------------------------------------------------------------*/
+
+class BtorCaDiCaLTerminator : public CaDiCaL::Terminator
+{
+ public:
+  BtorCaDiCaLTerminator () : fun (0), state (0) {}
+
+  int32_t (*fun) (void *);
+  void *state;
+
+  bool terminate () { return fun && fun (state); }
+};
+
+struct BtorCaDiCaL
+{
+  CaDiCaL::Solver *solver;
+  BtorCaDiCaLTerminator term;
+  /* CaDiCaL only provides values in the satisfied state, i.e., after a
+   * satisfiable call and before adding clauses or assumptions */
+  bool nomodel;
+  unsigned long long calls;
+
+  BtorCaDiCaL () : solver (new CaDiCaL::Solver ()), nomodel (true), calls (0)
+  {
+  }
+
+  ~BtorCaDiCaL () { delete solver; }
+
+  bool is_known (int32_t lit) { return abs (lit) <= solver->vars (); }
+};
+
+/*------------------------------------------------------------------------*/
+
+static void *
+init (BtorSATMgr *smgr)
+{
+  (void) smgr;
+  return new BtorCaDiCaL ();
+}
+
+static void
+add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  blcd->nomodel     = true;
+  blcd->solver->add (lit);
+}
+
+static int32_t
+sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  int32_t res;
+
+  blcd->calls++;
+  /* a negative limit disables the conflict limit of the next call */
+  blcd->solver->limit ("conflicts", limit < 0 ? -1 : limit);
+  res           = blcd->solver->solve ();
+  blcd->nomodel = res != 10;
+  return res;
+}
+
+static int32_t
+fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  if (!blcd->is_known (lit)) return 0;
+  return blcd->solver->fixed (lit);
+}
+
+static int32_t
+deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  if (blcd->nomodel || !blcd->is_known (lit)) return fixed (smgr, lit);
+  return blcd->solver->val (lit) > 0 ? 1 : -1;
+}
+
+static void
+reset (BtorSATMgr *smgr)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  delete blcd;
+}
+
+static void
+enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  if (level <= 1)
+    blcd->solver->set ("quiet", 1);
+  else if (level >= 2)
+    blcd->solver->set ("verbose", level - 2);
+}
+
+static void
+stats (BtorSATMgr *smgr)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  blcd->solver->statistics ();
+  printf ("[cadical] calls %llu\n", blcd->calls);
+  fflush (stdout);
+}
+
+/*------------------------------------------------------------------------*/
+/* incremental API                                                        */
+/*------------------------------------------------------------------------*/
+
+static void
+assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  blcd->nomodel     = true;
+  blcd->solver->assume (lit);
+}
+
+static int32_t
+failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  if (!blcd->is_known (lit)) return 0;
+  return blcd->solver->failed (lit);
+}
+
+/* Note: CaDiCaL reactivates eliminated variables that occur in clauses or
+ * assumptions added later on, hence CNF ids do not need to be frozen (as
+ * for Lingeling) in incremental mode. */
+
+static void
+setterm (BtorSATMgr *smgr)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  blcd->term.fun    = smgr->term.fun;
+  blcd->term.state  = smgr->term.state;
+  if (smgr->term.fun)
+    blcd->solver->connect_terminator (&blcd->term);
+  else
+    blcd->solver->disconnect_terminator ();
+}
+
+static void *
+clone (BtorSATMgr *smgr, BtorMemMgr *mm)
+{
+  (void) mm;
+
+  BtorCaDiCaL *res, *blcd;
+
+  blcd = (BtorCaDiCaL *) smgr->solver;
+
+  /* not initialized yet */
+  if (!blcd) return 0;
+
+  /* Copies irredundant clauses, units and the witness stack, but neither
+   * learned clauses nor the current model and assumptions.  Termination
+   * callbacks are reset by 'btor_sat_mgr_clone'. */
+  res = new BtorCaDiCaL ();
+  blcd->solver->copy (*res->solver);
+  res->calls = blcd->calls;
+  return res;
+}
+
+static void
+diversify (BtorSATMgr *smgr, uint32_t id)
+{
+  BtorCaDiCaL *blcd = (BtorCaDiCaL *) smgr->solver;
+  blcd->solver->set ("seed", id);
+  blcd->solver->set ("phase", id & 1);
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_cadical (BtorSATMgr *smgr)
+{
+  assert (smgr != NULL);
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_cadical'");
+
+  smgr->name = "CaDiCaL";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add              = add;
+  smgr->api.add_lits         = 0;
+  smgr->api.assume           = assume;
+  smgr->api.deref            = deref;
+  smgr->api.enable_verbosity = enable_verbosity;
+  smgr->api.failed           = failed;
+  smgr->api.fixed            = fixed;
+  smgr->api.inc_max_var      = 0;
+  smgr->api.init             = init;
+  smgr->api.melt             = 0;
+  smgr->api.repr             = 0;
+  smgr->api.reset            = reset;
+  smgr->api.sat              = sat;
+  smgr->api.set_output       = 0;
+  smgr->api.set_prefix       = 0;
+  smgr->api.stats            = stats;
+  smgr->api.clone            = clone;
+  smgr->api.setterm          = setterm;
+  smgr->api.setlearn         = 0;
+  smgr->api.diversify        = diversify;
+  return true;
+}
+}
+#endif
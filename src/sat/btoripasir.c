@@ -0,0 +1,234 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "sat/btoripasir.h"
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_USE_IPASIR
+/*------------------------------------------------------------------------*/
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include "btorabort.h"
+#include "btorcore.h"
+#include "btoropt.h"
+
+/*------------------------------------------------------------------------*/
+
+struct BtorIPASIR
+{
+  void *lib;    /* handle of the loaded shared library */
+  void *solver; /* IPASIR solver instance */
+  int32_t maxvar;
+  bool nomodel;
+
+  /* IPASIR does not support conflict limits, we approximate them by the
+   * number of polls of the termination callback, which IPASIR solvers
+   * check regularly during search. */
+  int32_t limit;
+  int32_t polls;
+
+  struct
+  {
+    int32_t (*fun) (void *);
+    void *state;
+  } term;
+
+  const char *(*signature) (void);
+  void *(*init) (void);
+  void (*release) (void *);
+  void (*add) (void *, int32_t);
+  void (*assume) (void *, int32_t);
+  int32_t (*solve) (void *);
+  int32_t (*val) (void *, int32_t);
+  int32_t (*failed) (void *, int32_t);
+  void (*set_terminate) (void *, void *, int32_t (*) (void *));
+};
+
+typedef struct BtorIPASIR BtorIPASIR;
+
+/*------------------------------------------------------------------------*/
+
+static void *
+load_sym (void *lib, const char *path, const char *name, bool required)
+{
+  void *res;
+
+  res = dlsym (lib, name);
+  BTOR_ABORT (required && !res,
+              "IPASIR library '%s' does not provide '%s'",
+              path,
+              name);
+  return res;
+}
+
+static int32_t
+terminate (void *state)
+{
+  BtorIPASIR *blib;
+
+  blib = state;
+  if (blib->limit >= 0 && blib->polls++ >= blib->limit) return 1;
+  return blib->term.fun && blib->term.fun (blib->term.state);
+}
+
+static void *
+init (BtorSATMgr *smgr)
+{
+  BtorIPASIR *res;
+  const char *path;
+
+  path = btor_opt_get_valstr (smgr->btor, BTOR_OPT_SAT_ENGINE);
+  BTOR_ABORT (!path, "no IPASIR library given, use 'ipasir:<path>'");
+
+  BTOR_CNEW (smgr->btor->mm, res);
+  res->lib = dlopen (path, RTLD_NOW | RTLD_LOCAL);
+  BTOR_ABORT (
+      !res->lib, "failed to load IPASIR library '%s': %s", path, dlerror ());
+
+  res->signature = load_sym (res->lib, path, "ipasir_signature", true);
+  res->init      = load_sym (res->lib, path, "ipasir_init", true);
+  res->release   = load_sym (res->lib, path, "ipasir_release", true);
+  res->add       = load_sym (res->lib, path, "ipasir_add", true);
+  res->assume    = load_sym (res->lib, path, "ipasir_assume", true);
+  res->solve     = load_sym (res->lib, path, "ipasir_solve", true);
+  res->val       = load_sym (res->lib, path, "ipasir_val", true);
+  res->failed    = load_sym (res->lib, path, "ipasir_failed", true);
+  res->set_terminate =
+      load_sym (res->lib, path, "ipasir_set_terminate", false);
+
+  BTOR_MSG (smgr->btor->msg, 1, "IPASIR solver %s", res->signature ());
+
+  res->solver  = res->init ();
+  res->nomodel = true;
+  res->limit   = -1;
+  if (res->set_terminate) res->set_terminate (res->solver, res, terminate);
+  return res;
+}
+
+static void
+add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *blib = smgr->solver;
+  blib->nomodel    = true;
+  if (abs (lit) > blib->maxvar) blib->maxvar = abs (lit);
+  blib->add (blib->solver, lit);
+}
+
+static void
+add_lits (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  BtorIPASIR *blib = smgr->solver;
+  size_t i;
+
+  blib->nomodel = true;
+  for (i = 0; i < n; i++)
+  {
+    if (abs (lits[i]) > blib->maxvar) blib->maxvar = abs (lits[i]);
+    blib->add (blib->solver, lits[i]);
+  }
+}
+
+static int32_t
+sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorIPASIR *blib = smgr->solver;
+  int32_t res;
+
+  blib->limit   = blib->set_terminate ? limit : -1;
+  blib->polls   = 0;
+  res           = blib->solve (blib->solver);
+  blib->nomodel = res != 10;
+  return res;
+}
+
+static int32_t
+deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *blib = smgr->solver;
+  int32_t val;
+
+  if (blib->nomodel || abs (lit) > blib->maxvar) return 0;
+  /* query the variable, solvers differ in how they handle negative
+   * literals in 'ipasir_val' */
+  val = blib->val (blib->solver, abs (lit));
+  if (val == 0) return 0;
+  val = val > 0 ? 1 : -1;
+  return lit < 0 ? -val : val;
+}
+
+static void
+reset (BtorSATMgr *smgr)
+{
+  BtorIPASIR *blib = smgr->solver;
+  blib->release (blib->solver);
+  dlclose (blib->lib);
+  BTOR_DELETE (smgr->btor->mm, blib);
+  smgr->solver = 0;
+}
+
+static void
+setterm (BtorSATMgr *smgr)
+{
+  BtorIPASIR *blib = smgr->solver;
+  blib->term.fun   = smgr->term.fun;
+  blib->term.state = smgr->term.state;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *blib = smgr->solver;
+  blib->nomodel    = true;
+  if (abs (lit) > blib->maxvar) blib->maxvar = abs (lit);
+  blib->assume (blib->solver, lit);
+}
+
+static int32_t
+failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorIPASIR *blib = smgr->solver;
+  return blib->failed (blib->solver, lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_ipasir (BtorSATMgr *smgr)
+{
+  assert (smgr != NULL);
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_ipasir'");
+
+  smgr->name = "IPASIR";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add              = add;
+  smgr->api.add_lits         = add_lits;
+  smgr->api.assume           = assume;
+  smgr->api.clone            = 0;
+  smgr->api.deref            = deref;
+  smgr->api.enable_verbosity = 0;
+  smgr->api.failed           = failed;
+  smgr->api.fixed            = 0;
+  smgr->api.inc_max_var      = 0;
+  smgr->api.init             = init;
+  smgr->api.melt             = 0;
+  smgr->api.repr             = 0;
+  smgr->api.reset            = reset;
+  smgr->api.sat              = sat;
+  smgr->api.set_output       = 0;
+  smgr->api.set_prefix       = 0;
+  smgr->api.setterm          = setterm;
+  smgr->api.stats            = 0;
+  return true;
+}
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
@@ -0,0 +1,24 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSATIPASIR_H_INCLUDED
+#define BTORSATIPASIR_H_INCLUDED
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_USE_IPASIR
+/*------------------------------------------------------------------------*/
+
+#include "btorsat.h"
+
+/* IPASIR solver loaded at runtime from the shared library given as string
+ * value of option BTOR_OPT_SAT_ENGINE ('--sat-engine=ipasir:<path>'). */
+bool btor_sat_enable_ipasir (BtorSATMgr* smgr);
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
+
+#endif
@@ -296,6 +296,14 @@ setterm (BtorSATMgr *smgr)
   lglseterm (blgl->lgl, smgr->term.fun, smgr->term.state);
 }
 
+static void
+diversify (BtorSATMgr *smgr, uint32_t id)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglsetopt (blgl->lgl, "seed", id);
+  lglsetopt (blgl->lgl, "phase", (int32_t) (id % 3) - 1);
+}
+
 /*------------------------------------------------------------------------*/
 
 bool
@@ -311,6 +319,7 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_lits         = 0;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
@@ -327,6 +336,8 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
   smgr->api.stats            = stats;
   smgr->api.clone            = clone;
   smgr->api.setterm          = setterm;
+  smgr->api.setlearn         = 0;
+  smgr->api.diversify        = diversify;
   return true;
 }
 
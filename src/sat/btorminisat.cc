@@ -242,6 +242,7 @@ btor_sat_enable_minisat (BtorSATMgr* smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_lits         = 0;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
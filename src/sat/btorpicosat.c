@@ -42,6 +42,19 @@ add (BtorSATMgr *smgr, int32_t lit)
   (void) picosat_add (smgr->solver, lit);
 }
 
+static void
+add_lits (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  const int32_t *p, *end;
+
+  /* picosat_add_lits adds one 0-terminated clause */
+  for (p = lits, end = lits + n; p < end; p++)
+  {
+    (void) picosat_add_lits (smgr->solver, (int32_t *) p);
+    while (*p) p++;
+  }
+}
+
 static int32_t
 sat (BtorSATMgr *smgr, int32_t limit)
 {
@@ -97,6 +110,19 @@ fixed (BtorSATMgr *smgr, int32_t lit)
   return picosat_deref_toplevel (smgr->solver, lit);
 }
 
+static void
+setterm (BtorSATMgr *smgr)
+{
+  picosat_set_interrupt (smgr->solver, smgr->term.state, smgr->term.fun);
+}
+
+static void
+diversify (BtorSATMgr *smgr, uint32_t id)
+{
+  picosat_set_seed (smgr->solver, id);
+  picosat_set_global_default_phase (smgr->solver, id % 4);
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -125,6 +151,7 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
 
   BTOR_CLR (&smgr->api);
   smgr->api.add              = add;
+  smgr->api.add_lits         = add_lits;
   smgr->api.assume           = assume;
   smgr->api.deref            = deref;
   smgr->api.enable_verbosity = enable_verbosity;
@@ -139,6 +166,8 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
   smgr->api.set_output       = set_output;
   smgr->api.set_prefix       = set_prefix;
   smgr->api.stats            = stats;
+  smgr->api.setterm          = setterm;
+  smgr->api.diversify        = diversify;
   return true;
 }
 /*------------------------------------------------------------------------*/
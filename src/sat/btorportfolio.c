@@ -0,0 +1,573 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "sat/btorportfolio.h"
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_HAVE_PTHREADS
+/*------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "btorabort.h"
+#include "btorcore.h"
+#include "btoropt.h"
+#include "utils/btorhashint.h"
+
+/*------------------------------------------------------------------------*/
+
+/* maximum size of learned clauses shared between instances */
+#define BTOR_PORTFOLIO_SHARE_SIZE 2
+/* number of literals (including terminating zeroes) of learned clauses
+ * an instance buffers for sharing per SAT call */
+#define BTOR_PORTFOLIO_SHARE_BUF (1 << 15)
+
+/*------------------------------------------------------------------------*/
+
+typedef struct BtorSATPortfolio BtorSATPortfolio;
+typedef struct BtorSATPortfolioInst BtorSATPortfolioInst;
+
+struct BtorSATPortfolioInst
+{
+  BtorSATPortfolio *pf;
+  BtorSATMgr *smgr; /* solver instance */
+  uint32_t id;
+  int32_t res; /* result of the last SAT call */
+  uint32_t wins;
+  pthread_t thread;
+  /* Learned units and binary clauses, filled by the 'learn' callback of
+   * the instance while it runs (fixed size since the memory manager is not
+   * thread-safe) and imported into the other instances before the next
+   * SAT call. */
+  int32_t *learned;
+  uint32_t nlearned;
+};
+
+struct BtorSATPortfolio
+{
+  BtorSATPortfolioInst *inst;
+  uint32_t ninst;
+  uint32_t winner; /* instance that determined the last result */
+  bool done;       /* set by the first instance that determines a result */
+  pthread_mutex_t mutex;
+
+  struct
+  {
+    int32_t (*fun) (void *);
+    void *state;
+  } term;
+
+  /* Learned units and binary clauses of one instance are shared with all
+   * other instances before the next SAT call.  Melted variables may be
+   * eliminated and must not be used in clauses anymore, hence clauses
+   * containing them are not shared. */
+  BtorIntHashTable *melted;
+  uint32_t nshared_units;
+  uint32_t nshared_bins;
+
+  /* Instances without 'learn' callback only share root level units, which
+   * are collected by scanning all variables on SAT calls 1, 2, 4, 8, ... */
+  bool scan_units;
+  BtorIntHashTable *shared; /* variables fixed in all instances */
+};
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+inst_fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.fixed) return smgr->api.fixed (smgr, lit);
+  return 0;
+}
+
+static int32_t
+terminate (void *state)
+{
+  BtorSATPortfolio *pf = state;
+  if (__atomic_load_n (&pf->done, __ATOMIC_RELAXED)) return 1;
+  return pf->term.fun && pf->term.fun (pf->term.state);
+}
+
+static void *
+run_inst (void *state)
+{
+  BtorSATPortfolioInst *inst = state;
+  BtorSATPortfolio *pf       = inst->pf;
+
+  inst->res = inst->smgr->api.sat (inst->smgr, -1);
+  if (inst->res)
+  {
+    pthread_mutex_lock (&pf->mutex);
+    if (!pf->done)
+    {
+      pf->winner = inst->id;
+      __atomic_store_n (&pf->done, true, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock (&pf->mutex);
+  }
+  return 0;
+}
+
+/* Propagate the state of the portfolio manager the solver wrappers rely
+ * on to the instances. */
+static void
+sync_inst (BtorSATMgr *smgr, BtorSATMgr *ismgr)
+{
+  ismgr->inc_required = smgr->inc_required;
+  ismgr->satcalls     = smgr->satcalls;
+  ismgr->output       = smgr->output;
+#ifdef BTOR_USE_LINGELING
+  /* forking Lingeling allocates from the (not thread-safe) memory manager */
+  ismgr->fork = false;
+#endif
+}
+
+static void
+learn (void *state, const int32_t *cls)
+{
+  BtorSATPortfolioInst *inst = state;
+  uint32_t size;
+
+  for (size = 0; cls[size]; size++)
+    if (btor_hashint_table_contains (inst->pf->melted, abs (cls[size])))
+      return;
+  if (inst->nlearned + size + 1 > BTOR_PORTFOLIO_SHARE_BUF) return;
+  for (size = 0; cls[size]; size++) inst->learned[inst->nlearned++] = cls[size];
+  inst->learned[inst->nlearned++] = 0;
+}
+
+/* Import the clauses learned by each instance into all other instances. */
+static void
+share_learned (BtorSATPortfolio *pf)
+{
+  BtorSATPortfolioInst *inst;
+  BtorSATMgr *ismgr;
+  int32_t *cls;
+  uint32_t i, j, k, size;
+  bool skip;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    inst = pf->inst + i;
+    for (cls = inst->learned; cls < inst->learned + inst->nlearned;
+         cls += size + 1)
+    {
+      for (size = 0, skip = false; cls[size]; size++)
+        skip |= btor_hashint_table_contains (pf->melted, abs (cls[size]));
+      if (skip) continue;
+
+      for (j = 0; j < pf->ninst; j++)
+      {
+        if (j == i) continue;
+        ismgr = pf->inst[j].smgr;
+        if (size == 1 && inst_fixed (ismgr, cls[0])) continue;
+        for (k = 0; k <= size; k++) ismgr->api.add (ismgr, cls[k]);
+        if (size == 1)
+          pf->nshared_units++;
+        else
+          pf->nshared_bins++;
+      }
+    }
+    inst->nlearned = 0;
+  }
+}
+
+static void
+share_units (BtorSATMgr *smgr, BtorSATPortfolio *pf)
+{
+  BtorSATMgr *ismgr;
+  int32_t v, val;
+  uint32_t i;
+
+  for (v = 1; v <= smgr->maxvar; v++)
+  {
+    if (btor_hashint_table_contains (pf->shared, v)
+        || btor_hashint_table_contains (pf->melted, v))
+      continue;
+
+    for (i = 0, val = 0; i < pf->ninst && !val; i++)
+      val = inst_fixed (pf->inst[i].smgr, v);
+    if (!val) continue;
+
+    for (i = 0; i < pf->ninst; i++)
+    {
+      ismgr = pf->inst[i].smgr;
+      if (inst_fixed (ismgr, v)) continue;
+      ismgr->api.add (ismgr, val > 0 ? v : -v);
+      ismgr->api.add (ismgr, 0);
+      pf->nshared_units++;
+    }
+    btor_hashint_table_add (pf->shared, v);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static void *
+init (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *res;
+  BtorSATMgr *ismgr;
+  BtorMemMgr *mm;
+  uint32_t i;
+
+  mm = smgr->btor->mm;
+  BTOR_CNEW (mm, res);
+  res->ninst = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO);
+  BTOR_CNEWN (mm, res->inst, res->ninst);
+  res->melted = btor_hashint_table_new (mm);
+  res->shared = btor_hashint_table_new (mm);
+  pthread_mutex_init (&res->mutex, 0);
+
+  for (i = 0; i < res->ninst; i++)
+  {
+    ismgr = btor_sat_mgr_new (smgr->btor);
+    btor_sat_enable_engine (ismgr);
+    sync_inst (smgr, ismgr);
+    ismgr->solver      = ismgr->api.init (ismgr);
+    ismgr->initialized = true;
+    if (i > 0)
+    {
+      ismgr->api.diversify (ismgr, i);
+      if (ismgr->api.enable_verbosity) ismgr->api.enable_verbosity (ismgr, 0);
+    }
+    ismgr->term.fun   = terminate;
+    ismgr->term.state = res;
+    ismgr->api.setterm (ismgr);
+
+    res->inst[i].pf   = res;
+    res->inst[i].smgr = ismgr;
+    res->inst[i].id   = i;
+
+    if (ismgr->api.setlearn)
+    {
+      BTOR_NEWN (mm, res->inst[i].learned, BTOR_PORTFOLIO_SHARE_BUF);
+      ismgr->learn.fun      = learn;
+      ismgr->learn.state    = res->inst + i;
+      ismgr->learn.max_size = BTOR_PORTFOLIO_SHARE_SIZE;
+      ismgr->api.setlearn (ismgr);
+    }
+    else
+      res->scan_units = true;
+  }
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "portfolio of %u %s instances",
+            res->ninst,
+            res->inst[0].smgr->name);
+  return res;
+}
+
+static void
+add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    ismgr->api.add (ismgr, lit);
+  }
+}
+
+static void
+add_lits (BtorSATMgr *smgr, const int32_t *lits, size_t n)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+  size_t j;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    if (ismgr->api.add_lits)
+      ismgr->api.add_lits (ismgr, lits, n);
+    else
+      for (j = 0; j < n; j++) ismgr->api.add (ismgr, lits[j]);
+  }
+}
+
+static int32_t
+sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++) sync_inst (smgr, pf->inst[i].smgr);
+
+  /* Clauses can only be added to the instances between SAT calls, the
+   * backends do not provide an interface to import clauses while solving.
+   * Eliminated variables can not be reintroduced in non-incremental mode. */
+  if (smgr->inc_required)
+  {
+    share_learned (pf);
+    if (pf->scan_units
+        && (smgr->satcalls == 1 || !(smgr->satcalls & (smgr->satcalls - 1))))
+      share_units (smgr, pf);
+  }
+
+  /* reset the result of the previous call, which terminates all instances
+   * (see terminate) */
+  pf->done = false;
+
+  /* Bounded calls are cheap checks, not worth spawning threads.  Only the
+   * first instance runs, but it still imports the clauses learned by all
+   * other instances in previous calls. */
+  if (limit >= 0)
+  {
+    ismgr      = pf->inst[0].smgr;
+    pf->winner = 0;
+    return ismgr->api.sat (ismgr, limit);
+  }
+
+  for (i = 1; i < pf->ninst; i++)
+    pthread_create (&pf->inst[i].thread, 0, run_inst, &pf->inst[i]);
+  run_inst (&pf->inst[0]);
+  for (i = 1; i < pf->ninst; i++) pthread_join (pf->inst[i].thread, 0);
+
+  if (!pf->done)
+  {
+    pf->winner = 0;
+    return 0;
+  }
+  pf->inst[pf->winner].wins++;
+  return pf->inst[pf->winner].res;
+}
+
+static int32_t
+deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr    = pf->inst[pf->winner].smgr;
+  return ismgr->api.deref (ismgr, lit);
+}
+
+static int32_t
+repr (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr    = pf->inst[0].smgr;
+  if (ismgr->api.repr) return ismgr->api.repr (ismgr, lit);
+  return lit;
+}
+
+static void
+reset (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorMemMgr *mm       = smgr->btor->mm;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    btor_sat_mgr_delete (pf->inst[i].smgr);
+    if (pf->inst[i].learned)
+      BTOR_DELETEN (mm, pf->inst[i].learned, BTOR_PORTFOLIO_SHARE_BUF);
+  }
+  btor_hashint_table_delete (pf->melted);
+  btor_hashint_table_delete (pf->shared);
+  pthread_mutex_destroy (&pf->mutex);
+  BTOR_DELETEN (mm, pf->inst, pf->ninst);
+  BTOR_DELETE (mm, pf);
+}
+
+static void
+set_output (BtorSATMgr *smgr, FILE *output)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr         = pf->inst[i].smgr;
+    ismgr->output = output;
+    if (ismgr->api.set_output) ismgr->api.set_output (ismgr, output);
+  }
+}
+
+static void
+set_prefix (BtorSATMgr *smgr, const char *prefix)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    if (ismgr->api.set_prefix) ismgr->api.set_prefix (ismgr, prefix);
+  }
+}
+
+static void
+enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr    = pf->inst[0].smgr;
+  if (ismgr->api.enable_verbosity) ismgr->api.enable_verbosity (ismgr, level);
+}
+
+static int32_t
+inc_max_var (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  int32_t res = 0, var;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    sync_inst (smgr, ismgr);
+    var = ismgr->api.inc_max_var ? ismgr->api.inc_max_var (ismgr)
+                                 : ismgr->maxvar + 1;
+    ismgr->maxvar = var;
+    assert (!i || var == res);
+    res = var;
+  }
+  return res;
+}
+
+static void
+stats (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s instance %u: %u wins",
+              ismgr->name,
+              i,
+              pf->inst[i].wins);
+    if (ismgr->api.stats) ismgr->api.stats (ismgr);
+  }
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u shared units, %u shared binary clauses",
+            pf->nshared_units,
+            pf->nshared_bins);
+}
+
+static int32_t
+fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  int32_t res;
+  uint32_t i;
+
+  for (i = 0, res = 0; i < pf->ninst && !res; i++)
+    res = inst_fixed (pf->inst[i].smgr, lit);
+  return res;
+}
+
+static void
+setterm (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  pf->term.fun         = smgr->term.fun;
+  pf->term.state       = smgr->term.state;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    ismgr->api.assume (ismgr, lit);
+  }
+}
+
+static void
+melt (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr;
+  uint32_t i;
+
+  if (!btor_hashint_table_contains (pf->melted, abs (lit)))
+    btor_hashint_table_add (pf->melted, abs (lit));
+  for (i = 0; i < pf->ninst; i++)
+  {
+    ismgr = pf->inst[i].smgr;
+    sync_inst (smgr, ismgr);
+    if (ismgr->api.melt) ismgr->api.melt (ismgr, lit);
+  }
+}
+
+static int32_t
+failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *pf = smgr->solver;
+  BtorSATMgr *ismgr    = pf->inst[pf->winner].smgr;
+  return ismgr->api.failed (ismgr, lit);
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_portfolio (BtorSATMgr *smgr)
+{
+  assert (smgr != NULL);
+
+  bool inc;
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_portfolio'");
+
+  if (!smgr->api.setterm || !smgr->api.diversify)
+  {
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s does not support running in a portfolio",
+              smgr->name);
+    return false;
+  }
+
+  inc        = smgr->api.assume && smgr->api.failed;
+  smgr->name = "Portfolio";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add              = add;
+  smgr->api.add_lits         = add_lits;
+  smgr->api.assume           = inc ? assume : 0;
+  smgr->api.deref            = deref;
+  smgr->api.enable_verbosity = enable_verbosity;
+  smgr->api.failed           = inc ? failed : 0;
+  smgr->api.fixed            = fixed;
+  smgr->api.inc_max_var      = inc_max_var;
+  smgr->api.init             = init;
+  smgr->api.melt             = melt;
+  smgr->api.repr             = repr;
+  smgr->api.reset            = reset;
+  smgr->api.sat              = sat;
+  smgr->api.set_output       = set_output;
+  smgr->api.set_prefix       = set_prefix;
+  smgr->api.stats            = stats;
+  smgr->api.clone            = 0;
+  smgr->api.setterm          = setterm;
+  return true;
+}
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
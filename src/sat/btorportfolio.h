@@ -0,0 +1,27 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSATPORTFOLIO_H_INCLUDED
+#define BTORSATPORTFOLIO_H_INCLUDED
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_HAVE_PTHREADS
+/*------------------------------------------------------------------------*/
+
+#include "btorsat.h"
+
+/* Wraps the SAT solver enabled for 'smgr' into a portfolio of
+ * BTOR_OPT_SAT_ENGINE_PORTFOLIO differently configured instances, which
+ * receive the same clauses and assumptions and run in parallel threads on
+ * each unbounded SAT call.  Returns false (and keeps the solver as is) if
+ * the solver does not support termination callbacks or diversification. */
+bool btor_sat_enable_portfolio (BtorSATMgr* smgr);
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
+
+#endif
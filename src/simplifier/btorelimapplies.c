@@ -41,9 +41,11 @@ btor_eliminate_applies (Btor *btor)
   uint32_t num_applies, num_applies_total = 0, round;
   double start, delta;
   BtorNode *app, *fun, *subst;
+  BtorPtrHashMapEntry *e;
   BtorNodeIterator it;
   BtorPtrHashTableIterator h_it;
-  BtorPtrHashTable *cache;
+  BtorPtrHashMapIterator c_it;
+  BtorPtrHashMap *cache;
 
   eliminate_update_nodes (btor);
 
@@ -51,9 +53,9 @@ btor_eliminate_applies (Btor *btor)
 
   start = btor_util_time_stamp ();
   round = 1;
-  cache = btor_hashptr_table_new (btor->mm,
-                                  (BtorHashPtr) btor_node_pair_hash,
-                                  (BtorCmpPtr) btor_node_pair_compare);
+  cache = btor_hashptrmap_new (btor->mm,
+                               (BtorHashPtr) btor_node_pair_hash,
+                               (BtorCmpPtr) btor_node_pair_compare);
 
   /* NOTE: in some cases substitute_and_rebuild creates applies that can be
    * beta-reduced. this can happen when parameterized applies become not
@@ -113,13 +115,14 @@ btor_eliminate_applies (Btor *btor)
   }
 #endif
 
-  btor_iter_hashptr_init (&h_it, cache);
-  while (btor_iter_hashptr_has_next (&h_it))
+  btor_iter_hashptrmap_init (&c_it, cache);
+  while (btor_iter_hashptrmap_has_next (&c_it))
   {
-    btor_node_release (btor, h_it.bucket->data.as_ptr);
-    btor_node_pair_delete (btor, btor_iter_hashptr_next (&h_it));
+    e = btor_iter_hashptrmap_next_entry (&c_it);
+    btor_node_release (btor, e->data.as_ptr);
+    btor_node_pair_delete (btor, e->key);
   }
-  btor_hashptr_table_delete (cache);
+  btor_hashptrmap_delete (cache);
 
   delta = btor_util_time_stamp () - start;
   btor->time.elimapplies += delta;
@@ -104,7 +104,8 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   BtorNode *var, *cur, *result, *lambda_var, *temp;
   BtorSortId sort;
   BtorSlice *s1, *s2, *new_s1, *new_s2, *new_s3, **sorted_slices;
-  BtorPtrHashBucket *b_var, *b1, *b2;
+  BtorPtrHashBucket *b1, *b2;
+  BtorPtrHashMapIterator vit;
   BtorNodeIterator it;
   BtorPtrHashTable *slices;
   int32_t i;
@@ -121,9 +122,10 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
 
   mm = btor->mm;
   BTOR_INIT_STACK (mm, vars);
-  for (b_var = btor->bv_vars->first; b_var != NULL; b_var = b_var->next)
+  btor_iter_hashptrmap_init (&vit, btor->bv_vars);
+  while (btor_iter_hashptrmap_has_next (&vit))
   {
-    var = (BtorNode *) b_var->key;
+    var = btor_iter_hashptrmap_next (&vit);
     BTOR_PUSH_STACK (vars, var);
   }
 
@@ -1085,7 +1085,7 @@ find_ranges (Btor *btor,
   if (size_pat_inc) *size_pat_inc += size_pattern_inc;
 }
 
-static BtorPtrHashTable *
+static BtorPtrHashMap *
 create_static_rho (Btor *btor,
                    BtorNode *indices[],
                    BtorNode *value,
@@ -1093,20 +1093,20 @@ create_static_rho (Btor *btor,
 {
   uint32_t i;
   BtorNode *idx, *args;
-  BtorPtrHashTable *static_rho;
+  BtorPtrHashMap *static_rho;
   BtorPtrHashBucket *b;
 
-  static_rho = btor_hashptr_table_new (btor->mm,
-                                       (BtorHashPtr) btor_node_hash_by_id,
-                                       (BtorCmpPtr) btor_node_compare_by_id);
+  static_rho = btor_hashptrmap_new (btor->mm,
+                                    (BtorHashPtr) btor_node_hash_by_id,
+                                    (BtorCmpPtr) btor_node_compare_by_id);
   if (value)
   {
     for (i = 0; indices[i]; i++)
     {
-      idx            = indices[i];
-      args           = btor_exp_args (btor, &idx, 1);
-      b              = btor_hashptr_table_add (static_rho, args);
-      b->data.as_ptr = btor_node_copy (btor, value);
+      idx  = indices[i];
+      args = btor_exp_args (btor, &idx, 1);
+      btor_hashptrmap_add (static_rho, args)->data.as_ptr =
+          btor_node_copy (btor, value);
     }
   }
   else
@@ -1117,10 +1117,10 @@ create_static_rho (Btor *btor,
       idx = indices[i];
       b   = btor_hashptr_table_get (index_value_map, idx);
       assert (b);
-      value          = b->data.as_ptr;
-      args           = btor_exp_args (btor, &idx, 1);
-      b              = btor_hashptr_table_add (static_rho, args);
-      b->data.as_ptr = btor_node_copy (btor, value);
+      value = b->data.as_ptr;
+      args  = btor_exp_args (btor, &idx, 1);
+      btor_hashptrmap_add (static_rho, args)->data.as_ptr =
+          btor_node_copy (btor, value);
     }
   }
   return static_rho;
@@ -1141,7 +1141,8 @@ extract_lambdas (Btor *btor,
   BtorNode *subst, *base, *tmp, *array, *value, *lower, *upper;
   BtorNode *src_array, *src_addr, *dst_addr;
   BtorPtrHashTableIterator it, iit;
-  BtorPtrHashTable *t, *index_value_map, *static_rho;
+  BtorPtrHashTable *t, *index_value_map;
+  BtorPtrHashMap *static_rho;
   BtorPtrHashBucket *b;
   BtorNodePtrStack ranges, indices, values, indices_itoi, indices_itoip1;
   BtorNodePtrStack indices_cpy, indices_rem, indices_ranges, *stack;
@@ -45,34 +45,38 @@
 //#endif
 
 static void
-delete_static_rho (Btor *btor, BtorPtrHashTable *static_rho)
+delete_static_rho (Btor *btor, BtorPtrHashMap *static_rho)
 {
-  BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
 
-  btor_iter_hashptr_init (&it, static_rho);
-  while (btor_iter_hashptr_has_next (&it))
+  btor_iter_hashptrmap_init (&it, static_rho);
+  while (btor_iter_hashptrmap_has_next (&it))
   {
-    btor_node_release (btor, it.bucket->data.as_ptr);
-    btor_node_release (btor, btor_iter_hashptr_next (&it));
+    e = btor_iter_hashptrmap_next_entry (&it);
+    btor_node_release (btor, e->data.as_ptr);
+    btor_node_release (btor, e->key);
   }
-  btor_hashptr_table_delete (static_rho);
+  btor_hashptrmap_delete (static_rho);
 }
 
 static void
-add_to_static_rho (Btor *btor, BtorPtrHashTable *to, BtorPtrHashTable *from)
+add_to_static_rho (Btor *btor, BtorPtrHashMap *to, BtorPtrHashMap *from)
 {
   BtorNode *data, *key;
-  BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator it;
+  BtorPtrHashMapEntry *e;
 
   if (!from) return;
 
-  btor_iter_hashptr_init (&it, from);
-  while (btor_iter_hashptr_has_next (&it))
+  btor_iter_hashptrmap_init (&it, from);
+  while (btor_iter_hashptrmap_has_next (&it))
   {
-    data = it.bucket->data.as_ptr;
-    key  = btor_iter_hashptr_next (&it);
-    if (btor_hashptr_table_get (to, key)) continue;
-    btor_hashptr_table_add (to, btor_node_copy (btor, key))->data.as_ptr =
+    e    = btor_iter_hashptrmap_next_entry (&it);
+    data = e->data.as_ptr;
+    key  = e->key;
+    if (btor_hashptrmap_get (to, key)) continue;
+    btor_hashptrmap_add (to, btor_node_copy (btor, key))->data.as_ptr =
         btor_node_copy (btor, data);
   }
 }
@@ -90,7 +94,8 @@ btor_merge_lambdas (Btor *btor)
   BtorPtrHashTableIterator it;
   BtorNodeIterator nit;
   BtorNodePtrStack stack, visit, params;
-  BtorPtrHashTable *merge_lambdas, *static_rho;
+  BtorPtrHashTable *merge_lambdas;
+  BtorPtrHashMap *static_rho;
   BtorIntHashTable *mark, *mark_lambda;
 
   if (btor->lambdas->count == 0) return;
@@ -113,7 +118,8 @@ btor_merge_lambdas (Btor *btor)
     assert (btor_node_is_regular (lambda));
 
     /* found top lambda */
-    parent = btor_node_real_addr (lambda->first_parent);
+    parent = btor_node_real_addr (
+        btor_node_get_parent_by_id (btor, lambda->first_parent));
     if (lambda->parents > 1
         || lambda->parents == 0
         /* case lambda->parents == 1 */
@@ -211,9 +217,9 @@ btor_merge_lambdas (Btor *btor)
     /* generate static_rho from merged lambdas' static_rhos */
     assert (merge_lambdas->count > 0);
     num_merged_lambdas += merge_lambdas->count;
-    static_rho = btor_hashptr_table_new (mm,
-                                         (BtorHashPtr) btor_node_hash_by_id,
-                                         (BtorCmpPtr) btor_node_compare_by_id);
+    static_rho = btor_hashptrmap_new (mm,
+                                      (BtorHashPtr) btor_node_hash_by_id,
+                                      (BtorCmpPtr) btor_node_compare_by_id);
     if (btor_node_lambda_get_static_rho (lambda))
     {
       btor_iter_hashptr_init (&it, merge_lambdas);
@@ -250,7 +256,7 @@ btor_merge_lambdas (Btor *btor)
         btor_node_lambda_set_static_rho (subst, static_rho);
     }
     else
-      btor_hashptr_table_delete (static_rho);
+      btor_hashptrmap_delete (static_rho);
 
     btor_insert_substitution (btor, lambda, subst, false);
     btor_node_release (btor, subst);
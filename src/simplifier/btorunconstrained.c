@@ -29,7 +29,8 @@ is_uc_write (BtorNode *cond)
 
   if (cond->parents != 1) return false;
 
-  lambda = btor_node_real_addr (cond->first_parent);
+  lambda = btor_node_real_addr (
+      btor_node_get_parent_by_id (cond->btor, cond->first_parent));
   if (!btor_node_is_lambda (lambda)) return false;
 
   return btor_node_lambda_get_static_rho (lambda) != 0;
@@ -90,8 +91,9 @@ btor_optimize_unconstrained (Btor *btor)
   uint32_t i, num_ucs;
   bool uc[3], ucp[3];
   BtorNode *cur, *cur_parent;
-  BtorNodePtrStack stack, roots;
+  BtorNodePtrStack stack, roots, inputs;
   BtorPtrHashTableIterator it;
+  BtorPtrHashMapIterator vit;
   BtorNodeIterator pit;
   BtorMemMgr *mm;
   BtorIntHashTable *ucs;  /* unconstrained candidate nodes */
@@ -114,15 +116,21 @@ btor_optimize_unconstrained (Btor *btor)
 
   /* collect nodes that might contribute to a unconstrained candidate
    * propagation */
-  btor_iter_hashptr_init (&it, btor->bv_vars);
-  btor_iter_hashptr_queue (&it, btor->ufs);
+  BTOR_INIT_STACK (mm, inputs);
+  btor_iter_hashptrmap_init (&vit, btor->bv_vars);
+  while (btor_iter_hashptrmap_has_next (&vit))
+    BTOR_PUSH_STACK (inputs, btor_iter_hashptrmap_next (&vit));
+  btor_iter_hashptr_init (&it, btor->ufs);
   while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (inputs, btor_iter_hashptr_next (&it));
+  for (i = 0; i < BTOR_COUNT_STACK (inputs); i++)
   {
-    cur = btor_iter_hashptr_next (&it);
+    cur = BTOR_PEEK_STACK (inputs, i);
     assert (btor_node_is_regular (cur));
     if (cur->parents == 1)
     {
-      cur_parent = btor_node_real_addr (cur->first_parent);
+      cur_parent = btor_node_real_addr (
+          btor_node_get_parent_by_id (btor, cur->first_parent));
       btor_hashint_table_add (ucs, cur->id);
       BTOR_MSG (btor->msg, 2, "found uc input %s", btor_util_node2string (cur));
       // TODO (ma): why not just collect ufs and vars?
@@ -243,7 +251,8 @@ btor_optimize_unconstrained (Btor *btor)
             if (ucp[1]
                 /* only consider head lambda of curried lambdas */
                 && (!cur->first_parent
-                    || !btor_node_is_lambda (cur->first_parent)))
+                    || !btor_node_is_lambda (btor_node_get_parent_by_id (
+                        btor, cur->first_parent))))
               mark_uc (btor, ucs, cur);
             break;
           default: break;
@@ -262,6 +271,7 @@ btor_optimize_unconstrained (Btor *btor)
   btor_hashint_table_delete (ucsp);
   BTOR_RELEASE_STACK (stack);
   BTOR_RELEASE_STACK (roots);
+  BTOR_RELEASE_STACK (inputs);
 
   delta = btor_util_time_stamp () - start;
   btor->time.ucopt += delta;
@@ -0,0 +1,402 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "utils/btorhashptrmap.h"
+
+#include <assert.h>
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_PTR_HASH_MAP_INIT_SIZE 8
+
+static uint32_t
+hash_ptr (const void *p)
+{
+  return 1183477 * (uint32_t) (uintptr_t) p;
+}
+
+static int32_t
+compare_ptr (const void *p, const void *q)
+{
+  return ((uintptr_t) p) != ((uintptr_t) q);
+}
+
+/* The index is addressed with the lower bits of the hash value, mix the
+ * user provided hash value since e.g. pointer hashes have zero lower bits. */
+static inline uint32_t
+mix (uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x45d9f3bu;
+  h ^= h >> 16;
+  return h;
+}
+
+/* Distance of the key stored at 'pos' to its home position. */
+static inline uint32_t
+probe_dist (const BtorPtrHashMap *map, uint32_t pos)
+{
+  return (pos - map->hashes[pos]) & (map->size - 1);
+}
+
+/* Insert entry at position 'epos' with hash value 'h' into the index. */
+static void
+index_insert (BtorPtrHashMap *map, uint32_t epos, uint32_t h)
+{
+  uint32_t i, e, tmp_e, tmp_h, dist, d, mask;
+
+  mask = map->size - 1;
+  e    = epos + 1;
+  i    = h & mask;
+  for (dist = 0;; dist++, i = (i + 1) & mask)
+  {
+    if (!map->index[i])
+    {
+      map->index[i]  = e;
+      map->hashes[i] = h;
+      return;
+    }
+    /* Robin Hood: take the position of keys closer to their home and
+     * continue with inserting the displaced key */
+    d = probe_dist (map, i);
+    if (d < dist)
+    {
+      tmp_e          = map->index[i];
+      tmp_h          = map->hashes[i];
+      map->index[i]  = e;
+      map->hashes[i] = h;
+      e              = tmp_e;
+      h              = tmp_h;
+      dist           = d;
+    }
+  }
+}
+
+/* Returns the index position of 'key', or 'size' if 'key' is not in 'map'. */
+static uint32_t
+index_find (const BtorPtrHashMap *map, const void *key, uint32_t h)
+{
+  uint32_t i, dist, mask;
+
+  mask = map->size - 1;
+  i    = h & mask;
+  for (dist = 0;; dist++, i = (i + 1) & mask)
+  {
+    if (!map->index[i] || probe_dist (map, i) < dist) return map->size;
+    if (map->hashes[i] == h
+        && !map->cmp (map->entries[map->index[i] - 1].key, key))
+      return i;
+  }
+}
+
+/* Rebuild the index with 'new_size' positions, removed entries are dropped
+ * from the entries array (preserving the order of the remaining entries). */
+static void
+rehash (BtorPtrHashMap *map, uint32_t new_size)
+{
+  uint32_t i, j;
+  BtorPtrHashMapEntry *e;
+
+  assert (new_size > map->count);
+
+  BTOR_DELETEN (map->mm, map->index, map->size);
+  BTOR_DELETEN (map->mm, map->hashes, map->size);
+  BTOR_CNEWN (map->mm, map->index, new_size);
+  BTOR_NEWN (map->mm, map->hashes, new_size);
+  map->size = new_size;
+
+  for (i = j = 0; i < map->num_entries; i++)
+  {
+    e = map->entries + i;
+    if (!e->key) continue;
+    map->entries[j] = *e;
+    index_insert (map, j, mix (map->hash (e->key)));
+    j++;
+  }
+  assert (j == map->count);
+  map->num_entries = j;
+}
+
+BtorPtrHashMap *
+btor_hashptrmap_new (BtorMemMgr *mm, BtorHashPtr hash, BtorCmpPtr cmp)
+{
+  BtorPtrHashMap *res;
+
+  BTOR_CNEW (mm, res);
+  res->mm           = mm;
+  res->hash         = hash ? hash : hash_ptr;
+  res->cmp          = cmp ? cmp : compare_ptr;
+  res->size         = BTOR_PTR_HASH_MAP_INIT_SIZE;
+  res->entries_size = BTOR_PTR_HASH_MAP_INIT_SIZE / 2;
+  BTOR_CNEWN (mm, res->index, res->size);
+  BTOR_NEWN (mm, res->hashes, res->size);
+  BTOR_NEWN (mm, res->entries, res->entries_size);
+  return res;
+}
+
+BtorPtrHashMap *
+btor_hashptrmap_clone (BtorMemMgr *mm,
+                       BtorPtrHashMap *map,
+                       BtorCloneKeyPtr ckey,
+                       BtorCloneDataPtr cdata,
+                       const void *key_map,
+                       const void *data_map)
+{
+  assert (mm);
+  assert (ckey);
+
+  BtorPtrHashMap *res;
+  BtorPtrHashMapEntry *e, *ce;
+  uint32_t i;
+
+  if (!map) return 0;
+
+  res = btor_hashptrmap_new (mm, map->hash, map->cmp);
+  BTOR_REALLOC (mm, res->entries, res->entries_size, map->entries_size);
+  res->entries_size = map->entries_size;
+  if (res->size != map->size)
+  {
+    BTOR_DELETEN (mm, res->index, res->size);
+    BTOR_DELETEN (mm, res->hashes, res->size);
+    res->size = map->size;
+    BTOR_CNEWN (mm, res->index, res->size);
+    BTOR_NEWN (mm, res->hashes, res->size);
+  }
+
+  for (i = 0; i < map->num_entries; i++)
+  {
+    e = map->entries + i;
+    if (!e->key) continue;
+    ce = btor_hashptrmap_add (res, ckey (mm, key_map, e->key));
+    if (!cdata)
+      assert (e->data.as_ptr == 0);
+    else
+      cdata (mm, data_map, &e->data, &ce->data);
+  }
+  assert (res->count == map->count);
+  assert (res->size == map->size);
+  assert (res->entries_size == map->entries_size);
+  return res;
+}
+
+void
+btor_hashptrmap_delete (BtorPtrHashMap *map)
+{
+  assert (map);
+  BTOR_DELETEN (map->mm, map->index, map->size);
+  BTOR_DELETEN (map->mm, map->hashes, map->size);
+  BTOR_DELETEN (map->mm, map->entries, map->entries_size);
+  BTOR_DELETE (map->mm, map);
+}
+
+size_t
+btor_hashptrmap_size (const BtorPtrHashMap *map)
+{
+  assert (map);
+  return sizeof (*map) + map->size * (sizeof (uint32_t) + sizeof (uint32_t))
+         + map->entries_size * sizeof (BtorPtrHashMapEntry);
+}
+
+BtorPtrHashMapEntry *
+btor_hashptrmap_get (BtorPtrHashMap *map, const void *key)
+{
+  assert (map);
+  assert (key);
+
+  uint32_t pos;
+
+  if (!map->count) return 0;
+  pos = index_find (map, key, mix (map->hash (key)));
+  if (pos == map->size) return 0;
+  return map->entries + map->index[pos] - 1;
+}
+
+BtorPtrHashMapEntry *
+btor_hashptrmap_add (BtorPtrHashMap *map, void *key)
+{
+  assert (map);
+  assert (key);
+  assert (!btor_hashptrmap_get (map, key));
+
+  BtorPtrHashMapEntry *res;
+  uint32_t new_size;
+
+  /* keep load factor of the index <= 3/4 */
+  if (4 * (map->count + 1) > 3 * map->size) rehash (map, 2 * map->size);
+
+  if (map->num_entries == map->entries_size)
+  {
+    /* drop removed entries if at least half of the entries are removed,
+     * otherwise grow the entries array */
+    if (2 * map->count <= map->num_entries)
+      rehash (map, map->size);
+    else
+    {
+      new_size = 2 * map->entries_size;
+      BTOR_REALLOC (map->mm, map->entries, map->entries_size, new_size);
+      map->entries_size = new_size;
+    }
+  }
+  assert (map->num_entries < map->entries_size);
+
+  res = map->entries + map->num_entries;
+  index_insert (map, map->num_entries, mix (map->hash (key)));
+  map->num_entries += 1;
+  map->count += 1;
+  res->key = key;
+  BTOR_CLR (&res->data);
+  return res;
+}
+
+void
+btor_hashptrmap_remove (BtorPtrHashMap *map,
+                        void *key,
+                        void **stored_key_ptr,
+                        BtorHashTableData *stored_data_ptr)
+{
+  assert (map);
+  assert (key);
+
+  uint32_t i, j, mask;
+  BtorPtrHashMapEntry *e;
+
+  i = index_find (map, key, mix (map->hash (key)));
+  assert (i < map->size);
+  e = map->entries + map->index[i] - 1;
+
+  if (stored_key_ptr) *stored_key_ptr = e->key;
+  if (stored_data_ptr) *stored_data_ptr = e->data;
+  e->key = 0;
+  BTOR_CLR (&e->data);
+  assert (map->count > 0);
+  map->count -= 1;
+
+  /* backward shift deletion */
+  mask = map->size - 1;
+  for (j = (i + 1) & mask; map->index[j] && probe_dist (map, j) > 0;
+       i = j, j = (j + 1) & mask)
+  {
+    map->index[i]  = map->index[j];
+    map->hashes[i] = map->hashes[j];
+  }
+  map->index[i] = 0;
+}
+
+/*------------------------------------------------------------------------*/
+/* iterators                                                              */
+/*------------------------------------------------------------------------*/
+
+/* Find the next non-removed entry starting from the current position of the
+ * iterator, returns false if there is no such entry. */
+static bool
+iter_find (const BtorPtrHashMapIterator *it, uint8_t *pos, int64_t *cur_pos)
+{
+  const BtorPtrHashMap *map;
+  uint8_t p = it->pos;
+  int64_t c = it->cur_pos;
+
+  while (p < it->num_queued)
+  {
+    map = it->stack[p];
+    if (it->reversed)
+    {
+      for (; c >= 0 && !map->entries[c].key; c--)
+        ;
+      if (c >= 0) break;
+    }
+    else
+    {
+      for (; c < map->num_entries && !map->entries[c].key; c++)
+        ;
+      if (c < map->num_entries) break;
+    }
+    p += 1;
+    if (p < it->num_queued)
+      c = it->reversed ? (int64_t) it->stack[p]->num_entries - 1 : 0;
+  }
+  *pos     = p;
+  *cur_pos = c;
+  return p < it->num_queued;
+}
+
+void
+btor_iter_hashptrmap_init (BtorPtrHashMapIterator *it,
+                           const BtorPtrHashMap *map)
+{
+  assert (it);
+  assert (map);
+
+  it->cur_pos    = 0;
+  it->reversed   = false;
+  it->num_queued = 1;
+  it->pos        = 0;
+  it->stack[0]   = map;
+}
+
+void
+btor_iter_hashptrmap_init_reversed (BtorPtrHashMapIterator *it,
+                                    const BtorPtrHashMap *map)
+{
+  assert (it);
+  assert (map);
+
+  it->cur_pos    = (int64_t) map->num_entries - 1;
+  it->reversed   = true;
+  it->num_queued = 1;
+  it->pos        = 0;
+  it->stack[0]   = map;
+}
+
+void
+btor_iter_hashptrmap_queue (BtorPtrHashMapIterator *it,
+                            const BtorPtrHashMap *map)
+{
+  assert (it);
+  assert (map);
+  assert (it->num_queued < BTOR_PTR_HASH_MAP_ITERATOR_STACK_SIZE);
+
+  it->stack[it->num_queued++] = map;
+}
+
+bool
+btor_iter_hashptrmap_has_next (const BtorPtrHashMapIterator *it)
+{
+  assert (it);
+
+  uint8_t pos;
+  int64_t cur_pos;
+  return iter_find (it, &pos, &cur_pos);
+}
+
+BtorPtrHashMapEntry *
+btor_iter_hashptrmap_next_entry (BtorPtrHashMapIterator *it)
+{
+  assert (it);
+
+  BtorPtrHashMapEntry *e;
+  bool found;
+
+  found = iter_find (it, &it->pos, &it->cur_pos);
+  assert (found);
+  (void) found;
+  e = it->stack[it->pos]->entries + it->cur_pos;
+  it->cur_pos += it->reversed ? -1 : 1;
+  return e;
+}
+
+void *
+btor_iter_hashptrmap_next (BtorPtrHashMapIterator *it)
+{
+  assert (it);
+  return btor_iter_hashptrmap_next_entry (it)->key;
+}
+
+BtorHashTableData *
+btor_iter_hashptrmap_next_data (BtorPtrHashMapIterator *it)
+{
+  assert (it);
+  return &btor_iter_hashptrmap_next_entry (it)->data;
+}
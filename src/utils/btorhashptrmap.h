@@ -0,0 +1,116 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTOR_PTR_HASH_MAP_H_INCLUDED
+#define BTOR_PTR_HASH_MAP_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "utils/btorhash.h"
+#include "utils/btorhashptr.h"
+#include "utils/btormem.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Open addressing (Robin Hood) hash map from pointers to BtorHashTableData.
+ * Entries are stored in insertion order in a dense array, the index only
+ * holds positions in that array. Compared to BtorPtrHashTable there is no
+ * per-entry allocation and no chronological/collision chain pointers.
+ * Each entry takes sizeof (BtorPtrHashMapEntry) bytes (24 on 64-bit hosts)
+ * and each index slot 8 bytes (position and hash value), the index is kept
+ * at most three quarters full.
+ *
+ * Pointers to entries returned by 'get' and 'add' are only valid until the
+ * next call to 'add'. Entries may be removed while iterating, adding entries
+ * while iterating is not supported. */
+
+typedef struct BtorPtrHashMap BtorPtrHashMap;
+typedef struct BtorPtrHashMapEntry BtorPtrHashMapEntry;
+
+struct BtorPtrHashMapEntry
+{
+  void *key;
+  BtorHashTableData data;
+};
+
+struct BtorPtrHashMap
+{
+  BtorMemMgr *mm;
+
+  uint32_t count;       /* number of entries */
+  uint32_t size;        /* size of the index (power of 2) */
+  uint32_t num_entries; /* used entries (including removed) */
+  uint32_t entries_size;
+  BtorPtrHashMapEntry *entries; /* in insertion order */
+  uint32_t *index;              /* position + 1 in 'entries', 0 if empty */
+  uint32_t *hashes;             /* hash values of indexed keys */
+
+  BtorHashPtr hash;
+  BtorCmpPtr cmp;
+};
+
+/*------------------------------------------------------------------------*/
+
+BtorPtrHashMap *btor_hashptrmap_new (BtorMemMgr *mm,
+                                     BtorHashPtr hash,
+                                     BtorCmpPtr cmp);
+
+/* Clone hash map, see btor_hashptr_table_clone. */
+BtorPtrHashMap *btor_hashptrmap_clone (BtorMemMgr *mm,
+                                       BtorPtrHashMap *map,
+                                       BtorCloneKeyPtr ckey,
+                                       BtorCloneDataPtr cdata,
+                                       const void *key_map,
+                                       const void *data_map);
+
+void btor_hashptrmap_delete (BtorPtrHashMap *map);
+
+/* Returns the size of the hash map in Byte. */
+size_t btor_hashptrmap_size (const BtorPtrHashMap *map);
+
+BtorPtrHashMapEntry *btor_hashptrmap_get (BtorPtrHashMap *map,
+                                          const void *key);
+
+/* Add 'key', which must not be in the map yet. */
+BtorPtrHashMapEntry *btor_hashptrmap_add (BtorPtrHashMap *map, void *key);
+
+/* Remove 'key', which must be in the map. If 'stored_key_ptr' resp.
+ * 'stored_data_ptr' is non zero, the key resp. data of the removed entry is
+ * copied to this location. */
+void btor_hashptrmap_remove (BtorPtrHashMap *map,
+                             void *key,
+                             void **stored_key_ptr,
+                             BtorHashTableData *stored_data_ptr);
+
+/*------------------------------------------------------------------------*/
+/* iterators                                                              */
+/*------------------------------------------------------------------------*/
+
+#define BTOR_PTR_HASH_MAP_ITERATOR_STACK_SIZE 8
+
+typedef struct BtorPtrHashMapIterator
+{
+  int64_t cur_pos;
+  bool reversed;
+  uint8_t num_queued;
+  uint8_t pos;
+  const BtorPtrHashMap *stack[BTOR_PTR_HASH_MAP_ITERATOR_STACK_SIZE];
+} BtorPtrHashMapIterator;
+
+void btor_iter_hashptrmap_init (BtorPtrHashMapIterator *it,
+                                const BtorPtrHashMap *map);
+void btor_iter_hashptrmap_init_reversed (BtorPtrHashMapIterator *it,
+                                         const BtorPtrHashMap *map);
+void btor_iter_hashptrmap_queue (BtorPtrHashMapIterator *it,
+                                 const BtorPtrHashMap *map);
+bool btor_iter_hashptrmap_has_next (const BtorPtrHashMapIterator *it);
+void *btor_iter_hashptrmap_next (BtorPtrHashMapIterator *it);
+BtorHashTableData *btor_iter_hashptrmap_next_data (BtorPtrHashMapIterator *it);
+BtorPtrHashMapEntry *btor_iter_hashptrmap_next_entry (
+    BtorPtrHashMapIterator *it);
+
+/*------------------------------------------------------------------------*/
+#endif
@@ -27,11 +27,28 @@
     if (mm->maxallocated < mm->allocated) mm->maxallocated = mm->allocated; \
   } while (0)
 
-#define SAT_ADJUST()                              \
-  do                                              \
-  {                                               \
-    if (mm->sat_maxallocated < mm->sat_allocated) \
-      mm->sat_maxallocated = mm->sat_allocated;   \
+/* SAT solver memory is accounted atomically since the instances of a SAT
+ * solver portfolio (see sat/btorportfolio.c) allocate concurrently. */
+
+#define SAT_ADD(size) \
+  __atomic_add_fetch (&mm->sat_allocated, (size), __ATOMIC_RELAXED)
+
+#define SAT_SUB(size) \
+  __atomic_sub_fetch (&mm->sat_allocated, (size), __ATOMIC_RELAXED)
+
+#define SAT_ADJUST(allocated)                                              \
+  do                                                                       \
+  {                                                                        \
+    size_t cur = (allocated);                                              \
+    size_t max = __atomic_load_n (&mm->sat_maxallocated, __ATOMIC_RELAXED); \
+    while (max < cur                                                       \
+           && !__atomic_compare_exchange_n (&mm->sat_maxallocated,         \
+                                            &max,                          \
+                                            cur,                           \
+                                            true,                          \
+                                            __ATOMIC_RELAXED,              \
+                                            __ATOMIC_RELAXED))             \
+      ;                                                                    \
   } while (0)
 
 /*------------------------------------------------------------------------*/
@@ -52,6 +69,111 @@
   } while (0)
 #endif
 
+/*------------------------------------------------------------------------*/
+/* Size-class slab pool. Objects of at most BTOR_MEM_POOL_MAX_SIZE bytes are
+ * rounded up to a multiple of BTOR_MEM_POOL_GRAIN bytes and carved out of
+ * slabs of BTOR_MEM_SLAB_SIZE bytes that each hold objects of a single size
+ * class. Freed objects are kept on a per-class free list.
+ */
+
+#define BTOR_MEM_SLAB_SIZE ((size_t) 1 << 14)
+#define BTOR_MEM_POOL_GRAIN 16
+#define BTOR_MEM_POOL_NUM_CLASSES (BTOR_MEM_POOL_MAX_SIZE / BTOR_MEM_POOL_GRAIN)
+
+#define BTOR_MEM_SIZE_CLASS(size) (((size) - 1) / BTOR_MEM_POOL_GRAIN)
+#define BTOR_MEM_CLASS_SIZE(c) (((c) + 1) * BTOR_MEM_POOL_GRAIN)
+
+/* Header at the beginning of each slab, slabs are aligned to their size in
+ * order to find the header of an object in debug mode. */
+struct BtorMemSlab
+{
+  struct BtorMemSlab *next;
+  BtorMemMgr *mm;
+  uint32_t size_class;
+};
+
+typedef struct BtorMemSlab BtorMemSlab;
+
+#define BTOR_MEM_SLAB_HEADER_SIZE 32
+
+struct BtorMemPool
+{
+  BtorMemSlab *slabs;
+  size_t num_slabs;
+  void *free[BTOR_MEM_POOL_NUM_CLASSES];
+  char *cur[BTOR_MEM_POOL_NUM_CLASSES];
+  char *end[BTOR_MEM_POOL_NUM_CLASSES];
+};
+
+typedef struct BtorMemPool BtorMemPool;
+
+static void *
+pool_new_slab (BtorMemMgr *mm, uint32_t c)
+{
+  BtorMemPool *pool = mm->pool;
+  BtorMemSlab *slab;
+  size_t size = BTOR_MEM_CLASS_SIZE (c);
+  void *mem   = 0;
+
+  assert (sizeof (BtorMemSlab) <= BTOR_MEM_SLAB_HEADER_SIZE);
+  BTOR_ABORT (posix_memalign (&mem, BTOR_MEM_SLAB_SIZE, BTOR_MEM_SLAB_SIZE),
+              "out of memory in 'btor_mem_malloc'");
+  slab             = mem;
+  slab->next       = pool->slabs;
+  slab->mm         = mm;
+  slab->size_class = c;
+  pool->slabs      = slab;
+  pool->num_slabs += 1;
+  pool->cur[c] = (char *) slab + BTOR_MEM_SLAB_HEADER_SIZE;
+  pool->end[c] = pool->cur[c]
+                 + (BTOR_MEM_SLAB_SIZE - BTOR_MEM_SLAB_HEADER_SIZE) / size * size;
+  return pool->cur[c];
+}
+
+static inline void *
+pool_malloc (BtorMemMgr *mm, size_t size)
+{
+  BtorMemPool *pool = mm->pool;
+  uint32_t c        = BTOR_MEM_SIZE_CLASS (size);
+  void *result;
+
+  assert (size > 0);
+  assert (size <= BTOR_MEM_POOL_MAX_SIZE);
+
+  if ((result = pool->free[c]))
+  {
+    pool->free[c] = *(void **) result;
+    return result;
+  }
+  result = pool->cur[c];
+  if (!result || pool->cur[c] == pool->end[c]) result = pool_new_slab (mm, c);
+  pool->cur[c] += BTOR_MEM_CLASS_SIZE (c);
+  return result;
+}
+
+static inline void
+pool_free (BtorMemMgr *mm, void *p, size_t size)
+{
+  BtorMemPool *pool = mm->pool;
+  uint32_t c        = BTOR_MEM_SIZE_CLASS (size);
+
+  assert (p);
+  assert (size > 0);
+  assert (size <= BTOR_MEM_POOL_MAX_SIZE);
+#ifndef NDEBUG
+  BtorMemSlab *slab =
+      (BtorMemSlab *) ((uintptr_t) p & ~(uintptr_t) (BTOR_MEM_SLAB_SIZE - 1));
+  assert (slab->mm == mm);
+  assert (slab->size_class == c);
+  memset (p, 0xa5, BTOR_MEM_CLASS_SIZE (c));
+#endif
+  *(void **) p  = pool->free[c];
+  pool->free[c] = p;
+}
+
+#define BTOR_MEM_POOLED(mm, size) \
+  ((mm)->pool && (size) <= BTOR_MEM_POOL_MAX_SIZE)
+
 /*------------------------------------------------------------------------*/
 
 BtorMemMgr *
@@ -63,16 +185,36 @@ btor_mem_mgr_new (void)
   mm->maxallocated     = 0;
   mm->sat_allocated    = 0;
   mm->sat_maxallocated = 0;
+  mm->pool             = 0;
+  return mm;
+}
+
+BtorMemMgr *
+btor_mem_mgr_new_pooled (void)
+{
+  BtorMemMgr *mm = btor_mem_mgr_new ();
+  mm->pool       = (BtorMemPool *) calloc (1, sizeof (BtorMemPool));
+  BTOR_ABORT (!mm->pool, "out of memory in 'btor_mem_mgr_new_pooled'");
   return mm;
 }
 
+size_t
+btor_mem_mgr_num_slabs (BtorMemMgr *mm)
+{
+  assert (mm);
+  return mm->pool ? mm->pool->num_slabs : 0;
+}
+
 void *
 btor_mem_malloc (BtorMemMgr *mm, size_t size)
 {
   void *result;
   if (!size) return 0;
   assert (mm);
-  result = malloc (size);
+  if (BTOR_MEM_POOLED (mm, size))
+    result = pool_malloc (mm, size);
+  else
+    result = malloc (size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_malloc'");
   mm->allocated += size;
   ADJUST ();
@@ -88,8 +230,7 @@ btor_mem_sat_malloc (BtorMemMgr *mm, size_t size)
   assert (mm);
   result = malloc (size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_sat_malloc'");
-  mm->sat_allocated += size;
-  SAT_ADJUST ();
+  SAT_ADJUST (SAT_ADD (size));
   return result;
 }
 
@@ -101,7 +242,26 @@ btor_mem_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
   assert (!p == !old_size);
   assert (mm->allocated >= old_size);
   BTOR_LOG_MEM ("%p free   %10ld (realloc)\n", p, old_size);
-  result = realloc (p, new_size);
+  if (BTOR_MEM_POOLED (mm, old_size) || BTOR_MEM_POOLED (mm, new_size))
+  {
+    if (p && new_size
+        && BTOR_MEM_POOLED (mm, old_size) && BTOR_MEM_POOLED (mm, new_size)
+        && BTOR_MEM_SIZE_CLASS (old_size) == BTOR_MEM_SIZE_CLASS (new_size))
+      result = p;
+    else
+    {
+      result = btor_mem_malloc (mm, new_size);
+      if (p)
+      {
+        memcpy (result, p, old_size < new_size ? old_size : new_size);
+        btor_mem_free (mm, p, old_size);
+      }
+      mm->allocated += old_size;
+      mm->allocated -= new_size;
+    }
+  }
+  else
+    result = realloc (p, new_size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_realloc'");
   mm->allocated -= old_size;
   mm->allocated += new_size;
@@ -119,9 +279,8 @@ btor_mem_sat_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
   assert (mm->sat_allocated >= old_size);
   result = realloc (p, new_size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_sat_realloc'");
-  mm->sat_allocated -= old_size;
-  mm->sat_allocated += new_size;
-  SAT_ADJUST ();
+  SAT_SUB (old_size);
+  SAT_ADJUST (SAT_ADD (new_size));
   return result;
 }
 
@@ -131,7 +290,13 @@ btor_mem_calloc (BtorMemMgr *mm, size_t nobj, size_t size)
   size_t bytes = nobj * size;
   void *result;
   assert (mm);
-  result = calloc (nobj, size);
+  if (bytes && BTOR_MEM_POOLED (mm, bytes))
+  {
+    result = pool_malloc (mm, bytes);
+    memset (result, 0, bytes);
+  }
+  else
+    result = calloc (nobj, size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_calloc'");
   mm->allocated += bytes;
   ADJUST ();
@@ -147,14 +312,17 @@ btor_mem_free (BtorMemMgr *mm, void *p, size_t freed)
   assert (mm->allocated >= freed);
   mm->allocated -= freed;
   BTOR_LOG_MEM ("%p free   %10ld\n", p, freed);
-  free (p);
+  if (p && BTOR_MEM_POOLED (mm, freed))
+    pool_free (mm, p, freed);
+  else
+    free (p);
 }
 
 void
 btor_mem_sat_free (BtorMemMgr *mm, void *p, size_t freed)
 {
   assert (mm);
-  if (p) mm->sat_allocated -= freed;
+  if (p) SAT_SUB (freed);
   free (p);
 }
 
@@ -185,6 +353,16 @@ btor_mem_mgr_delete (BtorMemMgr *mm)
 {
   assert (mm);
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKMEM") || !mm->allocated);
+  if (mm->pool)
+  {
+    BtorMemSlab *slab, *next;
+    for (slab = mm->pool->slabs; slab; slab = next)
+    {
+      next = slab->next;
+      free (slab);
+    }
+    free (mm->pool);
+  }
   free (mm);
 }
 
@@ -73,6 +73,7 @@ struct BtorMemMgr
   size_t maxallocated;
   size_t sat_allocated;
   size_t sat_maxallocated;
+  struct BtorMemPool *pool;
 };
 
 typedef struct BtorMemMgr BtorMemMgr;
@@ -81,6 +82,18 @@ typedef struct BtorMemMgr BtorMemMgr;
 
 BtorMemMgr *btor_mem_mgr_new (void);
 
+/* Create a memory manager that serves (non-SAT) allocations of at most
+ * BTOR_MEM_POOL_MAX_SIZE bytes from per-size-class slabs. Freed objects are
+ * recycled within their size class, slabs are only released (in bulk) on
+ * 'btor_mem_mgr_delete'. Memory allocated with a pooled memory manager must
+ * be freed with the same manager and the same size. */
+BtorMemMgr *btor_mem_mgr_new_pooled (void);
+
+#define BTOR_MEM_POOL_MAX_SIZE 256
+
+/* Number of slabs allocated by a pooled memory manager. */
+size_t btor_mem_mgr_num_slabs (BtorMemMgr *mm);
+
 void btor_mem_mgr_delete (BtorMemMgr *mm);
 
 void *btor_mem_sat_malloc (BtorMemMgr *mm, size_t size);
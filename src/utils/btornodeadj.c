@@ -0,0 +1,73 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "utils/btornodeadj.h"
+#include "btorcore.h"
+#include "utils/btornodeiter.h"
+
+/*------------------------------------------------------------------------*/
+
+BtorNodeAdj *
+btor_node_adj_new (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j, num_ids, num_edges;
+  BtorNode *cur;
+  BtorNodeAdj *res;
+  BtorNodeIterator it;
+  BtorMemMgr *mm;
+
+  mm      = btor->mm;
+  num_ids = BTOR_COUNT_STACK (btor->nodes_id_table);
+
+  BTOR_CNEW (mm, res);
+  res->mm      = mm;
+  res->num_ids = num_ids;
+  BTOR_CNEWN (mm, res->start, num_ids + 1);
+
+  /* count parents, the number of parents is maintained for every node */
+  num_edges = 0;
+  for (i = 1; i < num_ids; i++)
+  {
+    res->start[i] = num_edges;
+    cur           = BTOR_PEEK_STACK (btor->nodes_id_table, i);
+    if (cur) num_edges += cur->parents;
+  }
+  res->start[num_ids] = num_edges;
+  res->num_edges      = num_edges;
+
+  /* fill in parent ids */
+  if (num_edges) BTOR_NEWN (mm, res->parents, num_edges);
+  for (i = 1; i < num_ids; i++)
+  {
+    cur = BTOR_PEEK_STACK (btor->nodes_id_table, i);
+    if (!cur) continue;
+    j = res->start[i];
+    btor_iter_parent_init (&it, cur);
+    while (btor_iter_parent_has_next (&it))
+    {
+      assert (j < res->start[i + 1]);
+      res->parents[j++] = btor_node_get_id (btor_iter_parent_next (&it));
+    }
+    assert (j == res->start[i + 1]);
+  }
+
+  return res;
+}
+
+void
+btor_node_adj_delete (BtorNodeAdj *adj)
+{
+  assert (adj);
+
+  BtorMemMgr *mm = adj->mm;
+
+  BTOR_DELETEN (mm, adj->start, adj->num_ids + 1);
+  if (adj->parents) BTOR_DELETEN (mm, adj->parents, adj->num_edges);
+  BTOR_DELETE (mm, adj);
+}
+
@@ -0,0 +1,62 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORNODEADJ_H_INCLUDED
+#define BTORNODEADJ_H_INCLUDED
+
+#include <assert.h>
+#include <stdint.h>
+#include "btortypes.h"
+#include "utils/btormem.h"
+
+/*------------------------------------------------------------------------*/
+/* Compressed sparse row (CSR) snapshot of the parent relation of all nodes.
+ * The (regular) ids of the parents of the node with id 'id' are stored
+ * contiguously in 'parents[start[id]]' ... 'parents[start[id + 1] - 1]',
+ * in the same order as in the parent list of the node.  The snapshot is only
+ * valid as long as no nodes are created or deleted, hence it is intended to
+ * be built once per sat call by engines that do not modify the formula, and
+ * used by traversals that frequently walk up a cone of influence.
+ */
+struct BtorNodeAdj
+{
+  BtorMemMgr *mm;
+  uint32_t num_ids;   /* number of covered node ids (max. id + 1) */
+  uint32_t *start;    /* num_ids + 1 offsets into 'parents' */
+  int32_t *parents;   /* parent ids */
+  uint32_t num_edges; /* number of parents in total */
+};
+
+typedef struct BtorNodeAdj BtorNodeAdj;
+
+/*------------------------------------------------------------------------*/
+
+BtorNodeAdj *btor_node_adj_new (Btor *btor);
+void btor_node_adj_delete (BtorNodeAdj *adj);
+
+/*------------------------------------------------------------------------*/
+
+/* Get the number of parents of node with id 'id'. */
+static inline uint32_t
+btor_node_adj_get_num_parents (const BtorNodeAdj *adj, int32_t id)
+{
+  assert (adj);
+  assert (id > 0);
+  assert ((uint32_t) id < adj->num_ids);
+  return adj->start[id + 1] - adj->start[id];
+}
+
+/* Get the parent ids of node with id 'id'. */
+static inline const int32_t *
+btor_node_adj_get_parents (const BtorNodeAdj *adj, int32_t id)
+{
+  assert (adj);
+  assert (id > 0);
+  assert ((uint32_t) id < adj->num_ids);
+  return adj->parents + adj->start[id];
+}
+
+#endif
@@ -20,7 +20,9 @@ btor_iter_apply_parent_init (BtorNodeIterator *it, const BtorNode *exp)
 {
   assert (it);
   assert (exp);
-  it->cur = btor_node_real_addr (btor_node_real_addr (exp)->last_parent);
+  it->btor = btor_node_real_addr (exp)->btor;
+  it->cur  = btor_node_real_addr (btor_node_get_parent_by_id (
+      it->btor, btor_node_real_addr (exp)->last_parent));
 }
 
 bool
@@ -39,7 +41,8 @@ btor_iter_apply_parent_next (BtorNodeIterator *it)
   assert (it);
   result = it->cur;
   assert (result);
-  it->cur = btor_node_real_addr (BTOR_PREV_PARENT (result));
+  it->cur = btor_node_real_addr (
+      btor_node_get_parent_by_id (it->btor, BTOR_PREV_PARENT (result)));
   assert (btor_node_is_regular (result));
   assert (btor_node_is_apply (result));
   return result;
@@ -52,7 +55,9 @@ btor_iter_parent_init (BtorNodeIterator *it, const BtorNode *exp)
 {
   assert (it);
   assert (exp);
-  it->cur = btor_node_real_addr (exp)->first_parent;
+  it->btor = btor_node_real_addr (exp)->btor;
+  it->cur  = btor_node_get_parent_by_id (
+      it->btor, btor_node_real_addr (exp)->first_parent);
 }
 
 bool
@@ -70,7 +75,7 @@ btor_iter_parent_next (BtorNodeIterator *it)
   BtorNode *result;
   result = it->cur;
   assert (result);
-  it->cur = BTOR_NEXT_PARENT (result);
+  it->cur = btor_node_get_parent_by_id (it->btor, BTOR_NEXT_PARENT (result));
 
   return btor_node_real_addr (result);
 }
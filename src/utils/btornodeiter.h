@@ -34,6 +34,28 @@ typedef struct BtorNodeIterator
 #define BTOR_PREV_PARENT(exp) \
   (btor_node_real_addr (exp)->prev_parent[btor_node_get_tag (exp)])
 
+/* Get the tagged id of 'parent' with child at position 'pos', as stored in
+ * the parent lists. */
+static inline uint32_t
+btor_node_get_parent_id (const BtorNode *parent, uint32_t pos)
+{
+  assert (btor_node_is_regular (parent));
+  assert (parent->id > 0);
+  assert (pos <= 2);
+  return ((uint32_t) parent->id << 2) | pos;
+}
+
+/* Get the tagged parent for tagged id 'parent_id' (0 if 'parent_id' is 0). */
+static inline BtorNode *
+btor_node_get_parent_by_id (const Btor *btor, uint32_t parent_id)
+{
+  assert (btor);
+  if (!parent_id) return 0;
+  assert ((parent_id >> 2) < BTOR_COUNT_STACK (btor->nodes_id_table));
+  return btor_node_set_tag (
+      BTOR_PEEK_STACK (btor->nodes_id_table, parent_id >> 2), parent_id & 3);
+}
+
 void btor_iter_apply_parent_init (BtorNodeIterator *it, const BtorNode *exp);
 bool btor_iter_apply_parent_has_next (const BtorNodeIterator *it);
 BtorNode *btor_iter_apply_parent_next (BtorNodeIterator *it);
@@ -10,6 +10,8 @@
 
 #include "testaig.h"
 #include "btoraig.h"
+#include "btoraigopt.h"
+#include "btoraigsim.h"
 #include "btorcore.h"
 #include "btormsg.h"
 #include "btorsat.h"
@@ -163,6 +165,209 @@ test_aig_to_sat (void)
   btor_aig_mgr_delete (amgr);
 }
 
+static bool
+eval_aig (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIG **vars, uint32_t bits)
+{
+  BtorAIG *real_aig;
+  uint32_t i;
+  bool res;
+
+  if (btor_aig_is_const (aig)) return btor_aig_is_true (aig);
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (btor_aig_is_var (real_aig))
+  {
+    for (i = 0; vars[i] != real_aig; i++)
+      ;
+    res = (bits >> i) & 1;
+  }
+  else
+    res = eval_aig (amgr, btor_aig_get_left_child (amgr, real_aig), vars, bits)
+          && eval_aig (
+              amgr, btor_aig_get_right_child (amgr, real_aig), vars, bits);
+  return BTOR_IS_INVERTED_AIG (aig) ? !res : res;
+}
+
+static void
+test_aig_optimize (void)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (g_btor);
+  BtorAIG *vars[3], *and1, *and2, *roots[2];
+  uint32_t i, bits;
+  bool val[2][8];
+
+  btor_opt_set (g_btor, BTOR_OPT_AIG_REWRITE, 1);
+  for (i = 0; i < 3; i++) vars[i] = btor_aig_var (amgr);
+  /* (a & b) | (a & c) can be represented with 2 instead of 3 ANDs */
+  and1     = btor_aig_and (amgr, vars[0], vars[1]);
+  and2     = btor_aig_and (amgr, vars[0], vars[2]);
+  roots[0] = btor_aig_or (amgr, and1, and2);
+  roots[1] = btor_aig_not (amgr, roots[0]);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  assert (amgr->cur_num_aigs == 3);
+
+  for (bits = 0; bits < 8; bits++)
+    for (i = 0; i < 2; i++)
+      val[i][bits] = eval_aig (amgr, roots[i], vars, bits);
+  btor_aig_optimize (amgr, roots, 2);
+  assert (amgr->cur_num_aigs == 2);
+  assert (amgr->num_opt_saved == 1);
+  for (bits = 0; bits < 8; bits++)
+    for (i = 0; i < 2; i++)
+      assert (val[i][bits] == eval_aig (amgr, roots[i], vars, bits));
+
+  for (i = 0; i < 2; i++) btor_aig_release (amgr, roots[i]);
+  for (i = 0; i < 3; i++) btor_aig_release (amgr, vars[i]);
+  btor_aig_mgr_delete (amgr);
+  btor_opt_set (g_btor, BTOR_OPT_AIG_REWRITE, 0);
+}
+
+static void
+test_aig_fraig (void)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (g_btor);
+  BtorAIG *vars[3], *and1, *and2, *or, *roots[3];
+  uint32_t i;
+
+  btor_opt_set (g_btor, BTOR_OPT_AIG_FRAIG, 1);
+  for (i = 0; i < 3; i++) vars[i] = btor_aig_var (amgr);
+  /* a & (b | c) */
+  or       = btor_aig_or (amgr, vars[1], vars[2]);
+  roots[0] = btor_aig_and (amgr, vars[0], or);
+  btor_aig_release (amgr, or);
+  /* (a & b) | (a & c) */
+  and1     = btor_aig_and (amgr, vars[0], vars[1]);
+  and2     = btor_aig_and (amgr, vars[0], vars[2]);
+  roots[1] = btor_aig_or (amgr, and1, and2);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  /* miter */
+  roots[2] = BTOR_INVERT_AIG (btor_aig_eq (amgr, roots[0], roots[1]));
+  assert (roots[0] != roots[1]);
+  assert (roots[2] != BTOR_AIG_FALSE);
+
+  btor_aig_optimize (amgr, roots, 3);
+  assert (roots[0] == roots[1]);
+  assert (roots[2] == BTOR_AIG_FALSE);
+  assert (amgr->num_fraig_merges > 0);
+  assert (amgr->cur_num_aigs == 3);
+
+  for (i = 0; i < 3; i++) btor_aig_release (amgr, roots[i]);
+  for (i = 0; i < 3; i++) btor_aig_release (amgr, vars[i]);
+  btor_aig_mgr_delete (amgr);
+  btor_opt_set (g_btor, BTOR_OPT_AIG_FRAIG, 0);
+}
+
+/* Assert 'root' (or its negation if 'neg') and the assignment 'bits' of the
+ * variables and check the result and model against the evaluation of all
+ * roots. Returns the number of generated clauses. */
+static uint_least64_t
+check_aig_to_sat_pg (uint32_t bits, uint32_t root, bool neg)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (g_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *vars[3], *and1, *roots[4], *lit;
+  BtorSolverResult res;
+  uint_least64_t num_clauses;
+  uint32_t i;
+  bool val;
+
+  for (i = 0; i < 3; i++) vars[i] = btor_aig_var (amgr);
+  and1     = btor_aig_and (amgr, vars[0], BTOR_INVERT_AIG (vars[1]));
+  roots[0] = btor_aig_or (amgr, and1, vars[2]);
+  roots[1] = btor_aig_cond (amgr, vars[0], vars[1], vars[2]);
+  roots[2] = BTOR_INVERT_AIG (btor_aig_eq (amgr, and1, vars[2]));
+  roots[3] = btor_aig_and (amgr, roots[0], roots[2]);
+  btor_aig_release (amgr, and1);
+
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  lit = neg ? BTOR_INVERT_AIG (roots[root]) : roots[root];
+  btor_aig_add_toplevel_to_sat (amgr, lit);
+  for (i = 0; i < 3; i++)
+    btor_aig_add_toplevel_to_sat (
+        amgr, (bits >> i) & 1 ? vars[i] : BTOR_INVERT_AIG (vars[i]));
+  res = btor_sat_check_sat (smgr, -1);
+  assert ((res == BTOR_RESULT_SAT) == eval_aig (amgr, lit, vars, bits));
+  if (res == BTOR_RESULT_SAT)
+  {
+    for (i = 0; i < 4; i++)
+    {
+      /* without polarity-aware encoding, roots that are not encoded are
+       * assigned to false */
+      if (!btor_opt_get (g_btor, BTOR_OPT_AIG_PG)
+          && !btor_aig_is_encoded (roots[i]))
+        continue;
+      val = eval_aig (amgr, roots[i], vars, bits);
+      assert (btor_aig_get_assignment (amgr, roots[i]) == (val ? 1 : -1));
+    }
+  }
+  num_clauses = amgr->num_cnf_clauses;
+  btor_sat_reset (smgr);
+
+  for (i = 0; i < 4; i++) btor_aig_release (amgr, roots[i]);
+  for (i = 0; i < 3; i++) btor_aig_release (amgr, vars[i]);
+  btor_aig_mgr_delete (amgr);
+  return num_clauses;
+}
+
+static void
+test_aig_to_sat_pg (void)
+{
+  uint_least64_t num_clauses;
+  uint32_t bits, root, neg;
+
+  for (bits = 0; bits < 8; bits++)
+    for (root = 0; root < 4; root++)
+      for (neg = 0; neg < 2; neg++)
+      {
+        num_clauses = check_aig_to_sat_pg (bits, root, neg);
+        btor_opt_set (g_btor, BTOR_OPT_AIG_PG, 1);
+        assert (check_aig_to_sat_pg (bits, root, neg) <= num_clauses);
+        btor_opt_set (g_btor, BTOR_OPT_AIG_PG, 0);
+      }
+}
+
+static void
+test_aig_sim (void)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (g_btor);
+  BtorAIG *vars[3], *and1, *roots[3];
+  BtorAIGSim *sim;
+  BtorRNG rng;
+  uint32_t i, j, w, bits;
+  uint64_t word;
+
+  for (i = 0; i < 3; i++) vars[i] = btor_aig_var (amgr);
+  and1     = btor_aig_and (amgr, vars[0], BTOR_INVERT_AIG (vars[1]));
+  roots[0] = btor_aig_or (amgr, and1, vars[2]);
+  roots[1] = btor_aig_eq (amgr, and1, vars[1]);
+  roots[2] = BTOR_AIG_TRUE;
+  btor_aig_release (amgr, and1);
+
+  btor_rng_init (&rng, 0);
+  sim = btor_aig_sim_new (amgr, roots, 3, 2, false);
+  assert (btor_aig_sim_num_nodes (sim) == 3 + amgr->cur_num_aigs);
+  btor_aig_sim_randomize (sim, &rng, 0, 2);
+  btor_aig_sim_run (sim, 0, 2);
+  for (w = 0; w < 2; w++)
+    for (j = 0; j < 64; j++)
+    {
+      for (i = 0, bits = 0; i < 3; i++)
+        bits |= ((btor_aig_sim_get_word (sim, vars[i], w) >> j) & 1) << i;
+      for (i = 0; i < 3; i++)
+      {
+        word = btor_aig_sim_get_word (sim, roots[i], w);
+        assert (((word >> j) & 1) == eval_aig (amgr, roots[i], vars, bits));
+      }
+    }
+  btor_aig_sim_delete (sim);
+
+  for (i = 0; i < 2; i++) btor_aig_release (amgr, roots[i]);
+  for (i = 0; i < 3; i++) btor_aig_release (amgr, vars[i]);
+  btor_aig_mgr_delete (amgr);
+}
+
 void
 run_aig_tests (int32_t argc, char **argv)
 {
@@ -176,6 +381,10 @@ run_aig_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST_CHECK_LOG (eq_aig);
   BTOR_RUN_TEST_CHECK_LOG (cond_aig);
   BTOR_RUN_TEST (aig_to_sat);
+  BTOR_RUN_TEST (aig_to_sat_pg);
+  BTOR_RUN_TEST (aig_optimize);
+  BTOR_RUN_TEST (aig_fraig);
+  BTOR_RUN_TEST (aig_sim);
 }
 
 void
@@ -9,6 +9,7 @@
  */
 
 #include "testaigvec.h"
+#include "btoraigsim.h"
 #include "btoraigvec.h"
 #include "btorbv.h"
 #include "btorcore.h"
@@ -225,6 +226,146 @@ test_mul_aigvec (void)
   btor_aigvec_mgr_delete (avmgr);
 }
 
+static uint32_t
+mul (uint32_t a, uint32_t b)
+{
+  return a * b;
+}
+
+static uint32_t
+add (uint32_t a, uint32_t b)
+{
+  return a + b;
+}
+
+static uint32_t
+ult (uint32_t a, uint32_t b)
+{
+  return a < b;
+}
+
+/* Check 'res' = 'op' ('a', 'b') for all assignments to the 2 * 'width'
+ * inputs of 'a' and 'b' ('b' may be constant 'c'). */
+static void
+check_binop_aigvec (BtorAIGVecMgr *avmgr,
+                    uint32_t (*op) (uint32_t, uint32_t),
+                    BtorAIGVec *a,
+                    BtorAIGVec *b,
+                    BtorAIGVec *res,
+                    uint32_t width,
+                    uint32_t c)
+{
+  BtorAIGSim *sim;
+  uint32_t i, p, num_words, pa, pb;
+  uint64_t mask;
+  int32_t pos;
+
+  num_words = (1u << (2 * width)) / 64 + 1;
+  sim = btor_aig_sim_new (
+      avmgr->amgr, res->aigs, res->width, num_words, false);
+  for (p = 0; p < 64 * num_words; p++)
+  {
+    pa = p & ((1u << width) - 1);
+    pb = (p >> width) & ((1u << width) - 1);
+    for (i = 0; i < width; i++)
+    {
+      pos = btor_aig_sim_get_pos (sim, a->aigs[width - 1 - i]);
+      if (pos >= 0 && ((pa >> i) & 1))
+        btor_aig_sim_get_words (sim, pos)[p / 64] |= UINT64_C (1) << (p % 64);
+      pos = btor_aig_sim_get_pos (sim, b->aigs[width - 1 - i]);
+      if (pos >= 0 && ((pb >> i) & 1))
+        btor_aig_sim_get_words (sim, pos)[p / 64] |= UINT64_C (1) << (p % 64);
+    }
+  }
+  btor_aig_sim_run (sim, 0, num_words);
+  for (p = 0; p < 64 * num_words; p++)
+  {
+    pa = p & ((1u << width) - 1);
+    pb = btor_aig_is_const (b->aigs[0]) ? c
+                                        : (p >> width) & ((1u << width) - 1);
+    for (i = 0; i < res->width; i++)
+    {
+      mask = btor_aig_sim_get_word (
+          sim, res->aigs[res->width - 1 - i], p / 64);
+      assert (((mask >> (p % 64)) & 1) == ((op (pa, pb) >> i) & 1));
+    }
+  }
+  btor_aig_sim_delete (sim);
+}
+
+static void
+test_mul_enc_aigvec (void)
+{
+  BtorAIGVecMgr *avmgr;
+  BtorAIGVec *a, *b, *cv, *res;
+  BtorBitVector *bv;
+  uint32_t width, c, enc, csd;
+
+  avmgr = btor_aigvec_mgr_new (g_btor);
+  for (width = 1; width <= 6; width++)
+  {
+    a = btor_aigvec_var (avmgr, width);
+    b = btor_aigvec_var (avmgr, width);
+    for (enc = BTOR_MUL_ENC_MIN + 1; enc < BTOR_MUL_ENC_MAX; enc++)
+    {
+      btor_opt_set (g_btor, BTOR_OPT_MUL_ENC, enc);
+      res = btor_aigvec_mul (avmgr, a, b);
+      check_binop_aigvec (avmgr, mul, a, b, res, width, 0);
+      btor_aigvec_release_delete (avmgr, res);
+      for (csd = 0; csd <= 1; csd++)
+      {
+        btor_opt_set (g_btor, BTOR_OPT_MUL_CSD, csd);
+        for (c = 0; c < (1u << width); c++)
+        {
+          bv  = btor_bv_uint64_to_bv (g_btor->mm, c, width);
+          cv  = btor_aigvec_const (avmgr, bv);
+          res = btor_aigvec_mul (avmgr, cv, a);
+          check_binop_aigvec (avmgr, mul, a, cv, res, width, c);
+          btor_aigvec_release_delete (avmgr, res);
+          btor_aigvec_release_delete (avmgr, cv);
+          btor_bv_free (g_btor->mm, bv);
+        }
+      }
+    }
+    btor_aigvec_release_delete (avmgr, a);
+    btor_aigvec_release_delete (avmgr, b);
+  }
+  btor_opt_set (g_btor, BTOR_OPT_MUL_ENC, BTOR_MUL_ENC_DFLT);
+  btor_opt_set (g_btor, BTOR_OPT_MUL_CSD, 0);
+  btor_aigvec_mgr_delete (avmgr);
+}
+
+static void
+test_prefix_aigvec (void)
+{
+  BtorAIGVecMgr *avmgr;
+  BtorAIGVec *a, *b, *res;
+  uint32_t width, enc;
+
+  avmgr = btor_aigvec_mgr_new (g_btor);
+  btor_opt_set (g_btor, BTOR_OPT_PREFIX_WIDTH, 1);
+  for (width = 1; width <= 6; width++)
+  {
+    a = btor_aigvec_var (avmgr, width);
+    b = btor_aigvec_var (avmgr, width);
+    for (enc = BTOR_PREFIX_ENC_MIN + 1; enc < BTOR_PREFIX_ENC_MAX; enc++)
+    {
+      btor_opt_set (g_btor, BTOR_OPT_PREFIX_ENC, enc);
+      res = btor_aigvec_add (avmgr, a, b);
+      check_binop_aigvec (avmgr, add, a, b, res, width, 0);
+      btor_aigvec_release_delete (avmgr, res);
+      res = btor_aigvec_ult (avmgr, a, b);
+      check_binop_aigvec (avmgr, ult, a, b, res, width, 0);
+      btor_aigvec_release_delete (avmgr, res);
+    }
+    btor_aigvec_release_delete (avmgr, a);
+    btor_aigvec_release_delete (avmgr, b);
+  }
+  btor_opt_set (g_btor, BTOR_OPT_PREFIX_WIDTH, 0);
+  btor_opt_set (g_btor, BTOR_OPT_PREFIX_ENC, BTOR_PREFIX_ENC_DFLT);
+  btor_aigvec_mgr_delete (avmgr);
+}
+
 static void
 test_udiv_aigvec (void)
 {
@@ -253,6 +394,31 @@ test_urem_aigvec (void)
   btor_aigvec_mgr_delete (avmgr);
 }
 
+static void
+test_udiv_urem_shared_aigvec (void)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (g_btor);
+  BtorAIGVec *av1      = btor_aigvec_var (avmgr, 32);
+  BtorAIGVec *av2      = btor_aigvec_var (avmgr, 32);
+  BtorAIGVec *av3      = btor_aigvec_udiv (avmgr, av1, av2);
+  uint_least64_t num_aigs = avmgr->amgr->cur_num_aigs;
+  BtorAIGVec *av4, *av5;
+  assert (avmgr->div_cache->count == 1);
+  av4 = btor_aigvec_urem (avmgr, av1, av2);
+  av5 = btor_aigvec_udiv (avmgr, av1, av2);
+  /* the divider is shared by all uses and stays in the cache */
+  assert (avmgr->amgr->cur_num_aigs == num_aigs);
+  assert (avmgr->div_cache->count == 1);
+  assert (av4->width == 32);
+  assert (av5->width == 32);
+  btor_aigvec_release_delete (avmgr, av1);
+  btor_aigvec_release_delete (avmgr, av2);
+  btor_aigvec_release_delete (avmgr, av3);
+  btor_aigvec_release_delete (avmgr, av4);
+  btor_aigvec_release_delete (avmgr, av5);
+  btor_aigvec_mgr_delete (avmgr);
+}
+
 static void
 test_concat_aigvec (void)
 {
@@ -299,8 +465,11 @@ run_aigvec_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST (sll_aigvec);
   BTOR_RUN_TEST (srl_aigvec);
   BTOR_RUN_TEST (mul_aigvec);
+  BTOR_RUN_TEST (mul_enc_aigvec);
+  BTOR_RUN_TEST (prefix_aigvec);
   BTOR_RUN_TEST (udiv_aigvec);
   BTOR_RUN_TEST (urem_aigvec);
+  BTOR_RUN_TEST (udiv_urem_shared_aigvec);
   BTOR_RUN_TEST (concat_aigvec);
   BTOR_RUN_TEST (cond_aigvec);
 }
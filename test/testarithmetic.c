@@ -11,6 +11,7 @@
 #include "testarithmetic.h"
 
 #include "boolector.h"
+#include "btoropt.h"
 #include "testrunner.h"
 #include "utils/btorutil.h"
 
@@ -296,6 +297,103 @@ test_urem_arithmetic (void)
       rem, "urem", BTOR_TEST_ARITHMETIC_LOW, BTOR_TEST_ARITHMETIC_HIGH, 0);
 }
 
+/* Check quotient and remainder of non-constant operands for both division
+ * encodings. */
+static void
+test_udiv_urem_enc_arithmetic (void)
+{
+  uint32_t enc;
+  const char *assignment;
+  BoolectorSort s;
+  BoolectorNode *a, *b, *q, *r, *zero, *ones, *tmp, *def, *def_zero, *c;
+
+  for (enc = BTOR_DIV_ENC_MIN + 1; enc < BTOR_DIV_ENC_MAX; enc++)
+  {
+    /* b = 0 ? q = ~0 & r = a : a = q * b + r & r < b is valid */
+    g_btor = boolector_new ();
+    boolector_set_opt (g_btor, BTOR_OPT_DIV_ENC, enc);
+    s        = boolector_bitvec_sort (g_btor, 6);
+    a        = boolector_var (g_btor, s, "a");
+    b        = boolector_var (g_btor, s, "b");
+    q        = boolector_udiv (g_btor, a, b);
+    r        = boolector_urem (g_btor, a, b);
+    zero     = boolector_zero (g_btor, s);
+    ones     = boolector_ones (g_btor, s);
+    tmp      = boolector_eq (g_btor, q, ones);
+    c        = boolector_eq (g_btor, r, a);
+    def_zero = boolector_and (g_btor, tmp, c);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    tmp = boolector_mul (g_btor, q, b);
+    c   = boolector_add (g_btor, tmp, r);
+    boolector_release (g_btor, tmp);
+    tmp = boolector_eq (g_btor, c, a);
+    boolector_release (g_btor, c);
+    c   = boolector_ult (g_btor, r, b);
+    def = boolector_and (g_btor, tmp, c);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    tmp = boolector_eq (g_btor, b, zero);
+    c   = boolector_cond (g_btor, tmp, def_zero, def);
+    boolector_release (g_btor, tmp);
+    tmp = boolector_not (g_btor, c);
+    boolector_assert (g_btor, tmp);
+    assert (boolector_sat (g_btor) == BOOLECTOR_UNSAT);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    boolector_release (g_btor, def);
+    boolector_release (g_btor, def_zero);
+    boolector_release (g_btor, ones);
+    boolector_release (g_btor, zero);
+    boolector_release (g_btor, r);
+    boolector_release (g_btor, q);
+    boolector_release (g_btor, b);
+    boolector_release (g_btor, a);
+    boolector_release_sort (g_btor, s);
+    boolector_delete (g_btor);
+
+    /* a / b = 7, a % b = 3, 5 < b < 7 has the unique solution a = 45 */
+    g_btor = boolector_new ();
+    boolector_set_opt (g_btor, BTOR_OPT_DIV_ENC, enc);
+    boolector_set_opt (g_btor, BTOR_OPT_MODEL_GEN, 1);
+    s = boolector_bitvec_sort (g_btor, 6);
+    a = boolector_var (g_btor, s, "a");
+    b = boolector_var (g_btor, s, "b");
+    q = boolector_udiv (g_btor, a, b);
+    r = boolector_urem (g_btor, a, b);
+    c = boolector_unsigned_int (g_btor, 7, s);
+    tmp = boolector_eq (g_btor, q, c);
+    boolector_assert (g_btor, tmp);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    c   = boolector_unsigned_int (g_btor, 3, s);
+    tmp = boolector_eq (g_btor, r, c);
+    boolector_assert (g_btor, tmp);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    c   = boolector_unsigned_int (g_btor, 5, s);
+    tmp = boolector_ugt (g_btor, b, c);
+    boolector_assert (g_btor, tmp);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    c   = boolector_unsigned_int (g_btor, 7, s);
+    tmp = boolector_ult (g_btor, b, c);
+    boolector_assert (g_btor, tmp);
+    boolector_release (g_btor, tmp);
+    boolector_release (g_btor, c);
+    assert (boolector_sat (g_btor) == BOOLECTOR_SAT);
+    assignment = boolector_bv_assignment (g_btor, a);
+    assert (!strcmp (assignment, "101101"));
+    boolector_free_bv_assignment (g_btor, assignment);
+    boolector_release (g_btor, r);
+    boolector_release (g_btor, q);
+    boolector_release (g_btor, b);
+    boolector_release (g_btor, a);
+    boolector_release_sort (g_btor, s);
+    boolector_delete (g_btor);
+  }
+}
+
 static void
 test_add_s_arithmetic (void)
 {
@@ -349,6 +447,7 @@ run_all_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST (mul_u_arithmetic);
   BTOR_RUN_TEST (udiv_arithmetic);
   BTOR_RUN_TEST (urem_arithmetic);
+  BTOR_RUN_TEST (udiv_urem_enc_arithmetic);
 
   BTOR_RUN_TEST (add_s_arithmetic);
   BTOR_RUN_TEST (sub_s_arithmetic);
@@ -76,7 +76,8 @@ random_bv (uint32_t bw)
   BtorBitVector *res;
   res = btor_bv_new (g_mm, bw);
 
-  for (i = 0; i < res->len; i++) res->bits[i] = (BTOR_BV_TYPE) rand ();
+  for (i = 0; i < res->len; i++)
+    res->bits[i] = ((BTOR_BV_TYPE) rand () << 32) ^ (BTOR_BV_TYPE) rand ();
 
   if (bw != BTOR_BV_TYPE_BW * res->len)
     res->bits[0] &= ((((BTOR_BV_TYPE) 1 << (BTOR_BV_TYPE_BW - 1)) - 1)
@@ -171,6 +172,36 @@ test_uint64_to_bv_to_uint64_bitvec (void)
   }
 }
 
+static void
+test_init_inline_bitvec (void)
+{
+  uint32_t bw, i;
+  uint64_t x;
+  BtorBitVectorInline ibv;
+  BtorBitVector *a, *b, *res1, *res2;
+
+  for (bw = 1; bw <= BTOR_BV_TYPE_BW; bw++)
+  {
+    for (i = 0; i < 10; i++)
+    {
+      x = ((uint64_t) rand ()) << 32;
+      x |= (uint64_t) rand ();
+      a = btor_bv_init_inline (&ibv, x, bw);
+      b = btor_bv_uint64_to_bv (g_mm, x, bw);
+      assert (a == &ibv.bv);
+      assert (a->len == 1);
+      assert (!btor_bv_compare (a, b));
+      assert (btor_bv_hash (a) == btor_bv_hash (b));
+      res1 = btor_bv_add (g_mm, a, b);
+      res2 = btor_bv_add (g_mm, b, b);
+      assert (!btor_bv_compare (res1, res2));
+      btor_bv_free (g_mm, res1);
+      btor_bv_free (g_mm, res2);
+      btor_bv_free (g_mm, b);
+    }
+  }
+}
+
 static void
 test_int64_to_bv_bitvec (void)
 {
@@ -1272,6 +1303,466 @@ test_is_umulo_bitvec (void)
   is_umulo_bitvec (33);
 }
 
+static void
+test_wide_bitvec (void)
+{
+  uint32_t bw, i;
+  BtorBitVector *a, *b, *one, *tmp1, *tmp2, *tmp3;
+
+  /* widths spanning multiple chunks */
+  for (bw = 65; bw <= 300; bw += 7)
+  {
+    one = btor_bv_one (g_mm, bw);
+    for (i = 0; i < 10; i++)
+    {
+      a = random_bv (bw);
+      b = random_bv (bw);
+      /* (a + b) - b = a */
+      tmp1 = btor_bv_add (g_mm, a, b);
+      tmp2 = btor_bv_sub (g_mm, tmp1, b);
+      assert (!btor_bv_compare (tmp2, a));
+      btor_bv_free (g_mm, tmp1);
+      btor_bv_free (g_mm, tmp2);
+      /* a - b = a + -b */
+      tmp1 = btor_bv_sub (g_mm, a, b);
+      tmp2 = btor_bv_neg (g_mm, b);
+      tmp3 = btor_bv_add (g_mm, a, tmp2);
+      assert (!btor_bv_compare (tmp1, tmp3));
+      btor_bv_free (g_mm, tmp1);
+      btor_bv_free (g_mm, tmp2);
+      btor_bv_free (g_mm, tmp3);
+      /* inc (a) = a + 1, dec (inc (a)) = a */
+      tmp1 = btor_bv_inc (g_mm, a);
+      tmp2 = btor_bv_add (g_mm, a, one);
+      assert (!btor_bv_compare (tmp1, tmp2));
+      tmp3 = btor_bv_dec (g_mm, tmp1);
+      assert (!btor_bv_compare (tmp3, a));
+      btor_bv_free (g_mm, tmp1);
+      btor_bv_free (g_mm, tmp2);
+      btor_bv_free (g_mm, tmp3);
+      /* a * b = (a * b) with operands swapped */
+      tmp1 = btor_bv_mul (g_mm, a, b);
+      tmp2 = btor_bv_mul (g_mm, b, a);
+      assert (!btor_bv_compare (tmp1, tmp2));
+      btor_bv_free (g_mm, tmp1);
+      btor_bv_free (g_mm, tmp2);
+      /* a = (a / b) * b + a % b */
+      tmp1 = btor_bv_udiv (g_mm, a, b);
+      tmp2 = btor_bv_mul (g_mm, tmp1, b);
+      btor_bv_free (g_mm, tmp1);
+      tmp1 = btor_bv_urem (g_mm, a, b);
+      tmp3 = btor_bv_add (g_mm, tmp2, tmp1);
+      assert (!btor_bv_compare (tmp3, a));
+      btor_bv_free (g_mm, tmp1);
+      btor_bv_free (g_mm, tmp2);
+      btor_bv_free (g_mm, tmp3);
+      /* slice (concat (a, b)) */
+      tmp1 = btor_bv_concat (g_mm, a, b);
+      tmp2 = btor_bv_slice (g_mm, tmp1, 2 * bw - 1, bw);
+      tmp3 = btor_bv_slice (g_mm, tmp1, bw - 1, 0);
+      assert (!btor_bv_compare (tmp2, a));
+      assert (!btor_bv_compare (tmp3, b));
+      btor_bv_free (g_mm, tmp1);
+      btor_bv_free (g_mm, tmp2);
+      btor_bv_free (g_mm, tmp3);
+      btor_bv_free (g_mm, a);
+      btor_bv_free (g_mm, b);
+    }
+    btor_bv_free (g_mm, one);
+  }
+}
+
+static void
+test_karatsuba_bitvec (void)
+{
+  uint32_t bw, i, threshold;
+  BtorBitVector *a, *b, *res1, *res2;
+
+  threshold = btor_bv_karatsuba_threshold;
+  for (bw = 65; bw <= 3000; bw += 97)
+  {
+    for (i = 0; i < 5; i++)
+    {
+      a = random_bv (bw);
+      b = i == 0 ? btor_bv_ones (g_mm, bw) : random_bv (bw);
+      btor_bv_karatsuba_threshold = UINT32_MAX;
+      res1                        = btor_bv_mul (g_mm, a, b);
+      btor_bv_karatsuba_threshold = 2;
+      res2                        = btor_bv_mul (g_mm, a, b);
+      assert (!btor_bv_compare (res1, res2));
+      btor_bv_free (g_mm, res1);
+      btor_bv_free (g_mm, res2);
+      btor_bv_free (g_mm, a);
+      btor_bv_free (g_mm, b);
+    }
+  }
+  btor_bv_karatsuba_threshold = threshold;
+}
+
+static void
+test_wide_udiv_urem_bitvec (void)
+{
+  uint32_t bw, i, j, bwb;
+  BtorBitVector *a, *b, *tmp, *q, *r, *res;
+
+  for (bw = 65; bw <= 4096; bw += 131)
+  {
+    for (i = 0; i < 10; i++)
+    {
+      a = random_bv (bw);
+      b = random_bv (bw);
+      /* divisors with different numbers of significant bits, including
+       * zero (i = 0) and divisors with the MSB set (i = 9) */
+      bwb = i == 0 ? 0 : (i == 9 ? bw : 1 + rand () % bw);
+      for (j = bwb; j < bw; j++) btor_bv_set_bit (b, j, 0);
+      if (i == 9) btor_bv_set_bit (b, bw - 1, 1);
+
+      q = btor_bv_udiv (g_mm, a, b);
+      r = btor_bv_urem (g_mm, a, b);
+      if (btor_bv_is_zero (b))
+      {
+        assert (btor_bv_is_ones (q));
+        assert (!btor_bv_compare (r, a));
+      }
+      else
+      {
+        /* a = q * b + r, r < b */
+        tmp = btor_bv_mul (g_mm, q, b);
+        res = btor_bv_add (g_mm, tmp, r);
+        assert (!btor_bv_compare (res, a));
+        assert (btor_bv_compare (r, b) < 0);
+        btor_bv_free (g_mm, tmp);
+        btor_bv_free (g_mm, res);
+      }
+      btor_bv_free (g_mm, q);
+      btor_bv_free (g_mm, r);
+      btor_bv_free (g_mm, a);
+      btor_bv_free (g_mm, b);
+    }
+  }
+}
+
+/* Print the time per multiplication for different values of
+ * 'btor_bv_karatsuba_threshold' (in chunks, '-' is schoolbook only). The
+ * crossover point is the smallest threshold that does not slow down
+ * multiplication at any width. */
+static void
+test_perf_mul_bitvec (void)
+{
+  uint32_t i, j, k, n, threshold, num_iter;
+  uint32_t sizes[]      = {8, 16, 24, 32, 48, 64, 96, 128, 256};
+  uint32_t thresholds[] = {UINT32_MAX, 8, 12, 16, 24, 32, 48};
+  double start;
+  BtorBitVector *a, *b, *res;
+
+  threshold = btor_bv_karatsuba_threshold;
+  tprintf ("\n%8s", "width");
+  for (j = 0; j < sizeof (thresholds) / sizeof (*thresholds); j++)
+  {
+    if (thresholds[j] == UINT32_MAX)
+      tprintf (" %8s", "-");
+    else
+      tprintf (" %8u", thresholds[j]);
+  }
+  tprintf ("\n");
+  for (i = 0; i < sizeof (sizes) / sizeof (*sizes); i++)
+  {
+    n        = sizes[i];
+    a        = random_bv (n * BTOR_BV_TYPE_BW);
+    b        = random_bv (n * BTOR_BV_TYPE_BW);
+    res      = btor_bv_new (g_mm, a->width);
+    num_iter = 10000000 / (n * n) + 10;
+    tprintf ("%8u", a->width);
+    for (j = 0; j < sizeof (thresholds) / sizeof (*thresholds); j++)
+    {
+      btor_bv_karatsuba_threshold = thresholds[j];
+      start                       = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) btor_bv_mul_into (g_mm, res, a, b);
+      tprintf (" %5.0f ns",
+               (btor_util_time_stamp () - start) / num_iter * 1e9);
+    }
+    tprintf ("\n");
+    btor_bv_free (g_mm, res);
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+  }
+  btor_bv_karatsuba_threshold = threshold;
+}
+
+/* Print the time per division with algorithm D for a full width and a half
+ * width divisor. */
+static void
+test_perf_udiv_bitvec (void)
+{
+  uint32_t i, j, k, bw, num_iter;
+  uint32_t widths[] = {32, 64, 128, 256, 512, 1024, 2048, 4096};
+  double start, time[2];
+  BtorBitVector *a, *b, *res;
+
+  tprintf ("\n%8s %14s %14s\n", "width", "full divisor", "half divisor");
+  for (i = 0; i < sizeof (widths) / sizeof (*widths); i++)
+  {
+    bw       = widths[i];
+    a        = random_bv (bw);
+    b        = random_bv (bw);
+    res      = btor_bv_new (g_mm, bw);
+    num_iter = 20000000 / bw;
+    for (j = 0; j < 2; j++)
+    {
+      if (j == 1)
+        for (k = bw / 2; k < bw; k++) btor_bv_set_bit (b, k, 0);
+      start = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) btor_bv_udiv_into (g_mm, res, a, b);
+      time[j] = (btor_util_time_stamp () - start) / num_iter * 1e9;
+    }
+    tprintf ("%8u %11.0f ns %11.0f ns\n", bw, time[0], time[1]);
+    btor_bv_free (g_mm, res);
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+  }
+}
+
+static void
+simd_check_ops (BtorBitVector *a, BtorBitVector *b)
+{
+  uint32_t i, k, hash[2];
+  int32_t cmp[2];
+  bool zero[2], ones[2];
+  BtorBitVector *res[2][6];
+
+  for (k = 0; k < 2; k++)
+  {
+    btor_bv_simd_enable (k == 1);
+    res[k][0] = btor_bv_and (g_mm, a, b);
+    res[k][1] = btor_bv_or (g_mm, a, b);
+    res[k][2] = btor_bv_xor (g_mm, a, b);
+    res[k][3] = btor_bv_not (g_mm, a);
+    res[k][4] = btor_bv_eq (g_mm, a, b);
+    res[k][5] = btor_bv_ult (g_mm, a, b);
+    cmp[k]    = btor_bv_compare (a, b);
+    zero[k]   = btor_bv_is_zero (a);
+    ones[k]   = btor_bv_is_ones (a);
+    hash[k]   = btor_bv_hash (a);
+  }
+  for (i = 0; i < 6; i++)
+  {
+    assert (!btor_bv_compare (res[0][i], res[1][i]));
+    btor_bv_free (g_mm, res[0][i]);
+    btor_bv_free (g_mm, res[1][i]);
+  }
+  assert (cmp[0] == cmp[1]);
+  assert (zero[0] == zero[1]);
+  assert (ones[0] == ones[1]);
+  assert (hash[0] == hash[1]);
+}
+
+static void
+test_simd_bitvec (void)
+{
+  uint32_t bw, i;
+  BtorBitVector *a, *b;
+
+  for (bw = 1; bw <= 1500; bw += bw < 300 ? 1 : 37)
+  {
+    a = random_bv (bw);
+    b = random_bv (bw);
+    simd_check_ops (a, b);
+    simd_check_ops (a, a);
+    /* differ in a single bit */
+    for (i = 0; i < bw; i += bw < 64 ? 1 : 13)
+    {
+      btor_bv_free (g_mm, b);
+      b = btor_bv_flipped_bit (g_mm, a, i);
+      simd_check_ops (a, b);
+      simd_check_ops (b, a);
+    }
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+    /* zero and ones with a single bit flipped */
+    a = btor_bv_new (g_mm, bw);
+    simd_check_ops (a, a);
+    assert (btor_bv_is_zero (a));
+    b = btor_bv_flipped_bit (g_mm, a, bw - 1 - (bw / 3));
+    simd_check_ops (b, a);
+    assert (!btor_bv_is_zero (b));
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+    a = btor_bv_ones (g_mm, bw);
+    simd_check_ops (a, a);
+    assert (btor_bv_is_ones (a));
+    b = btor_bv_flipped_bit (g_mm, a, bw / 3);
+    simd_check_ops (b, a);
+    assert (!btor_bv_is_ones (b));
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+  }
+  btor_bv_simd_enable (true);
+}
+
+static void
+test_perf_simd_bitvec (void)
+{
+  uint32_t i, j, k, n, num_iter;
+  uint32_t sizes[] = {4, 8, 16, 64, 256};
+  uint32_t hash    = 0;
+  double start, t[2][5];
+  BtorBitVector *a, *b, *res, *r1, *ones;
+
+  r1 = btor_bv_new (g_mm, 1);
+  tprintf ("\nkernels: %s\n", btor_bv_simd_kernels ());
+  tprintf ("%8s %21s %21s %21s %21s %21s\n",
+           "width",
+           "and",
+           "xor",
+           "ult",
+           "is_ones",
+           "hash");
+  for (i = 0; i < sizeof (sizes) / sizeof (*sizes); i++)
+  {
+    n        = sizes[i];
+    a        = random_bv (n * BTOR_BV_TYPE_BW);
+    b        = btor_bv_copy (g_mm, a);
+    res      = btor_bv_new (g_mm, a->width);
+    ones     = btor_bv_ones (g_mm, a->width);
+    num_iter = 100000000 / n;
+    for (j = 0; j < 2; j++)
+    {
+      btor_bv_simd_enable (j == 1);
+      start = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) btor_bv_and_into (res, a, b);
+      t[j][0] = btor_util_time_stamp () - start;
+      start   = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) btor_bv_xor_into (res, a, b);
+      t[j][1] = btor_util_time_stamp () - start;
+      start   = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) btor_bv_ult_into (r1, a, b);
+      t[j][2] = btor_util_time_stamp () - start;
+      start   = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) hash += btor_bv_is_ones (ones);
+      t[j][3] = btor_util_time_stamp () - start;
+      start   = btor_util_time_stamp ();
+      for (k = 0; k < num_iter; k++) hash += btor_bv_hash (a);
+      t[j][4] = btor_util_time_stamp () - start;
+    }
+    tprintf ("%8u", a->width);
+    for (k = 0; k < 5; k++)
+      tprintf (" %6.0f ns -> %6.0f ns",
+               t[0][k] / num_iter * 1e9,
+               t[1][k] / num_iter * 1e9);
+    tprintf ("\n");
+    btor_bv_free (g_mm, ones);
+    btor_bv_free (g_mm, res);
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+  }
+  btor_bv_free (g_mm, r1);
+  btor_bv_simd_enable (true);
+  (void) hash;
+}
+
+/* Compare 'op_into' against 'op', once with a fresh destination and once
+ * with the first operand as destination. */
+#define CHECK_INTO(op, op_into, ...)        \
+  do                                        \
+  {                                         \
+    res = op (g_mm, a, __VA_ARGS__);        \
+    dst = random_bv (res->width);           \
+    op_into (dst, a, __VA_ARGS__);          \
+    assert (!btor_bv_compare (dst, res));   \
+    btor_bv_free (g_mm, dst);               \
+    if (res->width == a->width)             \
+    {                                       \
+      dst = btor_bv_copy (g_mm, a);         \
+      op_into (dst, dst, __VA_ARGS__);      \
+      assert (!btor_bv_compare (dst, res)); \
+      btor_bv_free (g_mm, dst);             \
+    }                                       \
+    btor_bv_free (g_mm, res);               \
+  } while (0)
+
+#define CHECK_INTO_MM(op, op_into)        \
+  do                                      \
+  {                                       \
+    res = op (g_mm, a, b);                \
+    dst = random_bv (res->width);         \
+    op_into (g_mm, dst, a, b);            \
+    assert (!btor_bv_compare (dst, res)); \
+    btor_bv_copy_into (dst, a);           \
+    op_into (g_mm, dst, dst, b);          \
+    assert (!btor_bv_compare (dst, res)); \
+    btor_bv_copy_into (dst, b);           \
+    op_into (g_mm, dst, a, dst);          \
+    assert (!btor_bv_compare (dst, res)); \
+    btor_bv_free (g_mm, dst);             \
+    btor_bv_free (g_mm, res);             \
+  } while (0)
+
+static void
+into_bitvec (uint32_t bw)
+{
+  uint32_t i, up, lo;
+  BtorBitVector *a, *b, *c, *s, *res, *dst;
+
+  for (i = 0; i < 20; i++)
+  {
+    a  = random_bv (bw);
+    b  = random_bv (bw);
+    c  = random_bv (1);
+    s  = btor_bv_uint64_to_bv (g_mm, rand () % (bw + 1), bw);
+    up = rand () % bw;
+    lo = rand () % (up + 1);
+
+    CHECK_INTO (btor_bv_add, btor_bv_add_into, b);
+    CHECK_INTO (btor_bv_sub, btor_bv_sub_into, b);
+    CHECK_INTO (btor_bv_and, btor_bv_and_into, b);
+    CHECK_INTO (btor_bv_or, btor_bv_or_into, b);
+    CHECK_INTO (btor_bv_xor, btor_bv_xor_into, b);
+    CHECK_INTO (btor_bv_eq, btor_bv_eq_into, b);
+    CHECK_INTO (btor_bv_eq, btor_bv_eq_into, a);
+    CHECK_INTO (btor_bv_ult, btor_bv_ult_into, b);
+    CHECK_INTO (btor_bv_sll, btor_bv_sll_into, s);
+    CHECK_INTO (btor_bv_srl, btor_bv_srl_into, s);
+    CHECK_INTO (btor_bv_concat, btor_bv_concat_into, b);
+    CHECK_INTO (btor_bv_slice, btor_bv_slice_into, up, lo);
+    CHECK_INTO_MM (btor_bv_mul, btor_bv_mul_into);
+    CHECK_INTO_MM (btor_bv_udiv, btor_bv_udiv_into);
+    CHECK_INTO_MM (btor_bv_urem, btor_bv_urem_into);
+
+    /* unary operations and ite */
+    res = btor_bv_not (g_mm, a);
+    dst = btor_bv_copy (g_mm, a);
+    btor_bv_not_into (dst, dst);
+    assert (!btor_bv_compare (dst, res));
+    btor_bv_neg_into (dst, a);
+    btor_bv_inc_into (res, res);
+    assert (!btor_bv_compare (dst, res));
+    btor_bv_dec_into (dst, dst);
+    btor_bv_not_into (dst, dst);
+    assert (!btor_bv_compare (dst, a));
+    btor_bv_ite_into (dst, c, a, b);
+    assert (!btor_bv_compare (dst, btor_bv_is_true (c) ? a : b));
+    btor_bv_free (g_mm, dst);
+    btor_bv_free (g_mm, res);
+
+    btor_bv_free (g_mm, a);
+    btor_bv_free (g_mm, b);
+    btor_bv_free (g_mm, c);
+    btor_bv_free (g_mm, s);
+  }
+}
+
+static void
+test_into_bitvec (void)
+{
+  into_bitvec (1);
+  into_bitvec (7);
+  into_bitvec (31);
+  into_bitvec (64);
+  into_bitvec (65);
+  into_bitvec (128);
+  into_bitvec (200);
+}
+
 static void
 test_compare_bitvec (void)
 {
@@ -2030,6 +2521,7 @@ run_bitvec_tests (int32_t argc, char **argv)
 
   BTOR_RUN_TEST (uint64_to_bitvec);
   BTOR_RUN_TEST (uint64_to_bv_to_uint64_bitvec);
+  BTOR_RUN_TEST (init_inline_bitvec);
   BTOR_RUN_TEST (int64_to_bv_bitvec);
   BTOR_RUN_TEST (char_to_bitvec);
   BTOR_RUN_TEST (bv_to_char_bitvec);
@@ -2061,6 +2553,14 @@ run_bitvec_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST (slice_bitvec);
   BTOR_RUN_TEST (uext_bitvec);
   BTOR_RUN_TEST (sext_bitvec);
+  BTOR_RUN_TEST (wide_bitvec);
+  BTOR_RUN_TEST (into_bitvec);
+  BTOR_RUN_TEST (karatsuba_bitvec);
+  BTOR_RUN_TEST (wide_udiv_urem_bitvec);
+  BTOR_RUN_TEST (perf_mul_bitvec);
+  BTOR_RUN_TEST (perf_udiv_bitvec);
+  BTOR_RUN_TEST (simd_bitvec);
+  BTOR_RUN_TEST (perf_simd_bitvec);
 
   BTOR_RUN_TEST (flipped_bit_bitvec);
   BTOR_RUN_TEST (flipped_bit_range_bitvec);
@@ -12,8 +12,11 @@
 #include "btorcore.h"
 #include "btorexp.h"
 #include "btornode.h"
+#include "btorrwcache.h"
 #include "dumper/btordumpbtor.h"
 #include "testrunner.h"
+#include "utils/btornodeadj.h"
+#include "utils/btornodeiter.h"
 
 #ifdef NDEBUG
 #undef NDEBUG
@@ -1010,6 +1013,112 @@ test_dec_exp (void)
   finish_exp_test ();
 }
 
+static void
+test_rw_cache_exp (void)
+{
+  int32_t i;
+  uint32_t num_sets;
+  BtorSortId sort;
+  BtorNode *v1, *v2, *and;
+  BtorRwCache *rwc;
+
+  init_exp_test ();
+  rwc  = g_btor->rw_cache;
+  sort = btor_sort_bv (g_btor, 8);
+  v1   = btor_exp_var (g_btor, sort, "v1");
+  v2   = btor_exp_var (g_btor, sort, "v2");
+  and  = btor_exp_bv_and (g_btor, v1, v2);
+  btor_rw_cache_add (rwc,
+                     BTOR_BV_AND_NODE,
+                     v1->id,
+                     v2->id,
+                     0,
+                     btor_node_real_addr (and)->id);
+  assert (btor_rw_cache_get (rwc, BTOR_BV_AND_NODE, v1->id, v2->id, 0)
+          == btor_node_real_addr (and)->id);
+
+  /* results that got deallocated are detected on lookup */
+  btor_node_release (g_btor, and);
+  assert (!btor_rw_cache_get (rwc, BTOR_BV_AND_NODE, v1->id, v2->id, 0));
+  assert (rwc->num_stale == 1);
+
+  /* reset invalidates all entries */
+  btor_rw_cache_add (rwc, BTOR_BV_SLICE_NODE, v1->id, 3, 0, v2->id);
+  assert (btor_rw_cache_get (rwc, BTOR_BV_SLICE_NODE, v1->id, 3, 0) == v2->id);
+  btor_rw_cache_reset (rwc);
+  assert (!btor_rw_cache_get (rwc, BTOR_BV_SLICE_NODE, v1->id, 3, 0));
+  assert (rwc->count == 0);
+
+  /* the cache grows until the memory limit is reached */
+  btor_opt_set (g_btor, BTOR_OPT_RW_CACHE_SIZE, 1);
+  num_sets = rwc->num_sets;
+  for (i = 0; i < 100000; i++)
+    btor_rw_cache_add (rwc, BTOR_BV_SLICE_NODE, v1->id, i, 0, v2->id);
+  assert (rwc->num_sets > num_sets);
+  assert (rwc->num_evict > 0);
+  assert (btor_rw_cache_size (rwc) <= (1 << 20));
+  assert (btor_rw_cache_get (rwc, BTOR_BV_SLICE_NODE, v1->id, 99999, 0)
+          == v2->id);
+
+  /* size 0 disables the cache */
+  btor_opt_set (g_btor, BTOR_OPT_RW_CACHE_SIZE, 0);
+  btor_rw_cache_add (rwc, BTOR_BV_SLICE_NODE, v1->id, 3, 0, v2->id);
+  assert (!btor_rw_cache_get (rwc, BTOR_BV_SLICE_NODE, v1->id, 3, 0));
+
+  btor_node_release (g_btor, v1);
+  btor_node_release (g_btor, v2);
+  btor_sort_release (g_btor, sort);
+  finish_exp_test ();
+}
+
+static void
+test_node_adj_exp (void)
+{
+  uint32_t i, n;
+  const int32_t *parents;
+  BtorSortId sort;
+  BtorNode *v1, *v2, *and, *add, *slice;
+  BtorNodeAdj *adj;
+  BtorNodeIterator it;
+
+  init_exp_test ();
+  btor_opt_set (g_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  sort  = btor_sort_bv (g_btor, 8);
+  v1    = btor_exp_var (g_btor, sort, "v1");
+  v2    = btor_exp_var (g_btor, sort, "v2");
+  and   = btor_exp_bv_and (g_btor, v1, v2);
+  add   = btor_exp_bv_add (g_btor, and, btor_node_invert (v1));
+  slice = btor_exp_bv_slice (g_btor, add, 3, 0);
+
+  adj = btor_node_adj_new (g_btor);
+  assert (adj->num_ids == BTOR_COUNT_STACK (g_btor->nodes_id_table));
+  assert (btor_node_adj_get_num_parents (adj, v1->id) == 2);
+  assert (btor_node_adj_get_num_parents (adj, v2->id) == 1);
+  assert (btor_node_adj_get_num_parents (
+              adj, btor_node_real_addr (slice)->id)
+          == 0);
+
+  /* parents are stored in the order of the parent lists */
+  n       = btor_node_adj_get_num_parents (adj, v1->id);
+  parents = btor_node_adj_get_parents (adj, v1->id);
+  btor_iter_parent_init (&it, v1);
+  for (i = 0; i < n; i++)
+  {
+    assert (btor_iter_parent_has_next (&it));
+    assert (parents[i] == btor_node_get_id (btor_iter_parent_next (&it)));
+  }
+  assert (!btor_iter_parent_has_next (&it));
+  btor_node_adj_delete (adj);
+
+  btor_node_release (g_btor, slice);
+  btor_node_release (g_btor, add);
+  btor_node_release (g_btor, and);
+  btor_node_release (g_btor, v1);
+  btor_node_release (g_btor, v2);
+  btor_sort_release (g_btor, sort);
+  finish_exp_test ();
+}
+
 void
 run_exp_tests (int32_t argc, char **argv)
 {
@@ -1071,6 +1180,8 @@ run_exp_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST_CHECK_LOG (write_exp);
   BTOR_RUN_TEST_CHECK_LOG (inc_exp);
   BTOR_RUN_TEST_CHECK_LOG (dec_exp);
+  BTOR_RUN_TEST (rw_cache_exp);
+  BTOR_RUN_TEST (node_adj_exp);
 }
 
 void
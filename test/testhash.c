@@ -11,6 +11,7 @@
 #include "testhash.h"
 #include "testrunner.h"
 #include "utils/btorhashptr.h"
+#include "utils/btorhashptrmap.h"
 
 #ifdef NDEBUG
 #undef NDEBUG
@@ -139,6 +140,117 @@ test_hash_str2str (void)
   btor_hashptr_table_delete (ht);
 }
 
+static void *
+clone_key_as_ptr (BtorMemMgr *mm, const void *map, const void *key)
+{
+  (void) mm;
+  (void) map;
+  return (void *) key;
+}
+
+static void
+clone_data_as_int (BtorMemMgr *mm,
+                   const void *map,
+                   BtorHashTableData *data,
+                   BtorHashTableData *cloned_data)
+{
+  (void) mm;
+  (void) map;
+  cloned_data->as_int = data->as_int;
+}
+
+static void
+test_hash_map_ptr2i (void)
+{
+  size_t allocated = mem->allocated;
+  uint32_t i, j, k, n = 5000;
+  int32_t keys[5000], seq = 0, prev;
+  bool in_map[5000];
+  BtorPtrHashMap *hm, *clone;
+  BtorPtrHashMapEntry *e;
+  BtorPtrHashMapIterator it;
+  BtorHashTableData data;
+  int32_t *key;
+
+  hm = btor_hashptrmap_new (mem, 0, 0);
+  for (i = 0; i < n; i++)
+  {
+    in_map[i]                                    = true;
+    keys[i]                                      = seq;
+    btor_hashptrmap_add (hm, &keys[i])->data.as_int = seq++;
+  }
+  assert (hm->count == n);
+
+  /* remove keys, some of them while iterating */
+  for (i = 0; i < n; i += 6)
+  {
+    btor_hashptrmap_remove (hm, &keys[i], (void **) &key, &data);
+    assert (key == &keys[i]);
+    assert (data.as_int == keys[i]);
+    in_map[i] = false;
+  }
+  btor_iter_hashptrmap_init (&it, hm);
+  while (btor_iter_hashptrmap_has_next (&it))
+  {
+    key = btor_iter_hashptrmap_next (&it);
+    j   = key - keys;
+    if (j % 6 == 3)
+    {
+      btor_hashptrmap_remove (hm, key, 0, 0);
+      in_map[j] = false;
+    }
+  }
+  for (i = 0; i < n; i++)
+  {
+    e = btor_hashptrmap_get (hm, &keys[i]);
+    assert (!e == !in_map[i]);
+    assert (!e || e->data.as_int == keys[i]);
+  }
+
+  /* re-added keys are appended to the insertion order */
+  for (i = 0; i < n; i += 6)
+  {
+    keys[i]                                      = seq;
+    btor_hashptrmap_add (hm, &keys[i])->data.as_int = seq++;
+    in_map[i]                                    = true;
+  }
+
+  clone = btor_hashptrmap_clone (
+      mem, hm, clone_key_as_ptr, clone_data_as_int, 0, 0);
+  assert (clone->count == hm->count);
+  assert (btor_hashptrmap_size (clone) == btor_hashptrmap_size (hm));
+
+  /* iterate over 'hm' and 'clone' in insertion order */
+  for (k = 0, j = 0, prev = -1; k < 2; k++)
+  {
+    btor_iter_hashptrmap_init (&it, hm);
+    btor_iter_hashptrmap_queue (&it, clone);
+    while (btor_iter_hashptrmap_has_next (&it))
+    {
+      key = btor_iter_hashptrmap_next (&it);
+      assert (in_map[key - keys]);
+      if (j % hm->count == 0) prev = -1;
+      assert (*key > prev);
+      prev = *key;
+      j++;
+    }
+  }
+  assert (j == 4 * hm->count);
+
+  btor_iter_hashptrmap_init_reversed (&it, clone);
+  for (j = 0, prev = seq; btor_iter_hashptrmap_has_next (&it); j++)
+  {
+    data = *btor_iter_hashptrmap_next_data (&it);
+    assert (data.as_int < prev);
+    prev = data.as_int;
+  }
+  assert (j == hm->count);
+
+  btor_hashptrmap_delete (clone);
+  btor_hashptrmap_delete (hm);
+  assert (allocated == mem->allocated);
+}
+
 void
 run_hash_tests (int32_t argc, char **argv)
 {
@@ -146,6 +258,7 @@ run_hash_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST (hash_str2i);
   BTOR_RUN_TEST_CHECK_LOG (traverse_hash_str2i);
   BTOR_RUN_TEST_CHECK_LOG (hash_str2str);
+  BTOR_RUN_TEST (hash_map_ptr2i);
 }
 
 void
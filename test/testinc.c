@@ -11,6 +11,7 @@
 
 #include "testinc.h"
 #include "boolector.h"
+#include "btorcore.h"
 #include "btorexit.h"
 #include "btoropt.h"
 #include "testrunner.h"
@@ -21,6 +22,9 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 static Btor *g_btor = NULL;
 
@@ -356,6 +360,412 @@ test_inc_lemmas_on_demand_1 ()
   boolector_delete (g_btor);
 }
 
+/* Conflicts in independent function cones are detected in parallel. */
+static void
+test_inc_lemmas_on_demand_par (void)
+{
+  BoolectorNode *a, *b, *w, *x, *y, *c3, *rax, *ray, *rbx, *rby, *rwy;
+  BoolectorNode *eq, *nea, *neb, *new;
+  BoolectorSort s, as;
+  int32_t res;
+
+  init_inc_test ();
+  boolector_set_opt (g_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (g_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  boolector_set_opt (g_btor, BTOR_OPT_FUN_PROP_THREADS, 2);
+  s   = boolector_bitvec_sort (g_btor, 8);
+  as  = boolector_array_sort (g_btor, s, s);
+  a   = boolector_array (g_btor, as, "a");
+  b   = boolector_array (g_btor, as, "b");
+  x   = boolector_var (g_btor, s, "x");
+  y   = boolector_var (g_btor, s, "y");
+  c3  = boolector_unsigned_int (g_btor, 3, s);
+  w   = boolector_write (g_btor, a, x, c3);
+  rax = boolector_read (g_btor, a, x);
+  ray = boolector_read (g_btor, a, y);
+  rbx = boolector_read (g_btor, b, x);
+  rby = boolector_read (g_btor, b, y);
+  rwy = boolector_read (g_btor, w, y);
+  eq  = boolector_eq (g_btor, x, y);
+  nea = boolector_ne (g_btor, rax, ray);
+  neb = boolector_ne (g_btor, rbx, rby);
+  new = boolector_ne (g_btor, rwy, c3);
+  boolector_assert (g_btor, eq);
+
+  boolector_assume (g_btor, nea);
+  boolector_assume (g_btor, neb);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_UNSAT);
+  boolector_assume (g_btor, new);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_UNSAT);
+  assert (boolector_failed (g_btor, new));
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_SAT);
+
+  boolector_release (g_btor, a);
+  boolector_release (g_btor, b);
+  boolector_release (g_btor, w);
+  boolector_release (g_btor, x);
+  boolector_release (g_btor, y);
+  boolector_release (g_btor, c3);
+  boolector_release (g_btor, rax);
+  boolector_release (g_btor, ray);
+  boolector_release (g_btor, rbx);
+  boolector_release (g_btor, rby);
+  boolector_release (g_btor, rwy);
+  boolector_release (g_btor, eq);
+  boolector_release (g_btor, nea);
+  boolector_release (g_btor, neb);
+  boolector_release (g_btor, new);
+  boolector_release_sort (g_btor, s);
+  boolector_release_sort (g_btor, as);
+  boolector_delete (g_btor);
+}
+
+/* Rho tables are kept across sat calls and only reused for function cones
+ * whose assignment did not change. */
+static void
+test_inc_lemmas_on_demand_reuse (void)
+{
+  BoolectorNode *a, *b, *w, *x, *y, *z, *c1, *rax, *rwy, *rwz;
+  BoolectorNode *eqa, *ult, *eqyz, *neyz, *eqxy;
+  BoolectorSort s, as;
+  const char *bits;
+  int32_t res;
+
+  init_inc_test ();
+  boolector_set_opt (g_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (g_btor, BTOR_OPT_MODEL_GEN, 1);
+  boolector_set_opt (g_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  s    = boolector_bitvec_sort (g_btor, 8);
+  as   = boolector_array_sort (g_btor, s, s);
+  a    = boolector_array (g_btor, as, "a");
+  b    = boolector_array (g_btor, as, "b");
+  x    = boolector_var (g_btor, s, "x");
+  y    = boolector_var (g_btor, s, "y");
+  z    = boolector_var (g_btor, s, "z");
+  c1   = boolector_one (g_btor, s);
+  w    = boolector_write (g_btor, b, x, c1);
+  rax  = boolector_read (g_btor, a, x);
+  rwy  = boolector_read (g_btor, w, y);
+  rwz  = boolector_read (g_btor, w, z);
+  eqa  = boolector_eq (g_btor, rax, c1);
+  ult  = boolector_ult (g_btor, rwy, rwz);
+  eqyz = boolector_eq (g_btor, y, z);
+  neyz = boolector_ne (g_btor, y, z);
+  eqxy = boolector_eq (g_btor, x, y);
+  boolector_assert (g_btor, eqa);
+  boolector_assert (g_btor, ult);
+
+  boolector_assume (g_btor, neyz);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_SAT);
+  boolector_assume (g_btor, eqyz);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_UNSAT);
+  assert (boolector_failed (g_btor, eqyz));
+  boolector_assume (g_btor, eqxy);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_SAT);
+  bits = boolector_bv_assignment (g_btor, rwy);
+  assert (!strcmp (bits, "00000001"));
+  boolector_free_bv_assignment (g_btor, bits);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_SAT);
+
+  boolector_release (g_btor, a);
+  boolector_release (g_btor, b);
+  boolector_release (g_btor, w);
+  boolector_release (g_btor, x);
+  boolector_release (g_btor, y);
+  boolector_release (g_btor, z);
+  boolector_release (g_btor, c1);
+  boolector_release (g_btor, rax);
+  boolector_release (g_btor, rwy);
+  boolector_release (g_btor, rwz);
+  boolector_release (g_btor, eqa);
+  boolector_release (g_btor, ult);
+  boolector_release (g_btor, eqyz);
+  boolector_release (g_btor, neyz);
+  boolector_release (g_btor, eqxy);
+  boolector_release_sort (g_btor, s);
+  boolector_release_sort (g_btor, as);
+  boolector_delete (g_btor);
+}
+
+/* Assertions in contexts are passed to the SAT solver via activation
+ * literals, popped contexts are disabled permanently. */
+static void
+test_inc_push_pop (void)
+{
+  BoolectorNode *array, *x, *y, *rx, *ry, *eqxy, *ner, *c3, *eqx3, *eqy3;
+  BoolectorSort s, as;
+  uint32_t i;
+  int32_t res;
+
+  init_inc_test ();
+  boolector_set_opt (g_btor, BTOR_OPT_INCREMENTAL, 1);
+  s     = boolector_bitvec_sort (g_btor, 8);
+  as    = boolector_array_sort (g_btor, s, s);
+  array = boolector_array (g_btor, as, "array");
+  x     = boolector_var (g_btor, s, "x");
+  y     = boolector_var (g_btor, s, "y");
+  rx    = boolector_read (g_btor, array, x);
+  ry    = boolector_read (g_btor, array, y);
+  eqxy  = boolector_eq (g_btor, x, y);
+  ner   = boolector_ne (g_btor, rx, ry);
+  c3    = boolector_unsigned_int (g_btor, 3, s);
+  eqx3  = boolector_eq (g_btor, x, c3);
+  eqy3  = boolector_eq (g_btor, y, c3);
+
+  boolector_assert (g_btor, ner);
+  for (i = 0; i < 20; i++)
+  {
+    boolector_push (g_btor, 1);
+    boolector_assert (g_btor, eqx3);
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_SAT);
+    assert (BTOR_PEEK_STACK (g_btor->assertions_act, 0) > 0);
+
+    boolector_push (g_btor, 2);
+    boolector_assert (g_btor, eqy3);
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_UNSAT);
+    assert (BTOR_PEEK_STACK (g_btor->assertions_act, 1) == 0);
+    assert (BTOR_PEEK_STACK (g_btor->assertions_act, 2) > 0);
+
+    boolector_assume (g_btor, eqxy);
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_UNSAT);
+
+    boolector_pop (g_btor, 2);
+    boolector_assume (g_btor, eqxy);
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_UNSAT);
+    assert (boolector_failed (g_btor, eqxy));
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_SAT);
+
+    boolector_pop (g_btor, 1);
+    assert (BTOR_EMPTY_STACK (g_btor->assertions_act));
+    assert (BTOR_EMPTY_STACK (g_btor->assertions_lit));
+  }
+  boolector_assert (g_btor, eqy3);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_SAT);
+
+  boolector_release (g_btor, array);
+  boolector_release (g_btor, x);
+  boolector_release (g_btor, y);
+  boolector_release (g_btor, rx);
+  boolector_release (g_btor, ry);
+  boolector_release (g_btor, eqxy);
+  boolector_release (g_btor, ner);
+  boolector_release (g_btor, c3);
+  boolector_release (g_btor, eqx3);
+  boolector_release (g_btor, eqy3);
+  boolector_release_sort (g_btor, s);
+  boolector_release_sort (g_btor, as);
+  finish_inc_test ();
+}
+
+/* Only the assertions of the context whose activation literal failed are
+ * reported as failed. */
+static void
+test_inc_push_pop_failed (void)
+{
+  BoolectorNode *x, *y, *c3, *c5, *eqx3, *gty5, *lty3;
+  BoolectorSort s;
+  int32_t res;
+
+  init_inc_test ();
+  boolector_set_opt (g_btor, BTOR_OPT_INCREMENTAL, 1);
+  s    = boolector_bitvec_sort (g_btor, 8);
+  x    = boolector_var (g_btor, s, "x");
+  y    = boolector_var (g_btor, s, "y");
+  c3   = boolector_unsigned_int (g_btor, 3, s);
+  c5   = boolector_unsigned_int (g_btor, 5, s);
+  eqx3 = boolector_eq (g_btor, x, c3);
+  gty5 = boolector_ugt (g_btor, y, c5);
+  lty3 = boolector_ult (g_btor, y, c3);
+
+  boolector_push (g_btor, 1);
+  boolector_assert (g_btor, eqx3);
+  boolector_push (g_btor, 1);
+  boolector_assert (g_btor, gty5);
+  boolector_assert (g_btor, lty3);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_UNSAT);
+  assert (BTOR_PEEK_STACK (g_btor->assertions_act, 0) > 0);
+  assert (BTOR_PEEK_STACK (g_btor->assertions_act, 1) > 0);
+  assert (!btor_failed_exp (g_btor, BTOR_IMPORT_BOOLECTOR_NODE (eqx3)));
+  assert (btor_failed_exp (g_btor, BTOR_IMPORT_BOOLECTOR_NODE (gty5)));
+  assert (btor_failed_exp (g_btor, BTOR_IMPORT_BOOLECTOR_NODE (lty3)));
+
+  boolector_pop (g_btor, 1);
+  res = boolector_sat (g_btor);
+  assert (res == BOOLECTOR_SAT);
+  boolector_pop (g_btor, 1);
+
+  boolector_release (g_btor, x);
+  boolector_release (g_btor, y);
+  boolector_release (g_btor, c3);
+  boolector_release (g_btor, c5);
+  boolector_release (g_btor, eqx3);
+  boolector_release (g_btor, gty5);
+  boolector_release (g_btor, lty3);
+  boolector_release_sort (g_btor, s);
+  finish_inc_test ();
+}
+
+/* The second instance adds the same formula with renamed inputs and in
+ * different order and gets the result and the model from the cache. */
+static void
+test_inc_result_cache (void)
+{
+  BoolectorNode *x, *y, *c, *one, *mul, *eq, *gtx, *gty;
+  BoolectorSort s;
+  const char *ax, *ay;
+  char *fname;
+  size_t len;
+  uint32_t i, vx, vy;
+  int32_t res;
+
+  len = strlen (btor_log_dir) + strlen ("resultcache.bin") + 1;
+  fname = malloc (len);
+  snprintf (fname, len, "%sresultcache.bin", btor_log_dir);
+  remove (fname);
+
+  for (i = 0; i < 2; i++)
+  {
+    init_inc_test ();
+    boolector_set_opt (g_btor, BTOR_OPT_MODEL_GEN, 1);
+    boolector_set_result_cache (g_btor, fname);
+    s = boolector_bitvec_sort (g_btor, 8);
+    if (i == 0)
+    {
+      x = boolector_var (g_btor, s, "x");
+      y = boolector_var (g_btor, s, "y");
+    }
+    else
+    {
+      y = boolector_var (g_btor, s, "b");
+      x = boolector_var (g_btor, s, "a");
+    }
+    c   = boolector_unsigned_int (g_btor, 91, s);
+    one = boolector_one (g_btor, s);
+    mul = boolector_mul (g_btor, i ? y : x, i ? x : y);
+    eq  = boolector_eq (g_btor, mul, c);
+    gtx = boolector_ugt (g_btor, x, one);
+    gty = boolector_ugt (g_btor, y, one);
+    if (i == 0)
+    {
+      boolector_assert (g_btor, eq);
+      boolector_assert (g_btor, gtx);
+      boolector_assert (g_btor, gty);
+    }
+    else
+    {
+      boolector_assert (g_btor, gty);
+      boolector_assert (g_btor, gtx);
+      boolector_assert (g_btor, eq);
+    }
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_SAT);
+    assert (g_btor->result_cache->num_hits == i);
+
+    ax = boolector_bv_assignment (g_btor, x);
+    ay = boolector_bv_assignment (g_btor, y);
+    vx = strtoul (ax, 0, 2);
+    vy = strtoul (ay, 0, 2);
+    assert (vx > 1 && vy > 1 && ((vx * vy) & 0xff) == 91);
+    boolector_free_bv_assignment (g_btor, ax);
+    boolector_free_bv_assignment (g_btor, ay);
+
+    boolector_release (g_btor, x);
+    boolector_release (g_btor, y);
+    boolector_release (g_btor, c);
+    boolector_release (g_btor, one);
+    boolector_release (g_btor, mul);
+    boolector_release (g_btor, eq);
+    boolector_release (g_btor, gtx);
+    boolector_release (g_btor, gty);
+    boolector_release_sort (g_btor, s);
+    finish_inc_test ();
+  }
+
+  remove (fname);
+  free (fname);
+}
+
+/* Constraints 'x > 1' and 'y > 1' only differ in their inputs. Their order
+ * must not depend on the order of creation, which is reversed in the second
+ * instance, since 'x' and 'y' occur at different positions in 'x < y'.
+ * Rewriting is disabled to keep the formula from being solved early. */
+static void
+test_inc_result_cache_order (void)
+{
+  BoolectorNode *x, *y, *one, *gtx, *gty, *lt, *c, *eq;
+  BoolectorSort s;
+  char *fname;
+  size_t len;
+  uint32_t i;
+  int32_t res;
+
+  len   = strlen (btor_log_dir) + strlen ("resultcache2.bin") + 1;
+  fname = malloc (len);
+  snprintf (fname, len, "%sresultcache2.bin", btor_log_dir);
+  remove (fname);
+
+  for (i = 0; i < 2; i++)
+  {
+    init_inc_test ();
+    boolector_set_opt (g_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+    boolector_set_result_cache (g_btor, fname);
+    s   = boolector_bitvec_sort (g_btor, 8);
+    one = boolector_one (g_btor, s);
+    if (i == 0)
+    {
+      x   = boolector_var (g_btor, s, "x");
+      y   = boolector_var (g_btor, s, "y");
+      gtx = boolector_ugt (g_btor, x, one);
+      gty = boolector_ugt (g_btor, y, one);
+    }
+    else
+    {
+      y   = boolector_var (g_btor, s, "y");
+      x   = boolector_var (g_btor, s, "x");
+      gty = boolector_ugt (g_btor, y, one);
+      gtx = boolector_ugt (g_btor, x, one);
+    }
+    lt = boolector_ult (g_btor, x, y);
+    c  = boolector_unsigned_int (g_btor, 2, s);
+    eq = boolector_eq (g_btor, y, c);
+    boolector_assert (g_btor, i ? gty : gtx);
+    boolector_assert (g_btor, i ? gtx : gty);
+    boolector_assert (g_btor, lt);
+    boolector_assert (g_btor, eq);
+    res = boolector_sat (g_btor);
+    assert (res == BOOLECTOR_UNSAT);
+    assert (g_btor->result_cache->num_hits == i);
+
+    boolector_release (g_btor, x);
+    boolector_release (g_btor, y);
+    boolector_release (g_btor, one);
+    boolector_release (g_btor, gtx);
+    boolector_release (g_btor, gty);
+    boolector_release (g_btor, lt);
+    boolector_release (g_btor, c);
+    boolector_release (g_btor, eq);
+    boolector_release_sort (g_btor, s);
+    finish_inc_test ();
+  }
+
+  remove (fname);
+  free (fname);
+}
+
 void
 init_inc_tests (void)
 {
@@ -382,6 +792,12 @@ run_inc_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST (inc_lt8);
   BTOR_RUN_TEST (inc_assume_assert1);
   BTOR_RUN_TEST (inc_lemmas_on_demand_1);
+  BTOR_RUN_TEST (inc_lemmas_on_demand_par);
+  BTOR_RUN_TEST (inc_lemmas_on_demand_reuse);
+  BTOR_RUN_TEST (inc_push_pop);
+  BTOR_RUN_TEST (inc_push_pop_failed);
+  BTOR_RUN_TEST (inc_result_cache);
+  BTOR_RUN_TEST (inc_result_cache_order);
 }
 
 void
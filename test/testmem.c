@@ -11,6 +11,7 @@
 #include "testmem.h"
 #include "testrunner.h"
 #include "utils/btormem.h"
+#include "utils/btorutil.h"
 
 #ifdef NDEBUG
 #undef NDEBUG
@@ -87,6 +88,85 @@ test_strdup_mem (void)
   btor_mem_mgr_delete (mm);
 }
 
+static void
+test_pooled_mem (void)
+{
+  uint32_t i, j, n;
+  size_t sizes[] = {1, 8, 9, 24, 100, 256, 257, 4096};
+  char *p[8][1000];
+  BtorMemMgr *mm = btor_mem_mgr_new_pooled ();
+
+  n = sizeof sizes / sizeof *sizes;
+  for (i = 0; i < n; i++)
+    for (j = 0; j < 1000; j++)
+    {
+      p[i][j] = btor_mem_malloc (mm, sizes[i]);
+      memset (p[i][j], (int) (i + j), sizes[i]);
+    }
+  assert (btor_mem_mgr_num_slabs (mm) > 0);
+  for (i = 0; i < n; i++)
+    for (j = 0; j < 1000; j++)
+    {
+      assert (p[i][j][0] == (char) (i + j));
+      assert (p[i][j][sizes[i] - 1] == (char) (i + j));
+    }
+  /* free every other object, reallocate them between size classes */
+  for (i = 0; i < n; i++)
+    for (j = 0; j < 1000; j += 2) btor_mem_free (mm, p[i][j], sizes[i]);
+  for (i = 0; i < n; i++)
+    for (j = 1; j < 1000; j += 2)
+    {
+      p[i][j] = btor_mem_realloc (mm, p[i][j], sizes[i], sizes[(i + 1) % n]);
+      assert (p[i][j][0] == (char) (i + j));
+      btor_mem_free (mm, p[i][j], sizes[(i + 1) % n]);
+    }
+  assert (mm->allocated == 0);
+
+  p[0][0] = btor_mem_calloc (mm, 10, 20);
+  for (i = 0; i < 200; i++) assert (p[0][0][i] == 0);
+  btor_mem_free (mm, p[0][0], 200);
+  btor_mem_mgr_delete (mm);
+}
+
+static void
+test_perf_pooled_mem (void)
+{
+  uint32_t i, j, k, n = 200000;
+  size_t sizes[] = {24, 40, 56, 96, 136}, size;
+  double start;
+  char **p;
+  BtorMemMgr *mm, *gmm = btor_mem_mgr_new ();
+
+  BTOR_NEWN (gmm, p, n);
+  for (k = 0; k < 2; k++)
+  {
+    mm    = k ? btor_mem_mgr_new_pooled () : btor_mem_mgr_new ();
+    start = btor_util_time_stamp ();
+    for (j = 0; j < 10; j++)
+    {
+      for (i = 0; i < n; i++) p[i] = btor_mem_malloc (mm, sizes[i % 5]);
+      /* free and reallocate every third object */
+      for (i = 0; i < n; i += 3)
+      {
+        btor_mem_free (mm, p[i], sizes[i % 5]);
+        p[i] = btor_mem_malloc (mm, sizes[i % 5]);
+      }
+      for (i = 0; i < n; i++)
+      {
+        size = sizes[(i * 7919) % n % 5];
+        btor_mem_free (mm, p[(i * 7919) % n], size);
+      }
+    }
+    btor_mem_mgr_delete (mm);
+    tprintf ("\n%s: %.0f ms",
+             k ? "pooled" : "malloc",
+             (btor_util_time_stamp () - start) * 1e3);
+  }
+  tprintf ("\n");
+  BTOR_DELETEN (gmm, p, n);
+  btor_mem_mgr_delete (gmm);
+}
+
 void
 run_mem_tests (int32_t argc, char **argv)
 {
@@ -95,6 +175,8 @@ run_mem_tests (int32_t argc, char **argv)
   BTOR_RUN_TEST (realloc_mem);
   BTOR_RUN_TEST (calloc_mem);
   BTOR_RUN_TEST (strdup_mem);
+  BTOR_RUN_TEST (pooled_mem);
+  BTOR_RUN_TEST (perf_pooled_mem);
 }
 
 void
@@ -52,11 +52,150 @@ test_next_cnf_id_sat_mgr (void)
   btor_sat_mgr_delete (smgr);
 }
 
+#ifdef BTOR_USE_CADICAL
+/* Incremental use of CaDiCaL: assumptions, failed assumptions and fixed
+ * literals over several calls with clauses added in between. */
+static void
+test_cadical_sat_mgr (void)
+{
+  BtorSATMgr *smgr;
+  int32_t a, b, c, d;
+
+  btor_opt_set (g_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_CADICAL);
+  smgr = btor_sat_mgr_new (g_btor);
+  btor_sat_enable_solver (smgr);
+  assert (btor_sat_mgr_has_incremental_support (smgr));
+  btor_sat_init (smgr);
+  a = btor_sat_mgr_next_cnf_id (smgr);
+  b = btor_sat_mgr_next_cnf_id (smgr);
+  c = btor_sat_mgr_next_cnf_id (smgr);
+  /* (a | b) & (-a | c) & (-b | c) */
+  btor_sat_add (smgr, a);
+  btor_sat_add (smgr, b);
+  btor_sat_add (smgr, 0);
+  btor_sat_add (smgr, -a);
+  btor_sat_add (smgr, c);
+  btor_sat_add (smgr, 0);
+  btor_sat_add (smgr, -b);
+  btor_sat_add (smgr, c);
+  btor_sat_add (smgr, 0);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_SAT);
+  assert (btor_sat_deref (smgr, c) == 1);
+  btor_sat_assume (smgr, a);
+  btor_sat_assume (smgr, -c);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_UNSAT);
+  assert (btor_sat_failed (smgr, -c));
+  /* assumptions only hold for one call */
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_SAT);
+  d = btor_sat_mgr_next_cnf_id (smgr);
+  btor_sat_add (smgr, -c);
+  btor_sat_add (smgr, d);
+  btor_sat_add (smgr, 0);
+  btor_sat_assume (smgr, -d);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_UNSAT);
+  assert (btor_sat_failed (smgr, -d));
+  btor_sat_add (smgr, d);
+  btor_sat_add (smgr, 0);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_SAT);
+  assert (btor_sat_fixed (smgr, d) == 1);
+  btor_sat_add (smgr, -d);
+  btor_sat_add (smgr, 0);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_UNSAT);
+  btor_sat_reset (smgr);
+  btor_sat_mgr_delete (smgr);
+  btor_opt_set (g_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_DFLT);
+}
+#endif
+
+#ifdef BTOR_HAVE_PTHREADS
+static void
+test_portfolio_sat_mgr (void)
+{
+  BtorSATMgr *smgr;
+  int32_t a, b, c;
+
+  btor_opt_set (g_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 4);
+  smgr = btor_sat_mgr_new (g_btor);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  a = btor_sat_mgr_next_cnf_id (smgr);
+  b = btor_sat_mgr_next_cnf_id (smgr);
+  c = btor_sat_mgr_next_cnf_id (smgr);
+  /* (a | b) & (-a | c) & (-b | c) */
+  btor_sat_add (smgr, a);
+  btor_sat_add (smgr, b);
+  btor_sat_add (smgr, 0);
+  btor_sat_add (smgr, -a);
+  btor_sat_add (smgr, c);
+  btor_sat_add (smgr, 0);
+  btor_sat_add (smgr, -b);
+  btor_sat_add (smgr, c);
+  btor_sat_add (smgr, 0);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_SAT);
+  assert (btor_sat_deref (smgr, c) == 1);
+  btor_sat_assume (smgr, -c);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_UNSAT);
+  assert (btor_sat_failed (smgr, -c));
+  btor_sat_add (smgr, -c);
+  btor_sat_add (smgr, 0);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_UNSAT);
+  btor_sat_reset (smgr);
+  btor_sat_mgr_delete (smgr);
+  btor_opt_set (g_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 0);
+}
+
+/* A bounded call after an unbounded call must not be terminated by the
+ * result of the previous call. */
+static void
+test_portfolio_sat_mgr_bounded (void)
+{
+  BtorSATMgr *smgr;
+  int32_t a, p[4][3];
+  uint32_t i, j, k;
+
+  btor_opt_set (g_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 2);
+  smgr = btor_sat_mgr_new (g_btor);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+  a = btor_sat_mgr_next_cnf_id (smgr);
+  btor_sat_add (smgr, a);
+  btor_sat_add (smgr, 0);
+  assert (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_SAT);
+  /* pigeon hole principle for 4 pigeons and 3 holes, requires search */
+  for (i = 0; i < 4; i++)
+    for (j = 0; j < 3; j++) p[i][j] = btor_sat_mgr_next_cnf_id (smgr);
+  for (i = 0; i < 4; i++)
+  {
+    for (j = 0; j < 3; j++) btor_sat_add (smgr, p[i][j]);
+    btor_sat_add (smgr, 0);
+  }
+  for (j = 0; j < 3; j++)
+    for (i = 0; i < 4; i++)
+      for (k = i + 1; k < 4; k++)
+      {
+        btor_sat_add (smgr, -p[i][j]);
+        btor_sat_add (smgr, -p[k][j]);
+        btor_sat_add (smgr, 0);
+      }
+  assert (btor_sat_check_sat (smgr, 100000) == BTOR_RESULT_UNSAT);
+  btor_sat_reset (smgr);
+  btor_sat_mgr_delete (smgr);
+  btor_opt_set (g_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 0);
+}
+#endif
+
 void
 run_sat_tests (int32_t argc, char **argv)
 {
   BTOR_RUN_TEST (new_delete_sat_mgr);
   BTOR_RUN_TEST (next_cnf_id_sat_mgr);
+#ifdef BTOR_USE_CADICAL
+  BTOR_RUN_TEST (cadical_sat_mgr);
+#endif
+#ifdef BTOR_HAVE_PTHREADS
+  BTOR_RUN_TEST (portfolio_sat_mgr);
+  BTOR_RUN_TEST (portfolio_sat_mgr_bounded);
+#endif
 }
 
 void